@@ -10,6 +10,49 @@
 #include "OpenXRHandPoseComponent.h"
 #include "Runtime/Engine/Public/Animation/AnimInstanceProxy.h"
 #include "BoneControllers/AnimNode_SkeletalControlBase.h"
+
+DECLARE_CYCLE_STAT(TEXT("ApplyOpenXRHandPose ~ Evaluate"), STAT_ApplyOpenXRHandPoseEvaluate, STATGROUP_OpenXRHandPose);
+DECLARE_CYCLE_STAT(TEXT("ApplyOpenXRHandPose ~ ConvertKeypoints"), STAT_ApplyOpenXRHandPoseConvertKeypoints, STATGROUP_OpenXRHandPose);
+
+namespace OpenXRHandKeypoints
+{
+	// Manually build the parent hierarchy starting at the wrist which has no parent (-1)
+	static const int8 BoneParents[26] =
+	{
+		1,	// Palm -> Wrist
+		-1,	// Wrist -> None
+		1,	// ThumbMetacarpal -> Wrist
+		2,	// ThumbProximal -> ThumbMetacarpal
+		3,	// ThumbDistal -> ThumbProximal
+		4,	// ThumbTip -> ThumbDistal
+
+		1,	// IndexMetacarpal -> Wrist
+		6,	// IndexProximal -> IndexMetacarpal
+		7,	// IndexIntermediate -> IndexProximal
+		8,	// IndexDistal -> IndexIntermediate
+		9,	// IndexTip -> IndexDistal
+
+		1,	// MiddleMetacarpal -> Wrist
+		11,	// MiddleProximal -> MiddleMetacarpal
+		12,	// MiddleIntermediate -> MiddleProximal
+		13,	// MiddleDistal -> MiddleIntermediate
+		14,	// MiddleTip -> MiddleDistal
+
+		1,	// RingMetacarpal -> Wrist
+		16,	// RingProximal -> RingMetacarpal
+		17,	// RingIntermediate -> RingProximal
+		18,	// RingDistal -> RingIntermediate
+		19,	// RingTip -> RingDistal
+
+		1,	// LittleMetacarpal -> Wrist
+		21,	// LittleProximal -> LittleMetacarpal
+		22,	// LittleIntermediate -> LittleProximal
+		23,	// LittleDistal -> LittleIntermediate
+		24,	// LittleTip -> LittleDistal
+	};
+
+	static_assert(UE_ARRAY_COUNT(BoneParents) == EHandKeypointCount, "Keypoint parent table is out of sync with EHandKeypoint");
+}
 	
 FAnimNode_ApplyOpenXRHandPose::FAnimNode_ApplyOpenXRHandPose()
 	: FAnimNode_SkeletalControlBase()
@@ -21,6 +64,9 @@ FAnimNode_ApplyOpenXRHandPose::FAnimNode_ApplyOpenXRHandPose()
 	bSkipRootBone = false;
 	bOnlyApplyWristTransform = false;
 	//WristAdjustment = FQuat::Identity;
+
+	bKeypointParentsMerged = false;
+	BuildKeypointParents(KeypointParents, bKeypointParentsMerged);
 }
 
 void FAnimNode_ApplyOpenXRHandPose::OnInitializeAnimInstance(const FAnimInstanceProxy* InProxy, const UAnimInstance* InAnimInstance)
@@ -112,6 +158,12 @@ void FAnimNode_ApplyOpenXRHandPose::InitializeBoneReferences(const FBoneContaine
 
 			MappedBonePairs.bInitialized = true;
 
+			bKeypointParentsMerged = MappedBonePairs.bMergeMissingBonesUE4;
+			BuildKeypointParents(KeypointParents, bKeypointParentsMerged);
+
+			HandTransformsScratch.SetNumUninitialized(EHandKeypointCount);
+			BoneTransformsScratch.Reset(1);
+
 			if (WristPair.ReferenceToConstruct.HasValidSetup() && IndexPair.ReferenceToConstruct.HasValidSetup() && PinkyPair.ReferenceToConstruct.HasValidSetup())
 			{
 				//TArray<FTransform> RefBones = AssetSkeleton->GetReferenceSkeleton().GetRefBonePose();
@@ -159,94 +211,94 @@ void FAnimNode_ApplyOpenXRHandPose::ConvertHandTransformsSpace(TArray<FTransform
 		OutTransforms.AddUninitialized(WorldTransforms.Num());
 	}
 
-	// Bone/Parent map
-	int32 BoneParents[26] =
+	int8 Parents[EHandKeypointCount];
+	BuildKeypointParents(Parents, bMergeMissingUE4Bones);
+	ConvertHandKeypointsToParentSpace(WorldTransforms.GetData(), OutTransforms.GetData(), AddTrans.GetRotation(), bMirrorLeftRight, Parents);
+}
+
+void FAnimNode_ApplyOpenXRHandPose::BuildKeypointParents(int8* OutParents, bool bMergeMissingUE4Bones)
+{
+	for (int32 Index = 0; Index < EHandKeypointCount; ++Index)
 	{
-		// Manually build the parent hierarchy starting at the wrist which has no parent (-1)
-		1,	// Palm -> Wrist
-		-1,	// Wrist -> None
-		1,	// ThumbMetacarpal -> Wrist
-		2,	// ThumbProximal -> ThumbMetacarpal
-		3,	// ThumbDistal -> ThumbProximal
-		4,	// ThumbTip -> ThumbDistal
+		int8 ParentIndex = OpenXRHandKeypoints::BoneParents[Index];
 
-		1,	// IndexMetacarpal -> Wrist
-		6,	// IndexProximal -> IndexMetacarpal
-		7,	// IndexIntermediate -> IndexProximal
-		8,	// IndexDistal -> IndexIntermediate
-		9,	// IndexTip -> IndexDistal
+		// Thumb keeps the metacarpal intact, we don't skip it
+		// Merging the missing metacarpal bone into the transform by parenting to the wrist instead
+		if (bMergeMissingUE4Bones && Index != (int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_PROXIMAL_EXT && ParentIndex > 0 &&
+			OpenXRHandKeypoints::BoneParents[ParentIndex] == 1) // Wrist
+		{
+			ParentIndex = 1;
+		}
 
-		1,	// MiddleMetacarpal -> Wrist
-		11,	// MiddleProximal -> MiddleMetacarpal
-		12,	// MiddleIntermediate -> MiddleProximal
-		13,	// MiddleDistal -> MiddleIntermediate
-		14,	// MiddleTip -> MiddleDistal
+		OutParents[Index] = ParentIndex;
+	}
+}
 
-		1,	// RingMetacarpal -> Wrist
-		16,	// RingProximal -> RingMetacarpal
-		17,	// RingIntermediate -> RingProximal
-		18,	// RingDistal -> RingIntermediate
-		19,	// RingTip -> RingDistal
+void FAnimNode_ApplyOpenXRHandPose::ConvertHandKeypointsToParentSpace(const FTransform* WorldTransforms, FTransform* OutTransforms, const FQuat& AddRotation, bool bMirrorLeftRight, const int8* KeypointParents)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ApplyOpenXRHandPoseConvertKeypoints);
 
-		1,	// LittleMetacarpal -> Wrist
-		21,	// LittleProximal -> LittleMetacarpal
-		22,	// LittleIntermediate -> LittleProximal
-		23,	// LittleDistal -> LittleIntermediate
-		24,	// LittleTip -> LittleDistal
-	};
+	// Packed world space components, every keypoint is read by its children so they are prepared once up front
+	VectorRegister Rotations[EHandKeypointCount];
+	VectorRegister Translations[EHandKeypointCount];
+	VectorRegister Scales[EHandKeypointCount];
+
+	// Mirroring on Y is S * M * S with S = (1, -1, 1), for the rotation that is (-X, Y, -Z, W)
+	// This skips the round trip through a matrix that FTransform::Mirror takes
+	static const VectorRegister RotationMirror = MakeVectorRegister(-1.f, 1.f, -1.f, 1.f);
+	static const VectorRegister TranslationMirror = MakeVectorRegister(1.f, -1.f, 1.f, 0.f);
+	static const VectorRegister ScaleTolerance = MakeVectorRegister(SMALL_NUMBER, SMALL_NUMBER, SMALL_NUMBER, SMALL_NUMBER);
 
-	// Convert transforms to parent space
-	// The hand tracking transforms are in world space.
+	const VectorRegister AddRot = VectorLoad(&AddRotation);
+	const VectorRegister RotationSign = bMirrorLeftRight ? RotationMirror : GlobalVectorConstants::FloatOne;
+	const VectorRegister TranslationSign = bMirrorLeftRight ? TranslationMirror : GlobalVectorConstants::Float1110;
 
 	for (int32 Index = 0; Index < EHandKeypointCount; ++Index)
 	{
-		WorldTransforms[Index].NormalizeRotation();
-
-		if (bMirrorLeftRight)
-		{
-			WorldTransforms[Index].Mirror(EAxis::Y, EAxis::Y);
-		}
-
-		WorldTransforms[Index].ConcatenateRotation(AddTrans.GetRotation());
+		const FTransform& WorldTransform = WorldTransforms[Index];
+		const FQuat Rotation = WorldTransform.GetRotation();
+		const FVector Translation = WorldTransform.GetTranslation();
+		const FVector Scale = WorldTransform.GetScale3D();
+
+		const VectorRegister Rot = VectorMultiply(VectorNormalizeQuaternion(VectorLoad(&Rotation)), RotationSign);
+		Rotations[Index] = VectorQuaternionMultiply2(Rot, AddRot);
+		Translations[Index] = VectorMultiply(VectorLoadFloat3_W0(&Translation), TranslationSign);
+		Scales[Index] = VectorLoadFloat3_W0(&Scale);
 	}
 
+	// Same math as FTransform::GetRelativeTransform against the parent keypoint
 	for (int32 Index = 0; Index < EHandKeypointCount; ++Index)
 	{
-		FTransform& BoneTransform = WorldTransforms[Index];
-		int32 ParentIndex = BoneParents[Index];
-		int32 ParentParent = -1;
+		VectorRegister Rot = Rotations[Index];
+		VectorRegister Trans = Translations[Index];
+		VectorRegister Scale = Scales[Index];
 
-		// Thumb keeps the metacarpal intact, we don't skip it
-		if (bMergeMissingUE4Bones)
+		const int32 ParentIndex = KeypointParents[Index];
+		if (ParentIndex >= 0)
 		{
-			if (Index != (int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_PROXIMAL_EXT && ParentIndex > 0)
-			{
-				ParentParent = BoneParents[ParentIndex];
-			}
-		}
+			const VectorRegister ParentRot = Rotations[ParentIndex];
+			const VectorRegister ParentScale = Scales[ParentIndex];
+			const VectorRegister SafeScaleRcp = VectorSelect(VectorCompareGE(VectorAbs(ParentScale), ScaleTolerance), VectorReciprocalAccurate(ParentScale), GlobalVectorConstants::FloatZero);
 
-		if (ParentIndex < 0)
-		{
-			// We are at the root, so use it.
-			OutTransforms[Index] = BoneTransform;
-		}
-		else
-		{
-			// Merging missing metacarpal bone into the transform
-			if (bMergeMissingUE4Bones && ParentParent == 1) // Wrist
-			{
-				OutTransforms[Index] = BoneTransform.GetRelativeTransform(WorldTransforms[ParentParent]);
-			}
-			else
-			{
-				OutTransforms[Index] = BoneTransform.GetRelativeTransform(WorldTransforms[ParentIndex]);
-			}
+			Trans = VectorMultiply(VectorQuaternionInverseRotateVector(ParentRot, VectorSubtract(Trans, Translations[ParentIndex])), SafeScaleRcp);
+			Rot = VectorQuaternionMultiply2(VectorQuaternionInverse(ParentRot), Rot);
+			Scale = VectorMultiply(Scale, SafeScaleRcp);
 		}
+
+		FQuat OutRotation;
+		FVector OutTranslation;
+		FVector OutScale;
+		VectorStore(Rot, &OutRotation);
+		VectorStoreFloat3(Trans, &OutTranslation);
+		VectorStoreFloat3(Scale, &OutScale);
+		OutTransforms[Index] = FTransform(OutRotation, OutTranslation, OutScale);
 	}
 }
 
 void FAnimNode_ApplyOpenXRHandPose::EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ApplyOpenXRHandPoseEvaluate);
+
 	if (!MappedBonePairs.bInitialized)
 		return;
 
@@ -288,7 +340,7 @@ void FAnimNode_ApplyOpenXRHandPose::EvaluateSkeletalControl_AnyThread(FComponent
 	uint8 BoneTransIndex = 0;
 	uint8 NumBones = StoredActionInfoPtr ? StoredActionInfoPtr->SkeletalTransforms.Num() : 0;
 
-	if (NumBones < 1)
+	if (NumBones < EHandKeypointCount)
 	{
 		// Early out, we don't have a valid data to work with
 		return;
@@ -296,17 +348,28 @@ void FAnimNode_ApplyOpenXRHandPose::EvaluateSkeletalControl_AnyThread(FComponent
 
 	FTransform trans = FTransform::Identity;
 	OutBoneTransforms.Reserve(MappedBonePairs.BonePairs.Num());
-	TArray<FBoneTransform> TransBones;
-	FTransform AdditionTransform = StoredActionInfoPtr->AdditionTransform;
+	TArray<FBoneTransform>& TransBones = BoneTransformsScratch;
+	TransBones.Reset();
 
 	FTransform TempTrans = FTransform::Identity;
 	FTransform ParentTrans = FTransform::Identity;
-	FTransform * ParentTransPtr = nullptr;
 
 	//AdditionTransform.SetRotation(MappedBonePairs.AdjustmentQuat);
 
-	TArray<FTransform> HandTransforms;
-	ConvertHandTransformsSpace(HandTransforms, StoredActionInfoPtr->SkeletalTransforms, AdditionTransform, StoredActionInfoPtr->bMirrorLeftRight, MappedBonePairs.bMergeMissingBonesUE4);
+	// Mappings initialized through UOpenXRAnimInstance::InitializeCustomBoneMapping don't pass through InitializeBoneReferences
+	if (bKeypointParentsMerged != MappedBonePairs.bMergeMissingBonesUE4)
+	{
+		bKeypointParentsMerged = MappedBonePairs.bMergeMissingBonesUE4;
+		BuildKeypointParents(KeypointParents, bKeypointParentsMerged);
+	}
+
+	if (HandTransformsScratch.Num() != EHandKeypointCount)
+	{
+		HandTransformsScratch.SetNumUninitialized(EHandKeypointCount);
+	}
+
+	const TArray<FTransform>& HandTransforms = HandTransformsScratch;
+	ConvertHandKeypointsToParentSpace(StoredActionInfoPtr->SkeletalTransforms.GetData(), HandTransformsScratch.GetData(), StoredActionInfoPtr->AdditionTransform.GetRotation(), StoredActionInfoPtr->bMirrorLeftRight, KeypointParents);
 
 	for (const FBPOpenXRSkeletalPair& BonePair : MappedBonePairs.BonePairs)
 	{
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "OpenXRBenchmarkUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+
+#if !UE_BUILD_SHIPPING
+
+DEFINE_LOG_CATEGORY(LogOpenXRBenchmark);
+
+namespace OpenXRBenchmarkUtils
+{
+	void ParseCommonArg(const FString& Arg, FCommonArgs& InOutArgs)
+	{
+		FParse::Value(*Arg, TEXT("Out="), InOutArgs.OutputPath);
+		InOutArgs.bQuitWhenDone |= Arg.Equals(TEXT("Quit"), ESearchCase::IgnoreCase);
+	}
+
+	void SetDefaultOutputPath(FString& InOutPath, const TCHAR* Folder, const TCHAR* Prefix)
+	{
+		if (InOutPath.IsEmpty())
+		{
+			InOutPath = FPaths::ProfilingDir() / Folder / FString::Printf(TEXT("%s-%s.csv"), Prefix, *FDateTime::Now().ToString());
+		}
+	}
+
+	bool SaveCsv(const TCHAR* CommandName, const FString& Csv, const FString& OutputPath)
+	{
+		if (FFileHelper::SaveStringToFile(Csv, *OutputPath))
+		{
+			UE_LOG(LogOpenXRBenchmark, Display, TEXT("%s: Wrote %s"), CommandName, *FPaths::ConvertRelativePathToFull(OutputPath));
+			return true;
+		}
+
+		UE_LOG(LogOpenXRBenchmark, Warning, TEXT("%s: Failed to write %s"), CommandName, *OutputPath);
+		return false;
+	}
+
+	void SaveAndLogResults(const TCHAR* CommandName, const FString& Csv, const FString& OutputPath)
+	{
+		SaveCsv(CommandName, Csv, OutputPath);
+		UE_LOG(LogOpenXRBenchmark, Display, TEXT("%s results:\n%s"), CommandName, *Csv);
+	}
+
+	void QuitIfRequested(const FCommonArgs& Args)
+	{
+		if (Args.bQuitWhenDone)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+DECLARE_LOG_CATEGORY_EXTERN(LogOpenXRBenchmark, Log, All);
+
+// Shared plumbing for the vr.OpenXR* benchmark and report console commands, same conventions as VRBenchmarkUtils in the
+// VRExpansionPlugin module, which this module doesn't depend on
+// Every command takes Out=Path.csv and Quit, writes a CSV to ProfilingDir/<Folder>/ by default and logs to LogOpenXRBenchmark
+namespace OpenXRBenchmarkUtils
+{
+	struct FCommonArgs
+	{
+		FString OutputPath;
+		bool bQuitWhenDone = false;
+	};
+
+	// Picks Out= and Quit out of a single console argument
+	void ParseCommonArg(const FString& Arg, FCommonArgs& InOutArgs);
+
+	// Fills in ProfilingDir/Folder/Prefix-Date.csv if Out= wasn't passed
+	void SetDefaultOutputPath(FString& InOutPath, const TCHAR* Folder, const TCHAR* Prefix);
+
+	// Writes the CSV and logs where it went
+	bool SaveCsv(const TCHAR* CommandName, const FString& Csv, const FString& OutputPath);
+
+	// Writes the CSV and logs both the path and the results
+	void SaveAndLogResults(const TCHAR* CommandName, const FString& Csv, const FString& OutputPath);
+
+	void QuitIfRequested(const FCommonArgs& Args);
+}
+
+#endif
@@ -0,0 +1,188 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+#include "Misc/Parse.h"
+#include "AnimNode_ApplyOpenXRHandPose.h"
+#include "OpenXRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Keypoint conversion cost of FAnimNode_ApplyOpenXRHandPose, the previous per evaluation path vs the batched kernel
+// Every node is run as its own task on the task graph workers, the same threads parallel anim evaluation uses,
+// so the timings include contention from evaluating many hands at once. Results are per node.
+//
+// Usage: vr.OpenXRHandPoseBenchmark [Nodes=64] [Iterations=1000] [Out=Path.csv] [Quit]
+namespace OpenXRHandPoseBenchmark
+{
+	struct FNodeState
+	{
+		TArray<FTransform> WorldTransforms;
+		TArray<FTransform> LegacyOutput;
+		TArray<FTransform> KernelOutput;
+		int8 Parents[EHandKeypointCount];
+		FQuat AddRotation;
+		bool bMirror;
+		bool bMerge;
+
+		double LegacyUs;
+		double KernelUs;
+		float MaxTranslationError;
+		float MaxRotationErrorDeg;
+		uint32 ThreadId;
+	};
+
+	// The evaluation path the node used before, fresh arrays every call and a matrix round trip for the mirror
+	static void LegacyConvert(TArray<FTransform>& OutTransforms, const TArray<FTransform>& InWorldTransforms, const FTransform& AddTrans, bool bMirrorLeftRight, const int8* Parents)
+	{
+		TArray<FTransform> WorldTransforms = InWorldTransforms;
+		OutTransforms.Empty(WorldTransforms.Num());
+		OutTransforms.AddUninitialized(WorldTransforms.Num());
+
+		for (int32 Index = 0; Index < EHandKeypointCount; ++Index)
+		{
+			WorldTransforms[Index].NormalizeRotation();
+
+			if (bMirrorLeftRight)
+			{
+				WorldTransforms[Index].Mirror(EAxis::Y, EAxis::Y);
+			}
+
+			WorldTransforms[Index].ConcatenateRotation(AddTrans.GetRotation());
+		}
+
+		for (int32 Index = 0; Index < EHandKeypointCount; ++Index)
+		{
+			const int32 ParentIndex = Parents[Index];
+			OutTransforms[Index] = ParentIndex < 0 ? WorldTransforms[Index] : WorldTransforms[Index].GetRelativeTransform(WorldTransforms[ParentIndex]);
+		}
+	}
+
+	static void InitNode(FNodeState& Node, int32 NodeIndex)
+	{
+		FRandomStream Stream(NodeIndex + 1);
+
+		Node.WorldTransforms.SetNumUninitialized(EHandKeypointCount);
+		for (int32 Index = 0; Index < EHandKeypointCount; ++Index)
+		{
+			const FQuat Rotation(Stream.GetUnitVector(), Stream.FRandRange(-PI, PI));
+			Node.WorldTransforms[Index] = FTransform(Rotation, Stream.GetUnitVector() * Stream.FRandRange(1.f, 20.f), FVector(1.f));
+		}
+
+		Node.AddRotation = FRotator(180.f, 0.f, -90.f).Quaternion();
+		Node.bMirror = (NodeIndex % 2) != 0;
+		Node.bMerge = (NodeIndex % 4) < 2;
+		FAnimNode_ApplyOpenXRHandPose::BuildKeypointParents(Node.Parents, Node.bMerge);
+
+		Node.KernelOutput.SetNumUninitialized(EHandKeypointCount);
+		Node.LegacyUs = 0.0;
+		Node.KernelUs = 0.0;
+		Node.MaxTranslationError = 0.f;
+		Node.MaxRotationErrorDeg = 0.f;
+		Node.ThreadId = 0;
+	}
+
+	static void RunNode(FNodeState& Node, int32 Iterations)
+	{
+		Node.ThreadId = FPlatformTLS::GetCurrentThreadId();
+		const FTransform AddTrans(Node.AddRotation);
+
+		uint64 Start = FPlatformTime::Cycles64();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			LegacyConvert(Node.LegacyOutput, Node.WorldTransforms, AddTrans, Node.bMirror, Node.Parents);
+		}
+		Node.LegacyUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0 / Iterations;
+
+		Start = FPlatformTime::Cycles64();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			FAnimNode_ApplyOpenXRHandPose::ConvertHandKeypointsToParentSpace(Node.WorldTransforms.GetData(), Node.KernelOutput.GetData(), Node.AddRotation, Node.bMirror, Node.Parents);
+		}
+		Node.KernelUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0 / Iterations;
+
+		for (int32 Index = 0; Index < EHandKeypointCount; ++Index)
+		{
+			const FTransform& Legacy = Node.LegacyOutput[Index];
+			const FTransform& Kernel = Node.KernelOutput[Index];
+			Node.MaxTranslationError = FMath::Max(Node.MaxTranslationError, (Legacy.GetTranslation() - Kernel.GetTranslation()).Size());
+			Node.MaxRotationErrorDeg = FMath::Max(Node.MaxRotationErrorDeg, FMath::RadiansToDegrees(Legacy.GetRotation().AngularDistance(Kernel.GetRotation())));
+		}
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		int32 NumNodes = 64;
+		int32 Iterations = 1000;
+		OpenXRBenchmarkUtils::FCommonArgs Common;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Nodes="), NumNodes);
+			FParse::Value(*Arg, TEXT("Iterations="), Iterations);
+			OpenXRBenchmarkUtils::ParseCommonArg(Arg, Common);
+		}
+
+		NumNodes = FMath::Max(1, NumNodes);
+		Iterations = FMath::Max(1, Iterations);
+
+		OpenXRBenchmarkUtils::SetDefaultOutputPath(Common.OutputPath, TEXT("OpenXRHandPoseBenchmark"), TEXT("OpenXRHandPoseBenchmark"));
+
+		TArray<FNodeState> Nodes;
+		Nodes.SetNum(NumNodes);
+		for (int32 i = 0; i < NumNodes; ++i)
+		{
+			InitNode(Nodes[i], i);
+		}
+
+		ParallelFor(NumNodes, [&Nodes, Iterations](int32 NodeIndex)
+		{
+			RunNode(Nodes[NodeIndex], Iterations);
+		});
+
+		FString Csv = TEXT("Node,ThreadId,Mirror,Merge,LegacyUsAvg,KernelUsAvg,Speedup,MaxTranslationError,MaxRotationErrorDeg\n");
+
+		double TotalLegacyUs = 0.0;
+		double TotalKernelUs = 0.0;
+		float WorstTranslationError = 0.f;
+		float WorstRotationErrorDeg = 0.f;
+
+		for (int32 i = 0; i < NumNodes; ++i)
+		{
+			const FNodeState& Node = Nodes[i];
+			Csv += FString::Printf(TEXT("%d,%u,%d,%d,%.3f,%.3f,%.2f,%.6f,%.6f\n"),
+				i,
+				Node.ThreadId,
+				Node.bMirror ? 1 : 0,
+				Node.bMerge ? 1 : 0,
+				Node.LegacyUs,
+				Node.KernelUs,
+				Node.KernelUs > 0.0 ? Node.LegacyUs / Node.KernelUs : 0.0,
+				Node.MaxTranslationError,
+				Node.MaxRotationErrorDeg);
+
+			TotalLegacyUs += Node.LegacyUs;
+			TotalKernelUs += Node.KernelUs;
+			WorstTranslationError = FMath::Max(WorstTranslationError, Node.MaxTranslationError);
+			WorstRotationErrorDeg = FMath::Max(WorstRotationErrorDeg, Node.MaxRotationErrorDeg);
+		}
+
+		OpenXRBenchmarkUtils::SaveCsv(TEXT("vr.OpenXRHandPoseBenchmark"), Csv, Common.OutputPath);
+
+		UE_LOG(LogOpenXRBenchmark, Display, TEXT("vr.OpenXRHandPoseBenchmark: %d nodes, legacy %.3fus / kernel %.3fus per node on average, max error %.6f cm / %.6f deg"),
+			NumNodes, TotalLegacyUs / NumNodes, TotalKernelUs / NumNodes, WorstTranslationError, WorstRotationErrorDeg);
+
+		OpenXRBenchmarkUtils::QuitIfRequested(Common);
+	}
+
+	static FAutoConsoleCommand OpenXRHandPoseBenchmarkCommand(
+		TEXT("vr.OpenXRHandPoseBenchmark"),
+		TEXT("Times the hand keypoint conversion of the ApplyOpenXRHandPose node per node across the task graph workers, old path vs the batched kernel, and writes a CSV to the profiling directory.\n")
+		TEXT("Args: Nodes=64 Iterations=1000 Out=Path.csv Quit"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
@@ -7,6 +7,83 @@
 #include "XRMotionControllerBase.h" // for GetHandEnumForSourceName()
 //#include "EngineMinimal.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skeletal Rep Bytes Sent"), STAT_SkeletalRepBytesSent, STATGROUP_OpenXRHandPose);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skeletal Rep Keyframes Sent"), STAT_SkeletalRepKeyframesSent, STATGROUP_OpenXRHandPose);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skeletal Rep Deltas Sent"), STAT_SkeletalRepDeltasSent, STATGROUP_OpenXRHandPose);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skeletal Rep Bones Skipped"), STAT_SkeletalRepBonesSkipped, STATGROUP_OpenXRHandPose);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skeletal Rep Deltas Dropped"), STAT_SkeletalRepDeltasDropped, STATGROUP_OpenXRHandPose);
+DECLARE_CYCLE_STAT(TEXT("OpenXRHandPose ~ DetectGesture"), STAT_OpenXRDetectGesture, STATGROUP_OpenXRHandPose);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gesture Detections Skipped"), STAT_OpenXRGestureDetectionsSkipped, STATGROUP_OpenXRHandPose);
+
+// Smallest three quaternion encoding for the skeletal data, same scheme as FTransform_NetQuantize in the VRExpansionPlugin
+// 9 bits per element is ~29 bits per bone, around the same as FRotator::SerializeCompressed but with far better precision
+namespace OpenXRSkeletalQuant
+{
+	static const uint32 QuatBits = 9;
+	static const float MinimumQ = -1.0f / 1.414214f;
+	static const float MaximumQ = +1.0f / 1.414214f;
+	static const float MinMaxQDiff = MaximumQ - MinimumQ;
+
+	static void SerializeQuat_SmallestThree(FArchive& Ar, FQuat& InQuat)
+	{
+		const float Scale = float((1 << QuatBits) - 1);
+		uint32 LargestIndex = 0;
+		uint32 Integers[3] = { 0, 0, 0 };
+
+		if (Ar.IsSaving())
+		{
+			InQuat.Normalize();
+			const float Components[4] = { InQuat.X, InQuat.Y, InQuat.Z, InQuat.W };
+
+			float LargestValue = FMath::Abs(Components[0]);
+			for (uint32 i = 1; i < 4; ++i)
+			{
+				if (FMath::Abs(Components[i]) > LargestValue)
+				{
+					LargestIndex = i;
+					LargestValue = FMath::Abs(Components[i]);
+				}
+			}
+
+			// q and -q are the same rotation, flip so the dropped component is always positive
+			const float Sign = Components[LargestIndex] >= 0.f ? 1.f : -1.f;
+			for (uint32 i = 0, j = 0; i < 4; ++i)
+			{
+				if (i == LargestIndex)
+					continue;
+
+				const float Normal = ((Components[i] * Sign) - MinimumQ) / MinMaxQDiff;
+				Integers[j++] = (uint32)FMath::Clamp(FMath::FloorToInt(Normal * Scale + 0.5f), 0, (1 << QuatBits) - 1);
+			}
+		}
+
+		Ar.SerializeBits(&LargestIndex, 2);
+		Ar.SerializeBits(&Integers[0], QuatBits);
+		Ar.SerializeBits(&Integers[1], QuatBits);
+		Ar.SerializeBits(&Integers[2], QuatBits);
+
+		if (Ar.IsLoading())
+		{
+			const float InverseScale = 1.0f / Scale;
+			float Components[4];
+			float SumSquared = 0.f;
+
+			for (uint32 i = 0, j = 0; i < 4; ++i)
+			{
+				if (i == LargestIndex)
+					continue;
+
+				Components[i] = Integers[j++] * InverseScale * MinMaxQDiff + MinimumQ;
+				SumSquared += Components[i] * Components[i];
+			}
+
+			Components[LargestIndex] = FMath::Sqrt(FMath::Max(0.f, 1.f - SumSquared));
+			InQuat = FQuat(Components[0], Components[1], Components[2], Components[3]);
+			InQuat.Normalize();
+		}
+	}
+}
+
 UOpenXRHandPoseComponent::UOpenXRHandPoseComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -20,6 +97,11 @@ UOpenXRHandPoseComponent::UOpenXRHandPoseComponent(const FObjectInitializer& Obj
 	bDetectGestures = true;
 	SetIsReplicatedByDefault(true);
 	bGetMockUpPoseForDebugging = false;
+	bUseDeltaSkeletalCompression = false;
+	SkeletalKeyframeInterval = 10;
+	SkeletalDeltaRotationTolerance = 0.25f;
+	GestureMovementTolerance = 0.1f;
+	GestureReleaseHysteresis = 0.2f;
 }
 
 void UOpenXRHandPoseComponent::GetLifetimeReplicatedProps(TArray< class FLifetimeProperty > & OutLifetimeProps) const
@@ -37,20 +119,45 @@ void UOpenXRHandPoseComponent::Server_SendSkeletalTransforms_Implementation(cons
 	{
 		if (HandSkeletalActions[i].TargetHand == SkeletalInfo.TargetHand)
 		{
+			FBPSkeletalRepContainer ResolvedInfo = SkeletalInfo;
+
+			if (ResolvedInfo.bUseDeltaCompression)
+			{
+				if (ResolvedInfo.bIsKeyframe)
+				{
+					Client_AckSkeletalKeyframe(ResolvedInfo.TargetHand, ResolvedInfo.KeyframeId);
+				}
+
+				// Out of order or lost keyframe, wait for the next one
+				if (!GetDeltaManager(ResolvedInfo.TargetHand).ResolveDelta(ResolvedInfo))
+				{
+					INC_DWORD_STAT(STAT_SkeletalRepDeltasDropped);
+					break;
+				}
+			}
+
 			HandSkeletalActions[i].OldSkeletalTransforms = HandSkeletalActions[i].SkeletalTransforms;
 
-			FBPSkeletalRepContainer::CopyReplicatedTo(SkeletalInfo, HandSkeletalActions[i]);
+			FBPSkeletalRepContainer::CopyReplicatedTo(ResolvedInfo, HandSkeletalActions[i]);
 
-			if (SkeletalInfo.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
+			FBPSkeletalRepContainer& HandRep = (ResolvedInfo.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left) ? LeftHandRep : RightHandRep;
+			HandRep = ResolvedInfo;
+
+			// Property replication has no per connection ack and can skip values, so the simulated proxies only get keyframes
+			if (bUseDeltaSkeletalCompression && HandRep.bHasValidData())
 			{
-				LeftHandRep = SkeletalInfo;
-				if (bSmoothReplicatedSkeletalData)
-					LeftHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations);
+				FSkeletalDeltaManager::EncodeStandaloneKeyframe(HandRep);
 			}
 			else
 			{
-				RightHandRep = SkeletalInfo;
-				if (bSmoothReplicatedSkeletalData)
+				HandRep.bUseDeltaCompression = false;
+			}
+
+			if (bSmoothReplicatedSkeletalData)
+			{
+				if (ResolvedInfo.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
+					LeftHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations);
+				else
 					RightHandRepManager.NotifyNewData(HandSkeletalActions[i], ReplicationRateForSkeletalAnimations);
 			}
 
@@ -64,6 +171,11 @@ bool UOpenXRHandPoseComponent::Server_SendSkeletalTransforms_Validate(const FBPS
 	return true;
 }
 
+void UOpenXRHandPoseComponent::Client_AckSkeletalKeyframe_Implementation(EVRSkeletalHandIndex TargetHand, uint8 KeyframeId)
+{
+	GetDeltaManager(TargetHand).NotifyKeyframeAcked(KeyframeId);
+}
+
 void FOpenXRAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
 {
 	Super::PreUpdate(InAnimInstance, DeltaSeconds);
@@ -170,6 +282,13 @@ void UOpenXRHandPoseComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 						{
 							FBPSkeletalRepContainer ContainerSend;
 							ContainerSend.CopyForReplication(actionInfo);
+
+							if (bUseDeltaSkeletalCompression && ContainerSend.bHasValidData())
+							{
+								GetDeltaManager(actionInfo.TargetHand).EncodeDelta(ContainerSend, SkeletalKeyframeInterval, SkeletalDeltaRotationTolerance);
+							}
+
+							RecordSkeletalSendStats(ContainerSend);
 							Server_SendSkeletalTransforms(ContainerSend);
 						}
 					}
@@ -177,10 +296,19 @@ void UOpenXRHandPoseComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 					{
 						if (actionInfo.bHasValidData)
 						{
-							if (actionInfo.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
-								LeftHandRep.CopyForReplication(actionInfo);
+							FBPSkeletalRepContainer& HandRep = (actionInfo.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left) ? LeftHandRep : RightHandRep;
+							HandRep.CopyForReplication(actionInfo);
+
+							if (bUseDeltaSkeletalCompression && HandRep.bHasValidData())
+							{
+								FSkeletalDeltaManager::EncodeStandaloneKeyframe(HandRep);
+							}
 							else
-								RightHandRep.CopyForReplication(actionInfo);
+							{
+								HandRep.bUseDeltaCompression = false;
+							}
+
+							RecordSkeletalSendStats(HandRep);
 						}
 					}
 				}
@@ -196,6 +324,33 @@ void UOpenXRHandPoseComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
+void UOpenXRHandPoseComponent::RecordSkeletalSendStats(FBPSkeletalRepContainer& Container)
+{
+#if STATS
+	// Serialize into a scratch writer to get the real wire size, stat fps * bytes gives the bandwidth for the live hand data
+	if (!Container.bHasValidData())
+		return;
+
+	FBitWriter SizeWriter(0, true);
+	bool bSuccess = true;
+	Container.NetSerialize(SizeWriter, nullptr, bSuccess);
+	INC_DWORD_STAT_BY(STAT_SkeletalRepBytesSent, SizeWriter.GetNumBytes());
+
+	if (Container.bUseDeltaCompression)
+	{
+		if (Container.bIsKeyframe)
+		{
+			INC_DWORD_STAT(STAT_SkeletalRepKeyframesSent);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_SkeletalRepDeltasSent);
+			INC_DWORD_STAT_BY(STAT_SkeletalRepBonesSkipped, Container.SkeletalTransforms.Num() - FMath::CountBits(Container.ChangedBoneMask));
+		}
+	}
+#endif
+}
+
 bool UOpenXRHandPoseComponent::SaveCurrentPose(FName RecordingName, EVRSkeletalHandIndex HandToSave)
 {
 
@@ -255,7 +410,7 @@ bool UOpenXRHandPoseComponent::SaveCurrentPose(FName RecordingName, EVRSkeletalH
 		}
 
 		NewGesture.Name = RecordingName;
-		GesturesDB->Gestures.Add(NewGesture);
+		GesturesDB->AddGesture(NewGesture);
 
 		return true;
 	}
@@ -264,84 +419,168 @@ bool UOpenXRHandPoseComponent::SaveCurrentPose(FName RecordingName, EVRSkeletalH
 }
 
 
-bool UOpenXRHandPoseComponent::K2_DetectCurrentPose(UPARAM(ref) FBPOpenXRActionSkeletalData& SkeletalAction, FOpenXRGesture & GestureOut)
+void UOpenXRGestureDatabase::PostLoad()
 {
-	if (!GesturesDB || GesturesDB->Gestures.Num() < 1)
+	Super::PostLoad();
+	RecompileGestures();
+}
+
+#if WITH_EDITOR
+void UOpenXRGestureDatabase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	RecompileGestures();
+}
+#endif
+
+int32 UOpenXRGestureDatabase::AddGesture(const FOpenXRGesture& NewGesture)
+{
+	const int32 GestureIndex = Gestures.Add(NewGesture);
+	RecompileGestures();
+	return GestureIndex;
+}
+
+bool UOpenXRGestureDatabase::SetGesture(int32 GestureIndex, const FOpenXRGesture& NewGesture)
+{
+	if (!Gestures.IsValidIndex(GestureIndex))
 		return false;
 
-	int32 FingerMap[5] =
-	{
-		(int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_TIP_EXT,
-		(int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_TIP_EXT,
-		(int32)EXRHandJointType::OXR_HAND_JOINT_MIDDLE_TIP_EXT,
-		(int32)EXRHandJointType::OXR_HAND_JOINT_RING_TIP_EXT,
-		(int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_TIP_EXT
-	};
+	Gestures[GestureIndex] = NewGesture;
+	RecompileGestures();
+	return true;
+}
+
+bool UOpenXRGestureDatabase::RemoveGesture(int32 GestureIndex)
+{
+	if (!Gestures.IsValidIndex(GestureIndex))
+		return false;
 
-	FVector WristLoc = FVector::ZeroVector;
+	Gestures.RemoveAt(GestureIndex);
+	RecompileGestures();
+	return true;
+}
 
-	if (SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
-	{
-		WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation().MirrorByVector(FVector::RightVector);
-	}
-	else
+void UOpenXRGestureDatabase::ClearGestures()
+{
+	Gestures.Empty();
+	RecompileGestures();
+}
+
+void UOpenXRGestureDatabase::RecompileGestures()
+{
+	CompiledGestures.Compile(Gestures);
+}
+
+bool UOpenXRGestureDatabase::MatchesGesture(const FOpenXRGesture& Gesture, const FVector* Tips, float ThresholdScale)
+{
+	if (Gesture.FingerValues.Num() < 5)
+		return false;
+
+	for (int i = 0; i < 5; ++i)
 	{
-		WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation();
+		if (Gesture.FingerValues[i].Threshold <= 0.0f)
+			continue;
+
+		if (!Gesture.FingerValues[i].Value.Equals(Tips[i], Gesture.FingerValues[i].Threshold * ThresholdScale))
+			return false;
 	}
 
-	// Early fill in an array to keep from performing math for each gesture
-	TArray<FVector> CurrentTips;
-	CurrentTips.AddUninitialized(5);
-	for (int i = 0; i < 5; ++i)
+	return true;
+}
+
+void FOpenXRCompiledGestureTable::Compile(const TArray<FOpenXRGesture>& Gestures)
+{
+	static uint32 NextVersion = 0;
+	Version = ++NextVersion;
+	if (Version == 0) // Wrapped, 0 means never compiled
+		Version = ++NextVersion;
+
+	SourceGestureCount = Gestures.Num();
+	GestureIndices.Reset(Gestures.Num());
+
+	for (int32 GestureIndex = 0; GestureIndex < Gestures.Num(); ++GestureIndex)
 	{
-		if (SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
+		// If not enough indexs to match curl values
+		if (Gestures[GestureIndex].FingerValues.Num() >= 5)
 		{
-			CurrentTips[i] = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation().MirrorByVector(FVector::RightVector) - WristLoc;
+			GestureIndices.Add(GestureIndex);
 		}
-		else
+	}
+
+	PaddedCount = Align(GestureIndices.Num(), 4);
+
+	// Padding has a negative threshold so it can never match
+	Rows.Reset(5 * 4 * PaddedCount);
+	Rows.AddZeroed(5 * 4 * PaddedCount);
+
+	for (int32 Finger = 0; Finger < 5; ++Finger)
+	{
+		float* X = Rows.GetData() + (Finger * 4 + 0) * PaddedCount;
+		float* Y = Rows.GetData() + (Finger * 4 + 1) * PaddedCount;
+		float* Z = Rows.GetData() + (Finger * 4 + 2) * PaddedCount;
+		float* Threshold = Rows.GetData() + (Finger * 4 + 3) * PaddedCount;
+
+		for (int32 Entry = 0; Entry < PaddedCount; ++Entry)
 		{
-			CurrentTips[i] = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation() - WristLoc;
+			if (Entry >= GestureIndices.Num())
+			{
+				Threshold[Entry] = -1.0f;
+				continue;
+			}
+
+			const FOpenXRGestureFingerPosition& FingerValue = Gestures[GestureIndices[Entry]].FingerValues[Finger];
+			X[Entry] = FingerValue.Value.X;
+			Y[Entry] = FingerValue.Value.Y;
+			Z[Entry] = FingerValue.Value.Z;
+
+			// Fingers with no threshold don't count towards the gesture
+			Threshold[Entry] = FingerValue.Threshold <= 0.0f ? MAX_flt : FingerValue.Threshold;
 		}
 	}
+}
+
+int32 FOpenXRCompiledGestureTable::FindFirstMatch(const FVector* Tips) const
+{
+	VectorRegister TipX[5];
+	VectorRegister TipY[5];
+	VectorRegister TipZ[5];
 
-	for (const FOpenXRGesture& Gesture : GesturesDB->Gestures)
+	for (int32 Finger = 0; Finger < 5; ++Finger)
 	{
-		// If not enough indexs to match curl values, or if this gesture requires finger splay and the controller can't do it
-		if (Gesture.FingerValues.Num() < 5 || SkeletalAction.SkeletalTransforms.Num() < EHandKeypointCount)
-			continue;
+		TipX[Finger] = VectorSetFloat1(Tips[Finger].X);
+		TipY[Finger] = VectorSetFloat1(Tips[Finger].Y);
+		TipZ[Finger] = VectorSetFloat1(Tips[Finger].Z);
+	}
 
-		bool bDetectedPose = true;
-		for (int i = 0; i < 5; ++i)
+	// Same per axis test as FVector::Equals, four gestures per pass
+	for (int32 Base = 0; Base < PaddedCount; Base += 4)
+	{
+		int32 MatchBits = 0xF;
+
+		for (int32 Finger = 0; Finger < 5 && MatchBits; ++Finger)
 		{
-			FVector GestureV = Gesture.FingerValues[i].Value;
-			FVector CurrentV = CurrentTips[i];
-			FVector Difference = GestureV - CurrentV;
+			const VectorRegister Threshold = VectorLoadAligned(GetRow(Finger, 3) + Base);
+			const VectorRegister DiffX = VectorAbs(VectorSubtract(VectorLoadAligned(GetRow(Finger, 0) + Base), TipX[Finger]));
+			const VectorRegister DiffY = VectorAbs(VectorSubtract(VectorLoadAligned(GetRow(Finger, 1) + Base), TipY[Finger]));
+			const VectorRegister DiffZ = VectorAbs(VectorSubtract(VectorLoadAligned(GetRow(Finger, 2) + Base), TipZ[Finger]));
 
-			if (!Gesture.FingerValues[i].Value.Equals(CurrentTips[i], Gesture.FingerValues[i].Threshold))
-			{
-				bDetectedPose = false;
-				break;
-			}
+			const VectorRegister InRange = VectorBitwiseAnd(VectorBitwiseAnd(VectorCompareGE(Threshold, DiffX), VectorCompareGE(Threshold, DiffY)), VectorCompareGE(Threshold, DiffZ));
+			MatchBits &= VectorMaskBits(InRange);
 		}
 
-		if (bDetectedPose)
+		if (MatchBits)
 		{
-			GestureOut = Gesture;
-			return true;
+			// Lowest lane keeps the database order priority
+			return GestureIndices[Base + FMath::CountTrailingZeros((uint32)MatchBits)];
 		}
 	}
 
-	return false;
+	return INDEX_NONE;
 }
 
-bool UOpenXRHandPoseComponent::DetectCurrentPose(FBPOpenXRActionSkeletalData &SkeletalAction)
+void UOpenXRHandPoseComponent::GetGestureFingerTips(const FBPOpenXRActionSkeletalData& SkeletalAction, FVector* OutTips)
 {
-	if (!GesturesDB || GesturesDB->Gestures.Num() < 1 || SkeletalAction.SkeletalTransforms.Num() < EHandKeypointCount)
-		return false;
-
-	FTransform BoneTransform = FTransform::Identity;
-
-	int32 FingerMap[5] =
+	static const int32 FingerMap[5] =
 	{
 		(int32)EXRHandJointType::OXR_HAND_JOINT_THUMB_TIP_EXT,
 		(int32)EXRHandJointType::OXR_HAND_JOINT_INDEX_TIP_EXT,
@@ -350,69 +589,109 @@ bool UOpenXRHandPoseComponent::DetectCurrentPose(FBPOpenXRActionSkeletalData &Sk
 		(int32)EXRHandJointType::OXR_HAND_JOINT_LITTLE_TIP_EXT
 	};
 
-	FVector WristLoc = FVector::ZeroVector;
+	const bool bMirror = SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left;
 
-	if (SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
+	FVector WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation();
+	if (bMirror)
 	{
-		WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation().MirrorByVector(FVector::RightVector);
+		WristLoc = WristLoc.MirrorByVector(FVector::RightVector);
 	}
-	else
+
+	for (int i = 0; i < 5; ++i)
 	{
-		WristLoc = SkeletalAction.SkeletalTransforms[(int32)EXRHandJointType::OXR_HAND_JOINT_WRIST_EXT].GetLocation();
+		const FVector TipLoc = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation();
+		OutTips[i] = (bMirror ? TipLoc.MirrorByVector(FVector::RightVector) : TipLoc) - WristLoc;
 	}
+}
+
+bool UOpenXRHandPoseComponent::K2_DetectCurrentPose(UPARAM(ref) FBPOpenXRActionSkeletalData& SkeletalAction, FOpenXRGesture & GestureOut)
+{
+	if (!GesturesDB || GesturesDB->Gestures.Num() < 1 || SkeletalAction.SkeletalTransforms.Num() < EHandKeypointCount)
+		return false;
 
 	// Early fill in an array to keep from performing math for each gesture
-	TArray<FVector> CurrentTips;
-	CurrentTips.AddUninitialized(5);
-	for (int i = 0; i < 5; ++i)
+	FVector CurrentTips[5];
+	GetGestureFingerTips(SkeletalAction, CurrentTips);
+
+	const int32 MatchIndex = GesturesDB->GetCompiledGestures().FindFirstMatch(CurrentTips);
+	if (MatchIndex != INDEX_NONE)
 	{
-		if (SkeletalAction.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
-		{
-			CurrentTips[i] = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation().MirrorByVector(FVector::RightVector) - WristLoc;
-		}
-		else
-		{
-			CurrentTips[i] = SkeletalAction.SkeletalTransforms[FingerMap[i]].GetLocation() - WristLoc;
-		}
+		GestureOut = GesturesDB->Gestures[MatchIndex];
+		return true;
 	}
 
-	for (auto GestureIterator = GesturesDB->Gestures.CreateConstIterator(); GestureIterator; ++GestureIterator)
-	{
-		const FOpenXRGesture &Gesture = *GestureIterator;
+	return false;
+}
 
-		// If not enough indexs to match curl values, or if this gesture requires finger splay and the controller can't do it
-		if (Gesture.FingerValues.Num() < 5 || SkeletalAction.SkeletalTransforms.Num() < EHandKeypointCount)
-			continue;
+bool UOpenXRHandPoseComponent::DetectCurrentPose(FBPOpenXRActionSkeletalData &SkeletalAction)
+{
+	SCOPE_CYCLE_COUNTER(STAT_OpenXRDetectGesture);
+
+	if (!GesturesDB || GesturesDB->Gestures.Num() < 1 || SkeletalAction.SkeletalTransforms.Num() < EHandKeypointCount)
+		return false;
+
+	FVector CurrentTips[5];
+	GetGestureFingerTips(SkeletalAction, CurrentTips);
+
+	const FOpenXRCompiledGestureTable& CompiledGestures = GesturesDB->GetCompiledGestures();
+
+	// Nothing can have changed if the hand is holding still against the same gesture set
+	if (GestureMovementTolerance > 0.0f && SkeletalAction.LastGestureTableVersion == CompiledGestures.Version)
+	{
+		const float ToleranceSq = FMath::Square(GestureMovementTolerance);
+		bool bMoved = false;
 
-		bool bDetectedPose = true;
 		for (int i = 0; i < 5; ++i)
 		{
-			if (Gesture.FingerValues[i].Threshold <= 0.0f)
-				continue;
-
-			if (!Gesture.FingerValues[i].Value.Equals(CurrentTips[i], Gesture.FingerValues[i].Threshold))
+			if (FVector::DistSquared(CurrentTips[i], SkeletalAction.LastGestureTips[i]) > ToleranceSq)
 			{
-				bDetectedPose = false;
+				bMoved = true;
 				break;
 			}
 		}
 
-		if (bDetectedPose)
+		if (!bMoved)
 		{
-			if (SkeletalAction.LastHandGesture != Gesture.Name)
-			{
-				if (SkeletalAction.LastHandGesture != NAME_None)
-					OnGestureEnded.Broadcast(SkeletalAction.LastHandGesture, SkeletalAction.LastHandGestureIndex, SkeletalAction.TargetHand);
+			INC_DWORD_STAT(STAT_OpenXRGestureDetectionsSkipped);
+			return false;
+		}
+	}
 
-				SkeletalAction.LastHandGesture = Gesture.Name;
-				SkeletalAction.LastHandGestureIndex = GestureIterator.GetIndex();
-				OnNewGestureDetected.Broadcast(SkeletalAction.LastHandGesture, SkeletalAction.LastHandGestureIndex, SkeletalAction.TargetHand);
+	for (int i = 0; i < 5; ++i)
+	{
+		SkeletalAction.LastGestureTips[i] = CurrentTips[i];
+	}
+	SkeletalAction.LastGestureTableVersion = CompiledGestures.Version;
 
-				return true;
-			}
-			else
-				return false; // Same gesture
+	// Hold the active gesture while it is inside its widened thresholds
+	if (SkeletalAction.LastHandGesture != NAME_None && GesturesDB->Gestures.IsValidIndex(SkeletalAction.LastHandGestureIndex))
+	{
+		const FOpenXRGesture& ActiveGesture = GesturesDB->Gestures[SkeletalAction.LastHandGestureIndex];
+		if (ActiveGesture.Name == SkeletalAction.LastHandGesture && UOpenXRGestureDatabase::MatchesGesture(ActiveGesture, CurrentTips, 1.0f + GestureReleaseHysteresis))
+		{
+			return false; // Same gesture
+		}
+	}
+
+	const int32 MatchIndex = CompiledGestures.FindFirstMatch(CurrentTips);
+
+	if (MatchIndex != INDEX_NONE)
+	{
+		const FOpenXRGesture& Gesture = GesturesDB->Gestures[MatchIndex];
+
+		if (SkeletalAction.LastHandGesture != Gesture.Name)
+		{
+			if (SkeletalAction.LastHandGesture != NAME_None)
+				OnGestureEnded.Broadcast(SkeletalAction.LastHandGesture, SkeletalAction.LastHandGestureIndex, SkeletalAction.TargetHand);
+
+			SkeletalAction.LastHandGesture = Gesture.Name;
+			SkeletalAction.LastHandGestureIndex = MatchIndex;
+			OnNewGestureDetected.Broadcast(SkeletalAction.LastHandGesture, SkeletalAction.LastHandGestureIndex, SkeletalAction.TargetHand);
+
+			return true;
 		}
+		else
+			return false; // Same gesture
 	}
 
 	if (SkeletalAction.LastHandGesture != NAME_None)
@@ -527,6 +806,130 @@ void UOpenXRHandPoseComponent::FTransformLerpManager::UpdateManager(float DeltaT
 	}
 }
 
+UOpenXRHandPoseComponent::FSkeletalDeltaManager::FSkeletalDeltaManager()
+{
+	AckedKeyframeId = 0;
+	PendingKeyframeId = 0;
+	NextKeyframeId = 0;
+	bHasAckedKeyframe = false;
+	bHasPendingKeyframe = false;
+	SendsSinceKeyframe = 0;
+
+	for (int i = 0; i < NumReceivedKeyframes; ++i)
+	{
+		ReceivedKeyframeIds[i] = 0;
+		bHasReceivedKeyframe[i] = false;
+	}
+}
+
+void UOpenXRHandPoseComponent::FSkeletalDeltaManager::EncodeStandaloneKeyframe(FBPSkeletalRepContainer& Container)
+{
+	Container.bUseDeltaCompression = true;
+	Container.bIsKeyframe = true;
+	Container.KeyframeId = 0;
+	Container.ChangedBoneMask = Container.GetFullBoneMask();
+}
+
+void UOpenXRHandPoseComponent::FSkeletalDeltaManager::EncodeDelta(FBPSkeletalRepContainer& Container, int32 KeyframeInterval, float RotationTolerance)
+{
+	Container.bUseDeltaCompression = true;
+	Container.bIsKeyframe = false;
+
+	const int32 NumBones = Container.SkeletalTransforms.Num();
+	const uint32 FullMask = Container.GetFullBoneMask();
+
+	// Bone layout changed, previous keyframes are useless
+	if ((bHasAckedKeyframe && AckedKeyframe.Num() != NumBones) || (bHasPendingKeyframe && PendingKeyframe.Num() != NumBones))
+	{
+		bHasAckedKeyframe = false;
+		bHasPendingKeyframe = false;
+	}
+
+	if ((!bHasAckedKeyframe && !bHasPendingKeyframe) || ++SendsSinceKeyframe >= KeyframeInterval)
+	{
+		Container.bIsKeyframe = true;
+		Container.KeyframeId = NextKeyframeId++;
+		Container.ChangedBoneMask = FullMask;
+		SendsSinceKeyframe = 0;
+
+		PendingKeyframe = Container.SkeletalTransforms;
+		PendingKeyframeId = Container.KeyframeId;
+		bHasPendingKeyframe = true;
+		return;
+	}
+
+	// Nothing acked yet, send everything but don't make the receiver store it
+	if (!bHasAckedKeyframe)
+	{
+		Container.KeyframeId = PendingKeyframeId;
+		Container.ChangedBoneMask = FullMask;
+		return;
+	}
+
+	Container.KeyframeId = AckedKeyframeId;
+	Container.ChangedBoneMask = 0;
+
+	const float RotationToleranceRad = FMath::DegreesToRadians(RotationTolerance);
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		const FTransform& Current = Container.SkeletalTransforms[i];
+		const FTransform& Keyed = AckedKeyframe[i];
+
+		// Position tolerance matches the 0.1 precision of the packed vector
+		if (Current.GetRotation().AngularDistance(Keyed.GetRotation()) > RotationToleranceRad ||
+			(Container.bAllowDeformingMesh && !Current.GetLocation().Equals(Keyed.GetLocation(), 0.1f)))
+		{
+			Container.ChangedBoneMask |= (1u << i);
+		}
+	}
+}
+
+void UOpenXRHandPoseComponent::FSkeletalDeltaManager::NotifyKeyframeAcked(uint8 KeyframeId)
+{
+	if (bHasPendingKeyframe && PendingKeyframeId == KeyframeId)
+	{
+		AckedKeyframe = MoveTemp(PendingKeyframe);
+		AckedKeyframeId = PendingKeyframeId;
+		bHasAckedKeyframe = true;
+		bHasPendingKeyframe = false;
+	}
+}
+
+bool UOpenXRHandPoseComponent::FSkeletalDeltaManager::ResolveDelta(FBPSkeletalRepContainer& Container)
+{
+	if (!Container.bUseDeltaCompression)
+		return true;
+
+	const int32 Slot = Container.KeyframeId % NumReceivedKeyframes;
+
+	if (Container.bIsKeyframe)
+	{
+		ReceivedKeyframes[Slot] = Container.SkeletalTransforms;
+		ReceivedKeyframeIds[Slot] = Container.KeyframeId;
+		bHasReceivedKeyframe[Slot] = true;
+		return true;
+	}
+
+	if (Container.ChangedBoneMask == Container.GetFullBoneMask())
+		return true;
+
+	if (!bHasReceivedKeyframe[Slot] || ReceivedKeyframeIds[Slot] != Container.KeyframeId || ReceivedKeyframes[Slot].Num() != Container.SkeletalTransforms.Num())
+		return false;
+
+	const TArray<FTransform>& Keyframe = ReceivedKeyframes[Slot];
+	for (int32 i = 0; i < Container.SkeletalTransforms.Num(); ++i)
+	{
+		if (!(Container.ChangedBoneMask & (1u << i)))
+		{
+			Container.SkeletalTransforms[i] = Keyframe[i];
+		}
+	}
+
+	// Fully resolved now
+	Container.ChangedBoneMask = Container.GetFullBoneMask();
+	return true;
+}
+
 void FBPSkeletalRepContainer::CopyForReplication(FBPOpenXRActionSkeletalData& Other)
 {
 	TargetHand = Other.TargetHand;
@@ -685,10 +1088,29 @@ bool FBPSkeletalRepContainer::NetSerialize(FArchive& Ar, class UPackageMap* Map,
 	Ar.SerializeBits(&TargetHand, 1);
 	Ar.SerializeBits(&bAllowDeformingMesh, 1);
 	Ar.SerializeBits(&bEnableUE4HandRepSavings, 1);
+	Ar.SerializeBits(&bUseDeltaCompression, 1);
 
 	int32 BoneCountAdjustment = 5 + (bEnableUE4HandRepSavings ? 4 : 0);
 	uint8 TransformCount = EHandKeypointCount - BoneCountAdjustment;
 
+	if (bUseDeltaCompression)
+	{
+		Ar.SerializeBits(&bIsKeyframe, 1);
+		Ar << KeyframeId;
+
+		if (bIsKeyframe)
+		{
+			ChangedBoneMask = GetFullBoneMask();
+		}
+		else
+		{
+			if (Ar.IsLoading())
+				ChangedBoneMask = 0;
+
+			Ar.SerializeBits(&ChangedBoneMask, TransformCount);
+		}
+	}
+
 	//Ar << TransformCount;
 
 	if (Ar.IsLoading())
@@ -698,28 +1120,50 @@ bool FBPSkeletalRepContainer::NetSerialize(FArchive& Ar, class UPackageMap* Map,
 
 	FVector Position = FVector::ZeroVector;
 	FRotator Rot = FRotator::ZeroRotator;
+	FQuat Quat = FQuat::Identity;
 
 	for (int i = 0; i < TransformCount; i++)
 	{
+		// Unchanged bones are filled in from the keyframe by the receiver
+		if (bUseDeltaCompression && !(ChangedBoneMask & (1u << i)))
+		{
+			if (Ar.IsLoading())
+			{
+				SkeletalTransforms.Add(FTransform::Identity);
+			}
+			continue;
+		}
+
 		if (Ar.IsSaving())
 		{
 			if (bAllowDeformingMesh)
 				Position = SkeletalTransforms[i].GetLocation();
 
-			Rot = SkeletalTransforms[i].Rotator();
+			if (bUseDeltaCompression)
+				Quat = SkeletalTransforms[i].GetRotation();
+			else
+				Rot = SkeletalTransforms[i].Rotator();
 		}
 
 		if (bAllowDeformingMesh)
 			bOutSuccess &= SerializePackedVector<10, 11>(Position, Ar);
 
-		Rot.SerializeCompressed(Ar); // Short? 10 bit?
+		if (bUseDeltaCompression)
+		{
+			OpenXRSkeletalQuant::SerializeQuat_SmallestThree(Ar, Quat);
+		}
+		else
+		{
+			Rot.SerializeCompressed(Ar); // Short? 10 bit?
+			Quat = Rot.Quaternion();
+		}
 
 		if (Ar.IsLoading())
 		{
 			if (bAllowDeformingMesh)
-				SkeletalTransforms.Add(FTransform(Rot, Position));
+				SkeletalTransforms.Add(FTransform(Quat, Position));
 			else
-				SkeletalTransforms.Add(FTransform(Rot));
+				SkeletalTransforms.Add(FTransform(Quat));
 		}
 	}
 
@@ -0,0 +1,414 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
+#include "Engine/World.h"
+#include "UObject/UObjectIterator.h"
+#include "OpenXRHandPoseComponent.h"
+#include "OpenXRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Bandwidth and round trip report for the skeletal hand replication
+// Replays recorded hand data through every path the component can send it on, serializes each container with its
+// NetSerialize, reads it back into a fresh container and resolves it the way the receiver would. The resolved bones are
+// compared against what was sent, so a delta that resolves against the wrong keyframe shows up as error, not just size.
+//
+// Legacy:		no delta compression, compressed rotators every send
+// Keyframes:	standalone smallest three keyframes, what the server sends the simulated proxies
+// Delta:		owning client -> server deltas against acked keyframes, AckDelay / Loss are applied to the sends and acks
+//
+// Record:	vr.OpenXRSkeletalRecord [Seconds=10] [Rate=10] [Out=Path.csv]
+//			Samples the skeletal actions of every locally controlled OpenXRHandPoseComponent
+// Report:	vr.OpenXRSkeletalDeltaReport File=Path.csv [KeyframeInterval=10] [Tolerance=0.25] [AckDelay=3] [Loss=0.0] [Seed=0] [Out=Path.csv] [Quit]
+//			AckDelay is the number of sends before an ack reaches the sender, Loss is the fraction of sends and acks dropped
+namespace OpenXRSkeletalDeltaReport
+{
+	static const int32 NumHeaderColumns = 5;
+	static const int32 NumBoneColumns = 7;
+
+	struct FRecordedPose
+	{
+		double Time = 0.0;
+		FBPOpenXRActionSkeletalData Action;
+	};
+
+	// Recorded rows are Time,Source,Hand,AllowDeforming,RepSavings then X,Y,Z,QX,QY,QZ,QW per keypoint
+	typedef TMap<FString, TArray<FRecordedPose>> FRecording;
+
+	enum class EMode : uint8
+	{
+		Legacy,
+		Keyframes,
+		Delta,
+		Count
+	};
+
+	static const TCHAR* GetModeName(EMode Mode)
+	{
+		switch (Mode)
+		{
+		case EMode::Legacy: return TEXT("Legacy");
+		case EMode::Keyframes: return TEXT("Keyframes");
+		case EMode::Delta: return TEXT("Delta");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	struct FSettings
+	{
+		int32 KeyframeInterval = 10;
+		float RotationTolerance = 0.25f;
+		int32 AckDelay = 3;
+		float Loss = 0.f;
+		int32 Seed = 0;
+	};
+
+	struct FResult
+	{
+		int64 TotalBits = 0;
+		int32 NumSends = 0;
+		int32 NumKeyframes = 0;
+		int32 NumDeltas = 0;
+		int32 NumLost = 0;
+		int32 NumDropped = 0;
+		double BytesPerSec = 0.0;
+		float MaxRotErrorDeg = 0.f;
+		float MaxPosError = 0.f;
+
+		double AvgBits() const { return NumSends > 0 ? (double)TotalBits / NumSends : 0.0; }
+	};
+
+	static bool LoadRecording(const FString& Path, FRecording& OutRecording)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+			return false;
+
+		for (const FString& Line : Lines)
+		{
+			TArray<FString> Columns;
+			Line.ParseIntoArray(Columns, TEXT(","));
+
+			// Skips the header and anything malformed
+			if (Columns.Num() != NumHeaderColumns + EHandKeypointCount * NumBoneColumns || !Columns[0].IsNumeric())
+				continue;
+
+			FRecordedPose& Pose = OutRecording.FindOrAdd(Columns[1]).AddDefaulted_GetRef();
+			Pose.Time = FCString::Atod(*Columns[0]);
+			Pose.Action.TargetHand = FCString::Atoi(*Columns[2]) == 0 ? EVRSkeletalHandIndex::EActionHandIndex_Left : EVRSkeletalHandIndex::EActionHandIndex_Right;
+			Pose.Action.bAllowDeformingMesh = FCString::Atoi(*Columns[3]) != 0;
+			Pose.Action.bEnableUE4HandRepSavings = FCString::Atoi(*Columns[4]) != 0;
+			Pose.Action.bHasValidData = true;
+			Pose.Action.SkeletalTransforms.SetNum(EHandKeypointCount);
+
+			for (int32 Bone = 0; Bone < EHandKeypointCount; ++Bone)
+			{
+				const int32 Start = NumHeaderColumns + Bone * NumBoneColumns;
+				const FVector Location(FCString::Atof(*Columns[Start]), FCString::Atof(*Columns[Start + 1]), FCString::Atof(*Columns[Start + 2]));
+				FQuat Rotation(FCString::Atof(*Columns[Start + 3]), FCString::Atof(*Columns[Start + 4]), FCString::Atof(*Columns[Start + 5]), FCString::Atof(*Columns[Start + 6]));
+				Rotation.Normalize();
+				Pose.Action.SkeletalTransforms[Bone] = FTransform(Rotation, Location);
+			}
+		}
+
+		return OutRecording.Num() > 0;
+	}
+
+	// Serializes the container, reads it back on the "receiver" and returns the number of bits it took
+	static int64 RoundTrip(FBPSkeletalRepContainer& Sent, FBPSkeletalRepContainer& OutReceived)
+	{
+		FBitWriter Writer(0, true);
+		bool bSuccess = true;
+		Sent.NetSerialize(Writer, nullptr, bSuccess);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		OutReceived = FBPSkeletalRepContainer();
+		OutReceived.NetSerialize(Reader, nullptr, bSuccess);
+
+		return Writer.GetNumBits();
+	}
+
+	static void CompareResolved(const FBPSkeletalRepContainer& Sent, const FBPSkeletalRepContainer& Received, FResult& Result)
+	{
+		if (Sent.SkeletalTransforms.Num() != Received.SkeletalTransforms.Num())
+		{
+			++Result.NumDropped;
+			return;
+		}
+
+		for (int32 i = 0; i < Sent.SkeletalTransforms.Num(); ++i)
+		{
+			const FTransform& A = Sent.SkeletalTransforms[i];
+			const FTransform& B = Received.SkeletalTransforms[i];
+
+			// Legacy rotators lose the quaternion sign, the angular distance doesn't care
+			Result.MaxRotErrorDeg = FMath::Max(Result.MaxRotErrorDeg, FMath::RadiansToDegrees(A.GetRotation().AngularDistance(B.GetRotation())));
+
+			if (Sent.bAllowDeformingMesh)
+			{
+				Result.MaxPosError = FMath::Max(Result.MaxPosError, (A.GetLocation() - B.GetLocation()).GetAbsMax());
+			}
+		}
+	}
+
+	static void ReplaySource(const TArray<FRecordedPose>& Poses, EMode Mode, const FSettings& Settings, FRandomStream& Stream, FResult& Result)
+	{
+		UOpenXRHandPoseComponent::FSkeletalDeltaManager Sender;
+		UOpenXRHandPoseComponent::FSkeletalDeltaManager Receiver;
+
+		// Send index the ack arrives at -> keyframe id
+		TArray<TPair<int32, uint8>> PendingAcks;
+
+		int64 SourceBits = 0;
+
+		for (int32 SendIndex = 0; SendIndex < Poses.Num(); ++SendIndex)
+		{
+			for (int32 i = PendingAcks.Num() - 1; i >= 0; --i)
+			{
+				if (PendingAcks[i].Key <= SendIndex)
+				{
+					Sender.NotifyKeyframeAcked(PendingAcks[i].Value);
+					PendingAcks.RemoveAt(i, 1, false);
+				}
+			}
+
+			FBPOpenXRActionSkeletalData Action = Poses[SendIndex].Action;
+			FBPSkeletalRepContainer Sent;
+			Sent.CopyForReplication(Action);
+
+			if (!Sent.bHasValidData())
+				continue;
+
+			switch (Mode)
+			{
+			case EMode::Keyframes: UOpenXRHandPoseComponent::FSkeletalDeltaManager::EncodeStandaloneKeyframe(Sent); break;
+			case EMode::Delta: Sender.EncodeDelta(Sent, Settings.KeyframeInterval, Settings.RotationTolerance); break;
+			default: Sent.bUseDeltaCompression = false; break;
+			}
+
+			FBPSkeletalRepContainer Received;
+			const int64 Bits = RoundTrip(Sent, Received);
+			SourceBits += Bits;
+			Result.TotalBits += Bits;
+			++Result.NumSends;
+
+			if (Sent.bUseDeltaCompression)
+			{
+				if (Sent.bIsKeyframe)
+					++Result.NumKeyframes;
+				else
+					++Result.NumDeltas;
+			}
+
+			if (Settings.Loss > 0.f && Stream.FRand() < Settings.Loss)
+			{
+				++Result.NumLost;
+				continue;
+			}
+
+			if (Received.bUseDeltaCompression)
+			{
+				// The server acks the keyframes it receives on the owner RPC path, the proxies never do
+				if (Mode == EMode::Delta && Received.bIsKeyframe && !(Settings.Loss > 0.f && Stream.FRand() < Settings.Loss))
+				{
+					PendingAcks.Emplace(SendIndex + Settings.AckDelay, Received.KeyframeId);
+				}
+
+				if (!Receiver.ResolveDelta(Received))
+				{
+					++Result.NumDropped;
+					continue;
+				}
+			}
+
+			// Deltas are expected to be off by up to the rotation tolerance plus quantization, anything past that is a bad resolve
+			CompareResolved(Sent, Received, Result);
+		}
+
+		const double Duration = Poses.Num() > 1 ? Poses.Last().Time - Poses[0].Time : 0.0;
+		if (Duration > 0.0)
+		{
+			Result.BytesPerSec += (SourceBits / 8.0) / Duration;
+		}
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		FString InputPath;
+		FSettings Settings;
+		OpenXRBenchmarkUtils::FCommonArgs Common;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("File="), InputPath);
+			FParse::Value(*Arg, TEXT("KeyframeInterval="), Settings.KeyframeInterval);
+			FParse::Value(*Arg, TEXT("Tolerance="), Settings.RotationTolerance);
+			FParse::Value(*Arg, TEXT("AckDelay="), Settings.AckDelay);
+			FParse::Value(*Arg, TEXT("Loss="), Settings.Loss);
+			FParse::Value(*Arg, TEXT("Seed="), Settings.Seed);
+			OpenXRBenchmarkUtils::ParseCommonArg(Arg, Common);
+		}
+
+		Settings.KeyframeInterval = FMath::Max(Settings.KeyframeInterval, 1);
+		Settings.AckDelay = FMath::Max(Settings.AckDelay, 0);
+		Settings.Loss = FMath::Clamp(Settings.Loss, 0.f, 1.f);
+
+		FRecording Recording;
+		if (!LoadRecording(InputPath, Recording))
+		{
+			UE_LOG(LogOpenXRBenchmark, Warning, TEXT("vr.OpenXRSkeletalDeltaReport: Couldn't load a recording from \"%s\", make one with vr.OpenXRSkeletalRecord"), *InputPath);
+			return;
+		}
+
+		OpenXRBenchmarkUtils::SetDefaultOutputPath(Common.OutputPath, TEXT("OpenXRSkeletalDelta"), TEXT("OpenXRSkeletalDeltaReport"));
+
+		FString Csv = TEXT("Mode,Sources,Sends,Keyframes,Deltas,Lost,Dropped,AvgBitsPerSend,BytesPerSec,MaxRotErrorDeg,MaxPosError\n");
+
+		for (uint8 ModeIndex = 0; ModeIndex < (uint8)EMode::Count; ++ModeIndex)
+		{
+			const EMode Mode = (EMode)ModeIndex;
+
+			// Same loss pattern for every mode
+			FRandomStream Stream(Settings.Seed);
+			FResult Result;
+
+			for (const TPair<FString, TArray<FRecordedPose>>& Source : Recording)
+			{
+				ReplaySource(Source.Value, Mode, Settings, Stream, Result);
+			}
+
+			Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%d,%d,%.1f,%.1f,%.3f,%.3f\n"),
+				GetModeName(Mode),
+				Recording.Num(),
+				Result.NumSends,
+				Result.NumKeyframes,
+				Result.NumDeltas,
+				Result.NumLost,
+				Result.NumDropped,
+				Result.AvgBits(),
+				Result.BytesPerSec,
+				Result.MaxRotErrorDeg,
+				Result.MaxPosError);
+		}
+
+		OpenXRBenchmarkUtils::SaveAndLogResults(TEXT("vr.OpenXRSkeletalDeltaReport"), Csv, Common.OutputPath);
+		OpenXRBenchmarkUtils::QuitIfRequested(Common);
+	}
+
+	static FAutoConsoleCommand OpenXRSkeletalDeltaReportCommand(
+		TEXT("vr.OpenXRSkeletalDeltaReport"),
+		TEXT("Replays a hand recording through the legacy, keyframe and delta skeletal replication paths, decodes and verifies every send and writes the bytes/sec and error to a CSV in the profiling directory.\n")
+		TEXT("Args: File=Path.csv KeyframeInterval=10 Tolerance=0.25 AckDelay=3 Loss=0.0 Seed=0 Out=Path.csv Quit"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+
+	// Recorder, samples on world post actor tick so the hand poses have been updated for the frame
+	struct FSkeletalRecorder
+	{
+		FDelegateHandle TickHandle;
+		FString OutputPath;
+		FString Csv;
+		double EndTime = 0.0;
+		double NextSampleTime = 0.0;
+		float SampleInterval = 0.1f;
+
+		void Sample(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+		{
+			if (!World || !World->IsGameWorld())
+				return;
+
+			const double Now = World->GetRealTimeSeconds();
+			if (Now < NextSampleTime)
+				return;
+
+			NextSampleTime = Now + SampleInterval;
+
+			for (TObjectIterator<UOpenXRHandPoseComponent> It; It; ++It)
+			{
+				if (It->GetWorld() != World || !It->IsLocallyControlled())
+					continue;
+
+				for (const FBPOpenXRActionSkeletalData& Action : It->HandSkeletalActions)
+				{
+					if (Action.bHasValidData && Action.SkeletalTransforms.Num() == EHandKeypointCount)
+					{
+						AddRow(Now, FString::Printf(TEXT("%s_%d"), *It->GetName(), (int32)Action.TargetHand), Action);
+					}
+				}
+			}
+
+			if (Now >= EndTime)
+			{
+				Finish();
+			}
+		}
+
+		void AddRow(double Time, const FString& Source, const FBPOpenXRActionSkeletalData& Action)
+		{
+			Csv += FString::Printf(TEXT("%f,%s,%d,%d,%d"), Time, *Source, (int32)Action.TargetHand, Action.bAllowDeformingMesh ? 1 : 0, Action.bEnableUE4HandRepSavings ? 1 : 0);
+
+			for (const FTransform& Bone : Action.SkeletalTransforms)
+			{
+				const FVector Location = Bone.GetLocation();
+				const FQuat Rotation = Bone.GetRotation();
+				Csv += FString::Printf(TEXT(",%f,%f,%f,%f,%f,%f,%f"), Location.X, Location.Y, Location.Z, Rotation.X, Rotation.Y, Rotation.Z, Rotation.W);
+			}
+
+			Csv += TEXT("\n");
+		}
+
+		void Finish()
+		{
+			FWorldDelegates::OnWorldPostActorTick.Remove(TickHandle);
+			TickHandle.Reset();
+
+			OpenXRBenchmarkUtils::SaveCsv(TEXT("vr.OpenXRSkeletalRecord"), Csv, OutputPath);
+		}
+	};
+
+	static FSkeletalRecorder Recorder;
+
+	static void Record(const TArray<FString>& Args, UWorld* World)
+	{
+		if (Recorder.TickHandle.IsValid())
+		{
+			UE_LOG(LogOpenXRBenchmark, Warning, TEXT("vr.OpenXRSkeletalRecord: Already recording"));
+			return;
+		}
+
+		if (!World)
+			return;
+
+		float Seconds = 10.f;
+		float Rate = 10.f;
+		FString OutputPath;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Seconds="), Seconds);
+			FParse::Value(*Arg, TEXT("Rate="), Rate);
+			FParse::Value(*Arg, TEXT("Out="), OutputPath);
+		}
+
+		OpenXRBenchmarkUtils::SetDefaultOutputPath(OutputPath, TEXT("OpenXRSkeletalDelta"), TEXT("SkeletalRecording"));
+
+		Recorder.OutputPath = OutputPath;
+		Recorder.Csv = TEXT("Time,Source,Hand,AllowDeforming,RepSavings,Keypoints(X;Y;Z;QX;QY;QZ;QW)...\n");
+		Recorder.SampleInterval = 1.f / FMath::Max(1.f, Rate);
+		Recorder.NextSampleTime = World->GetRealTimeSeconds();
+		Recorder.EndTime = Recorder.NextSampleTime + FMath::Max(0.1f, Seconds);
+		Recorder.TickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(&Recorder, &FSkeletalRecorder::Sample);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs OpenXRSkeletalRecordCommand(
+		TEXT("vr.OpenXRSkeletalRecord"),
+		TEXT("Records the skeletal actions of the locally controlled OpenXR hand pose components for use with vr.OpenXRSkeletalDeltaReport, Rate should match the replication rate.\n")
+		TEXT("Args: Seconds=10 Rate=10 Out=Path.csv"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Record));
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "Runtime/AnimGraphRuntime/Public/BoneControllers/AnimNode_SkeletalControlBase.h"
 #include "OpenXRExpansionTypes.h"
+#include "HeadMountedDisplayTypes.h"
 //#include "Skeleton/BodyStateSkeleton.h"
 //#include "BodyStateAnimInstance.h"
 
@@ -41,8 +42,18 @@ public:
 
 	bool bIsOpenInputAnimationInstance;
 
+	// WorldTransforms is no longer modified, kept non const for existing callers
 	void ConvertHandTransformsSpace(TArray<FTransform>& OutTransforms, TArray<FTransform>& WorldTransforms, FTransform AddTrans, bool bMirrorLeftRight, bool bMergeMissingUE4Bones);
 
+	// Fills OutParents with the parent keypoint of each keypoint (-1 for the wrist)
+	// With bMergeMissingUE4Bones the finger proximals skip their metacarpal and parent directly to the wrist
+	static void BuildKeypointParents(int8* OutParents, bool bMergeMissingUE4Bones);
+
+	// Converts EHandKeypointCount world space keypoints into parent space in a single batched pass over vector registers
+	// Normalizes, mirrors and applies AddRotation to every keypoint up front, then takes each relative to its parent
+	// Assumes non negative scales (tracked keypoints are unit scale), WorldTransforms is left untouched
+	static void ConvertHandKeypointsToParentSpace(const FTransform* WorldTransforms, FTransform* OutTransforms, const FQuat& AddRotation, bool bMirrorLeftRight, const int8* KeypointParents);
+
 	FTransform GetRefBoneInCS(TArray<FTransform>& RefBones, TArray<FMeshBoneInfo>& RefBonesInfo, int32 BoneIndex)
 	{
 		FTransform BoneTransform;
@@ -101,5 +112,13 @@ protected:
 	bool WorldIsGame;
 	AActor* OwningActor;
 
+	// Scratch buffers kept between evaluations so the node doesn't allocate on the anim worker threads
+	TArray<FTransform> HandTransformsScratch;
+	TArray<FBoneTransform> BoneTransformsScratch;
+
+	// Parent of each keypoint for the current merge setting, built with the bone references
+	int8 KeypointParents[EHandKeypointCount];
+	bool bKeypointParentsMerged;
+
 private:
 };
\ No newline at end of file
@@ -110,6 +110,10 @@ public:
 	FName LastHandGesture;
 	int32 LastHandGestureIndex;
 
+	// Wrist relative finger tips at the last gesture evaluation, detection is skipped until they move past the tolerance
+	FVector LastGestureTips[5];
+	uint32 LastGestureTableVersion;
+
 	FBPOpenXRActionSkeletalData()
 	{
 		//bGetTransformsInParentSpace = false;
@@ -122,6 +126,7 @@ public:
 		bHasValidData = false;
 		LastHandGestureIndex = INDEX_NONE;
 		LastHandGesture = NAME_None;
+		LastGestureTableVersion = 0;
 	}
 };
 
@@ -14,6 +14,8 @@
 
 #include "OpenXRHandPoseComponent.generated.h"
 
+DECLARE_STATS_GROUP(TEXT("OpenXRHandPose"), STATGROUP_OpenXRHandPose, STATCAT_Advanced);
+
 USTRUCT(BlueprintType, Category = "VRExpansionFunctions|OpenXR|HandSkeleton")
 struct OPENXREXPANSIONPLUGIN_API FBPSkeletalRepContainer
 {
@@ -36,6 +38,22 @@ public:
 	UPROPERTY(Transient, NotReplicated)
 		uint8 BoneCount;
 
+	// If true rotations are sent with smallest three encoding and only the bones flagged in ChangedBoneMask are serialized
+	UPROPERTY(Transient, NotReplicated)
+		bool bUseDeltaCompression;
+
+	// If true this is a full keyframe that the receiver stores as the base for following deltas
+	UPROPERTY(Transient, NotReplicated)
+		bool bIsKeyframe;
+
+	// The keyframe that this delta is relative to (or the id of this keyframe)
+	UPROPERTY(Transient, NotReplicated)
+		uint8 KeyframeId;
+
+	// Bit per replicated bone, bones not flagged are taken from the keyframe on the receiving end
+	UPROPERTY(Transient, NotReplicated)
+		uint32 ChangedBoneMask;
+
 
 	FBPSkeletalRepContainer()
 	{
@@ -43,6 +61,20 @@ public:
 		bAllowDeformingMesh = false;
 		bEnableUE4HandRepSavings = true;
 		BoneCount = 0;
+		bUseDeltaCompression = false;
+		bIsKeyframe = false;
+		KeyframeId = 0;
+		ChangedBoneMask = 0;
+	}
+
+	inline int32 GetReplicatedBoneCount() const
+	{
+		return EHandKeypointCount - (5 + (bEnableUE4HandRepSavings ? 4 : 0));
+	}
+
+	inline uint32 GetFullBoneMask() const
+	{
+		return (1u << GetReplicatedBoneCount()) - 1u;
 	}
 
 	bool bHasValidData()
@@ -127,6 +159,37 @@ public:
 	}
 };
 
+// The gestures of a database packed into a structure of arrays finger tip table so they can be matched four at a time
+// Each finger has an X, Y, Z and Threshold row, rows are padded to a multiple of four with entries that never match
+struct OPENXREXPANSIONPLUGIN_API FOpenXRCompiledGestureTable
+{
+	// Index into UOpenXRGestureDatabase::Gestures for each compiled entry, gestures without all five fingers are left out
+	TArray<int32> GestureIndices;
+
+	TArray<float, TAlignedHeapAllocator<16>> Rows;
+	int32 PaddedCount;
+
+	// Unique per compile across all tables, lets hands know their cached evaluation is stale
+	uint32 Version;
+	int32 SourceGestureCount;
+
+	FOpenXRCompiledGestureTable() :
+		PaddedCount(0),
+		Version(0),
+		SourceGestureCount(0)
+	{}
+
+	void Compile(const TArray<FOpenXRGesture>& Gestures);
+
+	// Returns the index into the source gestures of the first gesture that the tips match, or INDEX_NONE
+	int32 FindFirstMatch(const FVector* Tips) const;
+
+	FORCEINLINE const float* GetRow(int32 Finger, int32 Element) const
+	{
+		return Rows.GetData() + (Finger * 4 + Element) * PaddedCount;
+	}
+};
+
 /**
 * Items Database DataAsset, here we can save all of our game items
 */
@@ -136,13 +199,58 @@ class OPENXREXPANSIONPLUGIN_API UOpenXRGestureDatabase : public UDataAsset
 	GENERATED_BODY()
 public:
 
-	// Gestures in this database
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures")
+	// Gestures in this database, detection matches against a compiled copy so runtime edits go through the functions below
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "VRGestures")
 		TArray <FOpenXRGesture> Gestures;
 
 	UOpenXRGestureDatabase()
 	{
 	}
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// Adds a gesture and recompiles, returns its index
+	UFUNCTION(BlueprintCallable, Category = "VRGestures")
+		int32 AddGesture(const FOpenXRGesture& NewGesture);
+
+	// Replaces the gesture at the index and recompiles, returns false if the index is invalid
+	UFUNCTION(BlueprintCallable, Category = "VRGestures")
+		bool SetGesture(int32 GestureIndex, const FOpenXRGesture& NewGesture);
+
+	// Removes the gesture at the index and recompiles, returns false if the index is invalid
+	UFUNCTION(BlueprintCallable, Category = "VRGestures")
+		bool RemoveGesture(int32 GestureIndex);
+
+	// Removes all gestures
+	UFUNCTION(BlueprintCallable, Category = "VRGestures")
+		void ClearGestures();
+
+	// Rebuilds the packed table used for detection, the functions above, SaveCurrentPose and editor changes already call it.
+	// C++ code editing the Gestures array directly has to call it afterwards, detection keeps using the old table until then.
+	UFUNCTION(BlueprintCallable, Category = "VRGestures")
+		void RecompileGestures();
+
+	// Returns the packed table, it is only rebuilt here if it was never compiled or the gesture count no longer matches
+	// which guards the indices into Gestures against direct C++ edits, not a replacement for calling RecompileGestures.
+	const FOpenXRCompiledGestureTable& GetCompiledGestures()
+	{
+		if (CompiledGestures.Version == 0 || CompiledGestures.SourceGestureCount != Gestures.Num())
+		{
+			RecompileGestures();
+		}
+
+		return CompiledGestures;
+	}
+
+	// Returns true if the tips match the gesture, thresholds are scaled by ThresholdScale and fingers with a threshold <= 0 are ignored
+	static bool MatchesGesture(const FOpenXRGesture& Gesture, const FVector* Tips, float ThresholdScale = 1.0f);
+
+private:
+	FOpenXRCompiledGestureTable CompiledGestures;
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOpenXRGestureDetected, const FName &, GestureDetected, int32, GestureIndex, EVRSkeletalHandIndex, ActionHandType);
@@ -175,6 +283,19 @@ public:
 	// Known sequences
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures")
 		UOpenXRGestureDatabase *GesturesDB;
+
+	// Gesture detection is skipped while no finger tip has moved further than this (cm) since the last evaluation
+	// 0 evaluates every tick
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures", meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float GestureMovementTolerance;
+
+	// The active gesture is held until a finger leaves its threshold widened by this fraction
+	// Stops begin / end events from repeating when a finger sits right on the edge of a threshold
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "1.0"))
+		float GestureReleaseHysteresis;
+
+	// Fills OutTips with the five wrist relative finger tips, left hands are mirrored to match right hand gestures
+	static void GetGestureFingerTips(const FBPOpenXRActionSkeletalData& SkeletalAction, FVector* OutTips);
 	 
 	UFUNCTION(BlueprintCallable, Category = "VRGestures")
 		bool SaveCurrentPose(FName RecordingName, EVRSkeletalHandIndex HandToSave = EVRSkeletalHandIndex::EActionHandIndex_Right);
@@ -221,6 +342,10 @@ public:
 	UFUNCTION(Unreliable, Server, WithValidation)
 		void Server_SendSkeletalTransforms(const FBPSkeletalRepContainer& SkeletalInfo);
 
+	// Lets the owning client know that the server has a keyframe to delta against
+	UFUNCTION(Unreliable, Client)
+		void Client_AckSkeletalKeyframe(EVRSkeletalHandIndex TargetHand, uint8 KeyframeId);
+
 	bool bLerpingPositionLeft;
 	bool bReppedOnceLeft;
 
@@ -250,6 +375,53 @@ public:
 	FTransformLerpManager LeftHandRepManager;
 	FTransformLerpManager RightHandRepManager;
 
+	// Tracks the keyframes used for delta compression of the skeletal data
+	// Deltas are only sent on the owning client -> server RPC, against a keyframe the server has acked. The server has no
+	// per connection ack for property replication, so the simulated proxies are always sent standalone keyframes.
+	// The receiving side keeps the last few keyframes so deltas still in flight against an older one resolve while the
+	// ack for a newer keyframe is making its way back to the sender.
+	struct FSkeletalDeltaManager
+	{
+		static const int32 NumReceivedKeyframes = 4;
+
+		// Sending
+		TArray<FTransform> AckedKeyframe;
+		TArray<FTransform> PendingKeyframe;
+		uint8 AckedKeyframeId;
+		uint8 PendingKeyframeId;
+		uint8 NextKeyframeId;
+		bool bHasAckedKeyframe;
+		bool bHasPendingKeyframe;
+		int32 SendsSinceKeyframe;
+
+		// Receiving
+		TArray<FTransform> ReceivedKeyframes[NumReceivedKeyframes];
+		uint8 ReceivedKeyframeIds[NumReceivedKeyframes];
+		bool bHasReceivedKeyframe[NumReceivedKeyframes];
+
+		FSkeletalDeltaManager();
+
+		// Encodes against the last acked keyframe, keyframes are held as pending until NotifyKeyframeAcked
+		void EncodeDelta(FBPSkeletalRepContainer& Container, int32 KeyframeInterval, float RotationTolerance);
+
+		// Smallest three encoded keyframe that doesn't depend on anything the receiver has, for unacked paths
+		static void EncodeStandaloneKeyframe(FBPSkeletalRepContainer& Container);
+
+		void NotifyKeyframeAcked(uint8 KeyframeId);
+		bool ResolveDelta(FBPSkeletalRepContainer& Container);
+	};
+
+	FSkeletalDeltaManager LeftHandDeltaManager;
+	FSkeletalDeltaManager RightHandDeltaManager;
+
+	inline FSkeletalDeltaManager& GetDeltaManager(EVRSkeletalHandIndex TargetHand)
+	{
+		return TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left ? LeftHandDeltaManager : RightHandDeltaManager;
+	}
+
+	// Feeds the STATGROUP_OpenXRHandPose counters with the serialized size of an outgoing container
+	void RecordSkeletalSendStats(FBPSkeletalRepContainer& Container);
+
 	UFUNCTION()
 	virtual void OnRep_SkeletalTransformLeft()
 	{
@@ -257,6 +429,10 @@ public:
 		{
 			if (HandSkeletalActions[i].TargetHand == LeftHandRep.TargetHand)
 			{
+				// Drop deltas against a keyframe that we never received, the next keyframe will catch us back up
+				if (LeftHandRep.bUseDeltaCompression && !LeftHandDeltaManager.ResolveDelta(LeftHandRep))
+					break;
+
 				HandSkeletalActions[i].OldSkeletalTransforms = HandSkeletalActions[i].SkeletalTransforms;
 
 				FBPSkeletalRepContainer::CopyReplicatedTo(LeftHandRep, HandSkeletalActions[i]);
@@ -275,6 +451,10 @@ public:
 		{
 			if (HandSkeletalActions[i].TargetHand == RightHandRep.TargetHand)
 			{
+				// Drop deltas against a keyframe that we never received, the next keyframe will catch us back up
+				if (RightHandRep.bUseDeltaCompression && !RightHandDeltaManager.ResolveDelta(RightHandRep))
+					break;
+
 				HandSkeletalActions[i].OldSkeletalTransforms = HandSkeletalActions[i].SkeletalTransforms;
 
 				FBPSkeletalRepContainer::CopyReplicatedTo(RightHandRep, HandSkeletalActions[i]);
@@ -297,6 +477,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SkeletalData)
 		float ReplicationRateForSkeletalAnimations;
 
+	// If true we will send smallest three encoded rotations, and from the owning client only the bones that changed since the last acked keyframe
+	UPROPERTY(EditAnywhere, Category = SkeletalData)
+		bool bUseDeltaSkeletalCompression;
+
+	// Number of sends between full keyframes when using delta compression, also controls how fast we recover from a lost keyframe
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SkeletalData, meta = (EditCondition = "bUseDeltaSkeletalCompression", ClampMin = "1", UIMin = "1"))
+		int32 SkeletalKeyframeInterval;
+
+	// Rotation change in degrees from the keyframe before a bone is considered changed and re-sent
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SkeletalData, meta = (EditCondition = "bUseDeltaSkeletalCompression", ClampMin = "0.0", UIMin = "0.0"))
+		float SkeletalDeltaRotationTolerance;
+
 	// Used in Tick() to accumulate before sending updates, didn't want to use a timer in this case, also used for remotes to lerp position
 	float SkeletalNetUpdateCount;
 	// Used in Tick() to accumulate before sending updates, didn't want to use a timer in this case, also used for remotes to lerp position
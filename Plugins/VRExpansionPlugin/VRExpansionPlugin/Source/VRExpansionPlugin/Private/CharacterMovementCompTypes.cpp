@@ -12,6 +12,47 @@
 #include "VRBaseCharacter.h"
 #include "VRRootComponent.h"
 #include "VRPlayerController.h"
+
+// CVars
+namespace VRMoveDataCvars
+{
+	static int32 DeltaCompressMoves = 1;
+	FAutoConsoleVariableRef CVarDeltaCompressMoves(
+		TEXT("vr.DeltaCompressPendingMoves"),
+		DeltaCompressMoves,
+		TEXT("If 1 the VR values of the pending and old moves in a ServerMove are sent as deltas from the new move when that is smaller.\n")
+		TEXT("Only affects sending, servers read either encoding"),
+		ECVF_Default);
+}
+
+namespace VRMoveDataDelta
+{
+	// Bit width of a delta is sent in 4 bits
+	static const uint32 MaxDeltaWidth = 16;
+
+	// Keeps deltas well inside the range the packed vectors send without clamping and where the float conversion is exact
+	static const int32 MaxQuantizedValue = 1 << 24;
+
+	static bool IsInDeltaRange(const FIntVector& Quantized)
+	{
+		return FMath::Abs(Quantized.X) < MaxQuantizedValue && FMath::Abs(Quantized.Y) < MaxQuantizedValue && FMath::Abs(Quantized.Z) < MaxQuantizedValue;
+	}
+
+	// Bits needed to hold the value as two's complement
+	static uint32 GetSignedBitWidth(int32 Value)
+	{
+		const uint32 Magnitude = Value >= 0 ? (uint32)Value : (uint32)(-(Value + 1));
+		return FMath::CeilLogTwo(Magnitude + 1) + 1;
+	}
+
+	// Size of an absolute FVector_NetQuantize100
+	static uint32 GetPackedVectorBits(const FIntVector& Quantized)
+	{
+		const uint32 MaxValue = (uint32)FMath::Max3(FMath::Abs(Quantized.X), FMath::Abs(Quantized.Y), FMath::Abs(Quantized.Z));
+		const uint32 Bits = FMath::Clamp<uint32>(FMath::CeilLogTwo(1 + MaxValue), 1, 30) - 1;
+		return 5 + 3 * (Bits + 2);
+	}
+}
 	
 FSavedMove_VRBaseCharacter::FSavedMove_VRBaseCharacter() : FSavedMove_Character()
 {
@@ -289,6 +330,9 @@ FVRCharacterNetworkMoveData::FVRCharacterNetworkMoveData() : FCharacterNetworkMo
 	VRCapsuleLocation = FVector::ZeroVector;
 	LFDiff = FVector::ZeroVector;
 	VRCapsuleRotation = 0;
+	DeltaBaseline = nullptr;
+	QuantizedVRCapsuleLocation = FIntVector::ZeroValue;
+	QuantizedLFDiff = FIntVector::ZeroValue;
 }
 
 FVRCharacterNetworkMoveData::~FVRCharacterNetworkMoveData()
@@ -393,8 +437,20 @@ bool FVRCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& Charact
 
 	SerializeOptionalValue<uint8>(bIsSaving, Ar, CompressedMoveFlags, 0);
 	SerializeOptionalValue<uint8>(bIsSaving, Ar, MovementMode, MOVE_Walking);
-	VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
-	Ar << VRCapsuleRotation;
+
+	if (DeltaBaseline)
+	{
+		SerializeVectorDelta(Ar, PackageMap, VRCapsuleLocation, DeltaBaseline->QuantizedVRCapsuleLocation, bLocalSuccess);
+		SerializeYawDelta(Ar, VRCapsuleRotation, DeltaBaseline->VRCapsuleRotation);
+	}
+	else
+	{
+		VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		Ar << VRCapsuleRotation;
+
+		// The client goes through the decoded value as well so that both ends end up with the same baseline
+		QuantizedVRCapsuleLocation = QuantizeVector100(bIsSaving ? DequantizeVector100(QuantizeVector100(VRCapsuleLocation)) : VRCapsuleLocation);
+	}
 
 	if (MoveType == ENetworkMoveType::NewMove)
 	{
@@ -407,15 +463,166 @@ bool FVRCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& Charact
 	}
 
 	// Rep out our custom move settings
-	ConditionalMoveReps.NetSerialize(Ar, PackageMap, bLocalSuccess);
+	if (DeltaBaseline)
+	{
+		// Input and requested velocity tend to hold between moves
+		bool bSameConditionals = bIsSaving && VRMoveDataCvars::DeltaCompressMoves > 0 && ConditionalRepsMatch(ConditionalMoveReps, DeltaBaseline->ConditionalMoveReps);
+		Ar.SerializeBits(&bSameConditionals, 1);
+
+		if (!bSameConditionals)
+		{
+			ConditionalMoveReps.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		}
+		else if (!bIsSaving)
+		{
+			ConditionalMoveReps = DeltaBaseline->ConditionalMoveReps;
+		}
 
-	//VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
-	LFDiff.NetSerialize(Ar, PackageMap, bLocalSuccess);
-	//Ar << VRCapsuleRotation;
+		SerializeVectorDelta(Ar, PackageMap, LFDiff, DeltaBaseline->QuantizedLFDiff, bLocalSuccess);
+	}
+	else
+	{
+		ConditionalMoveReps.NetSerialize(Ar, PackageMap, bLocalSuccess);
+
+		//VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		LFDiff.NetSerialize(Ar, PackageMap, bLocalSuccess);
+		//Ar << VRCapsuleRotation;
+
+		QuantizedLFDiff = QuantizeVector100(bIsSaving ? DequantizeVector100(QuantizeVector100(LFDiff)) : LFDiff);
+	}
 
 	return !Ar.IsError();
 }
 
+FIntVector FVRCharacterNetworkMoveData::QuantizeVector100(const FVector& InVector)
+{
+	// Same scaling, NaN handling and clamping as WritePackedVector<100, 30>
+	FVector Scaled = InVector * 100;
+
+	if (Scaled.ContainsNaN())
+	{
+		Scaled = FVector::ZeroVector;
+	}
+
+	Scaled = ClampVector(Scaled, FVector(-1073741824.0f), FVector(1073741760.0f));
+	return FIntVector(FMath::RoundToInt(Scaled.X), FMath::RoundToInt(Scaled.Y), FMath::RoundToInt(Scaled.Z));
+}
+
+FVector FVRCharacterNetworkMoveData::DequantizeVector100(const FIntVector& InQuantized)
+{
+	// Same as ReadPackedVector<100, 30>
+	return FVector((float)InQuantized.X / 100, (float)InQuantized.Y / 100, (float)InQuantized.Z / 100);
+}
+
+void FVRCharacterNetworkMoveData::SerializeVectorDelta(FArchive& Ar, UPackageMap* PackageMap, FVector_NetQuantize100& Value, const FIntVector& BaselineQuantized, bool& bOutSuccess)
+{
+	bool bIsDelta = false;
+	FIntVector Delta = FIntVector::ZeroValue;
+	uint32 Width = 1;
+
+	if (Ar.IsSaving() && VRMoveDataCvars::DeltaCompressMoves > 0 && VRMoveDataDelta::IsInDeltaRange(BaselineQuantized))
+	{
+		const FIntVector Quantized = QuantizeVector100(Value);
+		if (VRMoveDataDelta::IsInDeltaRange(Quantized))
+		{
+			Delta = Quantized - BaselineQuantized;
+			Width = FMath::Max3(VRMoveDataDelta::GetSignedBitWidth(Delta.X), VRMoveDataDelta::GetSignedBitWidth(Delta.Y), VRMoveDataDelta::GetSignedBitWidth(Delta.Z));
+			bIsDelta = Width <= VRMoveDataDelta::MaxDeltaWidth && (4 + 3 * Width) < VRMoveDataDelta::GetPackedVectorBits(Quantized);
+		}
+	}
+
+	Ar.SerializeBits(&bIsDelta, 1);
+
+	if (!bIsDelta)
+	{
+		Value.NetSerialize(Ar, PackageMap, bOutSuccess);
+		return;
+	}
+
+	uint32 WidthMinusOne = Width - 1;
+	Ar.SerializeInt(WidthMinusOne, VRMoveDataDelta::MaxDeltaWidth);
+	Width = WidthMinusOne + 1;
+
+	const int32 Bias = 1 << (Width - 1);
+	for (int32 i = 0; i < 3; ++i)
+	{
+		uint32 Biased = (uint32)(Delta[i] + Bias);
+		Ar.SerializeInt(Biased, 1u << Width);
+		Delta[i] = (int32)Biased - Bias;
+	}
+
+	if (Ar.IsLoading())
+	{
+		// Decodes to exactly what the absolute value would have
+		Value = DequantizeVector100(BaselineQuantized + Delta);
+	}
+}
+
+void FVRCharacterNetworkMoveData::SerializeYawDelta(FArchive& Ar, uint16& Value, uint16 BaselineValue)
+{
+	bool bIsDelta = false;
+	int32 Delta = 0;
+	uint32 Width = 1;
+
+	if (Ar.IsSaving() && VRMoveDataCvars::DeltaCompressMoves > 0)
+	{
+		// Wraps, so turning across the seam is still a small delta
+		Delta = (int16)(uint16)(Value - BaselineValue);
+		Width = VRMoveDataDelta::GetSignedBitWidth(Delta);
+		bIsDelta = (4 + Width) < 16;
+	}
+
+	Ar.SerializeBits(&bIsDelta, 1);
+
+	if (!bIsDelta)
+	{
+		Ar << Value;
+		return;
+	}
+
+	uint32 WidthMinusOne = Width - 1;
+	Ar.SerializeInt(WidthMinusOne, VRMoveDataDelta::MaxDeltaWidth);
+	Width = WidthMinusOne + 1;
+
+	const int32 Bias = 1 << (Width - 1);
+	uint32 Biased = (uint32)(Delta + Bias);
+	Ar.SerializeInt(Biased, 1u << Width);
+
+	if (Ar.IsLoading())
+	{
+		Value = (uint16)(BaselineValue + ((int32)Biased - Bias));
+	}
+}
+
+bool FVRCharacterNetworkMoveData::ConditionalRepsMatch(const FVRConditionalMoveRep& A, const FVRConditionalMoveRep& B)
+{
+	if (A.MoveActionArray.MoveActions.Num() > 0 || B.MoveActionArray.MoveActions.Num() > 0)
+		return false;
+
+	// Both vectors are packed at the same scale, equal integers decode to equal values
+	return QuantizeVector100(A.CustomVRInputVector) == QuantizeVector100(B.CustomVRInputVector) &&
+		QuantizeVector100(A.RequestedVelocity) == QuantizeVector100(B.RequestedVelocity);
+}
+
+bool FVRCharacterNetworkMoveDataContainer::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap)
+{
+	// Our move data is always the VR type
+	FVRCharacterNetworkMoveData* NewMoveDataVR = (FVRCharacterNetworkMoveData*)NewMoveData;
+	FVRCharacterNetworkMoveData* PendingMoveDataVR = (FVRCharacterNetworkMoveData*)PendingMoveData;
+	FVRCharacterNetworkMoveData* OldMoveDataVR = (FVRCharacterNetworkMoveData*)OldMoveData;
+
+	NewMoveDataVR->DeltaBaseline = nullptr;
+	PendingMoveDataVR->DeltaBaseline = NewMoveDataVR;
+	OldMoveDataVR->DeltaBaseline = NewMoveDataVR;
+
+	const bool bSuccess = FCharacterNetworkMoveDataContainer::Serialize(CharacterMovement, Ar, PackageMap);
+
+	PendingMoveDataVR->DeltaBaseline = nullptr;
+	OldMoveDataVR->DeltaBaseline = nullptr;
+
+	return bSuccess;
+}
+
 
 void FVRCharacterMoveResponseDataContainer::ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement, const FClientAdjustment& PendingAdjustment)
 {
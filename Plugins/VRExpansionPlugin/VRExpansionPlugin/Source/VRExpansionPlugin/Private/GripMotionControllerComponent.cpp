@@ -14,6 +14,7 @@
 #include "MotionDelayBuffer.h"
 #include "UObject/VRObjectVersion.h"
 #include "UObject/UObjectGlobals.h" // for FindObject<>
+#include "UObject/UObjectIterator.h"
 #include "IXRTrackingSystem.h"
 #include "IXRSystemAssets.h"
 #include "DrawDebugHelpers.h"
@@ -46,6 +47,9 @@ DEFINE_LOG_CATEGORY(LogVRMotionController);
 //For UE4 Profiler ~ Stat
 DECLARE_CYCLE_STAT(TEXT("TickGrip ~ TickingGrip"), STAT_TickGrip, STATGROUP_TickGrip);
 DECLARE_CYCLE_STAT(TEXT("GetGripWorldTransform ~ GettingTransform"), STAT_GetGripTransform, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("LateUpdate ~ Setup"), STAT_LateUpdateSetup, STATGROUP_TickGrip);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LateUpdate ~ Primitives Walked"), STAT_LateUpdatePrimitivesWalked, STATGROUP_TickGrip);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LateUpdate ~ Hierarchy Rebuilds"), STAT_LateUpdateHierarchyRebuilds, STATGROUP_TickGrip);
 
 // MAGIC NUMBERS
 // Constraint multipliers for angular, to avoid having to have two sets of stiffness/damping variables
@@ -72,6 +76,22 @@ namespace GripMotionControllerCvars
 		TEXT("When on, will draw debug speheres for physics grips COM.\n")
 		TEXT("0: Disable, 1: Enable"),
 		ECVF_Default);
+
+	static int32 ForceLateUpdateRegather = 0;
+	FAutoConsoleVariableRef CVarForceLateUpdateRegather(
+		TEXT("vr.ForceLateUpdateRegather"),
+		ForceLateUpdateRegather,
+		TEXT("When on, the late update manager re-gathers every hierarchy each frame instead of using its cached set (for comparing the LateUpdate stats).\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+
+	static int32 ValidateGripScriptCache = 0;
+	FAutoConsoleVariableRef CVarValidateGripScriptCache(
+		TEXT("vr.ValidateGripScriptCache"),
+		ValidateGripScriptCache,
+		TEXT("When on, every grip checks its cached grip scripts against the interface each frame and warns and refreshes if they went stale (non shipping builds only).\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
 }
 
   //=============================================================================
@@ -525,6 +545,17 @@ void UGripMotionControllerComponent::GetLifetimeReplicatedProps(TArray< class FL
 
 void UGripMotionControllerComponent::Server_SendControllerTransform_Implementation(FBPVRComponentPosRep NewTransform)
 {
+	bool bSendAck = false;
+	uint8 BaselineAck = 0;
+	const bool bResolved = PoseDeltaReceiver.Resolve(NewTransform, bSendAck, BaselineAck);
+
+	if (bSendAck)
+		Client_AckPoseBaseline(BaselineAck);
+
+	// Delta against a baseline we never got, hold the last pose until the client resyncs
+	if (!bResolved)
+		return;
+
 	// Store new transform and trigger OnRep_Function
 	ReplicatedControllerTransform = NewTransform;
 
@@ -539,6 +570,73 @@ bool UGripMotionControllerComponent::Server_SendControllerTransform_Validate(FBP
 	// Optionally check to make sure that player is inside of their bounds and deny it if they aren't?
 }
 
+void UGripMotionControllerComponent::Client_AckPoseBaseline_Implementation(uint8 BaselineAck)
+{
+	PoseDeltaSender.OnBaselineAck(BaselineAck);
+}
+
+void UGripMotionControllerComponent::MarkGripDirty(FBPActorGripInformation& Grip)
+{
+	if (GrippedObjects.OwnsGrip(Grip))
+	{
+		GrippedObjects.MarkItemDirty(Grip);
+	}
+	else if (LocallyGrippedObjects.OwnsGrip(Grip))
+	{
+		LocallyGrippedObjects.MarkItemDirty(Grip);
+	}
+}
+
+void UGripMotionControllerComponent::ProcessReplicatedGripEvents(FBPGripInformationArray& GripArray)
+{
+	// Removes first, the grip ID may have been re-used by an add in the same receive
+	for (const FBPActorGripInformation& RemovedGrip : GripArray.PendingRepRemoves)
+	{
+		GripArray.LastReplicatedStates.RemoveAllSwap([&RemovedGrip](const FBPActorGripInformation& State) { return State.GripID == RemovedGrip.GripID; }, false);
+		OnGripRemovedByReplication(RemovedGrip);
+	}
+	GripArray.PendingRepRemoves.Reset();
+
+	for (uint8 GripID : GripArray.PendingRepAdds)
+	{
+		if (FBPActorGripInformation* Grip = GripArray.FindByKey(GripID))
+		{
+			HandleGripReplication(*Grip);
+			GripArray.LastReplicatedStates.Add(*Grip);
+		}
+	}
+	GripArray.PendingRepAdds.Reset();
+
+	for (uint8 GripID : GripArray.PendingRepChanges)
+	{
+		FBPActorGripInformation* Grip = GripArray.FindByKey(GripID);
+		if (!Grip)
+			continue;
+
+		if (FBPActorGripInformation* LastState = GripArray.LastReplicatedStates.FindByKey(GripID))
+		{
+			HandleGripReplication(*Grip, LastState);
+			*LastState = *Grip;
+		}
+		else
+		{
+			HandleGripReplication(*Grip);
+			GripArray.LastReplicatedStates.Add(*Grip);
+		}
+	}
+	GripArray.PendingRepChanges.Reset();
+}
+
+void UGripMotionControllerComponent::OnGripRemovedByReplication(const FBPActorGripInformation& RemovedGrip)
+{
+	// The NotifyDrop multicast handles the release events, this only catches a handle left behind if the
+	// grip was removed without the drop ever reaching us
+	if (!RemovedGrip.bIsPaused)
+	{
+		DestroyPhysicsHandle(RemovedGrip);
+	}
+}
+
 void UGripMotionControllerComponent::FGripViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewFamily)
 {
 	if (!MotionControllerComponent)
@@ -836,6 +934,7 @@ void UGripMotionControllerComponent::SetGripCollisionType(const FBPActorGripInfo
 	if (fIndex != INDEX_NONE)
 	{
 		GrippedObjects[fIndex].GripCollisionType = NewGripCollisionType;
+		GrippedObjects.MarkItemDirty(GrippedObjects[fIndex]);
 		ReCreateGrip(GrippedObjects[fIndex]);
 		Result = EBPVRResultSwitch::OnSucceeded;
 		return;
@@ -847,6 +946,7 @@ void UGripMotionControllerComponent::SetGripCollisionType(const FBPActorGripInfo
 		if (fIndex != INDEX_NONE)
 		{
 			LocallyGrippedObjects[fIndex].GripCollisionType = NewGripCollisionType;
+			LocallyGrippedObjects.MarkItemDirty(LocallyGrippedObjects[fIndex]);
 
 			if (GetNetMode() == ENetMode::NM_Client && !IsTornOff() && LocallyGrippedObjects[fIndex].GripMovementReplicationSetting == EGripMovementReplicationSettings::ClientSide_Authoritive)
 			{
@@ -871,6 +971,8 @@ void UGripMotionControllerComponent::SetGripLateUpdateSetting(const FBPActorGrip
 	if (fIndex != INDEX_NONE)
 	{
 		GrippedObjects[fIndex].GripLateUpdateSetting = NewGripLateUpdateSetting;
+		GrippedObjects.MarkItemDirty(GrippedObjects[fIndex]);
+		MarkLateUpdatesDirty();
 		Result = EBPVRResultSwitch::OnSucceeded;
 		return;
 	}
@@ -881,6 +983,8 @@ void UGripMotionControllerComponent::SetGripLateUpdateSetting(const FBPActorGrip
 		if (fIndex != INDEX_NONE)
 		{
 			LocallyGrippedObjects[fIndex].GripLateUpdateSetting = NewGripLateUpdateSetting;
+			LocallyGrippedObjects.MarkItemDirty(LocallyGrippedObjects[fIndex]);
+			MarkLateUpdatesDirty();
 
 			if (GetNetMode() == ENetMode::NM_Client && !IsTornOff() && LocallyGrippedObjects[fIndex].GripMovementReplicationSetting == EGripMovementReplicationSettings::ClientSide_Authoritive)
 			{
@@ -907,6 +1011,7 @@ void UGripMotionControllerComponent::SetGripRelativeTransform(
 	if (fIndex != INDEX_NONE)
 	{
 		GrippedObjects[fIndex].RelativeTransform = NewRelativeTransform;
+		GrippedObjects.MarkItemDirty(GrippedObjects[fIndex]);
 		if (FBPActorPhysicsHandleInformation * HandleInfo = GetPhysicsGrip(Grip))
 		{
 			UpdatePhysicsHandle(Grip.GripID, true);
@@ -923,6 +1028,7 @@ void UGripMotionControllerComponent::SetGripRelativeTransform(
 		if (fIndex != INDEX_NONE)
 		{
 			LocallyGrippedObjects[fIndex].RelativeTransform = NewRelativeTransform;
+			LocallyGrippedObjects.MarkItemDirty(LocallyGrippedObjects[fIndex]);
 			if (FBPActorPhysicsHandleInformation * HandleInfo = GetPhysicsGrip(Grip))
 			{
 				UpdatePhysicsHandle(Grip.GripID, true);
@@ -993,6 +1099,8 @@ void UGripMotionControllerComponent::SetGripStiffnessAndDamping(
 			GrippedObjects[fIndex].AdvancedGripSettings.PhysicsSettings.AngularDamping = OptionalAngularDamping;
 		}
 
+		GrippedObjects.MarkItemDirty(GrippedObjects[fIndex]);
+
 		Result = EBPVRResultSwitch::OnSucceeded;
 		SetGripConstraintStiffnessAndDamping(&GrippedObjects[fIndex]);
 		//return;
@@ -1012,6 +1120,8 @@ void UGripMotionControllerComponent::SetGripStiffnessAndDamping(
 				LocallyGrippedObjects[fIndex].AdvancedGripSettings.PhysicsSettings.AngularDamping = OptionalAngularDamping;
 			}
 
+			LocallyGrippedObjects.MarkItemDirty(LocallyGrippedObjects[fIndex]);
+
 			if (GetNetMode() == ENetMode::NM_Client && !IsTornOff() && LocallyGrippedObjects[fIndex].GripMovementReplicationSetting == EGripMovementReplicationSettings::ClientSide_Authoritive)
 			{
 				FBPActorGripInformation GripInfo = LocallyGrippedObjects[fIndex];
@@ -2461,6 +2571,8 @@ bool UGripMotionControllerComponent::NotifyGrip(FBPActorGripInformation &NewGrip
 	if (!NewGrip.GrippedObject || !NewGrip.GrippedObject->IsValidLowLevelFast())
 		return false;
 
+	MarkLateUpdatesDirty();
+
 	if (!NewGrip.AdvancedGripSettings.bDisallowLerping && !bIsReInit && NewGrip.GripCollisionType != EGripCollisionType::EventsOnly && NewGrip.GripCollisionType != EGripCollisionType::CustomGrip)
 	{
 		// Init lerping
@@ -2684,6 +2796,9 @@ bool UGripMotionControllerComponent::NotifyGrip(FBPActorGripInformation &NewGrip
 	}break;
 	}
 
+	// Resolve the interface and scripts once here so the grip tick can skip it
+	CacheGripResolution(NewGrip, root, pActor);
+
 	switch (NewGrip.GripMovementReplicationSetting)
 	{
 	case EGripMovementReplicationSettings::ForceClientSideMovement:
@@ -3048,6 +3163,7 @@ void UGripMotionControllerComponent::NotifyDrop_Implementation(const FBPActorGri
 
 void UGripMotionControllerComponent::Drop_Implementation(const FBPActorGripInformation &NewDrop, bool bSimulate)
 {
+	MarkLateUpdatesDirty();
 
 	bool bSkipFullDrop = false;
 	bool bHadAnotherSelfGrip = false;
@@ -3644,6 +3760,8 @@ bool UGripMotionControllerComponent::AddSecondaryAttachmentToGrip(const FBPActor
 		GripToUse->SecondaryGripInfo.curLerp = LerpToTime;
 	}
 
+	MarkGripDirty(*GripToUse);
+
 	if (bGrippedObjectIsInterfaced)
 	{
 		IVRGripInterface::Execute_OnSecondaryGrip(GripToUse->GrippedObject, this, SecondaryPointComponent, *GripToUse);
@@ -3830,6 +3948,7 @@ bool UGripMotionControllerComponent::RemoveSecondaryAttachmentFromGrip(const FBP
 
 		GripToUse->SecondaryGripInfo.SecondaryAttachment = nullptr;
 		GripToUse->SecondaryGripInfo.bHasSecondaryAttachment = false;
+		MarkGripDirty(*GripToUse);
 
 		if (GripToUse->GripMovementReplicationSetting == EGripMovementReplicationSettings::ClientSide_Authoritive && GetNetMode() == ENetMode::NM_Client)
 		{
@@ -4177,6 +4296,26 @@ void UGripMotionControllerComponent::OnAttachmentChanged()
 	Super::OnAttachmentChanged();
 }
 
+void UGripMotionControllerComponent::OnChildAttached(USceneComponent* ChildComponent)
+{
+	Super::OnChildAttached(ChildComponent);
+	MarkLateUpdatesDirty();
+}
+
+void UGripMotionControllerComponent::OnChildDetached(USceneComponent* ChildComponent)
+{
+	Super::OnChildDetached(ChildComponent);
+	MarkLateUpdatesDirty();
+}
+
+void UGripMotionControllerComponent::MarkLateUpdatesDirty()
+{
+	if (GripViewExtension.IsValid())
+	{
+		GripViewExtension->LateUpdate.MarkLateUpdateSetDirty();
+	}
+}
+
 void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 {
 	// Server/remote clients don't set the controller position in VR
@@ -4286,13 +4425,17 @@ void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 					// Perf difference.
 					if (GetNetMode() == NM_Client/* && !IsTornOff()*/)
 					{
+						// Turns the send into a baseline or delta if delta encoding is on
+						FBPVRComponentPosRep SendTransform = ReplicatedControllerTransform;
+						PoseDeltaSender.PrepareForSend(SendTransform);
+
 						AVRBaseCharacter* OwningChar = Cast<AVRBaseCharacter>(GetOwner());
 						if (OverrideSendTransform != nullptr && OwningChar != nullptr)
 						{
-							(OwningChar->* (OverrideSendTransform))(ReplicatedControllerTransform);
+							(OwningChar->* (OverrideSendTransform))(SendTransform);
 						}
 						else
-							Server_SendControllerTransform(ReplicatedControllerTransform);
+							Server_SendControllerTransform(SendTransform);
 					}
 				}
 			}
@@ -4379,7 +4522,7 @@ void UGripMotionControllerComponent::TickComponent(float DeltaTime, enum ELevelT
 	TickGrip(DeltaTime);
 }
 
-bool UGripMotionControllerComponent::GetGripWorldTransform(TArray<UVRGripScriptBase*>& GripScripts, float DeltaTime, FTransform & WorldTransform, const FTransform &ParentTransform, FBPActorGripInformation &Grip, AActor * actor, UPrimitiveComponent * root, bool bRootHasInterface, bool bActorHasInterface, bool bIsForTeleport, bool &bForceADrop)
+bool UGripMotionControllerComponent::GetGripWorldTransform(TArrayView<UVRGripScriptBase*> GripScripts, float DeltaTime, FTransform & WorldTransform, const FTransform &ParentTransform, FBPActorGripInformation &Grip, AActor * actor, UPrimitiveComponent * root, bool bRootHasInterface, bool bActorHasInterface, bool bIsForTeleport, bool &bForceADrop)
 {
 	SCOPE_CYCLE_COUNTER(STAT_GetGripTransform);
 
@@ -4435,6 +4578,106 @@ bool UGripMotionControllerComponent::GetGripWorldTransform(TArray<UVRGripScriptB
 	return bHasValidTransform;
 }
 
+void UGripMotionControllerComponent::CacheGripResolution(FBPActorGripInformation & Grip, UPrimitiveComponent * root, AActor * actor)
+{
+	FBPActorGripInformation::FGripResolutionCache & Cache = Grip.ResolutionCache;
+	Cache = FBPActorGripInformation::FGripResolutionCache();
+
+	Cache.ResolvedRoot = root;
+	Cache.ResolvedActor = actor;
+	Cache.bIsCustomGrip = Grip.GripCollisionType == EGripCollisionType::CustomGrip;
+
+	// Same precedence as the tick has always used, the root interface wins over the actor
+	if (root && root->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+	{
+		Cache.bRootHasInterface = true;
+		Cache.InterfaceOwner = root;
+	}
+	else if (actor && actor->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+	{
+		// Actor grip interface is checked after component
+		Cache.bActorHasInterface = true;
+		Cache.InterfaceOwner = actor;
+	}
+
+	if (UObject * InterfaceOwner = Cache.InterfaceOwner.Get())
+	{
+		TArray<UVRGripScriptBase*> GripScripts;
+		if (IVRGripInterface::Execute_GetGripScripts(InterfaceOwner, GripScripts))
+		{
+			for (UVRGripScriptBase* Script : GripScripts)
+			{
+				if (Script)
+				{
+					Cache.GripScripts.Add(Script);
+				}
+			}
+		}
+	}
+
+	Cache.bIsResolved = true;
+}
+
+bool UGripMotionControllerComponent::IsGripResolutionCacheCurrent(const FBPActorGripInformation & Grip) const
+{
+	const FBPActorGripInformation::FGripResolutionCache & Cache = Grip.ResolutionCache;
+	UObject * InterfaceOwner = Cache.InterfaceOwner.Get();
+
+	if (!InterfaceOwner)
+		return Cache.GripScripts.Num() == 0;
+
+	TArray<UVRGripScriptBase*> GripScripts;
+	IVRGripInterface::Execute_GetGripScripts(InterfaceOwner, GripScripts);
+	GripScripts.Remove(nullptr);
+
+	if (GripScripts.Num() != Cache.GripScripts.Num())
+		return false;
+
+	for (int32 i = 0; i < GripScripts.Num(); ++i)
+	{
+		if (Cache.GripScripts[i].Get() != GripScripts[i])
+			return false;
+	}
+
+	return true;
+}
+
+void UGripMotionControllerComponent::NotifyGripScriptsChangedOnAllControllers(UObject * ObjectToRefresh)
+{
+	if (!ObjectToRefresh)
+		return;
+
+	// Grips on an actor resolve against its root component first, so the holders of the object itself aren't enough
+	UWorld * World = ObjectToRefresh->GetWorld();
+	for (TObjectIterator<UGripMotionControllerComponent> It; It; ++It)
+	{
+		if (It->GetWorld() == World && (It->GrippedObjects.Items.Num() > 0 || It->LocallyGrippedObjects.Items.Num() > 0))
+		{
+			It->NotifyGripScriptsChanged(ObjectToRefresh);
+		}
+	}
+}
+
+void UGripMotionControllerComponent::NotifyGripScriptsChanged(UObject * ObjectToRefresh)
+{
+	if (!ObjectToRefresh)
+		return;
+
+	auto InvalidateArray = [ObjectToRefresh](TArray<FBPActorGripInformation> & GripArray)
+	{
+		for (FBPActorGripInformation & Grip : GripArray)
+		{
+			if (Grip.GrippedObject == ObjectToRefresh || Grip.ResolutionCache.InterfaceOwner.Get() == ObjectToRefresh)
+			{
+				Grip.ResolutionCache.Invalidate();
+			}
+		}
+	};
+
+	InvalidateArray(GrippedObjects.Items);
+	InvalidateArray(LocallyGrippedObjects.Items);
+}
+
 void UGripMotionControllerComponent::TickGrip(float DeltaTime)
 {
 	SCOPE_CYCLE_COUNTER(STAT_TickGrip);
@@ -4451,8 +4694,17 @@ void UGripMotionControllerComponent::TickGrip(float DeltaTime)
 
 	// Check for floating server sided client auth grips and handle them if we need too
 	if(!IsServer())
+	{
 		CheckTransactionBuffer();
 
+		// Normally handled in the rep notifies already
+		if (GrippedObjects.HasPendingRepEvents())
+			ProcessReplicatedGripEvents(GrippedObjects);
+
+		if (LocallyGrippedObjects.HasPendingRepEvents())
+			ProcessReplicatedGripEvents(LocallyGrippedObjects);
+	}
+
 	bool bOriginalPostTeleport = bIsPostTeleport;
 
 	// Split into separate functions so that I didn't have to combine arrays since I have some removal going on
@@ -4509,7 +4761,7 @@ FVector UGripMotionControllerComponent::GetComponentVelocity() const
 	return Super::GetComponentVelocity();
 }
 
-void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformation> &GrippedObjectsArray, const FTransform & ParentTransform, float DeltaTime, bool bReplicatedArray)
+void UGripMotionControllerComponent::HandleGripArray(FBPGripInformationArray &GrippedObjectsArray, const FTransform & ParentTransform, float DeltaTime, bool bReplicatedArray)
 {
 	if (GrippedObjectsArray.Num())
 	{
@@ -4574,21 +4826,24 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 					continue;
 				}
 
-				// Check if either implements the interface
-				bool bRootHasInterface = false;
-				bool bActorHasInterface = false;
-				
-				if (root->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+				// Resolved in NotifyGrip, only re-resolve if the cache was invalidated or the grip target changed
+				if (!Grip->ResolutionCache.IsValidFor(root, actor))
 				{
-					bRootHasInterface = true;
+					CacheGripResolution(*Grip, root, actor);
 				}
-				else if (actor->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+				else if (GripMotionControllerCvars::ValidateGripScriptCache > 0 && !IsGripResolutionCacheCurrent(*Grip))
 				{
-					// Actor grip interface is checked after component
-					bActorHasInterface = true;
+					UE_LOG(LogVRMotionController, Warning, TEXT("Cached grip scripts for %s were stale, call NotifyGripScriptsChanged after changing grip scripts during a grip."), *GetNameSafe(Grip->GrippedObject));
+					CacheGripResolution(*Grip, root, actor);
 				}
+#endif
+
+				// Check if either implements the interface
+				const bool bRootHasInterface = Grip->ResolutionCache.bRootHasInterface;
+				const bool bActorHasInterface = Grip->ResolutionCache.bActorHasInterface;
 
-				if (Grip->GripCollisionType == EGripCollisionType::CustomGrip)
+				if (Grip->ResolutionCache.bIsCustomGrip)
 				{
 					// Don't perform logic on the movement for this object, just pass in the GripTick() event with the controller difference instead
 					if(bRootHasInterface)
@@ -4601,15 +4856,14 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 				bool bRescalePhysicsGrips = false;
 				
-				TArray<UVRGripScriptBase*> GripScripts;
-
-				if (bRootHasInterface)
+				// Inline so that the tick does not allocate, scripts that were collected since caching are skipped
+				TArray<UVRGripScriptBase*, TInlineAllocator<8>> GripScripts;
+				for (const TWeakObjectPtr<UVRGripScriptBase>& CachedScript : Grip->ResolutionCache.GripScripts)
 				{
-					IVRGripInterface::Execute_GetGripScripts(root, GripScripts);
-				}
-				else if (bActorHasInterface)
-				{
-					IVRGripInterface::Execute_GetGripScripts(actor, GripScripts);
+					if (UVRGripScriptBase* Script = CachedScript.Get())
+					{
+						GripScripts.Add(Script);
+					}
 				}
 
 
@@ -5087,7 +5341,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 }
 
 
-void UGripMotionControllerComponent::CleanUpBadGrip(TArray<FBPActorGripInformation> &GrippedObjectsArray, int GripIndex, bool bReplicatedArray)
+void UGripMotionControllerComponent::CleanUpBadGrip(FBPGripInformationArray &GrippedObjectsArray, int GripIndex, bool bReplicatedArray)
 {
 	// Object has been destroyed without notification to plugin
 	if (!DestroyPhysicsHandle(GrippedObjectsArray[GripIndex]))
@@ -6539,8 +6793,8 @@ void UGripMotionControllerComponent::FGripViewExtension::LateLatchingViewFamily_
 
 void UGripMotionControllerComponent::GetAllGrips(TArray<FBPActorGripInformation> &GripArray)
 {
-	GripArray.Append(GrippedObjects);
-	GripArray.Append(LocallyGrippedObjects);
+	GripArray.Append(GrippedObjects.Items);
+	GripArray.Append(LocallyGrippedObjects.Items);
 }
 
 void UGripMotionControllerComponent::GetGrippedObjects(TArray<UObject*> &GrippedObjectsArray)
@@ -6708,6 +6962,8 @@ void UGripMotionControllerComponent::Server_NotifyLocalGripAddedOrChanged_Implem
 				LocallyGrippedObjects[NewIndex].bOriginalGravity = PrimComp->IsGravityEnabled();
 			}
 
+			LocallyGrippedObjects.MarkItemDirty(LocallyGrippedObjects[NewIndex]);
+
 			HandleGripReplication(LocallyGrippedObjects[NewIndex]);
 		}
 
@@ -6721,6 +6977,7 @@ void UGripMotionControllerComponent::Server_NotifyLocalGripAddedOrChanged_Implem
 		{
 			FBPActorGripInformation OriginalGrip = LocallyGrippedObjects[IndexFound];
 			LocallyGrippedObjects[IndexFound].RepCopy(newGrip);
+			LocallyGrippedObjects.MarkItemDirty(LocallyGrippedObjects[IndexFound]);
 			HandleGripReplication(LocallyGrippedObjects[IndexFound], &OriginalGrip);
 		}
 	}
@@ -6795,6 +7052,7 @@ void UGripMotionControllerComponent::Server_NotifySecondaryAttachmentChanged_Imp
 
 		// I override the = operator now so that it won't set the lerp components
 		GripInfo->SecondaryGripInfo.RepCopy(SecondaryGripInfo);
+		LocallyGrippedObjects.MarkItemDirty(*GripInfo);
 
 		// Initialize the differences, clients will do this themselves on the rep back
 		HandleGripReplication(*GripInfo, &OriginalGrip);
@@ -6822,6 +7080,7 @@ void UGripMotionControllerComponent::Server_NotifySecondaryAttachmentChanged_Ret
 		// I override the = operator now so that it won't set the lerp components
 		GripInfo->SecondaryGripInfo.RepCopy(SecondaryGripInfo);
 		GripInfo->RelativeTransform = NewRelativeTransform;
+		LocallyGrippedObjects.MarkItemDirty(*GripInfo);
 
 		// Initialize the differences, clients will do this themselves on the rep back
 		HandleGripReplication(*GripInfo, &OriginalGrip);
@@ -6868,6 +7127,8 @@ void UGripMotionControllerComponent::GetControllerDeviceID(FXRDeviceId & DeviceI
 FExpandedLateUpdateManager::FExpandedLateUpdateManager()
 	: LateUpdateGameWriteIndex(0)
 	, LateUpdateRenderReadIndex(0)
+	, SetupPass(0)
+	, bLateUpdateSetDirty(false)
 {
 }
 
@@ -6877,7 +7138,15 @@ void FExpandedLateUpdateManager::Setup(const FTransform& ParentToWorld, UGripMot
 		return;
 
 	check(IsInGameThread());
+	SCOPE_CYCLE_COUNTER(STAT_LateUpdateSetup);
 
+	if (bLateUpdateSetDirty || GripMotionControllerCvars::ForceLateUpdateRegather)
+	{
+		CachedHierarchies.Reset();
+		bLateUpdateSetDirty = false;
+	}
+
+	++SetupPass;
 
 	UpdateStates[LateUpdateGameWriteIndex].Primitives.Reset();
 	UpdateStates[LateUpdateGameWriteIndex].ParentToWorld = ParentToWorld;
@@ -6890,12 +7159,21 @@ void FExpandedLateUpdateManager::Setup(const FTransform& ParentToWorld, UGripMot
 			GatherLateUpdatePrimitives(primComp);
 	}
 
-	ProcessGripArrayLateUpdatePrimitives(Component, Component->LocallyGrippedObjects);
-	ProcessGripArrayLateUpdatePrimitives(Component, Component->GrippedObjects);
+	ProcessGripArrayLateUpdatePrimitives(Component, Component->LocallyGrippedObjects.Items);
+	ProcessGripArrayLateUpdatePrimitives(Component, Component->GrippedObjects.Items);
 
 	GatherLateUpdatePrimitives(Component);
 	//GatherLateUpdatePrimitives(Component);
 
+	// Remove hierarchies that weren't used this pass (dropped grips, removed additional components, ect)
+	for (auto HierarchyIt = CachedHierarchies.CreateIterator(); HierarchyIt; ++HierarchyIt)
+	{
+		if (HierarchyIt.Value().LastUsedPass != SetupPass)
+		{
+			HierarchyIt.RemoveCurrent();
+		}
+	}
+
 	UpdateStates[LateUpdateGameWriteIndex].bSkip = bSkipLateUpdate;
 	++UpdateStates[LateUpdateGameWriteIndex].TrackingNumber;
 
@@ -6997,23 +7275,81 @@ void FExpandedLateUpdateManager::CacheSceneInfo(USceneComponent* Component)
 
 void FExpandedLateUpdateManager::GatherLateUpdatePrimitives(USceneComponent* ParentComponent)
 {
-	CacheSceneInfo(ParentComponent);
-	TArray<USceneComponent*> DirectComponents;
+	FCachedLateUpdateHierarchy& Hierarchy = CachedHierarchies.FindOrAdd(ParentComponent);
+
+	// Already gathered this pass
+	if (Hierarchy.LastUsedPass == SetupPass)
+		return;
+
+	Hierarchy.LastUsedPass = SetupPass;
 
-	// Std late updates
-	ParentComponent->GetChildrenComponents(true, DirectComponents);
-	for (USceneComponent* Component : DirectComponents)
+	// Attaching / detaching deeper in the hierarchy (AttachToComponent, spawned meshes, ect) raises no event we can hook on
+	// arbitrary components, so a changed child count or attach parent on any cached node re-gathers it here.
+	// Registering doesn't change the hierarchy, CacheSceneInfo picks up the scene proxy once it exists.
+	if (!Hierarchy.Nodes.Num() || !CacheHierarchyPrimitives(Hierarchy))
 	{
-		if (Component != nullptr)
+		BuildCachedHierarchy(ParentComponent, Hierarchy);
+		INC_DWORD_STAT(STAT_LateUpdateHierarchyRebuilds);
+		CacheHierarchyPrimitives(Hierarchy);
+	}
+}
+
+bool FExpandedLateUpdateManager::CacheHierarchyPrimitives(const FCachedLateUpdateHierarchy& Hierarchy)
+{
+	for (int32 i = 0; i < Hierarchy.Nodes.Num(); ++i)
+	{
+		const FCachedLateUpdateNode& Node = Hierarchy.Nodes[i];
+		USceneComponent* Component = Node.Component.Get();
+
+		// The roots own attachment doesn't change what is under it
+		if (!Component || Component->GetAttachChildren().Num() != Node.NumAttachChildren || (i > 0 && Component->GetAttachParent() != Node.AttachParent.Get()))
 		{
+			return false;
+		}
+
+		if (Node.bIsPrimitive)
+		{
+			// Std late updates
 			CacheSceneInfo(Component);
+			INC_DWORD_STAT(STAT_LateUpdatePrimitivesWalked);
 		}
 	}
+
+	return true;
 }
 
-void FExpandedLateUpdateManager::ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent * MotionControllerComponent, TArray<FBPActorGripInformation> & GripArray)
+void FExpandedLateUpdateManager::BuildCachedHierarchy(USceneComponent* ParentComponent, FCachedLateUpdateHierarchy& Hierarchy)
 {
-	for (FBPActorGripInformation actor : GripArray)
+	Hierarchy.Nodes.Reset();
+
+	TArray<USceneComponent*> Gathered;
+	Gathered.Add(ParentComponent);
+
+	// Breadth first, same set as GetChildrenComponents(true) without the recursion
+	for (int32 i = 0; i < Gathered.Num(); ++i)
+	{
+		USceneComponent* Component = Gathered[i];
+		const TArray<USceneComponent*>& AttachChildren = Component->GetAttachChildren();
+
+		FCachedLateUpdateNode& Node = Hierarchy.Nodes.AddDefaulted_GetRef();
+		Node.Component = Component;
+		Node.AttachParent = Component->GetAttachParent();
+		Node.NumAttachChildren = AttachChildren.Num();
+		Node.bIsPrimitive = Component->IsA<UPrimitiveComponent>();
+
+		for (USceneComponent* Child : AttachChildren)
+		{
+			if (Child != nullptr)
+			{
+				Gathered.Add(Child);
+			}
+		}
+	}
+}
+
+void FExpandedLateUpdateManager::ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent * MotionControllerComponent, const TArray<FBPActorGripInformation> & GripArray)
+{
+	for (const FBPActorGripInformation& actor : GripArray)
 	{
 		// Skip actors that are colliding if turning off late updates during collision.
 		// Also skip turning off late updates for SweepWithPhysics, as it should always be locked to the hand
@@ -7067,7 +7403,23 @@ void FExpandedLateUpdateManager::ProcessGripArrayLateUpdatePrimitives(UGripMotio
 		}
 
 		// Don't run late updates if we have a grip script that denies it
-		if (actor.GrippedObject->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+		// Use the resolved scripts from the grip tick when they came from the gripped object itself
+		if (actor.ResolutionCache.bIsResolved && actor.ResolutionCache.InterfaceOwner.Get() == actor.GrippedObject)
+		{
+			bool bContinueOn = false;
+			for (const TWeakObjectPtr<UVRGripScriptBase>& Script : actor.ResolutionCache.GripScripts)
+			{
+				if (Script.IsValid() && Script->IsScriptActive() && Script->Wants_DenyLateUpdates())
+				{
+					bContinueOn = true;
+					break;
+				}
+			}
+
+			if (bContinueOn)
+				continue;
+		}
+		else if (actor.GrippedObject->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
 		{
 			TArray<UVRGripScriptBase*> GripScripts;
 			if (IVRGripInterface::Execute_GetGripScripts(actor.GrippedObject, GripScripts))
@@ -206,6 +206,7 @@ void UGS_Melee::UpdateHandPositionAndRotation(FBPGripPair HandPair, FTransform H
 			}
 
 			GripInfo->RelativeTransform = RelativeTrans.Inverse();
+			HandPair.HoldingController->MarkGripDirty(*GripInfo);
 			HandPair.HoldingController->UpdatePhysicsHandle(*GripInfo, true);
 			HandPair.HoldingController->NotifyGripTransformChanged(*GripInfo);
 
@@ -294,6 +295,7 @@ void UGS_Melee::UpdateHandPosition(FBPGripPair HandPair, FVector HandWorldPositi
 
 			RelativeTrans.SetLocation(orientationRot.UnrotateVector(currentLoc));
 			GripInfo->RelativeTransform = RelativeTrans.Inverse();
+			HandPair.HoldingController->MarkGripDirty(*GripInfo);
 			HandPair.HoldingController->UpdatePhysicsHandle(*GripInfo, true);
 			HandPair.HoldingController->NotifyGripTransformChanged(*GripInfo);
 
@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Grippables/GrippableActor.h"
+#include "GripMotionControllerComponent.h"
 #include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
 #include "PhysicsReplication.h"
@@ -272,6 +273,11 @@ bool AGrippableActor::ReplicateSubobjects(UActorChannel* Channel, class FOutBunc
 	return WroteSomething;
 }
 
+void AGrippableActor::OnRep_GripLogicScripts()
+{
+	UGripMotionControllerComponent::NotifyGripScriptsChangedOnAllControllers(this);
+}
+
 //=============================================================================
 AGrippableActor::~AGrippableActor()
 {
@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Grippables/GrippableBoxComponent.h"
+#include "GripMotionControllerComponent.h"
 #include "Net/UnrealNetwork.h"
 
 //=============================================================================
@@ -72,6 +73,11 @@ bool UGrippableBoxComponent::ReplicateSubobjects(UActorChannel* Channel, class F
 	return WroteSomething;
 }
 
+void UGrippableBoxComponent::OnRep_GripLogicScripts()
+{
+	UGripMotionControllerComponent::NotifyGripScriptsChangedOnAllControllers(this);
+}
+
 
 void UGrippableBoxComponent::BeginPlay()
 {
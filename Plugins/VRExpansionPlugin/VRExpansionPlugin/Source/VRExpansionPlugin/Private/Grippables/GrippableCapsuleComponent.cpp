@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Grippables/GrippableCapsuleComponent.h"
+#include "GripMotionControllerComponent.h"
 #include "Net/UnrealNetwork.h"
 
   //=============================================================================
@@ -68,6 +69,11 @@ bool UGrippableCapsuleComponent::ReplicateSubobjects(UActorChannel* Channel, cla
 	return WroteSomething;
 }
 
+void UGrippableCapsuleComponent::OnRep_GripLogicScripts()
+{
+	UGripMotionControllerComponent::NotifyGripScriptsChangedOnAllControllers(this);
+}
+
 //=============================================================================
 UGrippableCapsuleComponent::~UGrippableCapsuleComponent()
 {
@@ -4,18 +4,40 @@
 #include "UObject/ObjectMacros.h"
 #include "UObject/Interface.h"
 #include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
 #if WITH_CHAOS
 #include "Chaos/ChaosMarshallingManager.h"
 #include "PhysicsProxy/SingleParticlePhysicsProxy.h"
 #include "PBDRigidsSolver.h"
 #include "Chaos/PBDRigidsEvolutionGBF.h"
 #endif
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contact Modify Pairs Tested"), STAT_ContactModPairsTested, STATGROUP_VRPhysicsReplication);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contact Modify Pairs Ignored"), STAT_ContactModPairsIgnored, STATGROUP_VRPhysicsReplication);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Replication Targets Processed"), STAT_PhysRepTargetsProcessed, STATGROUP_VRPhysicsReplication);
+DECLARE_CYCLE_STAT(TEXT("Gather Targets"), STAT_PhysRepGatherTargets, STATGROUP_VRPhysicsReplication);
+DECLARE_CYCLE_STAT(TEXT("Compute Corrections"), STAT_PhysRepComputeCorrections, STATGROUP_VRPhysicsReplication);
+DECLARE_CYCLE_STAT(TEXT("Apply Corrections"), STAT_PhysRepApplyCorrections, STATGROUP_VRPhysicsReplication);
 
 // I cannot dynamic cast without RTTI so I am using a static var as a declarative in case the user removed our custom replicator
 // We don't want our casts to cause issues.
 namespace VRPhysicsReplicationStatics
 {
 	static bool bHasVRPhysicsReplication = false;
+
+	static int32 ParallelMinTargets = 64;
+	FAutoConsoleVariableRef CVarParallelMinTargets(
+		TEXT("vr.PhysicsReplicationParallelMinTargets"),
+		ParallelMinTargets,
+		TEXT("Minimum number of server side physics replication targets before the correction math is run in parallel.\n"),
+		ECVF_Default);
+
+	static int32 ParallelChunkSize = 32;
+	FAutoConsoleVariableRef CVarParallelChunkSize(
+		TEXT("vr.PhysicsReplicationParallelChunkSize"),
+		ParallelChunkSize,
+		TEXT("Number of physics replication targets processed per parallel task.\n"),
+		ECVF_Default);
 }
 
 #if WITH_CHAOS
@@ -182,6 +204,56 @@ bool FPhysicsReplicationVR::IsInitialized()
 	return VRPhysicsReplicationStatics::bHasVRPhysicsReplication;
 }
 
+FPhysicsReplicationVR::FCorrectionSettingsVR FPhysicsReplicationVR::FCorrectionSettingsVR::Resolve(const FRigidBodyErrorCorrection& ErrorCorrection)
+{
+	FCorrectionSettingsVR Settings;
+
+	// Grab configuration variables from engine config or from CVars if overriding is turned on.
+	static const auto CVarNetPingExtrapolation = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetPingExtrapolation"));
+	Settings.NetPingExtrapolation = CVarNetPingExtrapolation->GetFloat() >= 0.0f ? CVarNetPingExtrapolation->GetFloat() : ErrorCorrection.PingExtrapolation;
+
+	static const auto CVarNetPingLimit = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetPingLimit"));
+	Settings.NetPingLimit = CVarNetPingLimit->GetFloat() > 0.0f ? CVarNetPingLimit->GetFloat() : ErrorCorrection.PingLimit;
+
+	static const auto CVarErrorPerLinearDifference = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorPerLinearDifference"));
+	Settings.ErrorPerLinearDiff = CVarErrorPerLinearDifference->GetFloat() >= 0.0f ? CVarErrorPerLinearDifference->GetFloat() : ErrorCorrection.ErrorPerLinearDifference;
+
+	static const auto CVarErrorPerAngularDifference = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorPerAngularDifference"));
+	Settings.ErrorPerAngularDiff = CVarErrorPerAngularDifference->GetFloat() >= 0.0f ? CVarErrorPerAngularDifference->GetFloat() : ErrorCorrection.ErrorPerAngularDifference;
+
+	static const auto CVarMaxRestoredStateError = IConsoleManager::Get().FindConsoleVariable(TEXT("p.MaxRestoredStateError"));
+	Settings.MaxRestoredStateError = CVarMaxRestoredStateError->GetFloat() >= 0.0f ? CVarMaxRestoredStateError->GetFloat() : ErrorCorrection.MaxRestoredStateError;
+
+	static const auto CVarErrorAccumulation = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationSeconds"));
+	Settings.ErrorAccumulationSeconds = CVarErrorAccumulation->GetFloat() >= 0.0f ? CVarErrorAccumulation->GetFloat() : ErrorCorrection.ErrorAccumulationSeconds;
+
+	static const auto CVarErrorAccumulationDistanceSq = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationDistanceSq"));
+	Settings.ErrorAccumulationDistanceSq = CVarErrorAccumulationDistanceSq->GetFloat() >= 0.0f ? CVarErrorAccumulationDistanceSq->GetFloat() : ErrorCorrection.ErrorAccumulationDistanceSq;
+
+	static const auto CVarErrorAccumulationSimilarity = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationSimilarity"));
+	Settings.ErrorAccumulationSimilarity = CVarErrorAccumulationSimilarity->GetFloat() >= 0.0f ? CVarErrorAccumulationSimilarity->GetFloat() : ErrorCorrection.ErrorAccumulationSimilarity;
+
+	static const auto CVarLinSet = IConsoleManager::Get().FindConsoleVariable(TEXT("p.PositionLerp"));
+	Settings.PositionLerp = CVarLinSet->GetFloat() >= 0.0f ? CVarLinSet->GetFloat() : ErrorCorrection.PositionLerp;
+
+	static const auto CVarLinLerp = IConsoleManager::Get().FindConsoleVariable(TEXT("p.LinearVelocityCoefficient"));
+	Settings.LinearVelocityCoefficient = CVarLinLerp->GetFloat() >= 0.0f ? CVarLinLerp->GetFloat() : ErrorCorrection.LinearVelocityCoefficient;
+
+	static const auto CVarAngSet = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AngleLerp"));
+	Settings.AngleLerp = CVarAngSet->GetFloat() >= 0.0f ? CVarAngSet->GetFloat() : ErrorCorrection.AngleLerp;
+
+	static const auto CVarAngLerp = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AngularVelocityCoefficient"));
+	Settings.AngularVelocityCoefficient = CVarAngLerp->GetFloat() >= 0.0f ? CVarAngLerp->GetFloat() : ErrorCorrection.AngularVelocityCoefficient;
+
+	static const auto CVarMaxLinearHardSnapDistance = IConsoleManager::Get().FindConsoleVariable(TEXT("p.MaxLinearHardSnapDistance"));
+	Settings.MaxLinearHardSnapDistance = CVarMaxLinearHardSnapDistance->GetFloat() >= 0.f ? CVarMaxLinearHardSnapDistance->GetFloat() : ErrorCorrection.MaxLinearHardSnapDistance;
+
+	static const auto CVarAlwaysHardSnap = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AlwaysHardSnap"));
+	Settings.bAlwaysHardSnap = CVarAlwaysHardSnap->GetInt() != 0;
+
+	return Settings;
+}
+
 bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstance* BI, FReplicatedPhysicsTarget& PhysicsTarget, const FRigidBodyErrorCorrection& ErrorCorrection, const float PingSecondsOneWay)
 {
 	// Skip all of the custom logic if we aren't the server
@@ -204,6 +276,50 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 		return false;
 	}
 
+	// Single target version of the batched path in OnTick
+	FPendingTargetVR PendingTarget;
+	if (!PrepareTargetVR(BI, PhysicsTarget, PingSecondsOneWay, PendingTarget))
+	{
+		return true;
+	}
+
+	const FCorrectionSettingsVR Settings = FCorrectionSettingsVR::Resolve(ErrorCorrection);
+	ComputeCorrectionVR(DeltaSeconds, Settings, PendingTarget);
+	ApplyCorrectionVR(Settings, PendingTarget);
+
+	return PendingTarget.bRestoredState;
+}
+
+bool FPhysicsReplicationVR::PrepareTargetVR(FBodyInstance* BI, FReplicatedPhysicsTarget& PhysicsTarget, float PingSecondsOneWay, FPendingTargetVR& OutTarget)
+{
+	const FRigidBodyState& NewState = PhysicsTarget.TargetState;
+	const float NewQuatSizeSqr = NewState.Quaternion.SizeSquared();
+
+	// failure cases
+	if (NewQuatSizeSqr < KINDA_SMALL_NUMBER)
+	{
+		UE_LOG(LogPhysics, Warning, TEXT("Invalid zero quaternion set for body. (%s)"), *BI->GetBodyDebugName());
+		return false;
+	}
+	else if (FMath::Abs(NewQuatSizeSqr - 1.f) > KINDA_SMALL_NUMBER)
+	{
+		UE_LOG(LogPhysics, Warning, TEXT("Quaternion (%f %f %f %f) with non-unit magnitude detected. (%s)"),
+			NewState.Quaternion.X, NewState.Quaternion.Y, NewState.Quaternion.Z, NewState.Quaternion.W, *BI->GetBodyDebugName());
+		return false;
+	}
+
+	OutTarget.BI = BI;
+	OutTarget.PhysicsTarget = &PhysicsTarget;
+	OutTarget.PingSecondsOneWay = PingSecondsOneWay;
+	OutTarget.bApplyCorrection = true;
+
+	// Get Current state
+	BI->GetRigidBodyState(OutTarget.CurrentState);
+	return true;
+}
+
+void FPhysicsReplicationVR::ComputeCorrectionVR(float DeltaSeconds, const FCorrectionSettingsVR& Settings, FPendingTargetVR& Target)
+{
 	//
 	// NOTES:
 	//
@@ -233,80 +349,20 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 	// Once the error value has exceeded some threshold (0.5 seconds
 	// by default), a hard snap to the target physics state is applied.
 	//
+	// This only touches the target and the packed entry so that it can run off of the game thread
+	//
 
-	bool bRestoredState = true;
-	const FRigidBodyState NewState = PhysicsTarget.TargetState;
-	const float NewQuatSizeSqr = NewState.Quaternion.SizeSquared();
-
-	// failure cases
-	if (!BI->IsInstanceSimulatingPhysics())
-	{
-		UE_LOG(LogPhysics, Warning, TEXT("Physics replicating on non-simulated body. (%s)"), *BI->GetBodyDebugName());
-		return bRestoredState;
-	}
-	else if (NewQuatSizeSqr < KINDA_SMALL_NUMBER)
-	{
-		UE_LOG(LogPhysics, Warning, TEXT("Invalid zero quaternion set for body. (%s)"), *BI->GetBodyDebugName());
-		return bRestoredState;
-	}
-	else if (FMath::Abs(NewQuatSizeSqr - 1.f) > KINDA_SMALL_NUMBER)
-	{
-		UE_LOG(LogPhysics, Warning, TEXT("Quaternion (%f %f %f %f) with non-unit magnitude detected. (%s)"),
-			NewState.Quaternion.X, NewState.Quaternion.Y, NewState.Quaternion.Z, NewState.Quaternion.W, *BI->GetBodyDebugName());
-		return bRestoredState;
-	}
-
-	// Grab configuration variables from engine config or from CVars if overriding is turned on.
-	static const auto CVarNetPingExtrapolation = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetPingExtrapolation"));
-	const float NetPingExtrapolation = CVarNetPingExtrapolation->GetFloat() >= 0.0f ? CVarNetPingExtrapolation->GetFloat() : ErrorCorrection.PingExtrapolation;
-
-	static const auto CVarNetPingLimit = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetPingLimit"));
-	const float NetPingLimit = CVarNetPingLimit->GetFloat() > 0.0f ? CVarNetPingLimit->GetFloat() : ErrorCorrection.PingLimit;
-
-	static const auto CVarErrorPerLinearDifference = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorPerLinearDifference"));
-	const float ErrorPerLinearDiff = CVarErrorPerLinearDifference->GetFloat() >= 0.0f ? CVarErrorPerLinearDifference->GetFloat() : ErrorCorrection.ErrorPerLinearDifference;
-	
-	static const auto CVarErrorPerAngularDifference = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorPerAngularDifference"));
-	const float ErrorPerAngularDiff = CVarErrorPerAngularDifference->GetFloat() >= 0.0f ? CVarErrorPerAngularDifference->GetFloat() : ErrorCorrection.ErrorPerAngularDifference;
-	
-	static const auto CVarMaxRestoredStateError = IConsoleManager::Get().FindConsoleVariable(TEXT("p.MaxRestoredStateError"));
-	const float MaxRestoredStateError = CVarMaxRestoredStateError->GetFloat() >= 0.0f ? CVarMaxRestoredStateError->GetFloat() : ErrorCorrection.MaxRestoredStateError;
-	
-	static const auto CVarErrorAccumulation = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationSeconds"));
-	const float ErrorAccumulationSeconds = CVarErrorAccumulation->GetFloat() >= 0.0f ? CVarErrorAccumulation->GetFloat() : ErrorCorrection.ErrorAccumulationSeconds;
-	
-	static const auto CVarErrorAccumulationDistanceSq = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationDistanceSq"));
-	const float ErrorAccumulationDistanceSq = CVarErrorAccumulationDistanceSq->GetFloat() >= 0.0f ? CVarErrorAccumulationDistanceSq->GetFloat() : ErrorCorrection.ErrorAccumulationDistanceSq;
-	
-	static const auto CVarErrorAccumulationSimilarity = IConsoleManager::Get().FindConsoleVariable(TEXT("p.ErrorAccumulationSimilarity"));
-	const float ErrorAccumulationSimilarity = CVarErrorAccumulationSimilarity->GetFloat() >= 0.0f ? CVarErrorAccumulationSimilarity->GetFloat() : ErrorCorrection.ErrorAccumulationSimilarity;
-	
-	static const auto CVarLinSet = IConsoleManager::Get().FindConsoleVariable(TEXT("p.PositionLerp"));
-	const float PositionLerp = CVarLinSet->GetFloat() >= 0.0f ? CVarLinSet->GetFloat() : ErrorCorrection.PositionLerp;
-
-	static const auto CVarLinLerp = IConsoleManager::Get().FindConsoleVariable(TEXT("p.LinearVelocityCoefficient"));
-	const float LinearVelocityCoefficient = CVarLinLerp->GetFloat() >= 0.0f ? CVarLinLerp->GetFloat() : ErrorCorrection.LinearVelocityCoefficient;
-
-	static const auto CVarAngSet = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AngleLerp"));
-	const float AngleLerp = CVarAngSet->GetFloat() >= 0.0f ? CVarAngSet->GetFloat() : ErrorCorrection.AngleLerp;
-
-	static const auto CVarAngLerp = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AngularVelocityCoefficient"));
-	const float AngularVelocityCoefficient = CVarAngLerp->GetFloat() >= 0.0f ? CVarAngLerp->GetFloat() : ErrorCorrection.AngularVelocityCoefficient;
-	
-	static const auto CVarMaxLinearHardSnapDistance = IConsoleManager::Get().FindConsoleVariable(TEXT("p.MaxLinearHardSnapDistance"));
-	const float MaxLinearHardSnapDistance = CVarMaxLinearHardSnapDistance->GetFloat() >= 0.f ? CVarMaxLinearHardSnapDistance->GetFloat() : ErrorCorrection.MaxLinearHardSnapDistance;
-
-	// Get Current state
-	FRigidBodyState CurrentState;
-	BI->GetRigidBodyState(CurrentState);
+	FReplicatedPhysicsTarget& PhysicsTarget = *Target.PhysicsTarget;
+	const FRigidBodyState& NewState = PhysicsTarget.TargetState;
+	const FRigidBodyState& CurrentState = Target.CurrentState;
 
 	/////// EXTRAPOLATE APPROXIMATE TARGET VALUES ///////
 
 	// Starting from the last known authoritative position, and
 	// extrapolate an approximation using the last known velocity
 	// and ping.
-	const float PingSeconds = FMath::Clamp(PingSecondsOneWay, 0.f, NetPingLimit);
-	const float ExtrapolationDeltaSeconds = PingSeconds * NetPingExtrapolation;
+	const float PingSeconds = FMath::Clamp(Target.PingSecondsOneWay, 0.f, Settings.NetPingLimit);
+	const float ExtrapolationDeltaSeconds = PingSeconds * Settings.NetPingExtrapolation;
 	const FVector ExtrapolationDeltaPos = NewState.LinVel * ExtrapolationDeltaSeconds;
 	const FVector_NetQuantize100 TargetPos = NewState.Position + ExtrapolationDeltaPos;
 	float NewStateAngVel;
@@ -316,6 +372,9 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 	const FQuat ExtrapolationDeltaQuaternion = FQuat(NewStateAngVelAxis, NewStateAngVel * ExtrapolationDeltaSeconds);
 	FQuat TargetQuat = ExtrapolationDeltaQuaternion * NewState.Quaternion;
 
+	Target.TargetPos = TargetPos;
+	Target.TargetQuat = TargetQuat;
+
 	/////// COMPUTE DIFFERENCES ///////
 
 	FVector LinDiff;
@@ -330,13 +389,14 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 	/////// ACCUMULATE ERROR IF NOT APPROACHING SOLUTION ///////
 
 	// Store sleeping state
-	const bool bShouldSleep = (NewState.Flags & ERigidBodyFlags::Sleeping) != 0;
-	const bool bWasAwake = BI->IsInstanceAwake();
-	const bool bAutoWake = false;
+	Target.bShouldSleep = (NewState.Flags & ERigidBodyFlags::Sleeping) != 0;
+
+	const float Error = (LinDiffSize * Settings.ErrorPerLinearDiff) + (AngDiffSize * Settings.ErrorPerAngularDiff);
+	Target.bRestoredState = Error < Settings.MaxRestoredStateError;
+	Target.bHardSnap = false;
+	Target.bCorrect = false;
 
-	const float Error = (LinDiffSize * ErrorPerLinearDiff) + (AngDiffSize * ErrorPerAngularDiff);
-	bRestoredState = Error < MaxRestoredStateError;
-	if (bRestoredState)
+	if (Target.bRestoredState)
 	{
 		PhysicsTarget.AccumulatedErrorSeconds = 0.0f;
 	}
@@ -374,8 +434,8 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 
 		// If the conditions from the heuristic outlined above are met, accumulate
 		// error. Otherwise, reduce it.
-		if (PrevProgress < ErrorAccumulationDistanceSq &&
-			PrevSimilarity > ErrorAccumulationSimilarity)
+		if (PrevProgress < Settings.ErrorAccumulationDistanceSq &&
+			PrevSimilarity > Settings.ErrorAccumulationSimilarity)
 		{
 			PhysicsTarget.AccumulatedErrorSeconds += DeltaSeconds;
 		}
@@ -385,19 +445,76 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 		}
 
 		// Hard snap if error accumulation or linear error is big enough, and clear the error accumulator.
-		static const auto CVarAlwaysHardSnap = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AlwaysHardSnap"));
-		const bool bHardSnap =
-			LinDiffSize > MaxLinearHardSnapDistance ||
-			PhysicsTarget.AccumulatedErrorSeconds > ErrorAccumulationSeconds ||
-			CVarAlwaysHardSnap->GetInt();
+		Target.bCorrect = true;
+		Target.bHardSnap =
+			LinDiffSize > Settings.MaxLinearHardSnapDistance ||
+			PhysicsTarget.AccumulatedErrorSeconds > Settings.ErrorAccumulationSeconds ||
+			Settings.bAlwaysHardSnap;
 
-		const FTransform IdealWorldTM(TargetQuat, TargetPos);
-
-		if (bHardSnap)
+		if (Target.bHardSnap)
 		{
 			// Too much error so just snap state here and be done with it
 			PhysicsTarget.AccumulatedErrorSeconds = 0.0f;
-			bRestoredState = true;
+			Target.bRestoredState = true;
+		}
+		else
+		{
+			// Small enough error to interpolate, only used in the sync case but it is cheap enough to always fill out
+			Target.NewLinVel = FVector(NewState.LinVel) + (LinDiff * Settings.LinearVelocityCoefficient * DeltaSeconds);
+			Target.NewAngVel = FVector(NewState.AngVel) + (AngDiffAxis * AngDiff * Settings.AngularVelocityCoefficient * DeltaSeconds);
+
+			Target.NewPos = FMath::Lerp(FVector(CurrentState.Position), FVector(TargetPos), Settings.PositionLerp);
+			Target.NewAng = FQuat::Slerp(CurrentState.Quaternion, TargetQuat, Settings.AngleLerp);
+		}
+	}
+
+	PhysicsTarget.PrevPosTarget = TargetPos;
+	PhysicsTarget.PrevPos = FVector(CurrentState.Position);
+}
+
+void FPhysicsReplicationVR::ComputeCorrectionsVR(float DeltaSeconds, const FCorrectionSettingsVR& Settings, TArrayView<FPendingTargetVR> Targets, bool bForceSingleThread)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysRepComputeCorrections);
+
+	const int32 NumTargets = Targets.Num();
+	if (NumTargets < 1)
+		return;
+
+	const int32 ChunkSize = FMath::Max(VRPhysicsReplicationStatics::ParallelChunkSize, 1);
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumTargets, ChunkSize);
+
+	bForceSingleThread |= NumTargets < VRPhysicsReplicationStatics::ParallelMinTargets || NumChunks < 2;
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			const int32 Start = ChunkIndex * ChunkSize;
+			const int32 End = FMath::Min(Start + ChunkSize, NumTargets);
+			for (int32 i = Start; i < End; ++i)
+			{
+				if (Targets[i].bApplyCorrection)
+				{
+					ComputeCorrectionVR(DeltaSeconds, Settings, Targets[i]);
+				}
+			}
+		}, bForceSingleThread);
+}
+
+void FPhysicsReplicationVR::ApplyCorrectionVR(const FCorrectionSettingsVR& Settings, const FPendingTargetVR& Target)
+{
+	if (!Target.bApplyCorrection)
+		return;
+
+	FBodyInstance* BI = Target.BI;
+	FReplicatedPhysicsTarget& PhysicsTarget = *Target.PhysicsTarget;
+	const FRigidBodyState& NewState = PhysicsTarget.TargetState;
+	const bool bAutoWake = false;
+
+	if (Target.bCorrect)
+	{
+		const FTransform IdealWorldTM(Target.TargetQuat, Target.TargetPos);
+
+		if (Target.bHardSnap)
+		{
 			BI->SetBodyTransform(IdealWorldTM, ETeleportType::ResetPhysics, bAutoWake);
 
 			// Set the new velocities
@@ -411,15 +528,9 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 			if (AsyncCallbackServer == nullptr)	//sync case
 #endif
 			{
-				const FVector NewLinVel = FVector(NewState.LinVel) + (LinDiff * LinearVelocityCoefficient * DeltaSeconds);
-				const FVector NewAngVel = FVector(NewState.AngVel) + (AngDiffAxis * AngDiff * AngularVelocityCoefficient * DeltaSeconds);
-
-				const FVector NewPos = FMath::Lerp(FVector(CurrentState.Position), FVector(TargetPos), PositionLerp);
-				const FQuat NewAng = FQuat::Slerp(CurrentState.Quaternion, TargetQuat, AngleLerp);
-
-				BI->SetBodyTransform(FTransform(NewAng, NewPos), ETeleportType::ResetPhysics);
-				BI->SetLinearVelocity(NewLinVel, false);
-				BI->SetAngularVelocityInRadians(FMath::DegreesToRadians(NewAngVel), false);
+				BI->SetBodyTransform(FTransform(Target.NewAng, Target.NewPos), ETeleportType::ResetPhysics);
+				BI->SetLinearVelocity(Target.NewLinVel, false);
+				BI->SetAngularVelocityInRadians(FMath::DegreesToRadians(Target.NewAngVel), false);
 			}
 #if WITH_CHAOS
 			else
@@ -431,7 +542,7 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 				AsyncDesiredState.AngularVelocity = NewState.AngVel;
 				AsyncDesiredState.Proxy = static_cast<FSingleParticlePhysicsProxy*>(BI->GetPhysicsActorHandle());
 				AsyncDesiredState.ObjectState = AsyncDesiredState.Proxy->GetGameThreadAPI().ObjectState();
-				AsyncDesiredState.bShouldSleep = bShouldSleep;
+				AsyncDesiredState.bShouldSleep = Target.bShouldSleep;
 				CurAsyncDataVR->Buffer.Add(AsyncDesiredState);
 			}
 #endif
@@ -445,12 +556,12 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 			PhysicsTarget.ErrorHistory.bAutoAdjustMinMax = false;
 			PhysicsTarget.ErrorHistory.MinValue = 0.0f;
 			PhysicsTarget.ErrorHistory.MaxValue = 1.0f;
-			PhysicsTarget.ErrorHistory.AddSample(PhysicsTarget.AccumulatedErrorSeconds / ErrorAccumulationSeconds);
+			PhysicsTarget.ErrorHistory.AddSample(PhysicsTarget.AccumulatedErrorSeconds / Settings.ErrorAccumulationSeconds);
 			if (UWorld* OwningWorld = GetOwningWorld())
 			{
 				FColor Color = FColor::White;
 				static const auto CVarNetCorrectionLifetime = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetCorrectionLifetime"));
-				DrawDebugDirectionalArrow(OwningWorld, CurrentState.Position, TargetPos, 5.0f, Color, true, CVarNetCorrectionLifetime->GetFloat(), 0, 1.5f);
+				DrawDebugDirectionalArrow(OwningWorld, Target.CurrentState.Position, Target.TargetPos, 5.0f, Color, true, CVarNetCorrectionLifetime->GetFloat(), 0, 1.5f);
 #if 0
 				//todo: do we show this in async mode?
 				DrawDebugFloatHistory(*OwningWorld, PhysicsTarget.ErrorHistory, NewPos + FVector(0.0f, 0.0f, 100.0f), FVector2D(100.0f, 50.0f), FColor::White);
@@ -463,7 +574,7 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 	/////// SLEEP UPDATE ///////
 
 #if WITH_CHAOS
-	if (bShouldSleep)
+	if (Target.bShouldSleep)
 	{
 		// In the async case, we apply sleep state in ApplyAsyncDesiredState
 		if (AsyncCallbackServer == nullptr)
@@ -472,11 +583,55 @@ bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstanc
 		}
 	}
 #endif
+}
 
-	PhysicsTarget.PrevPosTarget = TargetPos;
-	PhysicsTarget.PrevPos = FVector(CurrentState.Position);
+FBodyInstance* FPhysicsReplicationVR::GetCachedBodyInstanceVR(FCachedTargetVR& Cached, UPrimitiveComponent* PrimComp, FName BoneName, bool& bOutIsSkeletal)
+{
+	if (!Cached.bInitialized || Cached.BoneName != BoneName)
+	{
+		Cached.bInitialized = true;
+		Cached.BoneName = BoneName;
+		Cached.BodyIndex = INDEX_NONE;
+		Cached.bIsSkeletal = PrimComp->IsA<USkeletalMeshComponent>();
+	}
 
-	return bRestoredState;
+	bOutIsSkeletal = Cached.bIsSkeletal;
+
+	// Static / shape components just hand back their own body instance, only skeletal meshes do a name lookup
+	if (!Cached.bIsSkeletal)
+	{
+		return PrimComp->GetBodyInstance(BoneName);
+	}
+
+	USkeletalMeshComponent* SkelComp = static_cast<USkeletalMeshComponent*>(PrimComp);
+
+	// Bodies are rebuilt when the physics state is recreated, so check that the cached slot still holds the same bone
+	if (SkelComp->Bodies.IsValidIndex(Cached.BodyIndex))
+	{
+		FBodyInstance* CachedBI = SkelComp->Bodies[Cached.BodyIndex];
+		if (CachedBI && !CachedBI->WeldParent && CachedBI->BodySetup.IsValid() && CachedBI->BodySetup->BoneName == BoneName)
+		{
+			return CachedBI;
+		}
+	}
+
+	FBodyInstance* BI = SkelComp->GetBodyInstance(BoneName);
+	Cached.BodyIndex = BI ? SkelComp->Bodies.IndexOfByKey(BI) : INDEX_NONE;
+	return BI;
+}
+
+bool FPhysicsReplicationVR::HasCachedNetOwningPlayerVR(FCachedTargetVR& Cached, AActor* OwningActor)
+{
+	AActor* Owner = OwningActor->GetOwner();
+
+	if (Cached.NetOwner.IsValid() && Cached.Owner.Get() == Owner)
+	{
+		return true;
+	}
+
+	Cached.Owner = Owner;
+	Cached.NetOwner = OwningActor->GetNetOwningPlayer() ? OwningActor->GetNetOwner() : nullptr;
+	return Cached.NetOwner.IsValid();
 }
 
 void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrimitiveComponent>, FReplicatedPhysicsTarget>& ComponentsToTargets)
@@ -521,93 +676,130 @@ void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrim
 		CurrentTimeSeconds = OwningWorld->GetTimeSeconds();
 	}*/
 
-	for (auto Itr = ComponentsToTargets.CreateIterator(); Itr; ++Itr)
+	static const auto CVarSkipPhysicsReplication = IConsoleManager::Get().FindConsoleVariable(TEXT("p.SkipPhysicsReplication"));
+	const bool bSkipPhysicsReplication = CVarSkipPhysicsReplication->GetInt() != 0;
+
+	static const auto CVarSkipSkeletalRepOptimization = IConsoleManager::Get().FindConsoleVariable(TEXT("p.SkipSkeletalRepOptimization"));
+	const bool bSkipSkeletalRepOptimization = /*PhysicsReplicationCVars::SkipSkeletalRepOptimization*/CVarSkipSkeletalRepOptimization->GetInt() != 0;
+
+	const FCorrectionSettingsVR Settings = FCorrectionSettingsVR::Resolve(PhysicErrorCorrection);
+
+	// Gather pass, everything that touches the components or the owners stays on the game thread
+	// The map isn't added to until the apply pass is done, so the target pointers stay valid
+	PendingTargets.Reset();
 	{
+		SCOPE_CYCLE_COUNTER(STAT_PhysRepGatherTargets);
 
-		// Its been more than half a second since the last update, lets cease using the target as a failsafe
-		// Clients will never update with that much latency, and if they somehow are, then they are dropping so many
-		// packets that it will be useless to use their data anyway
-		/*if ((CurrentTimeSeconds - Itr.Value().ArrivedTimeSeconds) > 0.5f)
+		for (auto Itr = ComponentsToTargets.CreateIterator(); Itr; ++Itr)
 		{
-			OnTargetRestored(Itr.Key().Get(), Itr.Value());
-			Itr.RemoveCurrent();
-		}
-		else */if (UPrimitiveComponent* PrimComp = Itr.Key().Get())
-		{
-			bool bRemoveItr = false;
 
-			if (FBodyInstance* BI = PrimComp->GetBodyInstance(Itr.Value().BoneName))
+			// Its been more than half a second since the last update, lets cease using the target as a failsafe
+			// Clients will never update with that much latency, and if they somehow are, then they are dropping so many
+			// packets that it will be useless to use their data anyway
+			/*if ((CurrentTimeSeconds - Itr.Value().ArrivedTimeSeconds) > 0.5f)
+			{
+				OnTargetRestored(Itr.Key().Get(), Itr.Value());
+				Itr.RemoveCurrent();
+			}
+			else */if (UPrimitiveComponent* PrimComp = Itr.Key().Get())
 			{
-				FReplicatedPhysicsTarget& PhysicsTarget = Itr.Value();
-				FRigidBodyState& UpdatedState = PhysicsTarget.TargetState;
-				bool bUpdated = false;
-				if (AActor* OwningActor = PrimComp->GetOwner())
+				FCachedTargetVR& Cached = CachedTargets.FindOrAdd(Itr.Key());
+				bool bIsSkeletal = false;
+				if (FBodyInstance* BI = GetCachedBodyInstanceVR(Cached, PrimComp, Itr.Value().BoneName, bIsSkeletal))
 				{
-
-					// Remove if there is no owner
-					if (!OwningActor->GetNetOwningPlayer())
+					FReplicatedPhysicsTarget& PhysicsTarget = Itr.Value();
+					if (AActor* OwningActor = PrimComp->GetOwner())
 					{
-						bRemoveItr = true;
-					}
-					else
-					{
-						// Removed as this is server sided
-						/*const ENetRole OwnerRole = OwningActor->GetLocalRole();
-						const bool bIsSimulated = OwnerRole == ROLE_SimulatedProxy;
-						const bool bIsReplicatedAutonomous = OwnerRole == ROLE_AutonomousProxy && PrimComp->bReplicatePhysicsToAutonomousProxy;
-						if (bIsSimulated || bIsReplicatedAutonomous)*/
-
-
+						// Remove if there is no owner
+						if (!HasCachedNetOwningPlayerVR(Cached, OwningActor))
+						{
+							OnTargetRestored(PrimComp, PhysicsTarget);
+							CachedTargets.Remove(Itr.Key());
+							Itr.RemoveCurrent();
+						}
 						// Deleted everything here, we will always be the server, I already filtered out clients to default logic
+						else if (PhysicsTarget.TargetState.Flags & ERigidBodyFlags::NeedsUpdate)
 						{
-							/*const*/ float OwnerPing = 0.0f;// GetOwnerPing(OwningActor, PhysicsTarget);
-
-							/*if (UPlayer* OwningPlayer = OwningActor->GetNetOwningPlayer())
-							{
-								if (APlayerController* PlayerController = OwningPlayer->GetPlayerController(nullptr))
-								{
-									if (APlayerState* PlayerState = PlayerController->PlayerState)
-									{
-										OwnerPing = PlayerState->ExactPing;
-									}
-								}
-							}*/
-
 							// Get the total ping - this approximates the time since the update was
 							// actually generated on the machine that is doing the authoritative sim.
 							// NOTE: We divide by 2 to approximate 1-way ping from 2-way ping.
 							const float PingSecondsOneWay = 0.0f;// (LocalPing + OwnerPing) * 0.5f * 0.001f;
 
+							FPendingTargetVR& PendingTarget = PendingTargets.AddDefaulted_GetRef();
+							PendingTarget.Key = Itr.Key();
+							PendingTarget.PrimComp = PrimComp;
+							PendingTarget.BI = BI;
+							PendingTarget.PhysicsTarget = &PhysicsTarget;
+							PendingTarget.bSyncComponent = !bSkipSkeletalRepOptimization || !bIsSkeletal; //simulated skeletal mesh does its own polling of physics results so we don't need to call this as it'll happen at the end of the physics sim
 
-							if (UpdatedState.Flags & ERigidBodyFlags::NeedsUpdate)
+							// Mirrors the early outs in ApplyRigidBodyState, skipped or non simulating bodies are left alone but still synced
+							if (!bSkipPhysicsReplication && BI->IsInstanceSimulatingPhysics())
 							{
-								const bool bRestoredState = ApplyRigidBodyState(DeltaSeconds, BI, PhysicsTarget, PhysicErrorCorrection, PingSecondsOneWay);
-
-								// Need to update the component to match new position.
-								static const auto CVarSkipSkeletalRepOptimization = IConsoleManager::Get().FindConsoleVariable(TEXT("p.SkipSkeletalRepOptimization"));
-								if (/*PhysicsReplicationCVars::SkipSkeletalRepOptimization*/CVarSkipSkeletalRepOptimization->GetInt() == 0 || Cast<USkeletalMeshComponent>(PrimComp) == nullptr)	//simulated skeletal mesh does its own polling of physics results so we don't need to call this as it'll happen at the end of the physics sim
+								if (!PrepareTargetVR(BI, PhysicsTarget, PingSecondsOneWay, PendingTarget))
 								{
-									PrimComp->SyncComponentToRBPhysics();
-								}
-
-								// Added a sleeping check from the input state as well, we always want to cease activity on sleep
-								if (bRestoredState || ((UpdatedState.Flags & ERigidBodyFlags::Sleeping) != 0))
-								{
-									bRemoveItr = true;
+									PendingTarget.bRestoredState = true;
 								}
 							}
 						}
 					}
 				}
 			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_PhysRepTargetsProcessed, PendingTargets.Num());
+
+	// Error and correction math over the packed targets
+	ComputeCorrectionsVR(DeltaSeconds, Settings, PendingTargets);
+
+	// Apply pass, writes to the bodies and pushes the async desired states in one batch
+	{
+		SCOPE_CYCLE_COUNTER(STAT_PhysRepApplyCorrections);
+
+#if WITH_CHAOS
+		if (CurAsyncDataVR)
+		{
+			CurAsyncDataVR->Buffer.Reserve(CurAsyncDataVR->Buffer.Num() + PendingTargets.Num());
+		}
+#endif
+
+		for (const FPendingTargetVR& PendingTarget : PendingTargets)
+		{
+			ApplyCorrectionVR(Settings, PendingTarget);
+
+			// Need to update the component to match new position.
+			if (PendingTarget.bSyncComponent)
+			{
+				PendingTarget.PrimComp->SyncComponentToRBPhysics();
+			}
+		}
 
-			if (bRemoveItr)
+		for (const FPendingTargetVR& PendingTarget : PendingTargets)
+		{
+			// Added a sleeping check from the input state as well, we always want to cease activity on sleep
+			if (PendingTarget.bRestoredState || ((PendingTarget.PhysicsTarget->TargetState.Flags & ERigidBodyFlags::Sleeping) != 0))
 			{
-				OnTargetRestored(Itr.Key().Get(), Itr.Value());
-				Itr.RemoveCurrent();
+				OnTargetRestored(PendingTarget.PrimComp, *PendingTarget.PhysicsTarget);
+				CachedTargets.Remove(PendingTarget.Key);
+				ComponentsToTargets.Remove(PendingTarget.Key);
 			}
 		}
 	}
+
+	PendingTargets.Reset();
+
+	// Drop cached lookups for targets that were removed outside of this tick
+	if (CachedTargets.Num() > ComponentsToTargets.Num())
+	{
+		for (auto CacheItr = CachedTargets.CreateIterator(); CacheItr; ++CacheItr)
+		{
+			if (!ComponentsToTargets.Contains(CacheItr.Key()))
+			{
+				CacheItr.RemoveCurrent();
+			}
+		}
+	}
+
 #if WITH_CHAOS
 	CurAsyncDataVR = nullptr;
 #endif
@@ -617,8 +809,79 @@ void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrim
 }
 
 #if PHYSICS_INTERFACE_PHYSX
-void FContactModifyCallbackVR::onContactModify(PxContactModifyPair* const pairs, PxU32 count)
+void FContactModifyIgnoreSetVR::AddPair(const FContactModBodyInstancePair& Pair)
 {
+	FContactModIgnoreKey Key = MakeKey(Pair);
+	if (!ContactsToIgnore.Contains(Key))
+	{
+		ContactsToIgnore.Add(Key, Pair);
+		bSnapshotDirty = true;
+	}
+}
+
+void FContactModifyIgnoreSetVR::RemovePair(const FContactModBodyInstancePair& Pair)
+{
+	if (ContactsToIgnore.Remove(MakeKey(Pair)) > 0)
+	{
+		bSnapshotDirty = true;
+	}
+}
+
+void FContactModifyIgnoreSetVR::RemovePairsForPrimitive(const UPrimitiveComponent* Prim)
+{
+	for (auto Itr = ContactsToIgnore.CreateIterator(); Itr; ++Itr)
+	{
+		if (Itr.Value().Prim1 == Prim || Itr.Value().Prim2 == Prim)
+		{
+			Itr.RemoveCurrent();
+			bSnapshotDirty = true;
+		}
+	}
+}
+
+void FContactModifyIgnoreSetVR::RemoveInvalidPairs()
+{
+	for (auto Itr = ContactsToIgnore.CreateIterator(); Itr; ++Itr)
+	{
+		const FContactModBodyInstancePair& Pair = Itr.Value();
+		if (
+			(!Pair.Prim1.IsValid() || !Pair.Prim2.IsValid()) ||
+			(!Pair.Actor1.IsValid() || !FPhysicsInterface::IsValid(Pair.Actor1)) ||
+			(!Pair.Actor2.IsValid() || !FPhysicsInterface::IsValid(Pair.Actor2))
+			)
+		{
+			Itr.RemoveCurrent();
+			bSnapshotDirty = true;
+		}
+	}
+}
+
+void FContactModifyIgnoreSetVR::PublishSnapshot()
+{
+	if (!bSnapshotDirty)
+		return;
+
+	// Fill the inactive buffer, nothing is reading it as the previous step has already been fetched
+	const int32 BackIndex = 1 - ActiveSnapshot.Load();
+	TSet<FContactModIgnoreKey>& BackBuffer = Snapshots[BackIndex];
+
+	BackBuffer.Reset();
+	BackBuffer.Reserve(ContactsToIgnore.Num());
+	for (const TPair<FContactModIgnoreKey, FContactModBodyInstancePair>& KeyPair : ContactsToIgnore)
+	{
+		BackBuffer.Add(KeyPair.Key);
+	}
+
+	ActiveSnapshot.Store(BackIndex);
+	bSnapshotDirty = false;
+}
+
+// Shared between the discrete and ccd callbacks, they only differ in their base class
+static void ModifyIgnoredContactsVR(const FContactModifyIgnoreSetVR& ContactsToIgnore, PxContactModifyPair* const pairs, PxU32 count)
+{
+	uint32 NumTested = 0;
+	uint32 NumIgnored = 0;
+
 	for (uint32 PairIdx = 0; PairIdx < count; PairIdx++)
 	{
 		const PxActor* PActor0 = pairs[PairIdx].actor[0];
@@ -639,11 +902,12 @@ void FContactModifyCallbackVR::onContactModify(PxContactModifyPair* const pairs,
 
 		if (BodyInst0->bContactModification && BodyInst1->bContactModification)
 		{
-			FRWScopeLock(RWAccessLock, FRWScopeLockType::SLT_ReadOnly);
+			++NumTested;
 
-			const FContactModBodyInstancePair* prop = ContactsToIgnore.FindByPredicate([&](const FContactModBodyInstancePair& it) {return (it.Actor1.SyncActor == PRigidBody0 && it.Actor2.SyncActor == PRigidBody1) || (it.Actor2.SyncActor == PRigidBody0 && it.Actor1.SyncActor == PRigidBody1);  });
-			if (prop)
+			if (ContactsToIgnore.ShouldIgnore(PRigidBody0, PRigidBody1))
 			{
+				++NumIgnored;
+
 				for (uint32 ContactPt = 0; ContactPt < pairs[PairIdx].contacts.size(); ContactPt++)
 				{
 					pairs[PairIdx].contacts.ignore(ContactPt);
@@ -651,43 +915,19 @@ void FContactModifyCallbackVR::onContactModify(PxContactModifyPair* const pairs,
 			}
 		}
 	}
+
+	INC_DWORD_STAT_BY(STAT_ContactModPairsTested, NumTested);
+	INC_DWORD_STAT_BY(STAT_ContactModPairsIgnored, NumIgnored);
+}
+
+void FContactModifyCallbackVR::onContactModify(PxContactModifyPair* const pairs, PxU32 count)
+{
+	ModifyIgnoredContactsVR(ContactsToIgnore, pairs, count);
 }
 
 void FCCDContactModifyCallbackVR::onCCDContactModify(PxContactModifyPair* const pairs, PxU32 count)
 {
-	for (uint32 PairIdx = 0; PairIdx < count; PairIdx++)
-	{
-		const PxActor* PActor0 = pairs[PairIdx].actor[0];
-		const PxActor* PActor1 = pairs[PairIdx].actor[1];
-		check(PActor0 && PActor1);
-
-		const PxRigidBody* PRigidBody0 = PActor0->is<PxRigidBody>();
-		const PxRigidBody* PRigidBody1 = PActor1->is<PxRigidBody>();
-
-		//physx::PxRigidActor* SyncActor;
-
-		const FBodyInstance* BodyInst0 = FPhysxUserData::Get<FBodyInstance>(PActor0->userData);
-		const FBodyInstance* BodyInst1 = FPhysxUserData::Get<FBodyInstance>(PActor1->userData);
-
-		if (BodyInst0 == nullptr || BodyInst1 == nullptr)
-		{
-			continue;
-		}
-
-		if (BodyInst0->bContactModification && BodyInst1->bContactModification)
-		{
-			FRWScopeLock(RWAccessLock, FRWScopeLockType::SLT_ReadOnly);
-
-			const FContactModBodyInstancePair* prop = ContactsToIgnore.FindByPredicate([&](const FContactModBodyInstancePair& it) {return (it.Actor1.SyncActor == PRigidBody0 && it.Actor2.SyncActor == PRigidBody1) || (it.Actor2.SyncActor == PRigidBody0 && it.Actor1.SyncActor == PRigidBody1);  });
-			if (prop)
-			{
-				for (uint32 ContactPt = 0; ContactPt < pairs[PairIdx].contacts.size(); ContactPt++)
-				{
-					pairs[PairIdx].contacts.ignore(ContactPt);
-				}
-			}
-		}
-	}
+	ModifyIgnoredContactsVR(ContactsToIgnore, pairs, count);
 }
 #endif
 
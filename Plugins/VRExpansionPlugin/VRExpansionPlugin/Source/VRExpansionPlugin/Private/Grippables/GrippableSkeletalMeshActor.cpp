@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Grippables/GrippableSkeletalMeshActor.h"
+#include "GripMotionControllerComponent.h"
 #include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
 #include "PhysicsReplication.h"
@@ -240,6 +241,11 @@ bool AGrippableSkeletalMeshActor::ReplicateSubobjects(UActorChannel* Channel, cl
 	return WroteSomething;
 }
 
+void AGrippableSkeletalMeshActor::OnRep_GripLogicScripts()
+{
+	UGripMotionControllerComponent::NotifyGripScriptsChangedOnAllControllers(this);
+}
+
 /*void AGrippableSkeletalMeshActor::GetLifetimeReplicatedProps(TArray< class FLifetimeProperty > & OutLifetimeProps) const
 {
 	DOREPLIFETIME(AGrippableSkeletalMeshActor, VRGripInterfaceSettings);
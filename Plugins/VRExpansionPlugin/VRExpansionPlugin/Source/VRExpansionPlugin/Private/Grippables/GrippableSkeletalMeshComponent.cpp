@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Grippables/GrippableSkeletalMeshComponent.h"
+#include "GripMotionControllerComponent.h"
 #include "Net/UnrealNetwork.h"
 
   //=============================================================================
@@ -68,6 +69,11 @@ bool UGrippableSkeletalMeshComponent::ReplicateSubobjects(UActorChannel* Channel
 	return WroteSomething;
 }
 
+void UGrippableSkeletalMeshComponent::OnRep_GripLogicScripts()
+{
+	UGripMotionControllerComponent::NotifyGripScriptsChangedOnAllControllers(this);
+}
+
 //=============================================================================
 UGrippableSkeletalMeshComponent::~UGrippableSkeletalMeshComponent()
 {
@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Grippables/GrippableSphereComponent.h"
+#include "GripMotionControllerComponent.h"
 #include "Net/UnrealNetwork.h"
 
   //=============================================================================
@@ -67,6 +68,11 @@ bool UGrippableSphereComponent::ReplicateSubobjects(UActorChannel* Channel, clas
 	return WroteSomething;
 }
 
+void UGrippableSphereComponent::OnRep_GripLogicScripts()
+{
+	UGripMotionControllerComponent::NotifyGripScriptsChangedOnAllControllers(this);
+}
+
 //=============================================================================
 UGrippableSphereComponent::~UGrippableSphereComponent()
 {
@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Grippables/GrippableStaticMeshActor.h"
+#include "GripMotionControllerComponent.h"
 #include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
 #include "PhysicsReplication.h"
@@ -266,6 +267,11 @@ bool AGrippableStaticMeshActor::ReplicateSubobjects(UActorChannel* Channel, clas
 	return WroteSomething;
 }
 
+void AGrippableStaticMeshActor::OnRep_GripLogicScripts()
+{
+	UGripMotionControllerComponent::NotifyGripScriptsChangedOnAllControllers(this);
+}
+
 //=============================================================================
 AGrippableStaticMeshActor::~AGrippableStaticMeshActor()
 {
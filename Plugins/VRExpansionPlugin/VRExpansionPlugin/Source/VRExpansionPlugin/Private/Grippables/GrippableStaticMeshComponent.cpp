@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Grippables/GrippableStaticMeshComponent.h"
+#include "GripMotionControllerComponent.h"
 #include "Net/UnrealNetwork.h"
 
   //=============================================================================
@@ -68,6 +69,11 @@ bool UGrippableStaticMeshComponent::ReplicateSubobjects(UActorChannel* Channel,
 	return WroteSomething;
 }
 
+void UGrippableStaticMeshComponent::OnRep_GripLogicScripts()
+{
+	UGripMotionControllerComponent::NotifyGripScriptsChangedOnAllControllers(this);
+}
+
 //=============================================================================
 UGrippableStaticMeshComponent::~UGrippableStaticMeshComponent()
 {
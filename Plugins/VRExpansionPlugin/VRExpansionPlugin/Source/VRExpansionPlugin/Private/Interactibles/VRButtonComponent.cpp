@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Interactibles/VRButtonComponent.h"
+#include "Misc/VRInteractibleUpdateSubsystem.h"
 #include "GameFramework/Character.h"
 
   //=============================================================================
@@ -62,10 +63,17 @@ void UVRButtonComponent::PreReplication(IRepChangedPropertyTracker & ChangedProp
 
 void UVRButtonComponent::OnRegister()
 {
+	UVRInteractibleUpdateSubsystem::RegisterInteractible(this);
 	Super::OnRegister();
 	ResetInitialButtonLocation();
 }
 
+void UVRButtonComponent::OnUnregister()
+{
+	UVRInteractibleUpdateSubsystem::UnregisterInteractible(this);
+	Super::OnUnregister();
+}
+
 void UVRButtonComponent::BeginPlay()
 {
 	// Call the base class 
@@ -133,7 +141,7 @@ void UVRButtonComponent::TickComponent(float DeltaTime, enum ELevelTick TickType
 		// Std precision tolerance should be fine
 		if (this->GetRelativeLocation().Equals(GetTargetRelativeLocation()))
 		{
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 
 			OnButtonEndInteraction.Broadcast(LocalLastInteractingActor.Get(), LocalLastInteractingComponent.Get());
 			ReceiveButtonEndInteraction(LocalLastInteractingActor.Get(), LocalLastInteractingComponent.Get());
@@ -288,7 +296,7 @@ void UVRButtonComponent::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AAc
 		InitialComponentLoc = OriginalBaseTransform.InverseTransformPosition(this->GetComponentLocation());
 		bToggledThisTouch = false;
 
-		this->SetComponentTickEnabled(true);
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, true);
 
 		if (LocalInteractingComponent != LocalLastInteractingComponent.Get())
 		{
@@ -344,7 +352,7 @@ void UVRButtonComponent::SetButtonToRestingPosition(bool bLerpToPosition)
 			this->SetRelativeLocation(InitialRelativeTransform.TransformPosition(SetAxisValue(NewDepth)), false);
 		}
 		else
-			this->SetComponentTickEnabled(true); // This will trigger the lerp to resting position
+			UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, true); // This will trigger the lerp to resting position
 
 	}break;
 	default:break;
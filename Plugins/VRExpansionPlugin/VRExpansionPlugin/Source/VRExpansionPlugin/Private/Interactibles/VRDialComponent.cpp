@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Interactibles/VRDialComponent.h"
+#include "Misc/VRInteractibleUpdateSubsystem.h"
 #include "VRExpansionFunctionLibrary.h"
 #include "Net/UnrealNetwork.h"
 
@@ -82,10 +83,17 @@ void UVRDialComponent::PreReplication(IRepChangedPropertyTracker & ChangedProper
 
 void UVRDialComponent::OnRegister()
 {
+	UVRInteractibleUpdateSubsystem::RegisterInteractible(this);
 	Super::OnRegister();
 	ResetInitialDialLocation(); // Load the original dial location
 }
 
+void UVRDialComponent::OnUnregister()
+{
+	UVRInteractibleUpdateSubsystem::UnregisterInteractible(this);
+	Super::OnUnregister();
+}
+
 void UVRDialComponent::BeginPlay()
 {
 	// Call the base class 
@@ -114,7 +122,7 @@ void UVRDialComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 
 		if (CurRotBackEnd == 0.f)
 		{
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 			bIsLerping = false;
 			OnDialFinishedLerping.Broadcast();
 			ReceiveDialFinishedLerping();
@@ -122,7 +130,7 @@ void UVRDialComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 	}
 	else
 	{
-		this->SetComponentTickEnabled(false); 
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false); 
 	}
 }
 
@@ -269,10 +277,10 @@ void UVRDialComponent::OnGripRelease_Implementation(UGripMotionControllerCompone
 	if (bLerpBackOnRelease)
 	{
 		bIsLerping = true;
-		this->SetComponentTickEnabled(true);
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, true);
 	}
 	else
-		this->SetComponentTickEnabled(false);
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 
 	//OnDropped.Broadcast(ReleasingController, GripInformation, bWasSocketed);
 }
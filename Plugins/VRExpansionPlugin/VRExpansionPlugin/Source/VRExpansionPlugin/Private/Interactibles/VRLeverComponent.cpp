@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Interactibles/VRLeverComponent.h"
+#include "Misc/VRInteractibleUpdateSubsystem.h"
 #include "Net/UnrealNetwork.h"
 
   //=============================================================================
@@ -109,6 +110,7 @@ void UVRLeverComponent::PreReplication(IRepChangedPropertyTracker & ChangedPrope
 
 void UVRLeverComponent::OnRegister()
 {
+	UVRInteractibleUpdateSubsystem::RegisterInteractible(this);
 	Super::OnRegister();
 	ResetInitialLeverLocation(); // Load the original lever location
 }
@@ -164,7 +166,7 @@ void UVRLeverComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 
 			if (LerpedQuat.IsIdentity())
 			{
-				this->SetComponentTickEnabled(false);
+				UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 				bIsLerping = false;
 				bReplicateMovement = bOriginalReplicatesMovement;
 				this->SetRelativeRotation(InitialRelativeTransform.Rotator());
@@ -236,6 +238,7 @@ void UVRLeverComponent::ProccessCurrentState(bool bWasLerping, bool bThrowEvents
 
 void UVRLeverComponent::OnUnregister()
 {
+	UVRInteractibleUpdateSubsystem::UnregisterInteractible(this);
 	DestroyConstraint();
 	Super::OnUnregister();
 }
@@ -433,7 +436,7 @@ void UVRLeverComponent::OnGrip_Implementation(UGripMotionControllerComponent * G
 	bIsInFirstTick = true;
 	MomentumAtDrop = 0.0f;
 
-	this->SetComponentTickEnabled(true);
+	UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, true);
 
 	//OnGripped.Broadcast(GrippingController, GripInformation);
 }
@@ -450,13 +453,13 @@ void UVRLeverComponent::OnGripRelease_Implementation(UGripMotionControllerCompon
 	if (LeverReturnTypeWhenReleased != EVRInteractibleLeverReturnType::Stay)
 	{		
 		bIsLerping = true;
-		this->SetComponentTickEnabled(true);
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, true);
 		if (MovementReplicationSetting != EGripMovementReplicationSettings::ForceServerSideMovement)
 			bReplicateMovement = false;
 	}
 	else
 	{
-		this->SetComponentTickEnabled(false);
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 		bReplicateMovement = bOriginalReplicatesMovement;
 	}
 
@@ -913,7 +916,7 @@ void UVRLeverComponent::LerpAxis(float CurrentAngle, float DeltaTime)
 		if (FMath::IsNearlyZero(MomentumAtDrop * DeltaTime, 0.1f))
 		{
 			MomentumAtDrop = 0.0f;
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 			bIsLerping = false;
 			bReplicateMovement = bOriginalReplicatesMovement;
 			return;
@@ -949,7 +952,7 @@ void UVRLeverComponent::LerpAxis(float CurrentAngle, float DeltaTime)
 		}
 		else
 		{
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 			bIsLerping = false;
 			bReplicateMovement = bOriginalReplicatesMovement;
 			FTransform CalcTransform = (FTransform(UVRInteractibleFunctionLibrary::SetAxisValueRot((EVRInteractibleAxis)LeverRotationAxis, TargetAngle, FRotator::ZeroRotator)) * InitialRelativeTransform);
@@ -1,6 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Interactibles/VRSliderComponent.h"
+#include "Misc/VRInteractibleUpdateSubsystem.h"
 #include "VRExpansionFunctionLibrary.h"
 #include "Net/UnrealNetwork.h"
 
@@ -107,6 +108,7 @@ void UVRSliderComponent::PreReplication(IRepChangedPropertyTracker & ChangedProp
 
 void UVRSliderComponent::OnRegister()
 {
+	UVRInteractibleUpdateSubsystem::RegisterInteractible(this);
 	Super::OnRegister();
 
 	// Init the slider settings
@@ -120,6 +122,12 @@ void UVRSliderComponent::OnRegister()
 	}
 }
 
+void UVRSliderComponent::OnUnregister()
+{
+	UVRInteractibleUpdateSubsystem::UnregisterInteractible(this);
+	Super::OnUnregister();
+}
+
 void UVRSliderComponent::BeginPlay()
 {
 	// Call the base class 
@@ -157,7 +165,7 @@ void UVRSliderComponent::TickComponent(float DeltaTime, enum ELevelTick TickType
 		OnSliderFinishedLerping.Broadcast(CurrentSliderProgress);
 		ReceiveSliderFinishedLerping(CurrentSliderProgress);
 
-		this->SetComponentTickEnabled(false);
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 		bReplicateMovement = bOriginalReplicatesMovement;
 
 		return;
@@ -256,7 +264,7 @@ void UVRSliderComponent::TickComponent(float DeltaTime, enum ELevelTick TickType
 			OnSliderFinishedLerping.Broadcast(CurrentSliderProgress);
 			ReceiveSliderFinishedLerping(CurrentSliderProgress);
 
-			this->SetComponentTickEnabled(false);
+			UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 			bReplicateMovement = bOriginalReplicatesMovement;
 		}
 		
@@ -295,7 +303,7 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 	if (SplineComponentToFollow != nullptr)
 	{
 		FVector WorldCalculatedLocation = CurrentRelativeTransform.TransformPosition(CalculatedLocation);
-		float ClosestKey = SplineComponentToFollow->FindInputKeyClosestToWorldLocation(WorldCalculatedLocation);
+		float ClosestKey = FindSplineInputKeyClosestToWorldLocation(WorldCalculatedLocation);
 
 		if (bSliderUsesSnapPoints)
 		{
@@ -304,11 +312,9 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 
 			SplineProgress = UVRInteractibleFunctionLibrary::Interactible_GetThresholdSnappedValue(SplineProgress, SnapIncrement, SnapThreshold);
 
-			const int32 NumPoints = SplineComponentToFollow->SplineCurves.Position.Points.Num();
-
 			if (SplineComponentToFollow->SplineCurves.Position.Points.Num() > 1)
 			{
-				ClosestKey = SplineComponentToFollow->SplineCurves.ReparamTable.Eval(SplineProgress * SplineLength, 0.0f);
+				ClosestKey = GetSplineInputKeyAtDistance(SplineProgress * SplineLength);
 			}
 
 			WorldCalculatedLocation = SplineComponentToFollow->GetLocationAtSplineInputKey(ClosestKey, ESplineCoordinateSpace::World);
@@ -340,7 +346,8 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 			}
 			else if (bLerpToNewKey)
 			{
-				trans = SplineComponentToFollow->FindTransformClosestToWorldLocation(WorldCalculatedLocation, ESplineCoordinateSpace::World, true);
+				// ClosestKey is already the closest key to WorldCalculatedLocation, no need to search again
+				trans = SplineComponentToFollow->GetTransformAtSplineInputKey(ClosestKey, ESplineCoordinateSpace::World, true);
 				bChangedLocation = true;
 			}
 
@@ -362,7 +369,7 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 			}
 			else if (bLerpToNewKey)
 			{
-				WorldLocation = SplineComponentToFollow->FindLocationClosestToWorldLocation(WorldCalculatedLocation, ESplineCoordinateSpace::World);
+				WorldLocation = SplineComponentToFollow->GetLocationAtSplineInputKey(ClosestKey, ESplineCoordinateSpace::World);
 				bChangedLocation = true;
 			}
 
@@ -503,7 +510,7 @@ void UVRSliderComponent::OnGrip_Implementation(UGripMotionControllerComponent *
 	}
 
 	if (bUpdateInTick)
-		SetComponentTickEnabled(true);
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, true);
 
 	//OnGripped.Broadcast(GrippingController, GripInformation);
 
@@ -516,7 +523,7 @@ void UVRSliderComponent::OnGripRelease_Implementation(UGripMotionControllerCompo
 	if (SliderBehaviorWhenReleased != EVRInteractibleSliderDropBehavior::Stay)
 	{
 		bIsLerping = true;
-		this->SetComponentTickEnabled(true);
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, true);
 
 		FVector Len = (MinSlideDistance.GetAbs() + MaxSlideDistance.GetAbs());
 		if(bSlideDistanceIsInParentSpace)
@@ -537,7 +544,7 @@ void UVRSliderComponent::OnGripRelease_Implementation(UGripMotionControllerCompo
 	}
 	else
 	{
-		this->SetComponentTickEnabled(false);
+		UVRInteractibleUpdateSubsystem::SetInteractibleAwake(this, false);
 		bReplicateMovement = bOriginalReplicatesMovement;
 	}
 
@@ -782,7 +789,7 @@ float UVRSliderComponent::GetCurrentSliderProgress(FVector CurLocation, bool bUs
 		float ClosestKey = CurKey;
 
 		if (!bUseKeyInstead)
-			ClosestKey = SplineComponentToFollow->FindInputKeyClosestToWorldLocation(CurLocation);
+			ClosestKey = FindSplineInputKeyClosestToWorldLocation(CurLocation);
 
 		/*int32 primaryKey = FMath::TruncToInt(ClosestKey);
 
@@ -822,6 +829,194 @@ float UVRSliderComponent::GetCurrentSliderProgress(FVector CurLocation, bool bUs
 	return Progress;
 }
 
+bool FVRSplineArcLengthTable::IsValidFor(const USplineComponent* InSpline) const
+{
+	return InSpline && Spline.Get() == InSpline &&
+		SplineVersion == InSpline->SplineCurves.Version &&
+		NumSplinePoints == InSpline->SplineCurves.Position.Points.Num() &&
+		bClosedLoop == InSpline->IsClosedLoop();
+}
+
+void FVRSplineArcLengthTable::Reset()
+{
+	Positions.Reset();
+	Keys.Reset();
+	ChunkCenters.Reset();
+	ChunkRadii.Reset();
+	SplineLength = 0.f;
+	Spline.Reset();
+	SplineVersion = 0;
+	NumSplinePoints = 0;
+	bClosedLoop = false;
+}
+
+void FVRSplineArcLengthTable::Build(const USplineComponent* InSpline)
+{
+	Reset();
+
+	if (!InSpline)
+		return;
+
+	Spline = InSpline;
+	SplineVersion = InSpline->SplineCurves.Version;
+	NumSplinePoints = InSpline->SplineCurves.Position.Points.Num();
+	bClosedLoop = InSpline->IsClosedLoop();
+	SplineLength = InSpline->GetSplineLength();
+
+	const int32 NumSegments = bClosedLoop ? NumSplinePoints : NumSplinePoints - 1;
+	const TArray<FInterpCurvePoint<float>>& ReparamPoints = InSpline->SplineCurves.ReparamTable.Points;
+
+	// Degenerate splines are left empty and the queries fall back to the spline itself
+	if (NumSegments < 1 || SplineLength <= KINDA_SMALL_NUMBER || ReparamPoints.Num() < 2)
+		return;
+
+	// Sampled at the reparam knots, the keys there are exact and the spacing is the splines own ReparamStepsPerSegment
+	const int32 NumSamples = ReparamPoints.Num();
+
+	Positions.SetNumUninitialized(NumSamples);
+	Keys.SetNumUninitialized(NumSamples);
+
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		Keys[i] = ReparamPoints[i].OutVal;
+		Positions[i] = InSpline->GetLocationAtSplineInputKey(Keys[i], ESplineCoordinateSpace::Local);
+	}
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumSamples, SamplesPerChunk);
+	ChunkCenters.SetNumUninitialized(NumChunks);
+	ChunkRadii.SetNumUninitialized(NumChunks);
+
+	for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+	{
+		const int32 Start = Chunk * SamplesPerChunk;
+		const int32 End = FMath::Min(Start + SamplesPerChunk, NumSamples);
+
+		FBox Bounds(ForceInit);
+		for (int32 i = Start; i < End; ++i)
+		{
+			Bounds += Positions[i];
+		}
+
+		const FVector Center = Bounds.GetCenter();
+		float RadiusSq = 0.f;
+		for (int32 i = Start; i < End; ++i)
+		{
+			RadiusSq = FMath::Max(RadiusSq, FVector::DistSquared(Center, Positions[i]));
+		}
+
+		ChunkCenters[Chunk] = Center;
+		ChunkRadii[Chunk] = FMath::Sqrt(RadiusSq);
+	}
+}
+
+float FVRSplineArcLengthTable::FindInputKeyClosestToLocalLocation(const USplineComponent* InSpline, const FVector& LocalLocation) const
+{
+	if (Keys.Num() < 2)
+	{
+		float Dummy;
+		return InSpline->SplineCurves.Position.InaccurateFindNearest(LocalLocation, Dummy);
+	}
+
+	// Seed with the chunk whose center is closest, then only visit chunks whose bounding sphere could hold a closer sample
+	int32 SeedChunk = 0;
+	float SeedDistSq = MAX_flt;
+	for (int32 Chunk = 0; Chunk < ChunkCenters.Num(); ++Chunk)
+	{
+		const float DistSq = FVector::DistSquared(LocalLocation, ChunkCenters[Chunk]);
+		if (DistSq < SeedDistSq)
+		{
+			SeedDistSq = DistSq;
+			SeedChunk = Chunk;
+		}
+	}
+
+	int32 BestSample = 0;
+	float BestDistSq = MAX_flt;
+
+	auto ScanChunk = [&](int32 Chunk)
+	{
+		const int32 Start = Chunk * SamplesPerChunk;
+		const int32 End = FMath::Min(Start + SamplesPerChunk, Positions.Num());
+		for (int32 i = Start; i < End; ++i)
+		{
+			const float DistSq = FVector::DistSquared(LocalLocation, Positions[i]);
+			if (DistSq < BestDistSq)
+			{
+				BestDistSq = DistSq;
+				BestSample = i;
+			}
+		}
+	};
+
+	ScanChunk(SeedChunk);
+
+	for (int32 Chunk = 0; Chunk < ChunkCenters.Num(); ++Chunk)
+	{
+		if (Chunk == SeedChunk)
+			continue;
+
+		const float LowerBound = FMath::Max(0.f, FVector::Dist(LocalLocation, ChunkCenters[Chunk]) - ChunkRadii[Chunk]);
+		if (LowerBound * LowerBound < BestDistSq)
+		{
+			ScanChunk(Chunk);
+		}
+	}
+
+	// Refine on the segment holding the closest sample and its neighbors with the same search the spline uses on every segment
+	const int32 NumSegments = bClosedLoop ? NumSplinePoints : NumSplinePoints - 1;
+	const int32 Segment = FMath::Clamp(FMath::FloorToInt(Keys[BestSample]), 0, NumSegments - 1);
+
+	float BestKey = Keys[BestSample];
+	float BestSegmentDistSq = MAX_flt;
+
+	for (int32 Offset = -1; Offset <= 1; ++Offset)
+	{
+		int32 SegmentToTest = Segment + Offset;
+
+		if (bClosedLoop)
+		{
+			SegmentToTest = (SegmentToTest + NumSegments) % NumSegments;
+		}
+		else if (SegmentToTest < 0 || SegmentToTest >= NumSegments)
+		{
+			continue;
+		}
+
+		float DistSq = 0.f;
+		const float Key = InSpline->SplineCurves.Position.InaccurateFindNearestOnSegment(LocalLocation, SegmentToTest, DistSq);
+		if (DistSq < BestSegmentDistSq)
+		{
+			BestSegmentDistSq = DistSq;
+			BestKey = Key;
+		}
+	}
+
+	return BestKey;
+}
+
+const FVRSplineArcLengthTable& UVRSliderComponent::GetSplineArcLengthTable()
+{
+	if (!SplineArcLengthTable.IsValidFor(SplineComponentToFollow))
+	{
+		SplineArcLengthTable.Build(SplineComponentToFollow);
+	}
+
+	return SplineArcLengthTable;
+}
+
+float UVRSliderComponent::FindSplineInputKeyClosestToWorldLocation(const FVector& WorldLocation)
+{
+	// Same local space query that USplineComponent::FindInputKeyClosestToWorldLocation makes
+	const FVector LocalLocation = SplineComponentToFollow->GetComponentTransform().InverseTransformPosition(WorldLocation);
+	return GetSplineArcLengthTable().FindInputKeyClosestToLocalLocation(SplineComponentToFollow, LocalLocation);
+}
+
+float UVRSliderComponent::GetSplineInputKeyAtDistance(float Distance)
+{
+	// The reparam search is O(log n) and exact to the engines own table, only the closest point search needed the cache
+	return SplineComponentToFollow->SplineCurves.ReparamTable.Eval(Distance, 0.0f);
+}
+
 void UVRSliderComponent::GetLerpedKey(float &ClosestKey, float DeltaTime)
 {
 	switch (SplineLerpType)
@@ -864,7 +1059,8 @@ void UVRSliderComponent::ResetToParentSplineLocation()
 	if (SplineComponentToFollow != nullptr)
 	{
 		FTransform ParentTransform = UVRInteractibleFunctionLibrary::Interactible_GetCurrentParentTransform(this);
-		FTransform WorldTransform = SplineComponentToFollow->FindTransformClosestToWorldLocation(this->GetComponentLocation(), ESplineCoordinateSpace::World, true);
+		const float ClosestKey = FindSplineInputKeyClosestToWorldLocation(this->GetComponentLocation());
+		FTransform WorldTransform = SplineComponentToFollow->GetTransformAtSplineInputKey(ClosestKey, ESplineCoordinateSpace::World, true);
 		if (bFollowSplineRotationAndScale)
 		{
 			WorldTransform.MultiplyScale3D(InitialRelativeTransform.GetScale3D());
@@ -876,7 +1072,7 @@ void UVRSliderComponent::ResetToParentSplineLocation()
 			this->SetWorldLocation(WorldTransform.GetLocation());
 		}
 
-		CurrentSliderProgress = GetCurrentSliderProgress(WorldTransform.GetLocation());
+		CurrentSliderProgress = GetCurrentSliderProgress(WorldTransform.GetLocation(), true, ClosestKey);
 	}
 }
 
@@ -888,17 +1084,18 @@ void UVRSliderComponent::SetSliderProgress(float NewSliderProgress)
 	{
 		FTransform ParentTransform = UVRInteractibleFunctionLibrary::Interactible_GetCurrentParentTransform(this);
 		float splineProgress = SplineComponentToFollow->GetSplineLength() * NewSliderProgress;
+		const float SplineKey = GetSplineInputKeyAtDistance(splineProgress);
 
 		if (bFollowSplineRotationAndScale)
 		{
-			FTransform trans = SplineComponentToFollow->GetTransformAtDistanceAlongSpline(splineProgress, ESplineCoordinateSpace::World, true);
+			FTransform trans = SplineComponentToFollow->GetTransformAtSplineInputKey(SplineKey, ESplineCoordinateSpace::World, true);
 			trans.MultiplyScale3D(InitialRelativeTransform.GetScale3D());
 			trans = trans * ParentTransform.Inverse();
 			this->SetRelativeTransform(trans);
 		}
 		else
 		{
-			this->SetRelativeLocation(ParentTransform.InverseTransformPosition(SplineComponentToFollow->GetLocationAtDistanceAlongSpline(splineProgress, ESplineCoordinateSpace::World)));
+			this->SetRelativeLocation(ParentTransform.InverseTransformPosition(SplineComponentToFollow->GetLocationAtSplineInputKey(SplineKey, ESplineCoordinateSpace::World)));
 		}
 	}
 	else // Not a spline follow
@@ -1,6 +1,21 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 
 #include "Misc/BucketUpdateSubsystem.h"
+#include "VRGlobalSettings.h"
+
+DECLARE_CYCLE_STAT(TEXT("BucketUpdates ~ UpdateBuckets"), STAT_UpdateBuckets, STATGROUP_BucketUpdates);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bucket Callbacks Fired"), STAT_BucketCallbacksFired, STATGROUP_BucketUpdates);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Bucket Frame Cost (ms)"), STAT_BucketFrameCost, STATGROUP_BucketUpdates);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Bucket Worst Frame Cost (ms)"), STAT_BucketWorstFrameCost, STATGROUP_BucketUpdates);
+
+	void UBucketUpdateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+	{
+		Super::Initialize(Collection);
+
+		const UVRGlobalSettings& VRSettings = *GetDefault<UVRGlobalSettings>();
+		BucketContainer.NumPhaseGroups = (uint8)FMath::Clamp(VRSettings.BucketUpdatePhaseGroups, 1, 32);
+		SetFrameBudget(VRSettings.BucketUpdateFrameBudgetMS);
+	}
 
 	bool UBucketUpdateSubsystem::AddObjectToBucket(int32 UpdateHTZ, UObject* InObject, FName FunctionName)
 	{
@@ -64,6 +79,22 @@
 		return BucketContainer.bNeedsUpdate;
 	}
 
+	void UBucketUpdateSubsystem::SetFrameBudget(float BudgetMS)
+	{
+		BucketContainer.FrameBudgetSeconds = FMath::Max(BudgetMS, 0.0f) / 1000.0f;
+	}
+
+	float UBucketUpdateSubsystem::GetWorstFrameCost() const
+	{
+		return BucketContainer.WorstFrameCostMS;
+	}
+
+	void UBucketUpdateSubsystem::ResetWorstFrameCost()
+	{
+		BucketContainer.WorstFrameCostMS = 0.0f;
+		SET_FLOAT_STAT(STAT_BucketWorstFrameCost, 0.0f);
+	}
+
 	void UBucketUpdateSubsystem::Tick(float DeltaTime)
 	{
 		BucketContainer.UpdateBuckets(DeltaTime);
@@ -135,15 +166,19 @@
 	FUpdateBucketDrop::FUpdateBucketDrop()
 	{
 		FunctionName = NAME_None;
+		PhaseIndex = 0;
 	}
 
 	FUpdateBucketDrop::FUpdateBucketDrop(FDynamicBucketUpdateTickSignature & DynCallback)
 	{
 		DynamicCallback = DynCallback;
+		PhaseIndex = 0;
 	}
 
 	FUpdateBucketDrop::FUpdateBucketDrop(UObject * Obj, FName FuncName)
 	{
+		PhaseIndex = 0;
+
 		if (Obj && Obj->FindFunction(FuncName))
 		{
 			FunctionName = FuncName;
@@ -155,39 +190,121 @@
 		}
 	}
 	
-	bool FUpdateBucket::Update(float DeltaTime)
+	void FUpdateBucket::AddCallback(const FUpdateBucketDrop & NewCallback)
+	{
+		// Round robin the phase so the groups stay balanced
+		int32 Index = Callbacks.Add(NewCallback);
+		Callbacks[Index].PhaseIndex = NextPhaseToAssign;
+		NextPhaseToAssign = (NextPhaseToAssign + 1) % NumPhases;
+	}
+
+	void FUpdateBucket::RemoveCallbackAt(int32 Index)
+	{
+		Callbacks.RemoveAt(Index);
+
+		// Everything above the removed index shifted down one
+		if (CallbackCursor != INDEX_NONE && Index <= CallbackCursor)
+		{
+			--CallbackCursor;
+		}
+	}
+
+	bool FUpdateBucket::Update(float DeltaTime, uint64 BudgetEndCycles, int32 & CallbacksFired)
 	{
-		//#TODO: Need to consider batching / spreading out load if there are a lot of updating objects in the bucket
 		if (Callbacks.Num() < 1)
-			return false;
+			return true;
 
-		// Check for if this bucket is ready to fire events
+		// Check for phases that are ready to fire
+		// Carrying the remainder over instead of zeroing keeps the average rate at the requested HTZ
+		const float PhaseRate = nUpdateRate / NumPhases;
 		nUpdateCount += DeltaTime;
-		if (nUpdateCount >= nUpdateRate)
+		while (nUpdateCount >= PhaseRate && NumDuePhases < NumPhases)
+		{
+			nUpdateCount -= PhaseRate;
+			++NumDuePhases;
+		}
+
+		// More than a full period behind, don't try and catch up on it, just drop the backlog
+		if (nUpdateCount >= PhaseRate)
 		{
 			nUpdateCount = 0.0f;
-			for (int i = Callbacks.Num() - 1; i >= 0; --i)
+		}
+
+		while (NumDuePhases > 0)
+		{
+			if (CallbackCursor == INDEX_NONE || CallbackCursor >= Callbacks.Num())
+			{
+				CallbackCursor = Callbacks.Num() - 1;
+			}
+
+			for (; CallbackCursor >= 0; --CallbackCursor)
 			{
-				if (Callbacks[i].ExecuteBoundCallback())
+				if (Callbacks[CallbackCursor].PhaseIndex != CurrentPhase)
+					continue;
+
+				// Out of time, pick back up here next frame
+				if (BudgetEndCycles > 0 && FPlatformTime::Cycles64() >= BudgetEndCycles)
+				{
+					return false;
+				}
+
+				++CallbacksFired;
+				if (Callbacks[CallbackCursor].ExecuteBoundCallback())
 				{
 					// If this returns true then we keep it in the queue
 					continue;
 				}
 
 				// Remove the callback, it is complete or invalid
-				Callbacks.RemoveAt(i);
+				Callbacks.RemoveAt(CallbackCursor);
 			}
+
+			CallbackCursor = INDEX_NONE;
+			CurrentPhase = (CurrentPhase + 1) % NumPhases;
+			--NumDuePhases;
 		}
 
-		return Callbacks.Num() > 0;
+		return true;
 	}
 	
 	void FUpdateBucketContainer::UpdateBuckets(float DeltaTime)
 	{
+		SCOPE_CYCLE_COUNTER(STAT_UpdateBuckets);
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const uint64 BudgetEndCycles = FrameBudgetSeconds > 0.0f ? StartCycles + (uint64)(FrameBudgetSeconds / FPlatformTime::GetSecondsPerCycle64()) : 0;
+		int32 CallbacksFired = 0;
+		bool bOutOfBudget = false;
+
+		// Finish off the bucket that ran out of time last frame first
+		FUpdateBucket * ResumeBucket = ResumeBucketKey != 0 ? ReplicationBuckets.Find(ResumeBucketKey) : nullptr;
+		if (ResumeBucket)
+		{
+			bOutOfBudget = !ResumeBucket->Update(DeltaTime, BudgetEndCycles, CallbacksFired);
+		}
+
+		if (!bOutOfBudget)
+		{
+			ResumeBucketKey = 0;
+		}
+
 		TArray<uint32> BucketsToRemove;
 		for(auto& Bucket : ReplicationBuckets)
-		{		
-			if (!Bucket.Value.Update(DeltaTime))
+		{
+			if (&Bucket.Value == ResumeBucket)
+				continue;
+
+			// Still need to accumulate time while out of budget so that the phases come due
+			if (!Bucket.Value.Update(DeltaTime, bOutOfBudget ? StartCycles : BudgetEndCycles, CallbacksFired) && !bOutOfBudget)
+			{
+				bOutOfBudget = true;
+				ResumeBucketKey = Bucket.Key;
+			}
+		}
+
+		for (auto& Bucket : ReplicationBuckets)
+		{
+			if (!Bucket.Value.HasCallbacks())
 			{
 				// Add Bucket to list to remove at end of update
 				BucketsToRemove.Add(Bucket.Key);
@@ -198,10 +315,20 @@
 		for (const uint32 Key : BucketsToRemove)
 		{
 			ReplicationBuckets.Remove(Key);
+
+			if (Key == ResumeBucketKey)
+				ResumeBucketKey = 0;
 		}
 
 		if (ReplicationBuckets.Num() < 1)
 			bNeedsUpdate = false;
+
+		const float FrameCostMS = (float)(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+		WorstFrameCostMS = FMath::Max(WorstFrameCostMS, FrameCostMS);
+
+		INC_DWORD_STAT_BY(STAT_BucketCallbacksFired, CallbacksFired);
+		SET_FLOAT_STAT(STAT_BucketFrameCost, FrameCostMS);
+		SET_FLOAT_STAT(STAT_BucketWorstFrameCost, WorstFrameCostMS);
 	}
 
 	bool FUpdateBucketContainer::AddBucketObject(uint32 UpdateHTZ, UObject* InObject, FName FunctionName)
@@ -214,12 +341,12 @@
 
 		if (ReplicationBuckets.Contains(UpdateHTZ))
 		{
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(InObject, FunctionName));
+			ReplicationBuckets[UpdateHTZ].AddCallback(FUpdateBucketDrop(InObject, FunctionName));
 		}
 		else
 		{
-			FUpdateBucket & newBucket = ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ));
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(InObject, FunctionName));
+			FUpdateBucket & newBucket = ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ, NumPhaseGroups));
+			newBucket.AddCallback(FUpdateBucketDrop(InObject, FunctionName));
 		}
 
 		if (ReplicationBuckets.Num() > 0)
@@ -239,12 +366,12 @@
 
 		if (ReplicationBuckets.Contains(UpdateHTZ))
 		{
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(Delegate));
+			ReplicationBuckets[UpdateHTZ].AddCallback(FUpdateBucketDrop(Delegate));
 		}
 		else
 		{
-			FUpdateBucket & newBucket = ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ));
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(Delegate));
+			FUpdateBucket & newBucket = ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ, NumPhaseGroups));
+			newBucket.AddCallback(FUpdateBucketDrop(Delegate));
 		}
 
 		if (ReplicationBuckets.Num() > 0)
@@ -268,7 +395,7 @@
 			{
 				if (Bucket.Value.Callbacks[i].IsBoundToObjectFunction(ObjectToRemove, FunctionName))
 				{
-					Bucket.Value.Callbacks.RemoveAt(i);
+					Bucket.Value.RemoveCallbackAt(i);
 					bRemovedObject = true;
 
 					// Leave the loop, this is called in add as well so we should never get duplicate entries
@@ -300,7 +427,7 @@
 			{
 				if (Bucket.Value.Callbacks[i].IsBoundToObjectDelegate(DynEvent))
 				{
-					Bucket.Value.Callbacks.RemoveAt(i);
+					Bucket.Value.RemoveCallbackAt(i);
 					bRemovedObject = true;
 
 					// Leave the loop, this is called in add as well so we should never get duplicate entries
@@ -332,7 +459,7 @@
 			{
 				if (Bucket.Value.Callbacks[i].IsBoundToObject(ObjectToRemove))
 				{
-					Bucket.Value.Callbacks.RemoveAt(i);
+					Bucket.Value.RemoveCallbackAt(i);
 					bRemovedObject = true;
 				}
 			}
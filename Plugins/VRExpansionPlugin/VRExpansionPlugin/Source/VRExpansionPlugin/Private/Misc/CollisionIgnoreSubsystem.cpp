@@ -6,6 +6,16 @@
 
 DEFINE_LOG_CATEGORY(VRE_CollisionIgnoreLog);
 
+namespace CollisionIgnoreSubsystemCvars
+{
+	static int32 MaxPrimitivesPerSweep = 32;
+	FAutoConsoleVariableRef CVarMaxPrimitivesPerSweep(
+		TEXT("vr.CollisionIgnoreSweepBudget"),
+		MaxPrimitivesPerSweep,
+		TEXT("Number of tracked primitives that the collision ignore subsystem validates per safety sweep.\n"),
+		ECVF_Default);
+}
+
 
 void UCollisionIgnoreSubsystem::CheckActiveFilters()
 {
@@ -70,38 +80,14 @@ void UCollisionIgnoreSubsystem::CheckActiveFilters()
 			{
 				if (FCCDContactModifyCallbackVR* ContactCallback = (FCCDContactModifyCallbackVR*)PScene->getCCDContactModifyCallback())
 				{
-					FRWScopeLock(ContactCallback->RWAccessLock, FRWScopeLockType::SLT_Write);
-
-					for (int i = ContactCallback->ContactsToIgnore.Num() - 1; i >= 0; --i)
-					{
-						if (
-							(!ContactCallback->ContactsToIgnore[i].Prim1.IsValid() || !ContactCallback->ContactsToIgnore[i].Prim2.IsValid()) ||
-							(!ContactCallback->ContactsToIgnore[i].Actor1.IsValid() || !FPhysicsInterface::IsValid(ContactCallback->ContactsToIgnore[i].Actor1)) ||
-							(!ContactCallback->ContactsToIgnore[i].Actor2.IsValid() || !FPhysicsInterface::IsValid(ContactCallback->ContactsToIgnore[i].Actor2))
-							)
-						{
-							ContactCallback->ContactsToIgnore.RemoveAt(i);
-						}
-					}
+					ContactCallback->ContactsToIgnore.RemoveInvalidPairs();
 
 					//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("CCD IGNORE: %i"), ContactCallback->ContactsToIgnore.Num()));
 				}
 
 				if (FContactModifyCallbackVR* ContactCallback = (FContactModifyCallbackVR*)PScene->getContactModifyCallback())
 				{
-					FRWScopeLock(ContactCallback->RWAccessLock, FRWScopeLockType::SLT_Write);
-
-					for (int i = ContactCallback->ContactsToIgnore.Num() - 1; i >= 0; --i)
-					{
-						if (
-							(!ContactCallback->ContactsToIgnore[i].Prim1.IsValid() || !ContactCallback->ContactsToIgnore[i].Prim2.IsValid()) ||
-							(!ContactCallback->ContactsToIgnore[i].Actor1.IsValid() || !FPhysicsInterface::IsValid(ContactCallback->ContactsToIgnore[i].Actor1)) ||
-							(!ContactCallback->ContactsToIgnore[i].Actor2.IsValid() || !FPhysicsInterface::IsValid(ContactCallback->ContactsToIgnore[i].Actor2))
-							)
-						{
-							ContactCallback->ContactsToIgnore.RemoveAt(i);
-						}
-					}
+					ContactCallback->ContactsToIgnore.RemoveInvalidPairs();
 
 					//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("IGNORE: %i"), ContactCallback->ContactsToIgnore.Num()));
 				}
@@ -112,11 +98,7 @@ void UCollisionIgnoreSubsystem::CheckActiveFilters()
 
 	for (const TPair<FCollisionPrimPair, FCollisionIgnorePairArray>& KeyPair : RemovedPairs)
 	{
-		if (CollisionTrackedPairs.Contains(KeyPair.Key))
-		{
-			CollisionTrackedPairs[KeyPair.Key].PairArray.Empty();
-			CollisionTrackedPairs.Remove(KeyPair.Key);
-		}
+		RemoveTrackedPair(KeyPair.Key);
 	}
 
 	//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("NumIgnored Actors: %i"), CollisionTrackedPairs.Num()));
@@ -130,15 +112,18 @@ void UCollisionIgnoreSubsystem::RemoveComponentCollisionIgnoreState(UPrimitiveCo
 	if (!Prim1)
 		return;
 
-	for (const TPair<FCollisionPrimPair, FCollisionIgnorePairArray>& KeyPair : CollisionTrackedPairs)
+	// Only the pairs that this primitive is part of
+	if (const TArray<FCollisionPrimPair>* PairsForPrim = ComponentPairIndex.Find(Prim1))
 	{
-		// First check for invalid primitives
-		if (KeyPair.Key.Prim1 == Prim1 || KeyPair.Key.Prim2 == Prim1)
+		for (const FCollisionPrimPair& PrimPair : *PairsForPrim)
 		{
 			// If we don't have a map element for this pair, then add it now
-			if (!RemovedPairs.Contains(KeyPair.Key))
+			if (!RemovedPairs.Contains(PrimPair))
 			{
-				RemovedPairs.Add(KeyPair.Key, KeyPair.Value);
+				if (const FCollisionIgnorePairArray* TrackedPair = CollisionTrackedPairs.Find(PrimPair))
+				{
+					RemovedPairs.Add(PrimPair, *TrackedPair);
+				}
 			}
 		}
 	}
@@ -155,28 +140,12 @@ void UCollisionIgnoreSubsystem::RemoveComponentCollisionIgnoreState(UPrimitiveCo
 			{
 				if (FCCDContactModifyCallbackVR* ContactCallback = (FCCDContactModifyCallbackVR*)PScene->getCCDContactModifyCallback())
 				{
-					FRWScopeLock(ContactCallback->RWAccessLock, FRWScopeLockType::SLT_Write);
-
-					for (int i = ContactCallback->ContactsToIgnore.Num() - 1; i >= 0; --i)
-					{
-						if (ContactCallback->ContactsToIgnore[i].Prim1 == Prim1 || ContactCallback->ContactsToIgnore[i].Prim2 == Prim1)
-						{
-							ContactCallback->ContactsToIgnore.RemoveAt(i);
-						}
-					}
+					ContactCallback->ContactsToIgnore.RemovePairsForPrimitive(Prim1);
 				}
 
 				if (FContactModifyCallbackVR* ContactCallback = (FContactModifyCallbackVR*)PScene->getContactModifyCallback())
 				{
-					FRWScopeLock(ContactCallback->RWAccessLock, FRWScopeLockType::SLT_Write);
-
-					for (int i = ContactCallback->ContactsToIgnore.Num() - 1; i >= 0; --i)
-					{
-						if (ContactCallback->ContactsToIgnore[i].Prim1 == Prim1 || ContactCallback->ContactsToIgnore[i].Prim2 == Prim1)
-						{
-							ContactCallback->ContactsToIgnore.RemoveAt(i);
-						}
-					}
+					ContactCallback->ContactsToIgnore.RemovePairsForPrimitive(Prim1);
 				}
 			}
 #endif
@@ -185,11 +154,7 @@ void UCollisionIgnoreSubsystem::RemoveComponentCollisionIgnoreState(UPrimitiveCo
 
 	for (const TPair<FCollisionPrimPair, FCollisionIgnorePairArray>& KeyPair : RemovedPairs)
 	{
-		if (CollisionTrackedPairs.Contains(KeyPair.Key))
-		{
-			CollisionTrackedPairs[KeyPair.Key].PairArray.Empty();
-			CollisionTrackedPairs.Remove(KeyPair.Key);
-		}
+		RemoveTrackedPair(KeyPair.Key);
 	}
 
 	UpdateTimer();
@@ -201,12 +166,127 @@ bool UCollisionIgnoreSubsystem::IsComponentIgnoringCollision(UPrimitiveComponent
 	if (!Prim1)
 		return false;
 
-	for (const TPair<FCollisionPrimPair, FCollisionIgnorePairArray>& KeyPair : CollisionTrackedPairs)
+	const TArray<FCollisionPrimPair>* PairsForPrim = ComponentPairIndex.Find(Prim1);
+	return PairsForPrim && PairsForPrim->Num() > 0;
+}
+
+void UCollisionIgnoreSubsystem::SweepTrackedPrimitives()
+{
+	if (SweepQueue.Num() < 1)
 	{
-		// First check for invalid primitives
-		if (KeyPair.Key.Prim1 == Prim1 || KeyPair.Key.Prim2 == Prim1)
+		ComponentPairIndex.GetKeys(SweepQueue);
+	}
+
+	bool bFoundInvalid = false;
+	int32 NumToCheck = FMath::Min(SweepQueue.Num(), FMath::Max(CollisionIgnoreSubsystemCvars::MaxPrimitivesPerSweep, 1));
+
+	for (int32 i = 0; i < NumToCheck; ++i)
+	{
+		if (!SweepQueue.Pop(false).IsValid())
 		{
-			return true;
+			bFoundInvalid = true;
+			break;
+		}
+	}
+
+	if (bFoundInvalid)
+	{
+		SweepQueue.Reset();
+		CheckActiveFilters();
+	}
+}
+
+void UCollisionIgnoreSubsystem::OnPrimitivePhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange)
+{
+	if (StateChange != EComponentPhysicsStateChange::Destroyed || !ChangedComponent)
+		return;
+
+	// DestroyComponent tears down the physics state before the component is marked pending kill, so don't wait on that.
+	// Once the physics state is gone (or the component is unregistering) the bodies the pairs were set up against no longer exist,
+	// drop them now instead of leaving them for the next sweep.
+	// AActor::Destroy broadcasts while the component is still registered with its physics state, only the owner is flagged by then.
+	AActor* Owner = ChangedComponent->GetOwner();
+	if (!ChangedComponent->IsPhysicsStateCreated() || !ChangedComponent->IsRegistered() || ChangedComponent->IsBeingDestroyed() || ChangedComponent->IsPendingKill() ||
+		(Owner && (Owner->IsActorBeingDestroyed() || Owner->IsPendingKill())))
+	{
+		RemoveComponentCollisionIgnoreState(ChangedComponent);
+	}
+}
+
+void UCollisionIgnoreSubsystem::BindPrimitiveCallbacks(const TWeakObjectPtr<UPrimitiveComponent>& Prim)
+{
+	if (UPrimitiveComponent* PrimComp = Prim.Get())
+	{
+		PrimComp->OnComponentPhysicsStateChanged.AddUniqueDynamic(this, &UCollisionIgnoreSubsystem::OnPrimitivePhysicsStateChanged);
+	}
+}
+
+void UCollisionIgnoreSubsystem::UnbindPrimitiveCallbacks(const TWeakObjectPtr<UPrimitiveComponent>& Prim)
+{
+	if (UPrimitiveComponent* PrimComp = Prim.Get())
+	{
+		PrimComp->OnComponentPhysicsStateChanged.RemoveDynamic(this, &UCollisionIgnoreSubsystem::OnPrimitivePhysicsStateChanged);
+	}
+}
+
+void UCollisionIgnoreSubsystem::AddTrackedPair(const FCollisionPrimPair& PrimPair)
+{
+	CollisionTrackedPairs.Add(PrimPair, FCollisionIgnorePairArray());
+
+	auto AddToIndex = [this, &PrimPair](const TWeakObjectPtr<UPrimitiveComponent>& Prim)
+	{
+		if (!ComponentPairIndex.Contains(Prim))
+		{
+			BindPrimitiveCallbacks(Prim);
+		}
+
+		ComponentPairIndex.FindOrAdd(Prim).AddUnique(PrimPair);
+	};
+
+	AddToIndex(PrimPair.Prim1);
+	AddToIndex(PrimPair.Prim2);
+}
+
+void UCollisionIgnoreSubsystem::RemoveTrackedPair(const FCollisionPrimPair& PrimPair)
+{
+	if (CollisionTrackedPairs.Remove(PrimPair) < 1)
+		return;
+
+	auto RemoveFromIndex = [this, &PrimPair](const TWeakObjectPtr<UPrimitiveComponent>& Prim)
+	{
+		if (TArray<FCollisionPrimPair>* PairsForPrim = ComponentPairIndex.Find(Prim))
+		{
+			PairsForPrim->RemoveSingleSwap(PrimPair);
+			if (PairsForPrim->Num() < 1)
+			{
+				UnbindPrimitiveCallbacks(Prim);
+				ComponentPairIndex.Remove(Prim);
+			}
+		}
+	};
+
+	RemoveFromIndex(PrimPair.Prim1);
+	RemoveFromIndex(PrimPair.Prim2);
+}
+
+bool UCollisionIgnoreSubsystem::IsBoneStillIgnored(const TWeakObjectPtr<UPrimitiveComponent>& Prim, FName BoneName) const
+{
+	const TArray<FCollisionPrimPair>* PairsForPrim = ComponentPairIndex.Find(Prim);
+	if (!PairsForPrim)
+		return false;
+
+	for (const FCollisionPrimPair& PrimPair : *PairsForPrim)
+	{
+		if (const FCollisionIgnorePairArray* TrackedPair = CollisionTrackedPairs.Find(PrimPair))
+		{
+			const bool bIsFirst = PrimPair.Prim1 == Prim;
+			const bool bFound = TrackedPair->PairArray.ContainsByPredicate([bIsFirst, BoneName](const FCollisionIgnorePair& Other)
+				{
+					return (bIsFirst ? Other.BoneName1 : Other.BoneName2) == BoneName;
+				});
+
+			if (bFound)
+				return true;
 		}
 	}
 
@@ -315,192 +395,168 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 	// If we don't have a map element for this pair, then add it now
 	if (bIgnoreCollision && !CollisionTrackedPairs.Contains(newPrimPair))
 	{
-		CollisionTrackedPairs.Add(newPrimPair, FCollisionIgnorePairArray());
+		AddTrackedPair(newPrimPair);
 	}
 
-	for (int i = 0; i < ApplicableBodies.Num(); ++i)
+	FPhysScene* PhysScene = Prim1->GetWorld()->GetPhysicsScene();
+
+	if (PhysScene && ApplicableBodies.Num() > 0 && ApplicableBodies2.Num() > 0)
 	{
-		for (int j = 0; j < ApplicableBodies2.Num(); ++j)
+		// Called when a pair stops being ignored, drops it from tracking and queues its bodies for the contact modification cleanup
+		auto UntrackIgnorePair = [&](const FCollisionIgnorePair& IgnorePair)
 		{
-			if (ApplicableBodies[i].BInstance && ApplicableBodies2[j].BInstance)
+			if (FCollisionIgnorePairArray* TrackedPair = CollisionTrackedPairs.Find(newPrimPair))
 			{
-				if (FPhysScene* PhysScene = Prim1->GetWorld()->GetPhysicsScene())
+				TrackedPair->PairArray.Remove(IgnorePair);
+				if (TrackedPair->PairArray.Num() < 1)
 				{
-					FContactModBodyInstancePair newContactPair;
-					newContactPair.Actor1 = ApplicableBodies[i].BInstance->ActorHandle;
-					newContactPair.Actor2 = ApplicableBodies2[j].BInstance->ActorHandle;
-					newContactPair.Prim1 = Prim1;
-					newContactPair.Prim2 = Prim2;
-
-					FCollisionIgnorePair newIgnorePair;
-					newIgnorePair.Actor1 = ApplicableBodies[i].BInstance->ActorHandle;
-					newIgnorePair.BoneName1 = ApplicableBodies[i].BName;
-					newIgnorePair.Actor2 = ApplicableBodies2[j].BInstance->ActorHandle;
-					newIgnorePair.BoneName2 = ApplicableBodies2[j].BName;
+					RemoveTrackedPair(newPrimPair);
+				}
+			}
+
+			// If we don't have a map element for this pair, then add it now
+			RemovedPairs.FindOrAdd(newPrimPair).PairArray.AddUnique(IgnorePair);
+		};
 
 #if WITH_CHAOS
-					Chaos::FUniqueIdx ID0 = ApplicableBodies[i].BInstance->ActorHandle->GetParticle_LowLevel()->UniqueIdx();
-					Chaos::FUniqueIdx ID1 = ApplicableBodies2[j].BInstance->ActorHandle->GetParticle_LowLevel()->UniqueIdx();
+		Chaos::FIgnoreCollisionManager& IgnoreCollisionManager = PhysScene->GetSolver()->GetEvolution()->GetBroadPhase().GetIgnoreCollisionManager();
 
-					Chaos::FIgnoreCollisionManager& IgnoreCollisionManager = PhysScene->GetSolver()->GetEvolution()->GetBroadPhase().GetIgnoreCollisionManager();
+		// All of the body pairs go through a single scene write instead of one lock per pair
+		FPhysicsCommand::ExecuteWrite(PhysScene, [&]()
+			{
+				using namespace Chaos;
 
-					FPhysicsCommand::ExecuteWrite(PhysScene, [&]()
-						{
-							using namespace Chaos;
+				for (int i = 0; i < ApplicableBodies.Num(); ++i)
+				{
+					for (int j = 0; j < ApplicableBodies2.Num(); ++j)
+					{
+						if (!ApplicableBodies[i].BInstance || !ApplicableBodies2[j].BInstance)
+							continue;
 
-							if (bIgnoreCollision)
-							{
-								if (!IgnoreCollisionManager.IgnoresCollision(ID0, ID1))
-								{
-									TPBDRigidParticleHandle<FReal, 3>* ParticleHandle0 = ApplicableBodies[i].BInstance->ActorHandle->GetHandle_LowLevel()->CastToRigidParticle();
-									TPBDRigidParticleHandle<FReal, 3>* ParticleHandle1 = ApplicableBodies2[j].BInstance->ActorHandle->GetHandle_LowLevel()->CastToRigidParticle();
+						FCollisionIgnorePair newIgnorePair;
+						newIgnorePair.Actor1 = ApplicableBodies[i].BInstance->ActorHandle;
+						newIgnorePair.BoneName1 = ApplicableBodies[i].BName;
+						newIgnorePair.Actor2 = ApplicableBodies2[j].BInstance->ActorHandle;
+						newIgnorePair.BoneName2 = ApplicableBodies2[j].BName;
 
-									if (ParticleHandle0 && ParticleHandle1)
-									{
-										ParticleHandle0->AddCollisionConstraintFlag(Chaos::ECollisionConstraintFlags::CCF_BroadPhaseIgnoreCollisions);
-										IgnoreCollisionManager.AddIgnoreCollisionsFor(ID0, ID1);
+						Chaos::FUniqueIdx ID0 = ApplicableBodies[i].BInstance->ActorHandle->GetParticle_LowLevel()->UniqueIdx();
+						Chaos::FUniqueIdx ID1 = ApplicableBodies2[j].BInstance->ActorHandle->GetParticle_LowLevel()->UniqueIdx();
 
-										ParticleHandle1->AddCollisionConstraintFlag(Chaos::ECollisionConstraintFlags::CCF_BroadPhaseIgnoreCollisions);
-										IgnoreCollisionManager.AddIgnoreCollisionsFor(ID1, ID0);
+						if (bIgnoreCollision)
+						{
+							if (!IgnoreCollisionManager.IgnoresCollision(ID0, ID1))
+							{
+								TPBDRigidParticleHandle<FReal, 3>* ParticleHandle0 = ApplicableBodies[i].BInstance->ActorHandle->GetHandle_LowLevel()->CastToRigidParticle();
+								TPBDRigidParticleHandle<FReal, 3>* ParticleHandle1 = ApplicableBodies2[j].BInstance->ActorHandle->GetHandle_LowLevel()->CastToRigidParticle();
 
-										if (CollisionTrackedPairs.Contains(newPrimPair))
-										{
-											CollisionTrackedPairs[newPrimPair].PairArray.AddUnique(newIgnorePair);
-										}
+								if (ParticleHandle0 && ParticleHandle1)
+								{
+									ParticleHandle0->AddCollisionConstraintFlag(Chaos::ECollisionConstraintFlags::CCF_BroadPhaseIgnoreCollisions);
+									IgnoreCollisionManager.AddIgnoreCollisionsFor(ID0, ID1);
 
-										/*if (ApplicableBodies[i].BInstance->bContactModification != bIgnoreCollision)
-											ApplicableBodies[i].BInstance->SetContactModification(true);
+									ParticleHandle1->AddCollisionConstraintFlag(Chaos::ECollisionConstraintFlags::CCF_BroadPhaseIgnoreCollisions);
+									IgnoreCollisionManager.AddIgnoreCollisionsFor(ID1, ID0);
 
-										if (ApplicableBodies2[j].BInstance->bContactModification != bIgnoreCollision)
-											ApplicableBodies2[j].BInstance->SetContactModification(true);*/
+									if (FCollisionIgnorePairArray* TrackedPair = CollisionTrackedPairs.Find(newPrimPair))
+									{
+										TrackedPair->PairArray.AddUnique(newIgnorePair);
 									}
 								}
 							}
-							else
+						}
+						else
+						{
+							if (IgnoreCollisionManager.IgnoresCollision(ID0, ID1))
 							{
-								if (IgnoreCollisionManager.IgnoresCollision(ID0, ID1))
-								{
-									TPBDRigidParticleHandle<FReal, 3>* ParticleHandle0 = ApplicableBodies[i].BInstance->ActorHandle->GetHandle_LowLevel()->CastToRigidParticle();
-									TPBDRigidParticleHandle<FReal, 3>* ParticleHandle1 = ApplicableBodies2[j].BInstance->ActorHandle->GetHandle_LowLevel()->CastToRigidParticle();
+								TPBDRigidParticleHandle<FReal, 3>* ParticleHandle0 = ApplicableBodies[i].BInstance->ActorHandle->GetHandle_LowLevel()->CastToRigidParticle();
+								TPBDRigidParticleHandle<FReal, 3>* ParticleHandle1 = ApplicableBodies2[j].BInstance->ActorHandle->GetHandle_LowLevel()->CastToRigidParticle();
 
-									if (ParticleHandle0 && ParticleHandle1)
-									{
-										IgnoreCollisionManager.RemoveIgnoreCollisionsFor(ID0, ID1);
-										IgnoreCollisionManager.RemoveIgnoreCollisionsFor(ID1, ID0);
-
-										if (IgnoreCollisionManager.NumIgnoredCollision(ID0) < 1)
-										{
-											ParticleHandle0->RemoveCollisionConstraintFlag(Chaos::ECollisionConstraintFlags::CCF_BroadPhaseIgnoreCollisions);
-										}
-
-										if (IgnoreCollisionManager.NumIgnoredCollision(ID1) < 1)
-										{
-											ParticleHandle1->RemoveCollisionConstraintFlag(Chaos::ECollisionConstraintFlags::CCF_BroadPhaseIgnoreCollisions);
-										}
-									}
+								if (ParticleHandle0 && ParticleHandle1)
+								{
+									IgnoreCollisionManager.RemoveIgnoreCollisionsFor(ID0, ID1);
+									IgnoreCollisionManager.RemoveIgnoreCollisionsFor(ID1, ID0);
 
-									CollisionTrackedPairs[newPrimPair].PairArray.Remove(newIgnorePair);
-									if (CollisionTrackedPairs[newPrimPair].PairArray.Num() < 1)
+									if (IgnoreCollisionManager.NumIgnoredCollision(ID0) < 1)
 									{
-										CollisionTrackedPairs.Remove(newPrimPair);
+										ParticleHandle0->RemoveCollisionConstraintFlag(Chaos::ECollisionConstraintFlags::CCF_BroadPhaseIgnoreCollisions);
 									}
 
-									// If we don't have a map element for this pair, then add it now
-									if (!RemovedPairs.Contains(newPrimPair))
+									if (IgnoreCollisionManager.NumIgnoredCollision(ID1) < 1)
 									{
-										RemovedPairs.Add(newPrimPair, FCollisionIgnorePairArray >());
+										ParticleHandle1->RemoveCollisionConstraintFlag(Chaos::ECollisionConstraintFlags::CCF_BroadPhaseIgnoreCollisions);
 									}
-									RemovedPairs[newPrimPair].PairArray.AddUnique(newIgnorePair);
 								}
+
+								UntrackIgnorePair(newIgnorePair);
 							}
-						});
+						}
+					}
+				}
+			});
 
 #elif PHYSICS_INTERFACE_PHYSX
-					if (PxScene* PScene = PhysScene->GetPxScene())
+		if (PxScene* PScene = PhysScene->GetPxScene())
+		{
+			// Resolve the callbacks once, their ignore sets only publish to the physics thread on the next pre tick anyway
+			FCCDContactModifyCallbackVR* CCDContactCallback = (FCCDContactModifyCallbackVR*)PScene->getCCDContactModifyCallback();
+			FContactModifyCallbackVR* ContactCallback = (FContactModifyCallbackVR*)PScene->getContactModifyCallback();
+
+			if (CCDContactCallback || ContactCallback)
+			{
+				for (int i = 0; i < ApplicableBodies.Num(); ++i)
+				{
+					for (int j = 0; j < ApplicableBodies2.Num(); ++j)
 					{
-						if (FCCDContactModifyCallbackVR* ContactCallback = (FCCDContactModifyCallbackVR*)PScene->getCCDContactModifyCallback())
+						if (!ApplicableBodies[i].BInstance || !ApplicableBodies2[j].BInstance)
+							continue;
+
+						FContactModBodyInstancePair newContactPair;
+						newContactPair.Actor1 = ApplicableBodies[i].BInstance->ActorHandle;
+						newContactPair.Actor2 = ApplicableBodies2[j].BInstance->ActorHandle;
+						newContactPair.Prim1 = Prim1;
+						newContactPair.Prim2 = Prim2;
+
+						FCollisionIgnorePair newIgnorePair;
+						newIgnorePair.Actor1 = ApplicableBodies[i].BInstance->ActorHandle;
+						newIgnorePair.BoneName1 = ApplicableBodies[i].BName;
+						newIgnorePair.Actor2 = ApplicableBodies2[j].BInstance->ActorHandle;
+						newIgnorePair.BoneName2 = ApplicableBodies2[j].BName;
+
+						if (bIgnoreCollision)
 						{
-							FRWScopeLock(ContactCallback->RWAccessLock, FRWScopeLockType::SLT_Write);
-
-							if (bIgnoreCollision)
-							{
+							if (CCDContactCallback)
+								CCDContactCallback->ContactsToIgnore.AddPair(newContactPair);
 
-								if (CollisionTrackedPairs.Contains(newPrimPair))
-								{
-									CollisionTrackedPairs[newPrimPair].PairArray.AddUnique(newIgnorePair);
-								}
-
-								ContactCallback->ContactsToIgnore.AddUnique(newContactPair);
+							if (ContactCallback)
+								ContactCallback->ContactsToIgnore.AddPair(newContactPair);
 
-								if (ApplicableBodies[i].BInstance->bContactModification != bIgnoreCollision)
-									ApplicableBodies[i].BInstance->SetContactModification(true);
-
-								if (ApplicableBodies2[j].BInstance->bContactModification != bIgnoreCollision)
-									ApplicableBodies2[j].BInstance->SetContactModification(true);
-							}
-							else
+							if (FCollisionIgnorePairArray* TrackedPair = CollisionTrackedPairs.Find(newPrimPair))
 							{
-								ContactCallback->ContactsToIgnore.Remove(newContactPair);
+								TrackedPair->PairArray.AddUnique(newIgnorePair);
+							}
 
-								CollisionTrackedPairs[newPrimPair].PairArray.Remove(newIgnorePair);
-								if (CollisionTrackedPairs[newPrimPair].PairArray.Num() < 1)
-								{
-									CollisionTrackedPairs.Remove(newPrimPair);
-								}
+							if (ApplicableBodies[i].BInstance->bContactModification != bIgnoreCollision)
+								ApplicableBodies[i].BInstance->SetContactModification(true);
 
-								// If we don't have a map element for this pair, then add it now
-								if (!RemovedPairs.Contains(newPrimPair))
-								{
-									RemovedPairs.Add(newPrimPair, FCollisionIgnorePairArray());
-								}
-								RemovedPairs[newPrimPair].PairArray.AddUnique(newIgnorePair);
-							}
+							if (ApplicableBodies2[j].BInstance->bContactModification != bIgnoreCollision)
+								ApplicableBodies2[j].BInstance->SetContactModification(true);
 						}
-
-						if (FContactModifyCallbackVR* ContactCallback = (FContactModifyCallbackVR*)PScene->getContactModifyCallback())
+						else
 						{
-							FRWScopeLock(ContactCallback->RWAccessLock, FRWScopeLockType::SLT_Write);
-
-							if (bIgnoreCollision)
-							{
-								ContactCallback->ContactsToIgnore.AddUnique(newContactPair);
-
-								if (CollisionTrackedPairs.Contains(newPrimPair))
-								{
-									CollisionTrackedPairs[newPrimPair].PairArray.AddUnique(newIgnorePair);
-								}
-
-								if (ApplicableBodies[i].BInstance->bContactModification != bIgnoreCollision)
-									ApplicableBodies[i].BInstance->SetContactModification(true);
+							if (CCDContactCallback)
+								CCDContactCallback->ContactsToIgnore.RemovePair(newContactPair);
 
-								if (ApplicableBodies2[j].BInstance->bContactModification != bIgnoreCollision)
-									ApplicableBodies2[j].BInstance->SetContactModification(true);
-							}
-							else
-							{
-								ContactCallback->ContactsToIgnore.Remove(newContactPair);
+							if (ContactCallback)
+								ContactCallback->ContactsToIgnore.RemovePair(newContactPair);
 
-								CollisionTrackedPairs[newPrimPair].PairArray.Remove(newIgnorePair);
-								if (CollisionTrackedPairs[newPrimPair].PairArray.Num() < 1)
-								{
-									CollisionTrackedPairs.Remove(newPrimPair);
-								}
-
-								// If we don't have a map element for this pair, then add it now
-								if (!RemovedPairs.Contains(newPrimPair))
-								{
-									RemovedPairs.Add(newPrimPair, FCollisionIgnorePairArray());
-								}
-								RemovedPairs[newPrimPair].PairArray.AddUnique(newIgnorePair);
-							}
+							UntrackIgnorePair(newIgnorePair);
 						}
 					}
-#endif
 				}
 			}
 		}
+#endif
 	}
-
 	// Update our timer state
 	UpdateTimer();
 }
\ No newline at end of file
@@ -34,10 +34,16 @@ DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Listener Update"), STAT_AI_Sen
 DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Register Target"), STAT_AI_Sense_Sight_RegisterTarget, STATGROUP_AI);
 DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Remove By Listener"), STAT_AI_Sense_Sight_RemoveByListener, STATGROUP_AI);
 DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Remove To Target"), STAT_AI_Sense_Sight_RemoveToTarget, STATGROUP_AI);
+DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Async Results"), STAT_AI_Sense_Sight_AsyncResults, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Sense: Sight, Queries Processed"), STAT_AI_Sense_Sight_QueriesProcessed, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Sense: Sight, Async Traces Submitted"), STAT_AI_Sense_Sight_AsyncTracesSubmitted, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Sense: Sight, Async Traces Resolved"), STAT_AI_Sense_Sight_AsyncTracesResolved, STATGROUP_AI);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Perception Sense: Sight, Queries Per Second"), STAT_AI_Sense_Sight_QueriesPerSecond, STATGROUP_AI);
 
 
 static const int32 DefaultMaxTracesPerTick = 6;
 static const int32 DefaultMinQueriesPerTimeSliceCheck = 40;
+static const int32 DefaultMaxAsyncTracesPerTick = 64;
 
 enum class EForEachResult : uint8
 {
@@ -92,6 +98,11 @@ FORCEINLINE_DEBUGGABLE bool CheckIsTargetInSightPie(const FPerceptionListener& L
 	return false;
 }
 
+FORCEINLINE uint64 MakeSightQueryKey(uint32 ObserverId, uint32 TargetId)
+{
+	return ((uint64)ObserverId << 32) | (uint64)TargetId;
+}
+
 //----------------------------------------------------------------------//
 // FAISightTargetVR
 //----------------------------------------------------------------------//
@@ -138,6 +149,11 @@ UAISense_Sight_VR::UAISense_Sight_VR(const FObjectInitializer& ObjectInitializer
 	, HighImportanceQueryDistanceThreshold(300.f)
 	, MaxQueryImportance(60.f)
 	, SightLimitQueryImportance(10.f)
+	, bUseAsyncTraces(false)
+	, MaxAsyncTracesPerTick(DefaultMaxAsyncTracesPerTick)
+	, QueriesPerSecond(0.f)
+	, QueriesSinceRateSample(0)
+	, LastRateSampleTime(0.0)
 {
 	if (HasAnyFlags(RF_ClassDefaultObject) == false)
 	{
@@ -210,13 +226,18 @@ float UAISense_Sight_VR::Update()
 {
 	SCOPE_CYCLE_COUNTER(STAT_AI_Sense_Sight);
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(GetPerceptionSystem()->GetOuter(), EGetWorldErrorMode::LogAndReturnNull);
+	UWorld* World = GEngine->GetWorldFromContextObject(GetPerceptionSystem()->GetOuter(), EGetWorldErrorMode::LogAndReturnNull);
 
 	if (World == NULL)
 	{
 		return SuspendNextUpdate;
 	}
 
+	AIPerception::FListenerMap& ListenersMap = *GetListeners();
+
+	// Resolve last updates traces before sorting so that their queries are restarted before they are scored
+	const int32 NumAsyncResultsApplied = ConsumeAsyncTraceResults(World, ListenersMap);
+
 	// sort Sight Queries
 	{
 		auto RecalcScore = [](FAISightQueryVR& SightQuery)->EForEachResult
@@ -241,7 +262,9 @@ float UAISense_Sight_VR::Update()
 	}
 
 	int32 TracesCount = 0;
+	int32 AsyncTracesCount = 0;
 	int32 NumQueriesProcessed = 0;
+	int32 NumQueriesCompleted = NumAsyncResultsApplied;
 	double TimeSliceEnd = FPlatformTime::Seconds() + MaxTimeSlicePerTick;
 	bool bHitTimeSliceLimit = false;
 	//#define AISENSE_SIGHT_TIMESLICING_DEBUG
@@ -267,8 +290,6 @@ float UAISense_Sight_VR::Update()
 	QueryOperations.Reserve(InitialInvalidItemsSize);
 	InvalidTargets.Reserve(InitialInvalidItemsSize);
 
-	AIPerception::FListenerMap& ListenersMap = *GetListeners();
-
 	int32 InRangeItr = 0;
 	int32 OutOfRangeItr = 0;
 	for (int32 QueryIndex = 0; QueryIndex < SightQueriesInRange.Num() + SightQueriesOutOfRange.Num(); ++QueryIndex)
@@ -301,7 +322,7 @@ float UAISense_Sight_VR::Update()
 			// do not break here since that would bypass queue aging
 		}
 
-		if (TracesCount < MaxTracesPerTick && bHitTimeSliceLimit == false)
+		if (TracesCount < MaxTracesPerTick && (!bUseAsyncTraces || AsyncTracesCount < MaxAsyncTracesPerTick) && bHitTimeSliceLimit == false)
 		{
 			bIsInRangeQuery ? ++InRangeItr : ++OutOfRangeItr;
 
@@ -324,6 +345,7 @@ float UAISense_Sight_VR::Update()
 				const float SightRadiusSq = SightQuery->bLastResult ? PropDigest.LoseSightRadiusSq : PropDigest.SightRadiusSq;
 
 				float StimulusStrength = 1.f;
+				bool bWaitingOnAsyncTrace = false;
 
 				// @Note that automagical "seeing" does not care about sight range nor vision cone
 				const bool bShouldAutomatically = ShouldAutomaticallySeeTarget(PropDigest, SightQuery, Listener, TargetActor, StimulusStrength);
@@ -365,6 +387,25 @@ float UAISense_Sight_VR::Update()
 
 						TracesCount += NumberOfLoSChecksPerformed;
 					}
+					else if (bUseAsyncTraces)
+					{
+						// The stimulus is registered and the query restarted when the result is consumed on the next update
+						bWaitingOnAsyncTrace = true;
+						if (!SightQuery->bAsyncTracePending)
+						{
+							FAISightAsyncTraceVR& AsyncTrace = PendingAsyncTraces.AddDefaulted_GetRef();
+							AsyncTrace.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Listener.CachedLocation, TargetLocation
+								, DefaultSightCollisionChannel
+								, FCollisionQueryParams(SCENE_QUERY_STAT(AILineOfSight), true, ListenerPtr->GetBodyActor()));
+							AsyncTrace.ObserverId = SightQuery->ObserverId;
+							AsyncTrace.TargetId = SightQuery->TargetId;
+							AsyncTrace.TargetLocation = TargetLocation;
+							AsyncTrace.SubmitFrameNumber = GFrameCounter;
+
+							SightQuery->bAsyncTracePending = true;
+							++AsyncTracesCount;
+						}
+					}
 					else
 					{
 						// we need to do tests ourselves
@@ -416,8 +457,12 @@ float UAISense_Sight_VR::Update()
 					QueryOperations.Add(FQueryOperation(bIsInRangeQuery, EOperationType::SwapList, bIsInRangeQuery ? InRangeIndex : OutOfRangeIndex));
 				}
 
-				// restart query
-				SightQuery->OnProcessed();
+				// restart query, ones waiting on an async trace are restarted in ConsumeAsyncTraceResults
+				if (!bWaitingOnAsyncTrace)
+				{
+					SightQuery->OnProcessed();
+					++NumQueriesCompleted;
+				}
 			}
 			else
 			{
@@ -443,6 +488,27 @@ float UAISense_Sight_VR::Update()
 	UE_LOG(LogAIPerceptionVR, VeryVerbose, TEXT("UAISense_Sight_VR::Update processed %d sources [time slice limited? %d]"), NumQueriesProcessed, bHitTimeSliceLimit ? 1 : 0);
 #endif // AISENSE_SIGHT_TIMESLICING_DEBUG
 
+	INC_DWORD_STAT_BY(STAT_AI_Sense_Sight_QueriesProcessed, NumQueriesCompleted);
+	INC_DWORD_STAT_BY(STAT_AI_Sense_Sight_AsyncTracesSubmitted, AsyncTracesCount);
+
+	// Sample the query rate once a second
+	{
+		QueriesSinceRateSample += NumQueriesCompleted;
+		const double CurrentTime = FPlatformTime::Seconds();
+		if (LastRateSampleTime <= 0.0)
+		{
+			LastRateSampleTime = CurrentTime;
+		}
+		else if (CurrentTime - LastRateSampleTime >= 1.0)
+		{
+			QueriesPerSecond = (float)(QueriesSinceRateSample / (CurrentTime - LastRateSampleTime));
+			QueriesSinceRateSample = 0;
+			LastRateSampleTime = CurrentTime;
+		}
+
+		SET_FLOAT_STAT(STAT_AI_Sense_Sight_QueriesPerSecond, QueriesPerSecond);
+	}
+
 	if (QueryOperations.Num() > 0)
 	{
 		// Sort by InRange and by descending Index 
@@ -512,6 +578,120 @@ float UAISense_Sight_VR::Update()
 	return 0.f;
 }
 
+int32 UAISense_Sight_VR::ConsumeAsyncTraceResults(UWorld* World, AIPerception::FListenerMap& ListenersMap)
+{
+	if (PendingAsyncTraces.Num() < 1)
+	{
+		return 0;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_AI_Sense_Sight_AsyncResults);
+
+	// Gather the traces that finished or expired, expired ones just release their query to be submitted again
+	TMap<uint64, int32> ResolvedTraces;
+	FTraceDatum TraceData;
+	for (int32 TraceIndex = 0; TraceIndex < PendingAsyncTraces.Num(); ++TraceIndex)
+	{
+		FAISightAsyncTraceVR& AsyncTrace = PendingAsyncTraces[TraceIndex];
+		if (World->QueryTraceData(AsyncTrace.TraceHandle, TraceData))
+		{
+			AsyncTrace.bHasResult = true;
+			AsyncTrace.bHit = TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit;
+			AsyncTrace.HitActor = AsyncTrace.bHit ? TraceData.OutHits[0].Actor : nullptr;
+		}
+		else if (World->IsTraceHandleValid(AsyncTrace.TraceHandle, false))
+		{
+			// Still in flight
+			continue;
+		}
+
+		AsyncTrace.bResolved = true;
+		ResolvedTraces.Add(MakeSightQueryKey(AsyncTrace.ObserverId, AsyncTrace.TargetId), TraceIndex);
+	}
+
+	if (ResolvedTraces.Num() < 1)
+	{
+		return 0;
+	}
+
+	int32 NumResultsApplied = 0;
+	auto ApplyTraceResult = [this, &ListenersMap, &ResolvedTraces, &NumResultsApplied](FAISightQueryVR& SightQuery)->EForEachResult
+	{
+		if (!SightQuery.bAsyncTracePending)
+		{
+			return EForEachResult::Continue;
+		}
+
+		const int32* TraceIndex = ResolvedTraces.Find(MakeSightQueryKey(SightQuery.ObserverId, SightQuery.TargetId));
+		if (TraceIndex == nullptr)
+		{
+			return EForEachResult::Continue;
+		}
+
+		SightQuery.bAsyncTracePending = false;
+
+		const FAISightAsyncTraceVR& AsyncTrace = PendingAsyncTraces[*TraceIndex];
+		FPerceptionListener* Listener = ListenersMap.Find(SightQuery.ObserverId);
+		FAISightTargetVR* Target = ObservedTargets.Find(SightQuery.TargetId);
+		AActor* TargetActor = Target ? Target->Target.Get() : nullptr;
+
+		// Invalid listeners and targets are cleaned up by the query loop
+		if (!AsyncTrace.bHasResult || Listener == nullptr || TargetActor == nullptr)
+		{
+			return EForEachResult::Continue;
+		}
+
+		AActor* HitResultActor = AsyncTrace.HitActor.Get();
+		if (AsyncTrace.bHit == false || (HitResultActor && HitResultActor->IsOwnedBy(TargetActor)))
+		{
+			Listener->RegisterStimulus(TargetActor, FAIStimulus(*this, 1.f, AsyncTrace.TargetLocation, Listener->CachedLocation));
+			SightQuery.bLastResult = true;
+			SightQuery.LastSeenLocation = AsyncTrace.TargetLocation;
+		}
+		// communicate failure only if we've seen give actor before
+		else if (SightQuery.bLastResult == true)
+		{
+			Listener->RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, AsyncTrace.TargetLocation, Listener->CachedLocation, FAIStimulus::SensingFailed));
+			SightQuery.bLastResult = false;
+			SightQuery.LastSeenLocation = FAISystem::InvalidLocation;
+		}
+
+		// restart query, the result is as old as the trace that produced it
+		SightQuery.OnProcessed(AsyncTrace.SubmitFrameNumber);
+		++NumResultsApplied;
+		return EForEachResult::Continue;
+	};
+
+	ForEach(SightQueriesInRange, ApplyTraceResult);
+	ForEach(SightQueriesOutOfRange, ApplyTraceResult);
+
+	// Results for queries that were removed while in flight are simply dropped here
+	PendingAsyncTraces.RemoveAllSwap([](const FAISightAsyncTraceVR& AsyncTrace) { return AsyncTrace.bResolved; }, /*bAllowShrinking*/false);
+
+	INC_DWORD_STAT_BY(STAT_AI_Sense_Sight_AsyncTracesResolved, NumResultsApplied);
+	return NumResultsApplied;
+}
+
+float UAISense_Sight_VR::GetAverageResultAge(const FPerceptionListenerID& ListenerId) const
+{
+	float TotalAge = 0.f;
+	int32 NumQueries = 0;
+
+	for (const TArray<FAISightQueryVR>* SightQueries : { &SightQueriesInRange, &SightQueriesOutOfRange })
+	{
+		for (const FAISightQueryVR& SightQuery : *SightQueries)
+		{
+			if (SightQuery.ObserverId == ListenerId)
+			{
+				TotalAge += SightQuery.GetAge();
+				++NumQueries;
+			}
+		}
+	}
+
+	return NumQueries > 0 ? TotalAge / NumQueries : 0.f;
+}
+
 void UAISense_Sight_VR::RegisterEvent(const FAISightEventVR& Event)
 {
 
@@ -966,6 +1146,19 @@ void UAISenseConfig_Sight_VR::DescribeSelfToGameplayDebugger(const UAIPerception
 			*LoseSightRangeColor.ToString(), *DescribeColorHelper(LoseSightRangeColor))
 	);
 
+	if (UWorld* World = PerceptionComponent->GetWorld())
+	{
+		UAIPerceptionSystem* PerceptionSys = UAIPerceptionSystem::GetCurrent(*World);
+		const UAISense_Sight_VR* SightSense = PerceptionSys ? Cast<const UAISense_Sight_VR>(PerceptionSys->GetSenseInstance(GetSenseID())) : nullptr;
+		if (SightSense)
+		{
+			DebuggerCategory->AddTextLine(
+				FString::Printf(TEXT("{white}  queries/s:{yellow}%.0f {white}avg result age:{yellow}%.1f frames {white}async traces in flight:{yellow}%d"),
+					SightSense->GetQueriesPerSecond(), SightSense->GetAverageResultAge(PerceptionComponent->GetListenerId()), SightSense->GetNumPendingAsyncTraces())
+			);
+		}
+	}
+
 	const AActor* BodyActor = PerceptionComponent->GetBodyActor();
 	if (BodyActor != nullptr)
 	{
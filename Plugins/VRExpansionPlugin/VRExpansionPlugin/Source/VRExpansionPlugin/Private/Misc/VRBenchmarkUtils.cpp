@@ -0,0 +1,73 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/VRBenchmarkUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+
+#if !UE_BUILD_SHIPPING
+
+DEFINE_LOG_CATEGORY(LogVRBenchmark);
+
+namespace VRBenchmarkUtils
+{
+	void ParseCommonArg(const FString& Arg, FCommonArgs& InOutArgs)
+	{
+		FParse::Value(*Arg, TEXT("Out="), InOutArgs.OutputPath);
+		InOutArgs.bQuitWhenDone |= Arg.Equals(TEXT("Quit"), ESearchCase::IgnoreCase);
+	}
+
+	bool ParseIntList(const FString& Arg, const TCHAR* Name, TArray<int32>& OutValues, int32 Min, int32 Max)
+	{
+		FString ListString;
+		if (!FParse::Value(*Arg, Name, ListString, false))
+			return false;
+
+		TArray<FString> ValueStrings;
+		ListString.ParseIntoArray(ValueStrings, TEXT(","));
+
+		OutValues.Reset();
+		for (const FString& ValueString : ValueStrings)
+		{
+			OutValues.Add(FMath::Clamp(FCString::Atoi(*ValueString), Min, Max));
+		}
+
+		return true;
+	}
+
+	void SetDefaultOutputPath(FString& InOutPath, const TCHAR* Folder, const TCHAR* Prefix)
+	{
+		if (InOutPath.IsEmpty())
+		{
+			InOutPath = FPaths::ProfilingDir() / Folder / FString::Printf(TEXT("%s-%s.csv"), Prefix, *FDateTime::Now().ToString());
+		}
+	}
+
+	bool SaveCsv(const TCHAR* CommandName, const FString& Csv, const FString& OutputPath)
+	{
+		if (FFileHelper::SaveStringToFile(Csv, *OutputPath))
+		{
+			UE_LOG(LogVRBenchmark, Display, TEXT("%s: Wrote %s"), CommandName, *FPaths::ConvertRelativePathToFull(OutputPath));
+			return true;
+		}
+
+		UE_LOG(LogVRBenchmark, Warning, TEXT("%s: Failed to write %s"), CommandName, *OutputPath);
+		return false;
+	}
+
+	void SaveAndLogResults(const TCHAR* CommandName, const FString& Csv, const FString& OutputPath)
+	{
+		SaveCsv(CommandName, Csv, OutputPath);
+		UE_LOG(LogVRBenchmark, Display, TEXT("%s results:\n%s"), CommandName, *Csv);
+	}
+
+	void QuitIfRequested(const FCommonArgs& Args)
+	{
+		if (Args.bQuitWhenDone)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+	}
+}
+
+#endif
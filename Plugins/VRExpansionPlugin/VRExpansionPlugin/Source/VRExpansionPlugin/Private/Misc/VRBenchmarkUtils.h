@@ -0,0 +1,39 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+DECLARE_LOG_CATEGORY_EXTERN(LogVRBenchmark, Log, All);
+
+// Shared plumbing for the vr.* benchmark and report console commands
+// Every command takes Out=Path.csv and Quit, writes a CSV to ProfilingDir/<Folder>/ by default and logs to LogVRBenchmark
+namespace VRBenchmarkUtils
+{
+	struct FCommonArgs
+	{
+		FString OutputPath;
+		bool bQuitWhenDone = false;
+	};
+
+	// Picks Out= and Quit out of a single console argument
+	void ParseCommonArg(const FString& Arg, FCommonArgs& InOutArgs);
+
+	// Parses a Name=1,2,3 list into OutValues clamped to [Min, Max], returns false and leaves OutValues alone if the argument isn't Name=
+	bool ParseIntList(const FString& Arg, const TCHAR* Name, TArray<int32>& OutValues, int32 Min = 1, int32 Max = MAX_int32);
+
+	// Fills in ProfilingDir/Folder/Prefix-Date.csv if Out= wasn't passed
+	void SetDefaultOutputPath(FString& InOutPath, const TCHAR* Folder, const TCHAR* Prefix);
+
+	// Writes the CSV and logs where it went
+	bool SaveCsv(const TCHAR* CommandName, const FString& Csv, const FString& OutputPath);
+
+	// Writes the CSV and logs both the path and the results
+	void SaveAndLogResults(const TCHAR* CommandName, const FString& Csv, const FString& OutputPath);
+
+	void QuitIfRequested(const FCommonArgs& Args);
+}
+
+#endif
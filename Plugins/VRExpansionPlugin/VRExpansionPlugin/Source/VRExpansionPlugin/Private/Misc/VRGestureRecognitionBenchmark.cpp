@@ -0,0 +1,520 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include "VRGestureComponent.h"
+#include "Misc/VRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Times DTW gesture recognition against a generated gesture database, the previous implementation vs the current one
+// The database is filled with random smooth strokes scaled to the database, half of the queries are time warped noisy
+// copies of a database gesture (with older unrelated samples trailing them like the recording buffer has) and the
+// other half are unrelated strokes. Every mode runs the same queries, the match each one picks is compared against
+// the previous implementation. The banded mode is allowed to differ, the band changes which paths are considered.
+//
+// The PerFrame modes replay the first FrameQueries queries one sample at a time the way the recording buffer fills up
+// and run both the full recognition and the streaming columns on every sample. For those rows Queries is the number of
+// frames, Speedup is against BatchPerFrame with the same max slope and MatchesPrevious is the number of frames the
+// streaming path picked the same gesture as the full recognition. The streaming columns fill the table the other way
+// around so they are only expected to agree every frame when the slope limit never kicks in (NoSlopeLimit) and the
+// scale is exact, the other rows show how far apart the defaults are.
+//
+// Usage: vr.GestureRecognitionBenchmark [Gestures=100] [Queries=200] [Iterations=5] [Band=8] [FrameQueries=20] [Seed=0] [Out=Path.csv] [Quit]
+namespace VRGestureRecognitionBenchmark
+{
+	// Previous recognition path, kept as it was before the DTW rework (by value gestures, per cell scaling, full table)
+	namespace PreviousPath
+	{
+		static inline float GetGestureDistance(FVector Seq1, FVector Seq2, bool bMirrorGesture = false)
+		{
+			if (bMirrorGesture)
+			{
+				return FVector::DistSquared(Seq1, FVector(Seq2.X, -Seq2.Y, Seq2.Z));
+			}
+
+			return FVector::DistSquared(Seq1, Seq2);
+		}
+
+		static float dtw(FVRGesture seq1, FVRGesture seq2, bool bMirrorGesture, float Scaler, int maxSlope)
+		{
+			int RowCount = seq1.Samples.Num() + 1;
+			int ColumnCount = seq2.Samples.Num() + 1;
+
+			TArray<float> LookupTable;
+			LookupTable.AddZeroed(ColumnCount * RowCount);
+
+			TArray<int> SlopeI;
+			SlopeI.AddZeroed(ColumnCount * RowCount);
+			TArray<int> SlopeJ;
+			SlopeJ.AddZeroed(ColumnCount * RowCount);
+
+			for (int i = 1; i < (ColumnCount * RowCount); i++)
+			{
+				LookupTable[i] = MAX_FLT;
+			}
+
+			int icol = 0, icolneg = 0;
+
+			for (int i = 1; i < RowCount; i++)
+			{
+				for (int j = 1; j < ColumnCount; j++)
+				{
+					icol = i * ColumnCount;
+					icolneg = icol - ColumnCount;
+
+					if (
+						LookupTable[icol + (j - 1)] < LookupTable[icolneg + (j - 1)] &&
+						LookupTable[icol + (j - 1)] < LookupTable[icolneg + j] &&
+						SlopeI[icol + (j - 1)] < maxSlope)
+					{
+						LookupTable[icol + j] = GetGestureDistance(seq1.Samples[i - 1] * Scaler, seq2.Samples[j - 1], bMirrorGesture) + LookupTable[icol + j - 1];
+						SlopeI[icol + j] = SlopeJ[icol + j - 1] + 1;
+						SlopeJ[icol + j] = 0;
+					}
+					else if (
+						LookupTable[icolneg + j] < LookupTable[icolneg + j - 1] &&
+						LookupTable[icolneg + j] < LookupTable[icol + j - 1] &&
+						SlopeJ[icolneg + j] < maxSlope)
+					{
+						LookupTable[icol + j] = GetGestureDistance(seq1.Samples[i - 1] * Scaler, seq2.Samples[j - 1], bMirrorGesture) + LookupTable[icolneg + j];
+						SlopeI[icol + j] = 0;
+						SlopeJ[icol + j] = SlopeJ[icolneg + j] + 1;
+					}
+					else
+					{
+						LookupTable[icol + j] = GetGestureDistance(seq1.Samples[i - 1] * Scaler, seq2.Samples[j - 1], bMirrorGesture) + LookupTable[icolneg + j - 1];
+						SlopeI[icol + j] = 0;
+						SlopeJ[icol + j] = 0;
+					}
+				}
+			}
+
+			float bestMatch = FLT_MAX;
+
+			for (int i = 1; i < seq1.Samples.Num() + 1; i++)
+			{
+				if (LookupTable[(i*ColumnCount) + seq2.Samples.Num()] < bestMatch)
+					bestMatch = LookupTable[(i*ColumnCount) + seq2.Samples.Num()];
+			}
+
+			return bestMatch;
+		}
+
+		static int32 RecognizeGesture(FVRGesture inputGesture, UGesturesDatabase* GesturesDB, EVRGestureMirrorMode MirroringHand, int maxSlope)
+		{
+			float minDist = MAX_FLT;
+
+			int OutGestureIndex = -1;
+			bool bMirrorGesture = false;
+
+			FVector Size = inputGesture.GestureSize.GetSize();
+			float Scaler = GesturesDB->TargetGestureScale / Size.GetMax();
+			float FinalScaler = Scaler;
+
+			for (int i = 0; i < GesturesDB->Gestures.Num(); i++)
+			{
+				FVRGesture &exampleGesture = GesturesDB->Gestures[i];
+
+				if (!exampleGesture.GestureSettings.bEnabled || exampleGesture.Samples.Num() < 1 || inputGesture.Samples.Num() < exampleGesture.GestureSettings.Minimum_Gesture_Length)
+					continue;
+
+				FinalScaler = exampleGesture.GestureSettings.bEnableScaling ? Scaler : 1.f;
+
+				bMirrorGesture = (MirroringHand != EVRGestureMirrorMode::GES_NoMirror && MirroringHand != EVRGestureMirrorMode::GES_MirrorBoth && MirroringHand == exampleGesture.GestureSettings.MirrorMode);
+
+				if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+				{
+					float d = dtw(inputGesture, exampleGesture, bMirrorGesture, FinalScaler, maxSlope) / (exampleGesture.Samples.Num());
+					if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
+					{
+						minDist = d;
+						OutGestureIndex = i;
+					}
+				}
+				else if (exampleGesture.GestureSettings.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth)
+				{
+					bMirrorGesture = true;
+					if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+					{
+						float d = dtw(inputGesture, exampleGesture, bMirrorGesture, FinalScaler, maxSlope) / (exampleGesture.Samples.Num());
+						if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
+						{
+							minDist = d;
+							OutGestureIndex = i;
+						}
+					}
+				}
+			}
+
+			return OutGestureIndex;
+		}
+	}
+
+	enum class EMode : uint8
+	{
+		Previous,
+		Current,
+		CurrentBanded,
+		CurrentParallel,
+		Count
+	};
+
+	enum class EFrameMode : uint8
+	{
+		BatchPerFrame,
+		StreamingPerFrame,
+		StreamingPerFrameExactScale,
+		BatchPerFrameNoSlopeLimit,
+		StreamingPerFrameNoSlopeLimit,
+		Count
+	};
+
+	static const TCHAR* GetModeName(EMode Mode)
+	{
+		switch (Mode)
+		{
+		case EMode::Previous: return TEXT("Previous");
+		case EMode::Current: return TEXT("Current");
+		case EMode::CurrentBanded: return TEXT("CurrentBanded");
+		case EMode::CurrentParallel: return TEXT("CurrentParallel");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	static const TCHAR* GetFrameModeName(EFrameMode Mode)
+	{
+		switch (Mode)
+		{
+		case EFrameMode::BatchPerFrame: return TEXT("BatchPerFrame");
+		case EFrameMode::StreamingPerFrame: return TEXT("StreamingPerFrame");
+		case EFrameMode::StreamingPerFrameExactScale: return TEXT("StreamingPerFrameExactScale");
+		case EFrameMode::BatchPerFrameNoSlopeLimit: return TEXT("BatchPerFrameNoSlopeLimit");
+		case EFrameMode::StreamingPerFrameNoSlopeLimit: return TEXT("StreamingPerFrameNoSlopeLimit");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	struct FQuery
+	{
+		FVRGesture Gesture;
+
+		// Database gesture this was made from, INDEX_NONE for unrelated strokes
+		int32 SourceIndex = INDEX_NONE;
+	};
+
+	// Smooth random walk starting at the origin
+	static void MakeStroke(FRandomStream& Stream, int32 NumSamples, TArray<FVector>& OutSamples)
+	{
+		OutSamples.Reset(NumSamples);
+
+		FVector Position = FVector::ZeroVector;
+		FVector Direction = Stream.GetUnitVector();
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			OutSamples.Add(Position);
+			Direction = (Direction + Stream.GetUnitVector() * 0.35f).GetSafeNormal();
+			Position += Direction * 5.f;
+		}
+	}
+
+	static void BuildDatabase(UGesturesDatabase* Database, int32 NumGestures, FRandomStream& Stream)
+	{
+		Database->Gestures.Reset(NumGestures);
+
+		for (int32 i = 0; i < NumGestures; ++i)
+		{
+			FVRGesture& Gesture = Database->Gestures.AddDefaulted_GetRef();
+			Gesture.Name = FString::Printf(TEXT("Gesture_%d"), i);
+			Gesture.GestureType = (uint8)(i % 256);
+			MakeStroke(Stream, Stream.RandRange(30, 60), Gesture.Samples);
+			Gesture.GestureSize = FBox(ForceInit);
+		}
+
+		Database->RecalculateGestures(true);
+	}
+
+	static void BuildQueries(const UGesturesDatabase* Database, int32 NumQueries, FRandomStream& Stream, TArray<FQuery>& OutQueries)
+	{
+		OutQueries.Reset(NumQueries);
+
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			FQuery& Query = OutQueries.AddDefaulted_GetRef();
+			TArray<FVector>& Samples = Query.Gesture.Samples;
+
+			if (i % 2 == 0 && Database->Gestures.Num() > 0)
+			{
+				// Resampled at a random speed with some jitter, in the database scale
+				Query.SourceIndex = Stream.RandRange(0, Database->Gestures.Num() - 1);
+				const TArray<FVector>& Source = Database->Gestures[Query.SourceIndex].Samples;
+				const float Step = Stream.FRandRange(0.75f, 1.25f);
+
+				for (float Time = 0.f; Time <= Source.Num() - 1; Time += Step)
+				{
+					const int32 Index = FMath::FloorToInt(Time);
+					const FVector Sample = FMath::Lerp(Source[Index], Source[FMath::Min(Index + 1, Source.Num() - 1)], Time - Index);
+					Samples.Add(Sample + Stream.GetUnitVector() * Stream.FRandRange(0.f, 2.f));
+				}
+
+				// Older samples the recording buffer still holds behind the gesture, the hand idling near where it started
+				const FVector IdlePosition = Samples.Last();
+				const int32 NumTrailing = Stream.RandRange(0, 15);
+				for (int32 j = 0; j < NumTrailing; ++j)
+				{
+					Samples.Add(IdlePosition + Stream.GetUnitVector() * Stream.FRandRange(0.f, 3.f));
+				}
+			}
+			else
+			{
+				MakeStroke(Stream, Stream.RandRange(30, 75), Samples);
+				for (FVector& Sample : Samples)
+				{
+					Sample *= 4.f;
+				}
+			}
+
+			Query.Gesture.GestureSize = FBox(Samples);
+		}
+	}
+
+	struct FFrameResult
+	{
+		int32 NumFrames = 0;
+		double TotalMs = 0.0;
+		int32 NumRecognized = 0;
+		int32 NumRecognizedSource = 0;
+		TArray<int32> Matches;
+	};
+
+	// Replays each query into the components sample buffer oldest sample first and recognizes after every sample
+	static FFrameResult RunPerFrame(UVRGestureComponent* GestureComponent, const TArray<FQuery>& Queries, int32 NumFrameQueries, bool bStreaming)
+	{
+		FFrameResult Result;
+
+		for (int32 QueryIndex = 0; QueryIndex < NumFrameQueries; ++QueryIndex)
+		{
+			const FQuery& Query = Queries[QueryIndex];
+			FVRGesture& GestureLog = GestureComponent->GestureLog;
+
+			GestureLog.Samples.Reset();
+			GestureLog.GestureSize = FBox(ForceInit);
+			GestureComponent->ResetStreamingRecognition();
+
+			for (int32 SampleIndex = Query.Gesture.Samples.Num() - 1; SampleIndex >= 0; --SampleIndex)
+			{
+				if (GestureLog.Samples.Num() >= GestureComponent->RecordingBufferSize)
+				{
+					GestureLog.Samples.Pop(false);
+				}
+
+				GestureLog.Samples.Insert(Query.Gesture.Samples[SampleIndex], 0);
+				GestureLog.GestureSize += Query.Gesture.Samples[SampleIndex];
+
+				float Distance = MAX_FLT;
+				const uint64 Start = FPlatformTime::Cycles64();
+				const int32 Match = bStreaming ? GestureComponent->FindBestStreamingGestureMatch(Distance) : GestureComponent->FindBestGestureMatch(GestureLog, Distance);
+				Result.TotalMs += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+				Result.Matches.Add(Match);
+				Result.NumRecognized += Match != INDEX_NONE ? 1 : 0;
+				Result.NumRecognizedSource += (Match != INDEX_NONE && Match == Query.SourceIndex) ? 1 : 0;
+				++Result.NumFrames;
+			}
+		}
+
+		return Result;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		int32 NumGestures = 100;
+		int32 NumQueries = 200;
+		int32 NumIterations = 5;
+		int32 BandWidth = 8;
+		int32 NumFrameQueries = 20;
+		int32 Seed = 0;
+		VRBenchmarkUtils::FCommonArgs Common;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Gestures="), NumGestures);
+			FParse::Value(*Arg, TEXT("Queries="), NumQueries);
+			FParse::Value(*Arg, TEXT("Iterations="), NumIterations);
+			FParse::Value(*Arg, TEXT("Band="), BandWidth);
+			FParse::Value(*Arg, TEXT("FrameQueries="), NumFrameQueries);
+			FParse::Value(*Arg, TEXT("Seed="), Seed);
+			VRBenchmarkUtils::ParseCommonArg(Arg, Common);
+		}
+
+		NumGestures = FMath::Max(NumGestures, 1);
+		NumQueries = FMath::Max(NumQueries, 1);
+		NumIterations = FMath::Max(NumIterations, 1);
+		BandWidth = FMath::Max(BandWidth, 1);
+		NumFrameQueries = FMath::Clamp(NumFrameQueries, 0, NumQueries);
+
+		VRBenchmarkUtils::SetDefaultOutputPath(Common.OutputPath, TEXT("GestureRecognitionBenchmark"), TEXT("GestureRecognitionBenchmark"));
+
+		FRandomStream Stream(Seed);
+
+		TStrongObjectPtr<UGesturesDatabase> Database(NewObject<UGesturesDatabase>(GetTransientPackage()));
+		BuildDatabase(Database.Get(), NumGestures, Stream);
+
+		TArray<FQuery> Queries;
+		BuildQueries(Database.Get(), NumQueries, Stream, Queries);
+
+		TStrongObjectPtr<UVRGestureComponent> GestureComponent(NewObject<UVRGestureComponent>(GetTransientPackage()));
+		GestureComponent->GesturesDB = Database.Get();
+
+		TArray<int32> PreviousMatches;
+		double PreviousMs = 0.0;
+
+		const int32 DefaultMaxSlope = GestureComponent->maxSlope;
+
+		FString Csv = TEXT("Mode,Gestures,Queries,Iterations,Band,TotalMs,AvgUsPerRecognition,Speedup,Recognized,RecognizedSource,MatchesPrevious,MaxSlope\n");
+
+		for (uint8 ModeIndex = 0; ModeIndex < (uint8)EMode::Count; ++ModeIndex)
+		{
+			const EMode Mode = (EMode)ModeIndex;
+
+			GestureComponent->DTWBandWidth = Mode == EMode::CurrentBanded ? BandWidth : 0;
+			GestureComponent->bParallelRecognition = Mode == EMode::CurrentParallel;
+			GestureComponent->ParallelRecognitionMinGestures = 1;
+			GestureComponent->GestureEnvelopes.Reset();
+
+			TArray<int32> Matches;
+			Matches.Init(INDEX_NONE, Queries.Num());
+
+			const uint64 Start = FPlatformTime::Cycles64();
+
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (int32 i = 0; i < Queries.Num(); ++i)
+				{
+					if (Mode == EMode::Previous)
+					{
+						Matches[i] = PreviousPath::RecognizeGesture(Queries[i].Gesture, Database.Get(), GestureComponent->MirroringHand, GestureComponent->maxSlope);
+					}
+					else
+					{
+						float Distance = MAX_FLT;
+						Matches[i] = GestureComponent->FindBestGestureMatch(Queries[i].Gesture, Distance);
+					}
+				}
+			}
+
+			const double TotalMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+			if (Mode == EMode::Previous)
+			{
+				PreviousMatches = Matches;
+				PreviousMs = TotalMs;
+			}
+
+			int32 NumRecognized = 0;
+			int32 NumRecognizedSource = 0;
+			int32 NumMatchesPrevious = 0;
+			for (int32 i = 0; i < Queries.Num(); ++i)
+			{
+				NumRecognized += Matches[i] != INDEX_NONE ? 1 : 0;
+				NumRecognizedSource += (Matches[i] != INDEX_NONE && Matches[i] == Queries[i].SourceIndex) ? 1 : 0;
+				NumMatchesPrevious += Matches[i] == PreviousMatches[i] ? 1 : 0;
+			}
+
+			if (Mode == EMode::Current && NumMatchesPrevious != Queries.Num())
+			{
+				UE_LOG(LogVRBenchmark, Warning, TEXT("vr.GestureRecognitionBenchmark: Current path picked a different gesture than the previous path for %d of %d queries"), Queries.Num() - NumMatchesPrevious, Queries.Num());
+			}
+
+			Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%.3f,%.3f,%.2f,%d,%d,%d,%d\n"),
+				GetModeName(Mode),
+				NumGestures,
+				Queries.Num(),
+				NumIterations,
+				GestureComponent->DTWBandWidth,
+				TotalMs,
+				(TotalMs * 1000.0) / (Queries.Num() * NumIterations),
+				TotalMs > 0.0 ? PreviousMs / TotalMs : 0.0,
+				NumRecognized,
+				NumRecognizedSource,
+				NumMatchesPrevious,
+				GestureComponent->maxSlope);
+		}
+
+		if (NumFrameQueries > 0)
+		{
+			// Hold the whole query so that nothing is popped before the gesture in it is complete
+			int32 MaxQueryLength = 1;
+			for (int32 i = 0; i < NumFrameQueries; ++i)
+			{
+				MaxQueryLength = FMath::Max(MaxQueryLength, Queries[i].Gesture.Samples.Num());
+			}
+
+			const float DefaultRescaleTolerance = GestureComponent->StreamingRescaleTolerance;
+			GestureComponent->RecordingBufferSize = MaxQueryLength;
+			GestureComponent->DTWBandWidth = 0;
+			GestureComponent->bParallelRecognition = false;
+
+			FFrameResult BatchResult;
+			for (uint8 ModeIndex = 0; ModeIndex < (uint8)EFrameMode::Count; ++ModeIndex)
+			{
+				const EFrameMode Mode = (EFrameMode)ModeIndex;
+				const bool bStreaming = Mode == EFrameMode::StreamingPerFrame || Mode == EFrameMode::StreamingPerFrameExactScale || Mode == EFrameMode::StreamingPerFrameNoSlopeLimit;
+				const bool bNoSlopeLimit = Mode == EFrameMode::BatchPerFrameNoSlopeLimit || Mode == EFrameMode::StreamingPerFrameNoSlopeLimit;
+
+				GestureComponent->maxSlope = bNoSlopeLimit ? MAX_int32 : DefaultMaxSlope;
+				GestureComponent->StreamingRescaleTolerance = Mode == EFrameMode::StreamingPerFrame ? DefaultRescaleTolerance : 0.f;
+
+				const FFrameResult Result = RunPerFrame(GestureComponent.Get(), Queries, NumFrameQueries, bStreaming);
+				if (!bStreaming)
+				{
+					BatchResult = Result;
+				}
+
+				int32 NumMatchesBatch = 0;
+				for (int32 i = 0; i < Result.Matches.Num(); ++i)
+				{
+					NumMatchesBatch += Result.Matches[i] == BatchResult.Matches[i] ? 1 : 0;
+				}
+
+				if (bStreaming && NumMatchesBatch != Result.NumFrames)
+				{
+					UE_LOG(LogVRBenchmark, Warning, TEXT("vr.GestureRecognitionBenchmark: %s picked a different gesture than the full recognition on %d of %d frames"), GetFrameModeName(Mode), Result.NumFrames - NumMatchesBatch, Result.NumFrames);
+				}
+
+				Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%.3f,%.3f,%.2f,%d,%d,%d,%d\n"),
+					GetFrameModeName(Mode),
+					NumGestures,
+					Result.NumFrames,
+					1,
+					0,
+					Result.TotalMs,
+					Result.NumFrames > 0 ? (Result.TotalMs * 1000.0) / Result.NumFrames : 0.0,
+					Result.TotalMs > 0.0 ? BatchResult.TotalMs / Result.TotalMs : 0.0,
+					Result.NumRecognized,
+					Result.NumRecognizedSource,
+					NumMatchesBatch,
+					GestureComponent->maxSlope);
+			}
+
+			GestureComponent->maxSlope = DefaultMaxSlope;
+			GestureComponent->StreamingRescaleTolerance = DefaultRescaleTolerance;
+		}
+
+		VRBenchmarkUtils::SaveAndLogResults(TEXT("vr.GestureRecognitionBenchmark"), Csv, Common.OutputPath);
+		VRBenchmarkUtils::QuitIfRequested(Common);
+	}
+
+	static FAutoConsoleCommand GestureRecognitionBenchmarkCommand(
+		TEXT("vr.GestureRecognitionBenchmark"),
+		TEXT("Times DTW gesture recognition against a generated gesture database with the previous and current implementations, checks the streaming columns against the full recognition per frame and writes the results to a CSV in the profiling directory.\n")
+		TEXT("Args: Gestures=100 Queries=200 Iterations=5 Band=8 FrameQueries=20 Seed=0 Out=Path.csv Quit"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
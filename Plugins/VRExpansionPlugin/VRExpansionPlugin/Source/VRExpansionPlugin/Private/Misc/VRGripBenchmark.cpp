@@ -0,0 +1,264 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/Parse.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "GripMotionControllerComponent.h"
+#include "Grippables/GrippableStaticMeshActor.h"
+#include "Grippables/GrippableSphereComponent.h"
+#include "Misc/VRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Headless grip throughput benchmark, works with -nullrhi so it can be run on build machines
+// Spawns grip targets for a set of controllers, grips them with every EGripCollisionType and ticks the grips manually
+// Results are written as CSV so that they can be tracked over time
+// The memory column comes from the low level memory tracker and needs -llm, it is the net growth during the grip tick
+// (allocations from every thread, transient ones freed in the same tick don't show up) and stays at 0 without it.
+// LLM adds a cost to every allocation, so compare tick times from runs without -llm
+//
+// Usage: vr.GripBenchmark [Controllers=8] [Actors=4] [Spheres=4] [Frames=120] [Out=Path.csv] [Quit]
+// Example CI run: UE4Editor <Project> <Map> -game -nullrhi -unattended -ExecCmds="vr.GripBenchmark Quit"
+namespace VRGripBenchmark
+{
+	struct FSettings
+	{
+		int32 NumControllers = 8;
+		int32 NumActors = 4;
+		int32 NumSpheres = 4;
+		int32 NumFrames = 120;
+		float DeltaTime = 1.0f / 90.0f;
+		VRBenchmarkUtils::FCommonArgs Common;
+	};
+
+	struct FResult
+	{
+		EGripCollisionType CollisionType;
+		int32 NumGrips = 0;
+		int32 NumPhysicsHandles = 0;
+		double GripSetupUs = 0.0;
+		double TickUsAvg = 0.0;
+		double TickUsMax = 0.0;
+		double LLMBytesPerFrame = 0.0;
+		double PhysicsHandleUpdateUs = 0.0;
+	};
+
+	static FResult RunCollisionType(UWorld* World, UStaticMesh* TargetMesh, const FSettings& Settings, EGripCollisionType CollisionType)
+	{
+		FResult Result;
+		Result.CollisionType = CollisionType;
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		AActor* Host = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		USceneComponent* HostRoot = NewObject<USceneComponent>(Host, TEXT("BenchmarkRoot"));
+		HostRoot->SetMobility(EComponentMobility::Movable);
+		Host->SetRootComponent(HostRoot);
+		HostRoot->RegisterComponent();
+
+		TArray<UGripMotionControllerComponent*> Controllers;
+		TArray<AActor*> SpawnedActors;
+		TArray<TPair<UGripMotionControllerComponent*, UObject*>> Grips;
+
+		for (int32 c = 0; c < Settings.NumControllers; ++c)
+		{
+			UGripMotionControllerComponent* Controller = NewObject<UGripMotionControllerComponent>(Host);
+			Controller->bUseWithoutTracking = true;
+			Controller->SetupAttachment(HostRoot);
+			Controller->SetRelativeLocation(FVector(0.f, c * 100.f, 0.f));
+			Controller->RegisterComponent();
+			Controllers.Add(Controller);
+
+			// Spread targets out so they don't collide with each other
+			const FVector ControllerLoc = Controller->GetComponentLocation();
+
+			for (int32 a = 0; a < Settings.NumActors; ++a)
+			{
+				FTransform SpawnTransform(ControllerLoc + FVector(20.f + a * 30.f, 0.f, 0.f));
+				AGrippableStaticMeshActor* Target = World->SpawnActor<AGrippableStaticMeshActor>(AGrippableStaticMeshActor::StaticClass(), SpawnTransform, SpawnParams);
+				if (Target && Target->GetStaticMeshComponent())
+				{
+					Target->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+					Target->GetStaticMeshComponent()->SetStaticMesh(TargetMesh);
+					Target->GetStaticMeshComponent()->SetWorldScale3D(FVector(0.1f));
+					SpawnedActors.Add(Target);
+					Grips.Add(TPair<UGripMotionControllerComponent*, UObject*>(Controller, Target));
+				}
+			}
+
+			if (Settings.NumSpheres > 0)
+			{
+				AActor* SphereHost = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(ControllerLoc), SpawnParams);
+				SpawnedActors.Add(SphereHost);
+
+				for (int32 s = 0; s < Settings.NumSpheres; ++s)
+				{
+					UGrippableSphereComponent* Sphere = NewObject<UGrippableSphereComponent>(SphereHost);
+					Sphere->SetSphereRadius(4.f);
+					Sphere->SetMobility(EComponentMobility::Movable);
+					Sphere->SetWorldLocation(ControllerLoc + FVector(20.f + s * 30.f, 0.f, 50.f));
+					Sphere->RegisterComponent();
+					Grips.Add(TPair<UGripMotionControllerComponent*, UObject*>(Controller, Sphere));
+				}
+			}
+		}
+
+		// Grip setup, includes SetUpPhysicsHandle for the physics based types
+		const uint64 SetupStart = FPlatformTime::Cycles64();
+		for (TPair<UGripMotionControllerComponent*, UObject*>& Grip : Grips)
+		{
+			FTransform WorldOffset = FTransform::Identity;
+			if (AActor* TargetActor = Cast<AActor>(Grip.Value))
+				WorldOffset = TargetActor->GetActorTransform();
+			else if (USceneComponent* TargetComp = Cast<USceneComponent>(Grip.Value))
+				WorldOffset = TargetComp->GetComponentTransform();
+
+			Grip.Key->GripObject(Grip.Value, WorldOffset, false, NAME_None, NAME_None, CollisionType,
+				EGripLateUpdateSettings::LateUpdatesAlwaysOff, EGripMovementReplicationSettings::ForceClientSideMovement);
+		}
+		Result.GripSetupUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - SetupStart) * 1000.0;
+
+		for (UGripMotionControllerComponent* Controller : Controllers)
+		{
+			Result.NumGrips += Controller->GrippedObjects.Num() + Controller->LocallyGrippedObjects.Num();
+			Result.NumPhysicsHandles += Controller->PhysicsGrips.Num();
+		}
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		const bool bTrackMemory = FLowLevelMemTracker::IsEnabled();
+#endif
+
+		double TotalTickUs = 0.0;
+		int64 TotalTrackedBytes = 0;
+		for (int32 Frame = 0; Frame < Settings.NumFrames; ++Frame)
+		{
+			// Sway the controllers so the grips have work to do every frame
+			HostRoot->SetWorldLocationAndRotation(FVector(FMath::Sin(Frame * 0.1f) * 10.f, 0.f, 0.f), FRotator(0.f, Frame * 0.5f, 0.f));
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+			const int64 TrackedStart = bTrackMemory ? (int64)FLowLevelMemTracker::Get().GetTotalTrackedMemory(ELLMTracker::Default) : 0;
+#endif
+
+			const uint64 TickStart = FPlatformTime::Cycles64();
+			for (UGripMotionControllerComponent* Controller : Controllers)
+			{
+				Controller->TickGrip(Settings.DeltaTime);
+			}
+			const double TickUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - TickStart) * 1000.0;
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+			if (bTrackMemory)
+			{
+				TotalTrackedBytes += (int64)FLowLevelMemTracker::Get().GetTotalTrackedMemory(ELLMTracker::Default) - TrackedStart;
+			}
+#endif
+
+			TotalTickUs += TickUs;
+			Result.TickUsMax = FMath::Max(Result.TickUsMax, TickUs);
+		}
+
+		if (Settings.NumFrames > 0)
+		{
+			Result.TickUsAvg = TotalTickUs / Settings.NumFrames;
+			Result.LLMBytesPerFrame = (double)TotalTrackedBytes / Settings.NumFrames;
+		}
+
+		// Isolated physics handle cost, one update per handle
+		if (Result.NumPhysicsHandles > 0)
+		{
+			const uint64 HandleStart = FPlatformTime::Cycles64();
+			for (UGripMotionControllerComponent* Controller : Controllers)
+			{
+				const FTransform ControllerTransform = Controller->GetComponentTransform();
+				for (const FBPActorGripInformation& Grip : Controller->GrippedObjects)
+				{
+					Controller->UpdatePhysicsHandleTransform(Grip, Grip.RelativeTransform * ControllerTransform);
+				}
+				for (const FBPActorGripInformation& Grip : Controller->LocallyGrippedObjects)
+				{
+					Controller->UpdatePhysicsHandleTransform(Grip, Grip.RelativeTransform * ControllerTransform);
+				}
+			}
+			Result.PhysicsHandleUpdateUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - HandleStart) * 1000.0 / Result.NumPhysicsHandles;
+		}
+
+		for (TPair<UGripMotionControllerComponent*, UObject*>& Grip : Grips)
+		{
+			Grip.Key->DropObject(Grip.Value, 0, false);
+		}
+
+		for (AActor* SpawnedActor : SpawnedActors)
+		{
+			SpawnedActor->Destroy();
+		}
+
+		Host->Destroy();
+		return Result;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			UE_LOG(LogVRBenchmark, Warning, TEXT("vr.GripBenchmark: No world to run in."));
+			return;
+		}
+
+		FSettings Settings;
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Controllers="), Settings.NumControllers);
+			FParse::Value(*Arg, TEXT("Actors="), Settings.NumActors);
+			FParse::Value(*Arg, TEXT("Spheres="), Settings.NumSpheres);
+			FParse::Value(*Arg, TEXT("Frames="), Settings.NumFrames);
+			VRBenchmarkUtils::ParseCommonArg(Arg, Settings.Common);
+		}
+
+		Settings.NumControllers = FMath::Max(1, Settings.NumControllers);
+		Settings.NumActors = FMath::Max(0, Settings.NumActors);
+		Settings.NumSpheres = FMath::Max(0, Settings.NumSpheres);
+		Settings.NumFrames = FMath::Max(1, Settings.NumFrames);
+
+		VRBenchmarkUtils::SetDefaultOutputPath(Settings.Common.OutputPath, TEXT("GripBenchmark"), TEXT("GripBenchmark"));
+
+		UStaticMesh* TargetMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+		const UEnum* CollisionEnum = StaticEnum<EGripCollisionType>();
+		FString Csv = TEXT("CollisionType,Controllers,Grips,PhysicsHandles,Frames,GripSetupUs,TickUsAvg,TickUsMax,LLMBytesPerFrame,PhysicsHandleUpdateUs\n");
+
+		for (int32 i = 0; i < CollisionEnum->NumEnums() - 1; ++i)
+		{
+			const EGripCollisionType CollisionType = (EGripCollisionType)CollisionEnum->GetValueByIndex(i);
+			const FResult Result = RunCollisionType(World, TargetMesh, Settings, CollisionType);
+
+			Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%.2f,%.2f,%.2f,%.1f,%.3f\n"),
+				*CollisionEnum->GetNameStringByIndex(i),
+				Settings.NumControllers,
+				Result.NumGrips,
+				Result.NumPhysicsHandles,
+				Settings.NumFrames,
+				Result.GripSetupUs,
+				Result.TickUsAvg,
+				Result.TickUsMax,
+				Result.LLMBytesPerFrame,
+				Result.PhysicsHandleUpdateUs);
+		}
+
+		VRBenchmarkUtils::SaveAndLogResults(TEXT("vr.GripBenchmark"), Csv, Settings.Common.OutputPath);
+		VRBenchmarkUtils::QuitIfRequested(Settings.Common);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs GripBenchmarkCommand(
+		TEXT("vr.GripBenchmark"),
+		TEXT("Runs the headless grip benchmark for every grip collision type and writes a CSV to the profiling directory.\n")
+		TEXT("Args: Controllers=8 Actors=4 Spheres=4 Frames=120 Out=Path.csv Quit"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
@@ -0,0 +1,264 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+#include "UObject/CoreNet.h"
+#include "UObject/UnrealType.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetSerialization.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/RepLayout.h"
+#include "VRBPDatatypes.h"
+#include "Misc/VRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Server side cost of replicating the grip arrays for a pawn holding many grips, the old plain TArray property vs the fast array
+// Every frame a single grip has its stiffness changed, which is the case that used to dirty the whole array.
+//
+// Needs a server world with a connected client (listen server PIE with 2 players is enough), the serializers write through
+// the worlds net driver and the first client connections package map so object references are real net GUIDs.
+//
+// FastArray drives the real FBPGripInformationArray::NetDeltaSerialize with an FNetDeltaSerializeInfo, an FNetBitWriter and the
+// base state from the previous frame, the same as the object replicator does for an immediately acked connection.
+// The per property delta of changed items needs the changelist that only the object replicator keeps, outside of it the
+// serializer sends changed items whole (its fallback for connections that don't support it), so the bits are an upper bound.
+//
+// TArray is the old property path, every replicated leaf property of every grip is compared against the shadow state and the
+// changed leaves are net serialized into the same writer, the way the rep layout walks its flattened array element commands.
+// Only the rep layout handle / array size framing is estimated.
+//
+// Usage: vr.GripReplicationBenchmark [Counts=2,8,32,128] [Frames=500] [Out=Path.csv] [Quit]
+namespace VRGripReplicationBenchmark
+{
+	// Rough rep layout framing costs, the property payloads themselves are serialized
+	static const int32 HandleBits = 8;
+	static const int32 ArrayNumBits = 16;
+
+	// Compares every replicated leaf under the struct and serializes the ones that changed, returns the number of changed leaves
+	static int32 SerializeChangedLeaves(const UStruct* Struct, void* NewData, const void* OldData, FNetBitWriter& Writer, UPackageMap* PackageMap)
+	{
+		int32 NumChanged = 0;
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			if (It->HasAnyPropertyFlags(CPF_RepSkip))
+				continue;
+
+			for (int32 i = 0; i < It->ArrayDim; ++i)
+			{
+				void* NewValue = It->ContainerPtrToValuePtr<void>(NewData, i);
+				const void* OldValue = It->ContainerPtrToValuePtr<void>(OldData, i);
+
+				// The rep layout flattens structs without a native net serializer into their members
+				const FStructProperty* StructProperty = CastField<FStructProperty>(*It);
+				if (StructProperty && !(StructProperty->Struct->StructFlags & STRUCT_NetSerializeNative))
+				{
+					NumChanged += SerializeChangedLeaves(StructProperty->Struct, NewValue, OldValue, Writer, PackageMap);
+					continue;
+				}
+
+				if (It->Identical(NewValue, OldValue))
+					continue;
+
+				++NumChanged;
+				Writer.WriteIntWrapped(0, 1 << HandleBits);
+				It->NetSerializeItem(Writer, PackageMap, NewValue);
+			}
+		}
+
+		return NumChanged;
+	}
+
+	static FBPActorGripInformation MakeGrip(int32 Index, UObject* GrippedObject)
+	{
+		FBPActorGripInformation Grip;
+		Grip.GripID = (uint8)(1 + (Index % 254));
+		Grip.GrippedObject = GrippedObject;
+		Grip.GripCollisionType = EGripCollisionType::ManipulationGrip;
+		Grip.RelativeTransform = FTransform(FRotator(0.f, Index * 3.f, 0.f), FVector(Index, 2.f, 3.f));
+		Grip.SlotName = Index % 2 ? FName(TEXT("VRGripP1")) : NAME_None;
+		return Grip;
+	}
+
+	struct FResult
+	{
+		int32 NumGrips = 0;
+		double TArrayUs = 0.0;
+		double FastArrayUs = 0.0;
+		double TArrayBits = 0.0;
+		double FastArrayBits = 0.0;
+		int32 FastArrayFramesSent = 0;
+	};
+
+	static FResult RunCount(int32 NumGrips, int32 NumFrames, UNetDriver* NetDriver, UNetConnection* Connection)
+	{
+		FResult Result;
+		Result.NumGrips = NumGrips;
+
+		UPackageMap* PackageMap = Connection->PackageMap;
+		UObject* GrippedObject = Connection->PlayerController;
+
+		// The writer is big enough for a full send of the largest count, reset between serializations
+		FNetBitWriter Writer(PackageMap, 1024 * 1024 * 8);
+
+		// Plain TArray with the shadow state the rep layout compares against, starts out in sync
+		TArray<FBPActorGripInformation> Grips;
+		TArray<FBPActorGripInformation> Shadow;
+
+		// Fast array with the base state the replicator keeps per connection
+		FBPGripInformationArray FastGrips;
+		TSharedPtr<INetDeltaBaseState> FastArrayBaseState;
+		FNetSerializeCB NetSerializeCB(NetDriver);
+
+		for (int32 i = 0; i < NumGrips; ++i)
+		{
+			Grips.Add(MakeGrip(i, GrippedObject));
+			FastGrips.Add(MakeGrip(i, GrippedObject));
+		}
+
+		Shadow = Grips;
+
+		auto SerializeFastArray = [&]() -> int64
+		{
+			Writer.Reset();
+
+			TSharedPtr<INetDeltaBaseState> NewState;
+			FNetDeltaSerializeInfo Parms;
+			Parms.Writer = &Writer;
+			Parms.Map = PackageMap;
+			Parms.Object = GrippedObject;
+			Parms.OldState = FastArrayBaseState.Get();
+			Parms.NewState = &NewState;
+			Parms.NetSerializeCB = &NetSerializeCB;
+
+			const bool bWroteChanges = FastGrips.NetDeltaSerialize(Parms);
+
+			// Acked straight away
+			if (NewState.IsValid())
+			{
+				FastArrayBaseState = NewState;
+			}
+
+			return bWroteChanges ? Writer.GetNumBits() : 0;
+		};
+
+		// Initial full send so both paths start from a replicated state
+		SerializeFastArray();
+
+		double TArrayUs = 0.0;
+		double FastUs = 0.0;
+		int64 TArrayBits = 0;
+		int64 FastBits = 0;
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const int32 ChangedIndex = Frame % NumGrips;
+			const float NewStiffness = 1000.f + Frame;
+
+			// TArray, every grip gets compared every net update
+			{
+				Grips[ChangedIndex].Stiffness = NewStiffness;
+
+				Writer.Reset();
+				const uint64 Start = FPlatformTime::Cycles64();
+				int32 NumChangedElements = 0;
+				for (int32 i = 0; i < Grips.Num(); ++i)
+				{
+					if (SerializeChangedLeaves(FBPActorGripInformation::StaticStruct(), &Grips[i], &Shadow[i], Writer, PackageMap) > 0)
+					{
+						++NumChangedElements;
+						Shadow[i] = Grips[i];
+					}
+				}
+				TArrayUs += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0;
+
+				if (NumChangedElements > 0)
+				{
+					// Array handle, size, then an element handle and terminator per changed element and the array terminator
+					TArrayBits += HandleBits + ArrayNumBits + NumChangedElements * HandleBits * 2 + HandleBits + Writer.GetNumBits();
+				}
+			}
+
+			// Fast array, only the marked grip is looked at past its key
+			{
+				FastGrips[ChangedIndex].Stiffness = NewStiffness;
+				FastGrips.MarkItemDirty(FastGrips[ChangedIndex]);
+
+				const uint64 Start = FPlatformTime::Cycles64();
+				const int64 FrameBits = SerializeFastArray();
+				FastUs += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0;
+
+				if (FrameBits > 0)
+				{
+					FastBits += FrameBits;
+					++Result.FastArrayFramesSent;
+				}
+			}
+		}
+
+		Result.TArrayUs = TArrayUs / NumFrames;
+		Result.FastArrayUs = FastUs / NumFrames;
+		Result.TArrayBits = (double)TArrayBits / NumFrames;
+		Result.FastArrayBits = (double)FastBits / NumFrames;
+		return Result;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+		UNetConnection* Connection = (NetDriver && NetDriver->IsServer() && NetDriver->ClientConnections.Num() > 0) ? NetDriver->ClientConnections[0] : nullptr;
+
+		if (!Connection || !Connection->PackageMap)
+		{
+			UE_LOG(LogVRBenchmark, Warning, TEXT("vr.GripReplicationBenchmark: Needs to be run on a server with a connected client (listen server PIE with 2 players works)"));
+			return;
+		}
+
+		TArray<int32> Counts = { 2, 8, 32, 128 };
+		int32 NumFrames = 500;
+		VRBenchmarkUtils::FCommonArgs Common;
+
+		for (const FString& Arg : Args)
+		{
+			// Grip IDs are a byte
+			VRBenchmarkUtils::ParseIntList(Arg, TEXT("Counts="), Counts, 1, 254);
+			FParse::Value(*Arg, TEXT("Frames="), NumFrames);
+			VRBenchmarkUtils::ParseCommonArg(Arg, Common);
+		}
+
+		NumFrames = FMath::Max(1, NumFrames);
+
+		VRBenchmarkUtils::SetDefaultOutputPath(Common.OutputPath, TEXT("GripReplicationBenchmark"), TEXT("GripReplicationBenchmark"));
+
+		FString Csv = TEXT("Grips,Frames,TArrayUsAvg,FastArrayUsAvg,TArrayBitsAvg,FastArrayBitsAvg,FastArrayFramesSent\n");
+
+		for (int32 NumGrips : Counts)
+		{
+			const FResult Result = RunCount(NumGrips, NumFrames, NetDriver, Connection);
+
+			Csv += FString::Printf(TEXT("%d,%d,%.3f,%.3f,%.1f,%.1f,%d\n"),
+				Result.NumGrips,
+				NumFrames,
+				Result.TArrayUs,
+				Result.FastArrayUs,
+				Result.TArrayBits,
+				Result.FastArrayBits,
+				Result.FastArrayFramesSent);
+		}
+
+		VRBenchmarkUtils::SaveAndLogResults(TEXT("vr.GripReplicationBenchmark"), Csv, Common.OutputPath);
+		VRBenchmarkUtils::QuitIfRequested(Common);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs GripReplicationBenchmarkCommand(
+		TEXT("vr.GripReplicationBenchmark"),
+		TEXT("Serializes the grip arrays through the real fast array NetDeltaSerialize and the old per property TArray path at several grip counts on a server with a connected client, and writes a CSV to the profiling directory.\n")
+		TEXT("Args: Counts=2,8,32,128 Frames=500 Out=Path.csv Quit"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
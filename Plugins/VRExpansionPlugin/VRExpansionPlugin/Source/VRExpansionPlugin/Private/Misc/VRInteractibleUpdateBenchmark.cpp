@@ -0,0 +1,246 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Containers/Ticker.h"
+#include "Misc/Parse.h"
+#include "RenderCore.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Interactibles/VRDialComponent.h"
+#include "Misc/VRInteractibleUpdateSubsystem.h"
+#include "Misc/VRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Game thread cost of a scene full of interactibles where only a few are doing anything, per component ticks vs the update subsystem
+// Spawns Idle + Active dials, the active ones are set lerping back slowly enough that they stay awake for the whole run.
+// Each mode is measured over the same number of frames against a baseline with no interactibles spawned, the spawn
+// cost is recorded as well since that is where the per component tick functions get registered.
+// Needs a running game world, frame times include everything else in the level so run it on an empty map.
+//
+// Usage: vr.InteractibleUpdateBenchmark [Idle=1500] [Active=50] [Frames=300] [Out=Path.csv] [Quit]
+namespace VRInteractibleUpdateBenchmark
+{
+	static const int32 WarmupFrames = 10;
+
+	enum class EPhase : uint8
+	{
+		Baseline,
+		PerComponentTicks,
+		Batched,
+		Done
+	};
+
+	static const TCHAR* GetPhaseName(EPhase Phase)
+	{
+		switch (Phase)
+		{
+		case EPhase::Baseline: return TEXT("Baseline");
+		case EPhase::PerComponentTicks: return TEXT("PerComponentTicks");
+		case EPhase::Batched: return TEXT("Batched");
+		default: return TEXT("Done");
+		}
+	}
+
+	struct FPhaseResult
+	{
+		EPhase Phase = EPhase::Baseline;
+		double SpawnMs = 0.0;
+		double GameThreadMsTotal = 0.0;
+		int32 NumSamples = 0;
+		int32 NumAwake = 0;
+	};
+
+	struct FBenchmarkRun
+	{
+		TWeakObjectPtr<UWorld> World;
+		TWeakObjectPtr<AActor> SpawnedActor;
+		int32 NumIdle = 1500;
+		int32 NumActive = 50;
+		int32 NumFrames = 300;
+		VRBenchmarkUtils::FCommonArgs Common;
+
+		int32 PreviousBatchedUpdates = 1;
+		EPhase Phase = EPhase::Baseline;
+		int32 PhaseFrame = 0;
+		TArray<FPhaseResult> Results;
+	};
+
+	static void SetBatchedUpdates(int32 Value)
+	{
+		if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("vr.InteractibleBatchedUpdates")))
+		{
+			CVar->Set(Value, ECVF_SetByCode);
+		}
+	}
+
+	static int32 GetBatchedUpdates()
+	{
+		IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("vr.InteractibleBatchedUpdates"));
+		return CVar ? CVar->GetInt() : 1;
+	}
+
+	static void SpawnInteractibles(FBenchmarkRun& Run, FPhaseResult& Result)
+	{
+		UWorld* World = Run.World.Get();
+		AActor* Actor = World->SpawnActor<AActor>();
+		USceneComponent* Root = NewObject<USceneComponent>(Actor, TEXT("Root"));
+		Actor->SetRootComponent(Root);
+		Root->RegisterComponent();
+		Run.SpawnedActor = Actor;
+
+		const uint64 Start = FPlatformTime::Cycles64();
+
+		for (int32 i = 0; i < Run.NumIdle + Run.NumActive; ++i)
+		{
+			UVRDialComponent* Dial = NewObject<UVRDialComponent>(Actor);
+			Dial->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			Dial->SetupAttachment(Root);
+			Dial->SetRelativeLocation(FVector((i % 64) * 10.f, (i / 64) * 10.f, 0.f));
+			Dial->RegisterComponent();
+
+			if (i >= Run.NumIdle)
+			{
+				// Far enough out and slow enough back that it is still lerping when the phase ends
+				Dial->DialReturnSpeed = 0.01f;
+				Dial->SetDialAngle(90.f);
+				Dial->bIsLerping = true;
+				UVRInteractibleUpdateSubsystem::SetInteractibleAwake(Dial, true);
+			}
+		}
+
+		Result.SpawnMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+		if (UVRInteractibleUpdateSubsystem* Subsystem = World->GetSubsystem<UVRInteractibleUpdateSubsystem>())
+		{
+			Result.NumAwake = Subsystem->GetNumActiveInteractibles();
+		}
+	}
+
+	static void WriteResults(const FBenchmarkRun& Run)
+	{
+		FString Csv = TEXT("Mode,Idle,Active,Frames,SpawnMs,GameThreadMsAvg,OverBaselineMsAvg,SubsystemAwake\n");
+
+		const double BaselineMs = Run.Results.Num() > 0 && Run.Results[0].NumSamples > 0 ? Run.Results[0].GameThreadMsTotal / Run.Results[0].NumSamples : 0.0;
+
+		for (const FPhaseResult& Result : Run.Results)
+		{
+			const double AvgMs = Result.NumSamples > 0 ? Result.GameThreadMsTotal / Result.NumSamples : 0.0;
+			const bool bIsBaseline = Result.Phase == EPhase::Baseline;
+
+			Csv += FString::Printf(TEXT("%s,%d,%d,%d,%.3f,%.4f,%.4f,%d\n"),
+				GetPhaseName(Result.Phase),
+				bIsBaseline ? 0 : Run.NumIdle,
+				bIsBaseline ? 0 : Run.NumActive,
+				Result.NumSamples,
+				Result.SpawnMs,
+				AvgMs,
+				AvgMs - BaselineMs,
+				Result.NumAwake);
+		}
+
+		VRBenchmarkUtils::SaveAndLogResults(TEXT("vr.InteractibleUpdateBenchmark"), Csv, Run.Common.OutputPath);
+	}
+
+	// Driven from the core ticker so that every sample is a full engine frame
+	static bool StepRun(float DeltaTime, TSharedRef<FBenchmarkRun> Run)
+	{
+		if (!Run->World.IsValid())
+		{
+			UE_LOG(LogVRBenchmark, Warning, TEXT("vr.InteractibleUpdateBenchmark: World went away, aborting"));
+			SetBatchedUpdates(Run->PreviousBatchedUpdates);
+			return false;
+		}
+
+		if (Run->PhaseFrame == 0)
+		{
+			FPhaseResult& Result = Run->Results.AddDefaulted_GetRef();
+			Result.Phase = Run->Phase;
+
+			if (Run->Phase != EPhase::Baseline)
+			{
+				// The mode is picked up when the components register
+				SetBatchedUpdates(Run->Phase == EPhase::Batched ? 1 : 0);
+				SpawnInteractibles(*Run, Result);
+			}
+		}
+		else if (Run->PhaseFrame > WarmupFrames)
+		{
+			// Time of the last completed frame
+			FPhaseResult& Result = Run->Results.Last();
+			Result.GameThreadMsTotal += FPlatformTime::ToMilliseconds(GGameThreadTime);
+			++Result.NumSamples;
+		}
+
+		if (++Run->PhaseFrame <= WarmupFrames + Run->NumFrames)
+			return true;
+
+		if (AActor* Actor = Run->SpawnedActor.Get())
+		{
+			Actor->Destroy();
+		}
+
+		Run->SpawnedActor.Reset();
+		Run->PhaseFrame = 0;
+		Run->Phase = (EPhase)((uint8)Run->Phase + 1);
+
+		if (Run->Phase != EPhase::Done)
+			return true;
+
+		SetBatchedUpdates(Run->PreviousBatchedUpdates);
+		WriteResults(*Run);
+		VRBenchmarkUtils::QuitIfRequested(Run->Common);
+
+		return false;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		TSharedRef<FBenchmarkRun> NewRun = MakeShared<FBenchmarkRun>();
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Idle="), NewRun->NumIdle);
+			FParse::Value(*Arg, TEXT("Active="), NewRun->NumActive);
+			FParse::Value(*Arg, TEXT("Frames="), NewRun->NumFrames);
+			VRBenchmarkUtils::ParseCommonArg(Arg, NewRun->Common);
+		}
+
+		NewRun->NumIdle = FMath::Max(0, NewRun->NumIdle);
+		NewRun->NumActive = FMath::Max(0, NewRun->NumActive);
+		NewRun->NumFrames = FMath::Max(1, NewRun->NumFrames);
+
+		VRBenchmarkUtils::SetDefaultOutputPath(NewRun->Common.OutputPath, TEXT("InteractibleUpdateBenchmark"), TEXT("InteractibleUpdateBenchmark"));
+
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (World && World->IsGameWorld() && World->HasBegunPlay())
+			{
+				NewRun->World = World;
+				break;
+			}
+		}
+
+		if (!NewRun->World.IsValid())
+		{
+			UE_LOG(LogVRBenchmark, Warning, TEXT("vr.InteractibleUpdateBenchmark: Needs a game world that has begun play"));
+			return;
+		}
+
+		NewRun->PreviousBatchedUpdates = GetBatchedUpdates();
+		FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&StepRun, NewRun));
+	}
+
+	static FAutoConsoleCommand InteractibleUpdateBenchmarkCommand(
+		TEXT("vr.InteractibleUpdateBenchmark"),
+		TEXT("Measures the game thread cost of many idle and a few active interactibles with per component ticks and with the interactible update subsystem, and writes a CSV to the profiling directory.\n")
+		TEXT("Args: Idle=1500 Active=50 Frames=300 Out=Path.csv Quit"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
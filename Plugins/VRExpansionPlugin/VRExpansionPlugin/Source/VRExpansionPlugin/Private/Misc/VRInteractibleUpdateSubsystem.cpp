@@ -0,0 +1,241 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/VRInteractibleUpdateSubsystem.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Interactibles ~ UpdateActive"), STAT_InteractiblesUpdateActive, STATGROUP_VRInteractibles);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Interactibles"), STAT_InteractiblesActive, STATGROUP_VRInteractibles);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Interactibles Woken"), STAT_InteractiblesWoken, STATGROUP_VRInteractibles);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Interactibles Slept"), STAT_InteractiblesSlept, STATGROUP_VRInteractibles);
+
+// CVars
+namespace InteractibleUpdateCvars
+{
+	static int32 BatchedUpdates = 1;
+	FAutoConsoleVariableRef CVarInteractibleBatchedUpdates(
+		TEXT("vr.InteractibleBatchedUpdates"),
+		BatchedUpdates,
+		TEXT("If 1 interactible components registered in game worlds are updated by the interactible update subsystem and have no tick function of their own.\n")
+		TEXT("0: Every interactible keeps its own tick function. Only applies to components registered after the change"),
+		ECVF_Default);
+}
+
+void UVRInteractibleUpdateSubsystem::Deinitialize()
+{
+	ActiveComponents.Empty();
+	ActiveIndices.Empty();
+	SuspendedComponents.Empty();
+	NumClearedSlots = 0;
+
+	Super::Deinitialize();
+}
+
+void UVRInteractibleUpdateSubsystem::RegisterInteractible(UActorComponent* InComponent)
+{
+	if (!InComponent)
+		return;
+
+	UWorld* World = InComponent->GetWorld();
+	if (!World || !World->IsGameWorld())
+		return;
+
+	const UActorComponent* DefaultComponent = InComponent->GetClass()->GetDefaultObject<UActorComponent>();
+	if (!DefaultComponent->PrimaryComponentTick.bCanEverTick)
+		return;
+
+	UVRInteractibleUpdateSubsystem* Subsystem = World->GetSubsystem<UVRInteractibleUpdateSubsystem>();
+
+	// Blueprint Event Tick needs the tick function to fire
+	const bool bHasBlueprintTick = InComponent->GetClass()->IsFunctionImplementedInScript(FName(TEXT("ReceiveTick")));
+	const bool bManaged = InteractibleUpdateCvars::BatchedUpdates > 0 && !bHasBlueprintTick && Subsystem != nullptr;
+
+	// Tick functions are registered after OnRegister, so this decides whether one exists at all
+	InComponent->PrimaryComponentTick.bCanEverTick = !bManaged;
+
+	// Re-registering (re-attaching, construction script re-runs, level streaming) picks up where it left off
+	// so lerping, momentum and held interactibles don't freeze in place
+	if (Subsystem && Subsystem->SuspendedComponents.Remove(InComponent) > 0)
+	{
+		if (bManaged)
+		{
+			// Not registered yet, the update pass puts it back to sleep if registering doesn't finish
+			Subsystem->ActiveIndices.Add(InComponent, Subsystem->ActiveComponents.Add(InComponent));
+			INC_DWORD_STAT(STAT_InteractiblesWoken);
+		}
+		else
+		{
+			// Kept when the tick function is registered
+			InComponent->SetComponentTickEnabled(true);
+		}
+	}
+}
+
+void UVRInteractibleUpdateSubsystem::UnregisterInteractible(UActorComponent* InComponent)
+{
+	if (!InComponent)
+		return;
+
+	if (UWorld* World = InComponent->GetWorld())
+	{
+		if (UVRInteractibleUpdateSubsystem* Subsystem = World->GetSubsystem<UVRInteractibleUpdateSubsystem>())
+		{
+			const bool bWasAwake = Subsystem->IsInteractibleAwake(InComponent);
+			Subsystem->SleepInteractible(InComponent);
+
+			// Remember it for RegisterInteractible unless it is going away for good
+			if (bWasAwake && !InComponent->IsBeingDestroyed() && !InComponent->IsPendingKill())
+			{
+				Subsystem->SuspendedComponents.Add(InComponent);
+			}
+		}
+	}
+}
+
+void UVRInteractibleUpdateSubsystem::SetInteractibleAwake(UActorComponent* InComponent, bool bAwake)
+{
+	if (!InComponent)
+		return;
+
+	if (!IsManagedInteractible(InComponent))
+	{
+		InComponent->SetComponentTickEnabled(bAwake);
+		return;
+	}
+
+	if (UWorld* World = InComponent->GetWorld())
+	{
+		if (UVRInteractibleUpdateSubsystem* Subsystem = World->GetSubsystem<UVRInteractibleUpdateSubsystem>())
+		{
+			if (bAwake)
+				Subsystem->WakeInteractible(InComponent);
+			else
+				Subsystem->SleepInteractible(InComponent);
+		}
+	}
+}
+
+bool UVRInteractibleUpdateSubsystem::IsManagedInteractible(const UActorComponent* InComponent)
+{
+	if (!InComponent || InComponent->PrimaryComponentTick.bCanEverTick)
+		return false;
+
+	return InComponent->GetClass()->GetDefaultObject<UActorComponent>()->PrimaryComponentTick.bCanEverTick;
+}
+
+void UVRInteractibleUpdateSubsystem::WakeInteractible(UActorComponent* InComponent)
+{
+	if (!InComponent || !InComponent->IsRegistered() || ActiveIndices.Contains(InComponent))
+		return;
+
+	ActiveIndices.Add(InComponent, ActiveComponents.Add(InComponent));
+	INC_DWORD_STAT(STAT_InteractiblesWoken);
+}
+
+void UVRInteractibleUpdateSubsystem::SleepInteractible(UActorComponent* InComponent)
+{
+	int32 Index = INDEX_NONE;
+	if (!ActiveIndices.RemoveAndCopyValue(InComponent, Index))
+		return;
+
+	INC_DWORD_STAT(STAT_InteractiblesSlept);
+
+	// Leave the layout alone while the update pass is walking it
+	if (bIsUpdating)
+	{
+		ActiveComponents[Index] = nullptr;
+		++NumClearedSlots;
+		return;
+	}
+
+	ActiveComponents.RemoveAtSwap(Index, 1, false);
+	if (ActiveComponents.IsValidIndex(Index))
+	{
+		ActiveIndices.FindChecked(ActiveComponents[Index]) = Index;
+	}
+}
+
+void UVRInteractibleUpdateSubsystem::CompactActiveComponents()
+{
+	ActiveComponents.RemoveAllSwap([](const UActorComponent* Component) { return Component == nullptr; }, false);
+
+	// Garbage collection can null out slots as well, so rebuild rather than patch
+	ActiveIndices.Reset();
+	for (int32 i = 0; i < ActiveComponents.Num(); ++i)
+	{
+		ActiveIndices.Add(ActiveComponents[i], i);
+	}
+
+	NumClearedSlots = 0;
+}
+
+void UVRInteractibleUpdateSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractiblesUpdateActive);
+	SET_DWORD_STAT(STAT_InteractiblesActive, ActiveIndices.Num());
+
+	bIsUpdating = true;
+
+	// Components woken during the pass start updating next frame, the same as enabling a tick function mid frame would
+	const int32 NumToUpdate = ActiveComponents.Num();
+	for (int32 i = 0; i < NumToUpdate; ++i)
+	{
+		UActorComponent* Component = ActiveComponents[i];
+		if (!Component)
+		{
+			++NumClearedSlots;
+			continue;
+		}
+
+		if (!Component->IsRegistered() || Component->IsPendingKill())
+		{
+			SleepInteractible(Component);
+			continue;
+		}
+
+		// Match the dilation the components tick function would have applied
+		const AActor* Owner = Component->GetOwner();
+		Component->TickComponent(Owner ? DeltaTime * Owner->CustomTimeDilation : DeltaTime, LEVELTICK_All, nullptr);
+	}
+
+	bIsUpdating = false;
+
+	if (NumClearedSlots > 0)
+	{
+		CompactActiveComponents();
+	}
+}
+
+bool UVRInteractibleUpdateSubsystem::IsTickable() const
+{
+	return ActiveComponents.Num() > 0;
+}
+
+UWorld* UVRInteractibleUpdateSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+bool UVRInteractibleUpdateSubsystem::IsTickableInEditor() const
+{
+	return false;
+}
+
+bool UVRInteractibleUpdateSubsystem::IsTickableWhenPaused() const
+{
+	return false;
+}
+
+ETickableTickType UVRInteractibleUpdateSubsystem::GetTickableTickType() const
+{
+	if (IsTemplate(RF_ClassDefaultObject))
+		return ETickableTickType::Never;
+
+	return ETickableTickType::Conditional;
+}
+
+TStatId UVRInteractibleUpdateSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRInteractibleUpdateSubsystem, STATGROUP_Tickables);
+}
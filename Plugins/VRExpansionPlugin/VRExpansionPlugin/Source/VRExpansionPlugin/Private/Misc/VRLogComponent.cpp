@@ -2,10 +2,170 @@
 
 #include "Misc/VRLogComponent.h"
 #include "Engine/Engine.h"
+#include "RHICommandList.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
 
 /* Top of File */
 #define LOCTEXT_NAMESPACE "VRLogComponent" 
 
+namespace VRLogComponentStatics
+{
+	// Raw messages from other threads are clipped to this so the pending queue stays bounded
+	static const int32 MaxPendingMessageLength = 16384;
+}
+
+void FVROutputLogHistory::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category)
+{
+	if (Verbosity == ELogVerbosity::SetColor)
+	{
+		// Skip Color Events
+		return;
+	}
+
+	if (IsInGameThread())
+	{
+		// Keep ordering with anything that was logged from other threads first
+		FlushPendingMessages();
+		CreateLogMessages(V, Verbosity, Category);
+		return;
+	}
+
+	// Other threads only queue the raw message, it gets split into lines when the game thread flushes
+	if (NumPendingLogs.Increment() > FMath::Max(MaxStoredMessages, 1))
+	{
+		NumPendingLogs.Decrement();
+		return;
+	}
+
+	FPendingLog PendingLog;
+	PendingLog.Message = FString(V).Left(VRLogComponentStatics::MaxPendingMessageLength);
+	PendingLog.Verbosity = Verbosity;
+	PendingLog.Category = Category;
+	PendingLogs.Enqueue(MoveTemp(PendingLog));
+}
+
+void FVROutputLogHistory::FlushPendingMessages()
+{
+	check(IsInGameThread());
+
+	FPendingLog PendingLog;
+	while (PendingLogs.Dequeue(PendingLog))
+	{
+		NumPendingLogs.Decrement();
+		CreateLogMessages(*PendingLog.Message, PendingLog.Verbosity, PendingLog.Category);
+	}
+}
+
+void FVROutputLogHistory::CreateLogMessages(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category)
+{
+	FName Style;
+	if (Category == NAME_Cmd)
+	{
+		Style = FName(TEXT("Log.Command"));
+	}
+	else if (Verbosity == ELogVerbosity::Error)
+	{
+		Style = FName(TEXT("Log.Error"));
+	}
+	else if (Verbosity == ELogVerbosity::Warning)
+	{
+		Style = FName(TEXT("Log.Warning"));
+	}
+	else
+	{
+		Style = FName(TEXT("Log.Normal"));
+	}
+
+	// Forget timestamps, I don't care about them and we have limited texture space to draw too
+	// Determine how to format timestamps
+	static ELogTimes::Type LogTimestampMode = ELogTimes::None;
+	/*if (UObjectInitialized() && !GExitPurge)
+	{
+	// Logging can happen very late during shutdown, even after the UObject system has been torn down, hence the init check above
+	LogTimestampMode = GetDefault<UEditorStyleSettings>()->LogTimestampMode;
+	}*/
+
+	// handle multiline strings by breaking them apart by line
+	TArray<FTextRange> LineRanges;
+	FString CurrentLogDump = V;
+	FTextRange::CalculateLineRangesFromString(CurrentLogDump, LineRanges);
+
+	bool bIsFirstLineInMessage = true;
+	for (const FTextRange& LineRange : LineRanges)
+	{
+		if (!LineRange.IsEmpty())
+		{
+			FString Line = CurrentLogDump.Mid(LineRange.BeginIndex, LineRange.Len());
+			Line = Line.ConvertTabsToSpaces(4);
+
+			// Hard-wrap lines to avoid them being too long
+			/*static const */int32 HardWrapLen = MaxLineLength;
+			for (int32 CurrentStartIndex = 0; CurrentStartIndex < Line.Len();)
+			{
+				int32 HardWrapLineLen = 0;
+				if (bIsFirstLineInMessage)
+				{
+					FString MessagePrefix = FOutputDeviceHelper::FormatLogLine(Verbosity, Category, nullptr, LogTimestampMode);
+
+					HardWrapLineLen = FMath::Min(HardWrapLen - MessagePrefix.Len(), Line.Len() - CurrentStartIndex);
+					FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
+
+					AddLine(FVRLogMessage(MessagePrefix + HardWrapLine, Verbosity, Category, Style));
+				}
+				else
+				{
+					HardWrapLineLen = FMath::Min(HardWrapLen, Line.Len() - CurrentStartIndex);
+					FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
+
+					AddLine(FVRLogMessage(MoveTemp(HardWrapLine), Verbosity, Category, Style));
+				}
+
+				bIsFirstLineInMessage = false;
+				CurrentStartIndex += HardWrapLineLen;
+			}
+		}
+	}
+}
+
+void FVROutputLogHistory::AddLine(FVRLogMessage&& Line)
+{
+	const int32 Capacity = FMath::Max(MaxStoredMessages, 1);
+
+	// Capacity changed after we started wrapping, re-order oldest first and trim to fit
+	if (RingHead != 0 && Ring.Num() != Capacity)
+	{
+		TArray<FVRLogMessage> Ordered;
+		Ordered.Reserve(Ring.Num());
+		for (int32 i = 0; i < Ring.Num(); ++i)
+		{
+			Ordered.Add(MoveTemp(Ring[(RingHead + i) % Ring.Num()]));
+		}
+
+		Ring = MoveTemp(Ordered);
+		RingHead = 0;
+	}
+
+	if (Ring.Num() > Capacity)
+	{
+		Ring.RemoveAt(0, Ring.Num() - Capacity, true);
+	}
+
+	if (Ring.Num() < Capacity)
+	{
+		Ring.Add(MoveTemp(Line));
+	}
+	else
+	{
+		// Overwrite the oldest line
+		Ring[RingHead] = MoveTemp(Line);
+		RingHead = (RingHead + 1) % Capacity;
+	}
+
+	++TotalMessages;
+	bIsDirty = true;
+}
+
   //=============================================================================
 UVRLogComponent::UVRLogComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -13,6 +173,11 @@ UVRLogComponent::UVRLogComponent(const FObjectInitializer& ObjectInitializer)
 	PrimaryComponentTick.bCanEverTick = false;
 	MaxLineLength = 130;
 	MaxStoredMessages = 10000;
+	MaxLinesDrawnPerFrame = 0;
+	ScrollScratchTarget = nullptr;
+	LastOutputLogSize = FIntPoint::ZeroValue;
+	LastScrollOffset = 0.0f;
+	LastDrawnMessageCount = 0;
 }
 
 //=============================================================================
@@ -66,6 +231,11 @@ void UVRLogComponent::AppendTextToConsole(FString Text, bool bReturnAtEnd)
 
 bool UVRLogComponent::DrawConsoleToRenderTarget2D(EBPVRConsoleDrawType DrawType, UTextureRenderTarget2D * Texture, float ScrollOffset, bool bForceDraw)
 {
+	if (!Texture)
+		return false;
+
+	OutputLogHistory.FlushPendingMessages();
+
 	if (!bForceDraw && DrawType == EBPVRConsoleDrawType::VRConsole_Draw_OutputLogOnly && !OutputLogHistory.bIsDirty)
 	{
 		return false;
@@ -101,9 +271,34 @@ bool UVRLogComponent::DrawConsoleToRenderTarget2D(EBPVRConsoleDrawType DrawType,
 	switch (DrawType)
 	{
 	//case EBPVRConsoleDrawType::VRConsole_Draw_ConsoleAndOutputLog: DrawConsole(true, Canvas); DrawOutputLog(true, Canvas); break;
-	case EBPVRConsoleDrawType::VRConsole_Draw_ConsoleOnly: DrawConsole(false, Canvas); break;
-	case EBPVRConsoleDrawType::VRConsole_Draw_OutputLogOnly: DrawOutputLog(false, Canvas, ScrollOffset); break;
-	default: break;
+	case EBPVRConsoleDrawType::VRConsole_Draw_ConsoleOnly:
+	{
+		DrawConsole(false, Canvas);
+
+		// The output log that was in this texture is gone, the next output log draw into it can't append
+		if (LastOutputLogTarget.Get() == Texture)
+		{
+			LastOutputLogTarget.Reset();
+		}
+	}break;
+	case EBPVRConsoleDrawType::VRConsole_Draw_OutputLogOnly:
+	{
+		if (bForceDraw || !AppendOutputLog(Canvas, Texture, ScrollOffset))
+		{
+			DrawOutputLog(false, Canvas, ScrollOffset);
+		}
+
+		LastOutputLogTarget = Texture;
+		LastOutputLogSize = FIntPoint(Texture->GetSurfaceWidth(), Texture->GetSurfaceHeight());
+		LastScrollOffset = ScrollOffset;
+	}break;
+	default:
+	{
+		if (LastOutputLogTarget.Get() == Texture)
+		{
+			LastOutputLogTarget.Reset();
+		}
+	}break;
 	}
 
 	// Clean up and flush the rendering canvas.
@@ -163,36 +358,154 @@ void UVRLogComponent::DrawOutputLog(bool bUpperHalf, UCanvas* Canvas, float Scro
 
 	FCanvasTextItem ConsoleText(FVector2D(0, 0 + Height - 5 - yl), FText::FromString(TEXT("")), Font, FColor::Emerald);
 
-	const TArray< TSharedPtr<FVRLogMessage> > LoggedMessages = OutputLogHistory.GetMessages();
+	const int32 NumMessages = OutputLogHistory.Num();
 	
 	int32 ScrollPos = 0;
 
-	if(ScrollOffset > 0 && LoggedMessages.Num() > 1)
-		ScrollPos = FMath::Clamp(FMath::RoundToInt(LoggedMessages.Num() * ScrollOffset ) , 0, LoggedMessages.Num() - 1);
+	if(ScrollOffset > 0 && NumMessages > 1)
+		ScrollPos = FMath::Clamp(FMath::RoundToInt(NumMessages * ScrollOffset ) , 0, NumMessages - 1);
 
 	float Xpos = 0.0f;
 	float Ypos = 0.0f;
-	for (int i = LoggedMessages.Num() - (1 + ScrollPos); i >= 0 && Ypos <= Height - yl; i--)//auto &Message : LoggedMessages)
+	for (int i = NumMessages - (1 + ScrollPos); i >= 0 && Ypos <= Height - yl; i--)//auto &Message : LoggedMessages)
 	{
-		switch (LoggedMessages[i]->Verbosity)
-		{
-
-		case ELogVerbosity::Error:
-		case ELogVerbosity::Fatal: ConsoleText.SetColor(FLinearColor(0.7f,0.1f,0.1f)); break;
-		case ELogVerbosity::Warning: ConsoleText.SetColor(FLinearColor(0.5f,0.5f,0.0f)); break;
-
-		case ELogVerbosity::Log:
-		default: ConsoleText.SetColor(FLinearColor(0.8f,0.8f,0.8f));
-		}
+		// Layout is cached on the message, copying the text is just a ref count
+		const FVRLogMessage& Message = OutputLogHistory.GetMessage(i);
+		ConsoleText.SetColor(Message.Color);
+		ConsoleText.Text = Message.DisplayText;
 
 		Ypos += yl;
-		ConsoleText.Text = FText::Format(NSLOCTEXT("VRLogComponent", "ConsoleFormat", "{0}"), FText::FromString(*LoggedMessages[i]->Message));
 		Canvas->DrawItem(ConsoleText, 0, Height - Ypos);
 	}
 
+	LastDrawnMessageCount = OutputLogHistory.GetTotalMessageCount();
 	OutputLogHistory.bIsDirty = false;
 }
 
+bool UVRLogComponent::AppendOutputLog(UCanvas* Canvas, UTextureRenderTarget2D* Texture, float ScrollOffset)
+{
+	// Only the bottom anchored, un-scrolled view can be appended to
+	if (ScrollOffset > 0.0f || LastScrollOffset > 0.0f || LastOutputLogTarget.Get() != Texture)
+		return false;
+
+	const int32 Width = Texture->GetSurfaceWidth();
+	const int32 Height = Texture->GetSurfaceHeight();
+
+	if (LastOutputLogSize != FIntPoint(Width, Height) || Width <= 0 || Height <= 0)
+		return false;
+
+	const int64 TotalMessages = OutputLogHistory.GetTotalMessageCount();
+	const int64 OldestStored = TotalMessages - OutputLogHistory.Num();
+	const int64 NumNewLines = TotalMessages - LastDrawnMessageCount;
+
+	// Lines we never drew have already been pushed out of the ring
+	if (NumNewLines <= 0 || LastDrawnMessageCount < OldestStored)
+		return false;
+
+	UFont* Font = GEngine->GetSmallFont();
+
+	float xl, yl;
+	Canvas->StrLen(Font, TEXT("M"), xl, yl);
+
+	// Shifting has to land on whole pixels to keep the lines on the same grid as a full redraw
+	if (yl < 1.0f || FMath::Frac(yl) != 0.0f)
+		return false;
+
+	const int32 LineHeight = (int32)yl;
+	const int32 NumVisibleLines = Height / LineHeight;
+
+	int32 NumLinesToDraw = (int32)FMath::Min<int64>(NumNewLines, MAX_int32);
+	if (MaxLinesDrawnPerFrame > 0)
+	{
+		NumLinesToDraw = FMath::Min(NumLinesToDraw, MaxLinesDrawnPerFrame);
+	}
+
+	// A full redraw is no more expensive at this point
+	if (NumLinesToDraw >= NumVisibleLines)
+		return false;
+
+	if (!ScrollScratchTarget || ScrollScratchTarget->SizeX != Width || ScrollScratchTarget->SizeY != Height || ScrollScratchTarget->GetFormat() != Texture->GetFormat())
+	{
+		if (!ScrollScratchTarget)
+		{
+			ScrollScratchTarget = NewObject<UTextureRenderTarget2D>(this);
+		}
+
+		ScrollScratchTarget->RenderTargetFormat = Texture->RenderTargetFormat;
+		ScrollScratchTarget->ClearColor = FLinearColor::Black;
+		ScrollScratchTarget->InitAutoFormat(Width, Height);
+		ScrollScratchTarget->UpdateResourceImmediate(true);
+	}
+
+	FTextureRenderTargetResource* TargetResource = Texture->GameThread_GetRenderTargetResource();
+	FTextureRenderTargetResource* ScratchResource = ScrollScratchTarget->GameThread_GetRenderTargetResource();
+
+	if (!TargetResource || !ScratchResource)
+		return false;
+
+	const int32 ShiftPixels = NumLinesToDraw * LineHeight;
+
+	// Move the existing lines up through the scratch target, a texture can't copy onto an overlapping region of itself
+	// This is queued before any of the canvas draws below so it lands first
+	ENQUEUE_RENDER_COMMAND(VRLogComponent_ScrollOutputLog)(
+		[TargetResource, ScratchResource, ShiftPixels, Width, Height](FRHICommandListImmediate& RHICmdList)
+		{
+			FRHITexture* TargetTexture = TargetResource->GetRenderTargetTexture();
+			FRHITexture* ScratchTexture = ScratchResource->GetRenderTargetTexture();
+
+			if (!TargetTexture || !ScratchTexture)
+				return;
+
+			FRHICopyTextureInfo CopyInfo;
+			CopyInfo.Size = FIntVector(Width, Height - ShiftPixels, 1);
+			CopyInfo.SourcePosition = FIntVector(0, ShiftPixels, 0);
+			CopyInfo.DestPosition = FIntVector(0, 0, 0);
+
+			RHICmdList.Transition({
+				FRHITransitionInfo(TargetTexture, ERHIAccess::Unknown, ERHIAccess::CopySrc),
+				FRHITransitionInfo(ScratchTexture, ERHIAccess::Unknown, ERHIAccess::CopyDest)
+				});
+			RHICmdList.CopyTexture(TargetTexture, ScratchTexture, CopyInfo);
+
+			CopyInfo.SourcePosition = FIntVector(0, 0, 0);
+
+			RHICmdList.Transition({
+				FRHITransitionInfo(ScratchTexture, ERHIAccess::CopyDest, ERHIAccess::CopySrc),
+				FRHITransitionInfo(TargetTexture, ERHIAccess::CopySrc, ERHIAccess::CopyDest)
+				});
+			RHICmdList.CopyTexture(ScratchTexture, TargetTexture, CopyInfo);
+
+			RHICmdList.Transition({
+				FRHITransitionInfo(ScratchTexture, ERHIAccess::CopySrc, ERHIAccess::SRVMask),
+				FRHITransitionInfo(TargetTexture, ERHIAccess::CopyDest, ERHIAccess::SRVMask)
+				});
+		});
+
+	// Clear the strip that the new lines go into
+	FLinearColor BackgroundColor = FColor::Black.ReinterpretAsLinear();
+	BackgroundColor.A = 1.0f;
+	FCanvasTileItem ClearTile(FVector2D(0.0f, (float)(Height - ShiftPixels)), GBlackTexture, FVector2D(Canvas->ClipX, (float)ShiftPixels), FVector2D(0.0f, 0.0f), FVector2D(1.0f, 1.0f), BackgroundColor);
+	ClearTile.BlendMode = SE_BLEND_AlphaBlend;
+	Canvas->DrawItem(ClearTile);
+
+	FCanvasTextItem ConsoleText(FVector2D(0.0f, 0.0f), FText::GetEmpty(), Font, FColor::Emerald);
+
+	// Oldest pending line first, the last one drawn ends up on the bottom row
+	const int64 FirstSequence = LastDrawnMessageCount;
+	for (int32 i = 0; i < NumLinesToDraw; ++i)
+	{
+		const FVRLogMessage& Message = OutputLogHistory.GetMessage((int32)(FirstSequence + i - OldestStored));
+		ConsoleText.SetColor(Message.Color);
+		ConsoleText.Text = Message.DisplayText;
+
+		Canvas->DrawItem(ConsoleText, 0, (float)(Height - (NumLinesToDraw - i) * LineHeight));
+	}
+
+	LastDrawnMessageCount += NumLinesToDraw;
+	OutputLogHistory.bIsDirty = LastDrawnMessageCount < OutputLogHistory.GetTotalMessageCount();
+	return true;
+}
+
 
 
 #undef LOCTEXT_NAMESPACE 
@@ -0,0 +1,395 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
+#include "Engine/World.h"
+#include "UObject/UObjectIterator.h"
+#include "CharacterMovementCompTypes.h"
+#include "VRBaseCharacterMovementComponent.h"
+#include "VRCharacterMovementComponent.h"
+#include "Misc/VRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Client upload report for the VR ServerMove data, the pending / old moves absolute vs delta encoded against the new move
+// Replays recorded client moves through FVRCharacterNetworkMoveDataContainer with vr.DeltaCompressPendingMoves off and on,
+// counts the serialized bits and checks that every value the server decodes from the delta stream is bit identical to
+// what it decodes from the absolute one. Sizes are the move container payload only, without RPC and packet overhead.
+//
+// Record:	vr.MoveDataRecord [Seconds=30] [Out=Path.csv]
+//			Records the saved moves of the locally controlled VR character, needs to run on a connected client
+// Report:	vr.MoveDataDeltaReport File=Path.csv [Pending=1] [OldEvery=0] [OldAge=4] [Out=Path.csv] [Quit]
+//			Pending sends the previous move as the pending move, OldEvery sends an old move OldAge moves back every N packets
+namespace VRMoveDataDeltaReport
+{
+	static const int32 NumColumns = 25;
+
+	// Recorded rows are TimeStamp,Accel XYZ,ControlRotation PYR,Location XYZ,Flags,Mode,VRCapsuleLocation XYZ,LFDiff XYZ,VRCapsuleRotation,CustomVRInput XYZ,RequestedVelocity XYZ
+	struct FRecordedMove
+	{
+		float TimeStamp = 0.f;
+		FVector Acceleration = FVector::ZeroVector;
+		FRotator ControlRotation = FRotator::ZeroRotator;
+		FVector Location = FVector::ZeroVector;
+		uint8 CompressedMoveFlags = 0;
+		uint8 MovementMode = 0;
+		FVector VRCapsuleLocation = FVector::ZeroVector;
+		FVector LFDiff = FVector::ZeroVector;
+		uint16 VRCapsuleRotation = 0;
+		FVector CustomVRInputVector = FVector::ZeroVector;
+		FVector RequestedVelocity = FVector::ZeroVector;
+	};
+
+	struct FResult
+	{
+		int64 TotalBits = 0;
+		int32 NumPackets = 0;
+		int32 NumMismatches = 0;
+	};
+
+	static FVector ParseVector(const TArray<FString>& Columns, int32 Start)
+	{
+		return FVector(FCString::Atof(*Columns[Start]), FCString::Atof(*Columns[Start + 1]), FCString::Atof(*Columns[Start + 2]));
+	}
+
+	static bool LoadRecording(const FString& Path, TArray<FRecordedMove>& OutMoves)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+			return false;
+
+		for (const FString& Line : Lines)
+		{
+			TArray<FString> Columns;
+			Line.ParseIntoArray(Columns, TEXT(","));
+
+			// Skips the header and anything malformed
+			if (Columns.Num() != NumColumns || !Columns[0].IsNumeric())
+				continue;
+
+			FRecordedMove& Move = OutMoves.AddDefaulted_GetRef();
+			Move.TimeStamp = FCString::Atof(*Columns[0]);
+			Move.Acceleration = ParseVector(Columns, 1);
+			Move.ControlRotation = FRotator(FCString::Atof(*Columns[4]), FCString::Atof(*Columns[5]), FCString::Atof(*Columns[6]));
+			Move.Location = ParseVector(Columns, 7);
+			Move.CompressedMoveFlags = (uint8)FCString::Atoi(*Columns[10]);
+			Move.MovementMode = (uint8)FCString::Atoi(*Columns[11]);
+			Move.VRCapsuleLocation = ParseVector(Columns, 12);
+			Move.LFDiff = ParseVector(Columns, 15);
+			Move.VRCapsuleRotation = (uint16)FCString::Atoi(*Columns[18]);
+			Move.CustomVRInputVector = ParseVector(Columns, 19);
+			Move.RequestedVelocity = ParseVector(Columns, 22);
+		}
+
+		return OutMoves.Num() > 0;
+	}
+
+	static void FillMoveData(FCharacterNetworkMoveData* InMoveData, const FRecordedMove& Move)
+	{
+		FVRCharacterNetworkMoveData* MoveData = (FVRCharacterNetworkMoveData*)InMoveData;
+		MoveData->TimeStamp = Move.TimeStamp;
+		MoveData->Acceleration = Move.Acceleration;
+		MoveData->ControlRotation = Move.ControlRotation;
+		MoveData->Location = Move.Location;
+		MoveData->CompressedMoveFlags = Move.CompressedMoveFlags;
+		MoveData->MovementMode = Move.MovementMode;
+		MoveData->MovementBase = nullptr;
+		MoveData->MovementBaseBoneName = NAME_None;
+		MoveData->VRCapsuleLocation = Move.VRCapsuleLocation;
+		MoveData->LFDiff = Move.LFDiff;
+		MoveData->VRCapsuleRotation = Move.VRCapsuleRotation;
+		MoveData->ConditionalMoveReps.CustomVRInputVector = Move.CustomVRInputVector;
+		MoveData->ConditionalMoveReps.RequestedVelocity = Move.RequestedVelocity;
+		MoveData->ConditionalMoveReps.MoveActionArray.Clear();
+	}
+
+	static bool BitsEqual(const FVector& A, const FVector& B)
+	{
+		return FMemory::Memcmp(&A, &B, sizeof(FVector)) == 0;
+	}
+
+	static bool DecodedVRValuesMatch(const FCharacterNetworkMoveData* InA, const FCharacterNetworkMoveData* InB)
+	{
+		const FVRCharacterNetworkMoveData* A = (const FVRCharacterNetworkMoveData*)InA;
+		const FVRCharacterNetworkMoveData* B = (const FVRCharacterNetworkMoveData*)InB;
+
+		return BitsEqual(A->VRCapsuleLocation, B->VRCapsuleLocation) &&
+			BitsEqual(A->LFDiff, B->LFDiff) &&
+			A->VRCapsuleRotation == B->VRCapsuleRotation &&
+			BitsEqual(A->ConditionalMoveReps.CustomVRInputVector, B->ConditionalMoveReps.CustomVRInputVector) &&
+			BitsEqual(A->ConditionalMoveReps.RequestedVelocity, B->ConditionalMoveReps.RequestedVelocity) &&
+			BitsEqual(A->Acceleration, B->Acceleration) &&
+			BitsEqual(A->Location, B->Location);
+	}
+
+	static void SetDeltaCompression(int32 Value)
+	{
+		if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("vr.DeltaCompressPendingMoves")))
+		{
+			CVar->Set(Value, ECVF_SetByCode);
+		}
+	}
+
+	// Sends every packet in both encodings, the absolute decode is the reference the delta decode has to match
+	static void EncodeSession(const TArray<FRecordedMove>& Moves, bool bSendPending, int32 OldEvery, int32 OldAge, FResult& OutAbsolute, FResult& OutDelta)
+	{
+		UCharacterMovementComponent& CharacterMovement = *GetMutableDefault<UVRCharacterMovementComponent>();
+
+		FVRCharacterNetworkMoveDataContainer SendContainer;
+		FVRCharacterNetworkMoveDataContainer AbsoluteReceiveContainer;
+		FVRCharacterNetworkMoveDataContainer DeltaReceiveContainer;
+
+		for (int32 MoveIndex = 0; MoveIndex < Moves.Num(); ++MoveIndex)
+		{
+			SendContainer.bHasPendingMove = bSendPending && MoveIndex > 0;
+			SendContainer.bIsDualHybridRootMotionMove = false;
+			SendContainer.bHasOldMove = OldEvery > 0 && (MoveIndex % OldEvery) == 0 && MoveIndex >= OldAge;
+
+			FillMoveData(SendContainer.GetNewMoveData(), Moves[MoveIndex]);
+
+			if (SendContainer.bHasPendingMove)
+			{
+				FillMoveData(SendContainer.GetPendingMoveData(), Moves[MoveIndex - 1]);
+			}
+
+			if (SendContainer.bHasOldMove)
+			{
+				FillMoveData(SendContainer.GetOldMoveData(), Moves[MoveIndex - OldAge]);
+			}
+
+			FVRCharacterNetworkMoveDataContainer* ReceiveContainers[2] = { &AbsoluteReceiveContainer, &DeltaReceiveContainer };
+			FResult* Results[2] = { &OutAbsolute, &OutDelta };
+
+			for (int32 Mode = 0; Mode < 2; ++Mode)
+			{
+				SetDeltaCompression(Mode);
+
+				FBitWriter Writer(0, true);
+				SendContainer.Serialize(CharacterMovement, Writer, nullptr);
+
+				FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+				ReceiveContainers[Mode]->Serialize(CharacterMovement, Reader, nullptr);
+
+				Results[Mode]->TotalBits += Writer.GetNumBits();
+				++Results[Mode]->NumPackets;
+			}
+
+			bool bMatches = DecodedVRValuesMatch(AbsoluteReceiveContainer.GetNewMoveData(), DeltaReceiveContainer.GetNewMoveData());
+
+			if (SendContainer.bHasPendingMove)
+			{
+				bMatches &= DecodedVRValuesMatch(AbsoluteReceiveContainer.GetPendingMoveData(), DeltaReceiveContainer.GetPendingMoveData());
+			}
+
+			if (SendContainer.bHasOldMove)
+			{
+				bMatches &= DecodedVRValuesMatch(AbsoluteReceiveContainer.GetOldMoveData(), DeltaReceiveContainer.GetOldMoveData());
+			}
+
+			OutDelta.NumMismatches += bMatches ? 0 : 1;
+		}
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		FString InputPath;
+		int32 SendPending = 1;
+		int32 OldEvery = 0;
+		int32 OldAge = 4;
+		VRBenchmarkUtils::FCommonArgs Common;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("File="), InputPath);
+			FParse::Value(*Arg, TEXT("Pending="), SendPending);
+			FParse::Value(*Arg, TEXT("OldEvery="), OldEvery);
+			FParse::Value(*Arg, TEXT("OldAge="), OldAge);
+			VRBenchmarkUtils::ParseCommonArg(Arg, Common);
+		}
+
+		OldEvery = FMath::Max(0, OldEvery);
+		OldAge = FMath::Max(1, OldAge);
+
+		TArray<FRecordedMove> Moves;
+		if (InputPath.IsEmpty() || !LoadRecording(InputPath, Moves))
+		{
+			UE_LOG(LogVRBenchmark, Warning, TEXT("vr.MoveDataDeltaReport: Could not load a recording from \"%s\", record one with vr.MoveDataRecord"), *InputPath);
+			return;
+		}
+
+		VRBenchmarkUtils::SetDefaultOutputPath(Common.OutputPath, TEXT("MoveDataDelta"), TEXT("MoveDataDelta"));
+
+		// Client timestamps reset every few minutes, only count forward steps
+		double SessionSeconds = 0.0;
+		for (int32 i = 1; i < Moves.Num(); ++i)
+		{
+			SessionSeconds += FMath::Max(0.f, Moves[i].TimeStamp - Moves[i - 1].TimeStamp);
+		}
+
+		IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("vr.DeltaCompressPendingMoves"));
+		const int32 PreviousDeltaCompression = CVar ? CVar->GetInt() : 1;
+
+		FResult Absolute;
+		FResult Delta;
+		EncodeSession(Moves, SendPending > 0, OldEvery, OldAge, Absolute, Delta);
+
+		SetDeltaCompression(PreviousDeltaCompression);
+
+		FString Csv = TEXT("Encoding,Packets,Seconds,AvgBitsPerPacket,BytesPerSecond,Savings,Mismatches\n");
+
+		const double AbsoluteBytesPerSecond = SessionSeconds > 0.0 ? (Absolute.TotalBits / 8.0) / SessionSeconds : 0.0;
+		const double DeltaBytesPerSecond = SessionSeconds > 0.0 ? (Delta.TotalBits / 8.0) / SessionSeconds : 0.0;
+
+		Csv += FString::Printf(TEXT("Absolute,%d,%.2f,%.2f,%.1f,0.0%%,0\n"),
+			Absolute.NumPackets,
+			SessionSeconds,
+			Absolute.NumPackets > 0 ? (double)Absolute.TotalBits / Absolute.NumPackets : 0.0,
+			AbsoluteBytesPerSecond);
+
+		Csv += FString::Printf(TEXT("Delta,%d,%.2f,%.2f,%.1f,%.1f%%,%d\n"),
+			Delta.NumPackets,
+			SessionSeconds,
+			Delta.NumPackets > 0 ? (double)Delta.TotalBits / Delta.NumPackets : 0.0,
+			DeltaBytesPerSecond,
+			Absolute.TotalBits > 0 ? (1.0 - (double)Delta.TotalBits / Absolute.TotalBits) * 100.0 : 0.0,
+			Delta.NumMismatches);
+
+		VRBenchmarkUtils::SaveAndLogResults(TEXT("vr.MoveDataDeltaReport"), Csv, Common.OutputPath);
+
+		if (Delta.NumMismatches > 0)
+		{
+			UE_LOG(LogVRBenchmark, Error, TEXT("vr.MoveDataDeltaReport: %d packets decoded differently with delta encoding"), Delta.NumMismatches);
+		}
+
+		VRBenchmarkUtils::QuitIfRequested(Common);
+	}
+
+	static FAutoConsoleCommand MoveDataDeltaReportCommand(
+		TEXT("vr.MoveDataDeltaReport"),
+		TEXT("Replays a move recording through the VR move data container with and without delta encoding of the pending / old moves, verifies the decoded values match and writes the upload rate to a CSV in the profiling directory.\n")
+		TEXT("Args: File=Path.csv Pending=1 OldEvery=0 OldAge=4 Out=Path.csv Quit"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+
+	// Recorder, picks up the moves the client saved during the frame on world post actor tick
+	struct FMoveRecorder
+	{
+		FDelegateHandle TickHandle;
+		FString OutputPath;
+		FString Csv;
+		double EndTime = 0.0;
+		float LastTimeStamp = -1.f;
+		int32 NumRecorded = 0;
+
+		void Sample(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+		{
+			if (!World || !World->IsGameWorld())
+				return;
+
+			for (TObjectIterator<UVRBaseCharacterMovementComponent> It; It; ++It)
+			{
+				ACharacter* CharacterOwner = It->GetCharacterOwner();
+				if (It->GetWorld() != World || !CharacterOwner || !CharacterOwner->IsLocallyControlled() || !It->HasPredictionData_Client())
+					continue;
+
+				FNetworkPredictionData_Client_Character* ClientData = It->GetPredictionData_Client_Character();
+				for (const FSavedMovePtr& SavedMove : ClientData->SavedMoves)
+				{
+					// Timestamps only go backwards by more than a frame when the client resets them
+					if (!SavedMove.IsValid() || (SavedMove->TimeStamp <= LastTimeStamp && SavedMove->TimeStamp + 1.f > LastTimeStamp))
+						continue;
+
+					FVRCharacterNetworkMoveData MoveData;
+					MoveData.ClientFillNetworkMoveData(*SavedMove, FCharacterNetworkMoveData::ENetworkMoveType::NewMove);
+					AddRow(MoveData);
+					LastTimeStamp = SavedMove->TimeStamp;
+				}
+
+				// Only the first local character
+				break;
+			}
+
+			if (World->GetRealTimeSeconds() >= EndTime)
+			{
+				Finish();
+			}
+		}
+
+		void AddRow(const FVRCharacterNetworkMoveData& Move)
+		{
+			Csv += FString::Printf(TEXT("%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%d,%d,%f,%f,%f,%f,%f,%f,%d,%f,%f,%f,%f,%f,%f\n"),
+				Move.TimeStamp,
+				Move.Acceleration.X, Move.Acceleration.Y, Move.Acceleration.Z,
+				Move.ControlRotation.Pitch, Move.ControlRotation.Yaw, Move.ControlRotation.Roll,
+				Move.Location.X, Move.Location.Y, Move.Location.Z,
+				(int32)Move.CompressedMoveFlags,
+				(int32)Move.MovementMode,
+				Move.VRCapsuleLocation.X, Move.VRCapsuleLocation.Y, Move.VRCapsuleLocation.Z,
+				Move.LFDiff.X, Move.LFDiff.Y, Move.LFDiff.Z,
+				(int32)Move.VRCapsuleRotation,
+				Move.ConditionalMoveReps.CustomVRInputVector.X, Move.ConditionalMoveReps.CustomVRInputVector.Y, Move.ConditionalMoveReps.CustomVRInputVector.Z,
+				Move.ConditionalMoveReps.RequestedVelocity.X, Move.ConditionalMoveReps.RequestedVelocity.Y, Move.ConditionalMoveReps.RequestedVelocity.Z);
+
+			++NumRecorded;
+		}
+
+		void Finish()
+		{
+			FWorldDelegates::OnWorldPostActorTick.Remove(TickHandle);
+			TickHandle.Reset();
+
+			if (NumRecorded < 1)
+			{
+				UE_LOG(LogVRBenchmark, Warning, TEXT("vr.MoveDataRecord: No moves were recorded, this needs a locally controlled VR character on a connected client"));
+			}
+
+			if (VRBenchmarkUtils::SaveCsv(TEXT("vr.MoveDataRecord"), Csv, OutputPath))
+			{
+				UE_LOG(LogVRBenchmark, Display, TEXT("vr.MoveDataRecord: Recorded %d moves"), NumRecorded);
+			}
+		}
+	};
+
+	static FMoveRecorder Recorder;
+
+	static void Record(const TArray<FString>& Args, UWorld* World)
+	{
+		if (Recorder.TickHandle.IsValid())
+		{
+			UE_LOG(LogVRBenchmark, Warning, TEXT("vr.MoveDataRecord: Already recording"));
+			return;
+		}
+
+		if (!World)
+			return;
+
+		float Seconds = 30.f;
+		FString OutputPath;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Seconds="), Seconds);
+			FParse::Value(*Arg, TEXT("Out="), OutputPath);
+		}
+
+		VRBenchmarkUtils::SetDefaultOutputPath(OutputPath, TEXT("MoveDataDelta"), TEXT("MoveRecording"));
+
+		Recorder.OutputPath = OutputPath;
+		Recorder.Csv = TEXT("TimeStamp,AccelX,AccelY,AccelZ,Pitch,Yaw,Roll,LocX,LocY,LocZ,Flags,Mode,VRLocX,VRLocY,VRLocZ,LFDiffX,LFDiffY,LFDiffZ,VRRot,InputX,InputY,InputZ,ReqVelX,ReqVelY,ReqVelZ\n");
+		Recorder.LastTimeStamp = -1.f;
+		Recorder.NumRecorded = 0;
+		Recorder.EndTime = World->GetRealTimeSeconds() + FMath::Max(0.1f, Seconds);
+		Recorder.TickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(&Recorder, &FMoveRecorder::Sample);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs MoveDataRecordCommand(
+		TEXT("vr.MoveDataRecord"),
+		TEXT("Records the client moves of the locally controlled VR character for use with vr.MoveDataDeltaReport.\n")
+		TEXT("Args: Seconds=30 Out=Path.csv"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Record));
+}
+
+#endif
@@ -0,0 +1,124 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+#include "Math/RandomStream.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "Grippables/GrippablePhysicsReplication.h"
+#include "Misc/VRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Scaling benchmark for the compute kernel of the server side physics replication tick, ComputeCorrectionsVR only
+// Runs the packed target correction math on synthetic targets single threaded and in parallel chunks
+// It does not need a world or net owners so it can run headless, which also means it does not exercise the gather pass
+// (body / net owner caching) or the apply pass, time those in a real session with "stat VRPhysicsReplication"
+//
+// Usage: vr.PhysicsReplicationBenchmark [Counts=100,500,2000] [Frames=200] [Out=Path.csv] [Quit]
+namespace VRPhysicsReplicationBenchmark
+{
+	struct FResult
+	{
+		int32 NumTargets = 0;
+		double SerialUsAvg = 0.0;
+		double ParallelUsAvg = 0.0;
+	};
+
+	static void BuildTargets(int32 NumTargets, TArray<FReplicatedPhysicsTarget>& OutTargets, TArray<FPhysicsReplicationVR::FPendingTargetVR>& OutPending)
+	{
+		FRandomStream Stream(NumTargets);
+
+		OutTargets.SetNum(NumTargets);
+		OutPending.SetNum(NumTargets);
+
+		for (int32 i = 0; i < NumTargets; ++i)
+		{
+			FReplicatedPhysicsTarget& Target = OutTargets[i];
+			Target.TargetState.Position = Stream.GetUnitVector() * 500.f;
+			Target.TargetState.Quaternion = FQuat(Stream.GetUnitVector(), Stream.FRandRange(0.f, PI));
+			Target.TargetState.LinVel = Stream.GetUnitVector() * 200.f;
+			Target.TargetState.AngVel = Stream.GetUnitVector() * 90.f;
+			Target.TargetState.Flags = ERigidBodyFlags::NeedsUpdate;
+
+			// Current state slightly off of the target so that every entry takes the correction path
+			FPhysicsReplicationVR::FPendingTargetVR& Pending = OutPending[i];
+			Pending.PhysicsTarget = &Target;
+			Pending.bApplyCorrection = true;
+			Pending.CurrentState.Position = Target.TargetState.Position + Stream.GetUnitVector() * 15.f;
+			Pending.CurrentState.Quaternion = FQuat(Stream.GetUnitVector(), 0.2f) * Target.TargetState.Quaternion;
+			Pending.CurrentState.LinVel = Target.TargetState.LinVel;
+			Pending.CurrentState.AngVel = Target.TargetState.AngVel;
+		}
+	}
+
+	static double TimeFrames(int32 NumFrames, float DeltaTime, const FPhysicsReplicationVR::FCorrectionSettingsVR& Settings, TArray<FPhysicsReplicationVR::FPendingTargetVR>& Pending, bool bForceSingleThread)
+	{
+		double TotalUs = 0.0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const uint64 Start = FPlatformTime::Cycles64();
+			FPhysicsReplicationVR::ComputeCorrectionsVR(DeltaTime, Settings, Pending, bForceSingleThread);
+			TotalUs += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0;
+		}
+
+		return NumFrames > 0 ? TotalUs / NumFrames : 0.0;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		TArray<int32> Counts = { 100, 500, 2000 };
+		int32 NumFrames = 200;
+		VRBenchmarkUtils::FCommonArgs Common;
+
+		for (const FString& Arg : Args)
+		{
+			VRBenchmarkUtils::ParseIntList(Arg, TEXT("Counts="), Counts);
+			FParse::Value(*Arg, TEXT("Frames="), NumFrames);
+			VRBenchmarkUtils::ParseCommonArg(Arg, Common);
+		}
+
+		NumFrames = FMath::Max(1, NumFrames);
+
+		VRBenchmarkUtils::SetDefaultOutputPath(Common.OutputPath, TEXT("PhysicsReplicationBenchmark"), TEXT("PhysicsReplicationBenchmark"));
+
+		const FPhysicsReplicationVR::FCorrectionSettingsVR Settings = FPhysicsReplicationVR::FCorrectionSettingsVR::Resolve(UPhysicsSettings::Get()->PhysicErrorCorrection);
+		const float DeltaTime = 1.0f / 60.0f;
+
+		FString Csv = TEXT("Targets,Frames,SerialUsAvg,ParallelUsAvg,Speedup\n");
+
+		TArray<FReplicatedPhysicsTarget> Targets;
+		TArray<FPhysicsReplicationVR::FPendingTargetVR> Pending;
+
+		for (int32 NumTargets : Counts)
+		{
+			FResult Result;
+			Result.NumTargets = NumTargets;
+
+			BuildTargets(NumTargets, Targets, Pending);
+			Result.SerialUsAvg = TimeFrames(NumFrames, DeltaTime, Settings, Pending, true);
+
+			BuildTargets(NumTargets, Targets, Pending);
+			Result.ParallelUsAvg = TimeFrames(NumFrames, DeltaTime, Settings, Pending, false);
+
+			Csv += FString::Printf(TEXT("%d,%d,%.2f,%.2f,%.2f\n"),
+				Result.NumTargets,
+				NumFrames,
+				Result.SerialUsAvg,
+				Result.ParallelUsAvg,
+				Result.ParallelUsAvg > 0.0 ? Result.SerialUsAvg / Result.ParallelUsAvg : 0.0);
+		}
+
+		VRBenchmarkUtils::SaveAndLogResults(TEXT("vr.PhysicsReplicationBenchmark"), Csv, Common.OutputPath);
+		VRBenchmarkUtils::QuitIfRequested(Common);
+	}
+
+	static FAutoConsoleCommand PhysicsReplicationBenchmarkCommand(
+		TEXT("vr.PhysicsReplicationBenchmark"),
+		TEXT("Times only the server side physics replication correction kernel (not the gather / apply passes) at several target counts, single threaded and in parallel, and writes a CSV to the profiling directory.\n")
+		TEXT("Args: Counts=100,500,2000 Frames=200 Out=Path.csv Quit"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
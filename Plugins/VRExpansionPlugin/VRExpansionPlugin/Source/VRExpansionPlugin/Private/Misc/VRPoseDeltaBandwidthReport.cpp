@@ -0,0 +1,316 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Math/RandomStream.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
+#include "Engine/World.h"
+#include "UObject/UObjectIterator.h"
+#include "VRBPDatatypes.h"
+#include "GripMotionControllerComponent.h"
+#include "ReplicatedVRCameraComponent.h"
+#include "Misc/VRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Bandwidth report for the FBPVRComponentPosRep delta stream
+// Encodes recorded tracking data at every EVRVectorQuantization / EVRRotationQuantization level, absolute and delta encoded,
+// and reports the average bits per send along with the largest error the delta stream added over the absolute one.
+//
+// Record:	vr.PoseDeltaRecordTracking [Seconds=10] [Rate=100] [Out=Path.csv]
+//			Samples the relative transform of every locally controlled tracked camera / motion controller
+// Report:	vr.PoseDeltaBandwidthReport File=Path.csv [AckDelay=6] [Loss=0.0] [Out=Path.csv] [Quit]
+//			AckDelay is the number of sends before an ack reaches the sender, Loss is the fraction of sends and acks dropped
+namespace VRPoseDeltaBandwidthReport
+{
+	// Recorded rows are Source,X,Y,Z,Pitch,Yaw,Roll
+	typedef TMap<FString, TArray<FBPVRComponentPosRep>> FRecording;
+
+	struct FResult
+	{
+		int64 TotalBits = 0;
+		int32 NumSends = 0;
+		int32 NumBaselines = 0;
+		int32 NumDeltas = 0;
+		int32 NumDropped = 0;
+		float MaxPosError = 0.f;
+		float MaxRotErrorDeg = 0.f;
+
+		double AvgBits() const { return NumSends > 0 ? (double)TotalBits / NumSends : 0.0; }
+	};
+
+	static bool LoadRecording(const FString& Path, FRecording& OutRecording)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+			return false;
+
+		for (const FString& Line : Lines)
+		{
+			TArray<FString> Columns;
+			Line.ParseIntoArray(Columns, TEXT(","));
+
+			// Skips the header and anything malformed
+			if (Columns.Num() != 7 || !Columns[1].IsNumeric())
+				continue;
+
+			FBPVRComponentPosRep& Pose = OutRecording.FindOrAdd(Columns[0]).AddDefaulted_GetRef();
+			Pose.Position = FVector(FCString::Atof(*Columns[1]), FCString::Atof(*Columns[2]), FCString::Atof(*Columns[3]));
+			Pose.Rotation = FRotator(FCString::Atof(*Columns[4]), FCString::Atof(*Columns[5]), FCString::Atof(*Columns[6]));
+		}
+
+		return OutRecording.Num() > 0;
+	}
+
+	static void DecodePose(const FBPVRComponentPosRep& InSendPose, FBPVRComponentPosRep& OutReceivedPose, int32& OutNumBits)
+	{
+		bool bSuccess = true;
+		FBPVRComponentPosRep SendPose = InSendPose;
+		FBitWriter Writer(0, true);
+		SendPose.NetSerialize(Writer, nullptr, bSuccess);
+		OutNumBits = (int32)Writer.GetNumBits();
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		OutReceivedPose.NetSerialize(Reader, nullptr, bSuccess);
+	}
+
+	static FResult EncodeStream(const TArray<FBPVRComponentPosRep>& Poses, EVRVectorQuantization VecQuant, EVRRotationQuantization RotQuant, bool bDelta, int32 AckDelay, float LossRate)
+	{
+		FResult Result;
+		FRandomStream Stream(Poses.Num());
+
+		FVRPoseDeltaSender Sender;
+		FVRPoseDeltaReceiver Receiver;
+
+		// Acks in flight, keyed by the send index they arrive at
+		TArray<TPair<int32, uint8>> PendingAcks;
+
+		for (int32 SendIndex = 0; SendIndex < Poses.Num(); ++SendIndex)
+		{
+			for (int32 i = PendingAcks.Num() - 1; i >= 0; --i)
+			{
+				if (PendingAcks[i].Key <= SendIndex)
+				{
+					Sender.OnBaselineAck(PendingAcks[i].Value);
+					PendingAcks.RemoveAtSwap(i, 1, false);
+				}
+			}
+
+			FBPVRComponentPosRep Pose = Poses[SendIndex];
+			Pose.QuantizationLevel = VecQuant;
+			Pose.RotationQuantizationLevel = RotQuant;
+			Pose.bUseDeltaEncoding = bDelta;
+
+			// Reference decode of the plain absolute pose so the error only counts what delta encoding added
+			FBPVRComponentPosRep AbsolutePose;
+			int32 AbsoluteBits = 0;
+			DecodePose(Pose, AbsolutePose, AbsoluteBits);
+
+			Sender.PrepareForSend(Pose);
+			Result.NumBaselines += Pose.bIsBaseline ? 1 : 0;
+			Result.NumDeltas += Pose.bIsDelta ? 1 : 0;
+
+			FBPVRComponentPosRep ReceivedPose;
+			int32 NumBits = 0;
+			DecodePose(Pose, ReceivedPose, NumBits);
+
+			Result.TotalBits += NumBits;
+			++Result.NumSends;
+
+			if (LossRate > 0.f && Stream.FRand() < LossRate)
+			{
+				++Result.NumDropped;
+				continue;
+			}
+
+			bool bSendAck = false;
+			uint8 BaselineAck = 0;
+			if (!Receiver.Resolve(ReceivedPose, bSendAck, BaselineAck))
+			{
+				++Result.NumDropped;
+			}
+			else
+			{
+				Result.MaxPosError = FMath::Max(Result.MaxPosError, (float)(ReceivedPose.Position - AbsolutePose.Position).GetAbsMax());
+				Result.MaxRotErrorDeg = FMath::Max(Result.MaxRotErrorDeg, FMath::RadiansToDegrees(ReceivedPose.Rotation.Quaternion().AngularDistance(AbsolutePose.Rotation.Quaternion())));
+			}
+
+			if (bSendAck && !(LossRate > 0.f && Stream.FRand() < LossRate))
+			{
+				PendingAcks.Add(TPair<int32, uint8>(SendIndex + AckDelay, BaselineAck));
+			}
+		}
+
+		return Result;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		FString InputPath;
+		int32 AckDelay = 6;
+		float LossRate = 0.f;
+		VRBenchmarkUtils::FCommonArgs Common;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("File="), InputPath);
+			FParse::Value(*Arg, TEXT("AckDelay="), AckDelay);
+			FParse::Value(*Arg, TEXT("Loss="), LossRate);
+			VRBenchmarkUtils::ParseCommonArg(Arg, Common);
+		}
+
+		AckDelay = FMath::Max(1, AckDelay);
+		LossRate = FMath::Clamp(LossRate, 0.f, 1.f);
+
+		FRecording Recording;
+		if (InputPath.IsEmpty() || !LoadRecording(InputPath, Recording))
+		{
+			UE_LOG(LogVRBenchmark, Warning, TEXT("vr.PoseDeltaBandwidthReport: Could not load a recording from \"%s\", record one with vr.PoseDeltaRecordTracking"), *InputPath);
+			return;
+		}
+
+		VRBenchmarkUtils::SetDefaultOutputPath(Common.OutputPath, TEXT("PoseDeltaBandwidth"), TEXT("PoseDeltaBandwidth"));
+
+		FString Csv = TEXT("Source,Sends,VectorQuantization,RotationQuantization,AbsoluteAvgBits,DeltaAvgBits,Savings,Baselines,Deltas,Dropped,DeltaMaxPosError,DeltaMaxRotErrorDeg\n");
+
+		const EVRVectorQuantization VecLevels[] = { EVRVectorQuantization::RoundOneDecimal, EVRVectorQuantization::RoundTwoDecimals };
+		const EVRRotationQuantization RotLevels[] = { EVRRotationQuantization::RoundTo10Bits, EVRRotationQuantization::RoundToShort };
+
+		for (const TPair<FString, TArray<FBPVRComponentPosRep>>& Source : Recording)
+		{
+			for (EVRVectorQuantization VecQuant : VecLevels)
+			{
+				for (EVRRotationQuantization RotQuant : RotLevels)
+				{
+					const FResult Absolute = EncodeStream(Source.Value, VecQuant, RotQuant, false, AckDelay, 0.f);
+					const FResult Delta = EncodeStream(Source.Value, VecQuant, RotQuant, true, AckDelay, LossRate);
+
+					Csv += FString::Printf(TEXT("%s,%d,%s,%s,%.2f,%.2f,%.1f%%,%d,%d,%d,%.3f,%.3f\n"),
+						*Source.Key,
+						Source.Value.Num(),
+						VecQuant == EVRVectorQuantization::RoundOneDecimal ? TEXT("RoundOneDecimal") : TEXT("RoundTwoDecimals"),
+						RotQuant == EVRRotationQuantization::RoundTo10Bits ? TEXT("RoundTo10Bits") : TEXT("RoundToShort"),
+						Absolute.AvgBits(),
+						Delta.AvgBits(),
+						Absolute.AvgBits() > 0.0 ? (1.0 - Delta.AvgBits() / Absolute.AvgBits()) * 100.0 : 0.0,
+						Delta.NumBaselines,
+						Delta.NumDeltas,
+						Delta.NumDropped,
+						Delta.MaxPosError,
+						Delta.MaxRotErrorDeg);
+				}
+			}
+		}
+
+		VRBenchmarkUtils::SaveAndLogResults(TEXT("vr.PoseDeltaBandwidthReport"), Csv, Common.OutputPath);
+		VRBenchmarkUtils::QuitIfRequested(Common);
+	}
+
+	static FAutoConsoleCommand PoseDeltaBandwidthReportCommand(
+		TEXT("vr.PoseDeltaBandwidthReport"),
+		TEXT("Encodes a tracking recording at every pose quantization level, absolute and delta encoded, and writes the bits per send to a CSV in the profiling directory.\n")
+		TEXT("Args: File=Path.csv AckDelay=6 Loss=0.0 Out=Path.csv Quit"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+
+	// Recorder, samples on world post actor tick so every tracked component has updated for the frame
+	struct FTrackingRecorder
+	{
+		FDelegateHandle TickHandle;
+		FString OutputPath;
+		FString Csv;
+		double EndTime = 0.0;
+		double NextSampleTime = 0.0;
+		float SampleInterval = 0.01f;
+
+		void Sample(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+		{
+			if (!World || !World->IsGameWorld())
+				return;
+
+			const double Now = World->GetRealTimeSeconds();
+			if (Now < NextSampleTime)
+				return;
+
+			NextSampleTime = Now + SampleInterval;
+
+			for (TObjectIterator<UGripMotionControllerComponent> It; It; ++It)
+			{
+				if (It->GetWorld() == World && It->IsLocallyControlled() && It->bTracked)
+				{
+					AddRow(It->GetName(), It->GetRelativeLocation(), It->GetRelativeRotation());
+				}
+			}
+
+			for (TObjectIterator<UReplicatedVRCameraComponent> It; It; ++It)
+			{
+				if (It->GetWorld() == World && It->IsLocallyControlled())
+				{
+					AddRow(It->GetName(), It->GetRelativeLocation(), It->GetRelativeRotation());
+				}
+			}
+
+			if (Now >= EndTime)
+			{
+				Finish();
+			}
+		}
+
+		void AddRow(const FString& Source, const FVector& Position, const FRotator& Rotation)
+		{
+			Csv += FString::Printf(TEXT("%s,%f,%f,%f,%f,%f,%f\n"), *Source, Position.X, Position.Y, Position.Z, Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
+		}
+
+		void Finish()
+		{
+			FWorldDelegates::OnWorldPostActorTick.Remove(TickHandle);
+			TickHandle.Reset();
+
+			VRBenchmarkUtils::SaveCsv(TEXT("vr.PoseDeltaRecordTracking"), Csv, OutputPath);
+		}
+	};
+
+	static FTrackingRecorder Recorder;
+
+	static void Record(const TArray<FString>& Args, UWorld* World)
+	{
+		if (Recorder.TickHandle.IsValid())
+		{
+			UE_LOG(LogVRBenchmark, Warning, TEXT("vr.PoseDeltaRecordTracking: Already recording"));
+			return;
+		}
+
+		if (!World)
+			return;
+
+		float Seconds = 10.f;
+		float Rate = 100.f;
+		FString OutputPath;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Seconds="), Seconds);
+			FParse::Value(*Arg, TEXT("Rate="), Rate);
+			FParse::Value(*Arg, TEXT("Out="), OutputPath);
+		}
+
+		VRBenchmarkUtils::SetDefaultOutputPath(OutputPath, TEXT("PoseDeltaBandwidth"), TEXT("TrackingRecording"));
+
+		Recorder.OutputPath = OutputPath;
+		Recorder.Csv = TEXT("Source,X,Y,Z,Pitch,Yaw,Roll\n");
+		Recorder.SampleInterval = 1.f / FMath::Max(1.f, Rate);
+		Recorder.NextSampleTime = World->GetRealTimeSeconds();
+		Recorder.EndTime = Recorder.NextSampleTime + FMath::Max(0.1f, Seconds);
+		Recorder.TickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(&Recorder, &FTrackingRecorder::Sample);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs PoseDeltaRecordTrackingCommand(
+		TEXT("vr.PoseDeltaRecordTracking"),
+		TEXT("Records the relative transforms of the locally controlled tracked cameras and motion controllers for use with vr.PoseDeltaBandwidthReport.\n")
+		TEXT("Args: Seconds=10 Rate=100 Out=Path.csv"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Record));
+}
+
+#endif
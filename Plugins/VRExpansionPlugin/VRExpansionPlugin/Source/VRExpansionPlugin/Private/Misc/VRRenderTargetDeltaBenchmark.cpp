@@ -0,0 +1,277 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Parse.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Misc/VRRenderTargetManager.h"
+#include "Misc/VRBenchmarkUtils.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Bandwidth comparison for render target texture replication, full resends vs dirty tile deltas
+// Replays a scripted whiteboard session (random brush strokes drawn at a steady rate) into a 565 pixel buffer the same
+// way the manager stores its readback. Clients go irrelevant and come back every FlipInterval seconds (staggered), and
+// each return is a texture send. The full resend path packs the whole texture every time, the delta path runs the
+// managers own UpdateTileVersions / BuildDeltaTextureStore / ApplyDeltaToTileCache, and every client cache is compared
+// against the server image after each send so a broken delta shows up as a mismatch.
+//
+// Usage: vr.RenderTargetDeltaBenchmark [Width=1024] [Height=1024] [Seconds=120] [StrokesPerSecond=2] [Clients=8]
+//			[FlipInterval=5] [TileSize=64] [Seed=0] [Out=Path.csv] [Quit]
+namespace VRRenderTargetDeltaBenchmark
+{
+	struct FSettings
+	{
+		int32 Width = 1024;
+		int32 Height = 1024;
+		float Seconds = 120.f;
+		float StrokesPerSecond = 2.f;
+		int32 NumClients = 8;
+		float FlipInterval = 5.f;
+		int32 TileSize = 64;
+		int32 Seed = 0;
+	};
+
+	struct FResult
+	{
+		int64 TotalBytes = 0;
+		int32 NumSends = 0;
+		int32 NumFullSends = 0;
+		int32 NumDeltaSends = 0;
+		int32 NumUpToDate = 0;
+		int32 NumMismatches = 0;
+	};
+
+	static uint16 ToRGB565(const FColor& Color)
+	{
+		// Same layout DeCompressRenderTarget2D expands
+		return (uint16)(((Color.R >> 3) << 11) | ((Color.G >> 2) << 5) | (Color.B >> 3));
+	}
+
+	// A stroke is a short random walk of round brush dabs
+	static void DrawStroke(TArray<uint16>& Pixels, const FSettings& Settings, FRandomStream& Stream)
+	{
+		const uint16 Color = ToRGB565(FColor(Stream.RandRange(0, 255), Stream.RandRange(0, 255), Stream.RandRange(0, 255)));
+		const int32 Radius = Stream.RandRange(2, 6);
+		const int32 NumDabs = Stream.RandRange(10, 40);
+
+		FVector2D Position(Stream.FRandRange(0.f, Settings.Width), Stream.FRandRange(0.f, Settings.Height));
+		float Heading = Stream.FRandRange(0.f, 2.f * PI);
+
+		for (int32 Dab = 0; Dab < NumDabs; ++Dab)
+		{
+			const int32 CenterX = FMath::RoundToInt(Position.X);
+			const int32 CenterY = FMath::RoundToInt(Position.Y);
+
+			for (int32 Y = FMath::Max(CenterY - Radius, 0); Y <= FMath::Min(CenterY + Radius, Settings.Height - 1); ++Y)
+			{
+				for (int32 X = FMath::Max(CenterX - Radius, 0); X <= FMath::Min(CenterX + Radius, Settings.Width - 1); ++X)
+				{
+					if (FMath::Square(X - CenterX) + FMath::Square(Y - CenterY) <= Radius * Radius)
+					{
+						Pixels[Y * Settings.Width + X] = Color;
+					}
+				}
+			}
+
+			Heading += Stream.FRandRange(-0.4f, 0.4f);
+			Position += FVector2D(FMath::Cos(Heading), FMath::Sin(Heading)) * Radius;
+		}
+	}
+
+	static bool CacheMatches(const UVRRenderTargetManager* Client, const TArray<uint16>& Pixels)
+	{
+		return Client->TileCachePixels.Num() == Pixels.Num() &&
+			FMemory::Memcmp(Client->TileCachePixels.GetData(), Pixels.GetData(), Pixels.Num() * sizeof(uint16)) == 0;
+	}
+
+	static void Replay(const FSettings& Settings, bool bUseDeltas, FResult& OutResult)
+	{
+		TStrongObjectPtr<UVRRenderTargetManager> Server(NewObject<UVRRenderTargetManager>(GetTransientPackage()));
+		Server->TextureTileSize = Settings.TileSize;
+
+		TArray<TStrongObjectPtr<UVRRenderTargetManager>> Clients;
+		TArray<int32> AckedVersions;
+		for (int32 i = 0; i < Settings.NumClients; ++i)
+		{
+			Clients.Emplace(NewObject<UVRRenderTargetManager>(GetTransientPackage()));
+			AckedVersions.Add(0);
+		}
+
+		// Blank whiteboard
+		TArray<uint16> Pixels;
+		Pixels.Init(0xFFFF, Settings.Width * Settings.Height);
+
+		// Both passes see the same session
+		FRandomStream Stream(Settings.Seed);
+		const float StrokeInterval = Settings.StrokesPerSecond > 0.f ? 1.f / Settings.StrokesPerSecond : Settings.Seconds;
+		float NextStroke = 0.f;
+
+		// Returns are staggered so the clients don't all resync on the same frame
+		TArray<float> NextFlips;
+		for (int32 i = 0; i < Settings.NumClients; ++i)
+		{
+			NextFlips.Add(Settings.FlipInterval * (i + 1) / Settings.NumClients);
+		}
+
+		for (;;)
+		{
+			// Next event in session time, either a stroke or a client coming back
+			int32 FlipClient = INDEX_NONE;
+			float EventTime = NextStroke;
+			for (int32 i = 0; i < NextFlips.Num(); ++i)
+			{
+				if (NextFlips[i] < EventTime)
+				{
+					EventTime = NextFlips[i];
+					FlipClient = i;
+				}
+			}
+
+			if (EventTime > Settings.Seconds)
+				break;
+
+			if (FlipClient == INDEX_NONE)
+			{
+				DrawStroke(Pixels, Settings, Stream);
+				NextStroke += StrokeInterval;
+				continue;
+			}
+
+			NextFlips[FlipClient] += Settings.FlipInterval;
+			UVRRenderTargetManager* Client = Clients[FlipClient].Get();
+
+			// What the manager does with a fresh readback
+			FBPVRReplicatedTextureStore& Store = Server->RenderTargetStore;
+			Store.Reset();
+			Store.UnpackedData = Pixels;
+			Store.Width = Settings.Width;
+			Store.Height = Settings.Height;
+			Store.PixelFormat = PF_B8G8R8A8;
+
+			FBPVRReplicatedTextureStore DeltaStore;
+			bool bHasDelta = false;
+			if (bUseDeltas)
+			{
+				Server->UpdateTileVersions(Store.UnpackedData, Settings.Width, Settings.Height);
+				Store.TextureVersion = Server->TextureVersion;
+
+				if (AckedVersions[FlipClient] != 0)
+				{
+					bHasDelta = Server->BuildDeltaTextureStore((uint32)AckedVersions[FlipClient], Store.UnpackedData, DeltaStore);
+				}
+			}
+
+			Store.PackData();
+
+			if (bHasDelta && DeltaStore.PackedData.Num() == 0)
+			{
+				// Already up to date, nothing is sent
+				++OutResult.NumUpToDate;
+				continue;
+			}
+
+			// Receive as DeCompressRenderTarget2D would
+			FBPVRReplicatedTextureStore Received = bHasDelta ? DeltaStore : Store;
+			OutResult.TotalBytes += Received.PackedData.Num();
+			++OutResult.NumSends;
+			Received.UnPackData();
+
+			if (Received.IsDelta())
+			{
+				++OutResult.NumDeltaSends;
+				if (!Client->ApplyDeltaToTileCache(Received))
+				{
+					Client->TileCachePixels.Empty();
+					Client->TileCacheVersion = 0;
+				}
+			}
+			else
+			{
+				++OutResult.NumFullSends;
+				Client->TileCachePixels = MoveTemp(Received.UnpackedData);
+				Client->TileCacheVersion = Received.TextureVersion;
+			}
+
+			if (!CacheMatches(Client, Pixels))
+			{
+				++OutResult.NumMismatches;
+			}
+
+			// Acks are seconds ahead of the next return, so treat them as arrived
+			AckedVersions[FlipClient] = (int32)Client->TileCacheVersion;
+		}
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		FSettings Settings;
+		VRBenchmarkUtils::FCommonArgs Common;
+
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Width="), Settings.Width);
+			FParse::Value(*Arg, TEXT("Height="), Settings.Height);
+			FParse::Value(*Arg, TEXT("Seconds="), Settings.Seconds);
+			FParse::Value(*Arg, TEXT("StrokesPerSecond="), Settings.StrokesPerSecond);
+			FParse::Value(*Arg, TEXT("Clients="), Settings.NumClients);
+			FParse::Value(*Arg, TEXT("FlipInterval="), Settings.FlipInterval);
+			FParse::Value(*Arg, TEXT("TileSize="), Settings.TileSize);
+			FParse::Value(*Arg, TEXT("Seed="), Settings.Seed);
+			VRBenchmarkUtils::ParseCommonArg(Arg, Common);
+		}
+
+		Settings.Width = FMath::Max(Settings.Width, 8);
+		Settings.Height = FMath::Max(Settings.Height, 8);
+		Settings.Seconds = FMath::Max(Settings.Seconds, 1.f);
+		Settings.NumClients = FMath::Max(Settings.NumClients, 1);
+		Settings.FlipInterval = FMath::Max(Settings.FlipInterval, 0.1f);
+		Settings.TileSize = FMath::Max(Settings.TileSize, 8);
+
+		VRBenchmarkUtils::SetDefaultOutputPath(Common.OutputPath, TEXT("RenderTargetDeltaBenchmark"), TEXT("RenderTargetDeltaBenchmark"));
+
+		FString Csv = TEXT("Mode,Width,Height,TileSize,Clients,Seconds,Sends,FullSends,DeltaSends,UpToDate,TotalBytes,BytesPerSec,AvgBytesPerSend,Mismatches\n");
+
+		for (int32 Pass = 0; Pass < 2; ++Pass)
+		{
+			const bool bUseDeltas = Pass == 1;
+
+			FResult Result;
+			Replay(Settings, bUseDeltas, Result);
+
+			Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%.1f,%d,%d,%d,%d,%lld,%.1f,%.1f,%d\n"),
+				bUseDeltas ? TEXT("TileDelta") : TEXT("FullResend"),
+				Settings.Width,
+				Settings.Height,
+				Settings.TileSize,
+				Settings.NumClients,
+				Settings.Seconds,
+				Result.NumSends,
+				Result.NumFullSends,
+				Result.NumDeltaSends,
+				Result.NumUpToDate,
+				Result.TotalBytes,
+				Result.TotalBytes / Settings.Seconds,
+				Result.NumSends > 0 ? (double)Result.TotalBytes / Result.NumSends : 0.0,
+				Result.NumMismatches);
+
+			if (Result.NumMismatches > 0)
+			{
+				UE_LOG(LogVRBenchmark, Warning, TEXT("vr.RenderTargetDeltaBenchmark: %d client textures didn't match the server after a %s send"), Result.NumMismatches, bUseDeltas ? TEXT("delta") : TEXT("full"));
+			}
+		}
+
+		VRBenchmarkUtils::SaveAndLogResults(TEXT("vr.RenderTargetDeltaBenchmark"), Csv, Common.OutputPath);
+		VRBenchmarkUtils::QuitIfRequested(Common);
+	}
+
+	static FAutoConsoleCommand RenderTargetDeltaBenchmarkCommand(
+		TEXT("vr.RenderTargetDeltaBenchmark"),
+		TEXT("Replays a scripted drawing session with clients periodically becoming relevant again and writes the texture bytes/sec for full resends and tile deltas to a CSV in the profiling directory.\n")
+		TEXT("Args: Width=1024 Height=1024 Seconds=120 StrokesPerSecond=2 Clients=8 FlipInterval=5 TileSize=64 Seed=0 Out=Path.csv Quit"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
@@ -5,6 +5,11 @@
 #include "GameFramework/PlayerState.h"
 #include "Net/UnrealNetwork.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Texture Bytes Sent"), STAT_RTTextureBytesSent, STATGROUP_VRRenderTargetManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Texture Bytes Saved By Deltas"), STAT_RTTextureBytesSavedByDelta, STATGROUP_VRRenderTargetManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Delta Textures Sent"), STAT_RTDeltaTexturesSent, STATGROUP_VRRenderTargetManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Full Textures Sent"), STAT_RTFullTexturesSent, STATGROUP_VRRenderTargetManager);
+
 namespace RLE_Funcs
 {
 	enum RLE_Flags
@@ -62,6 +67,14 @@ UVRRenderTargetManager::UVRRenderTargetManager(const FObjectInitializer& ObjectI
 	bInitiallyReplicateTexture = false;
 	bIsLoadingTextureBuffer = false;
 
+	bUseDeltaTextureReplication = true;
+	TextureTileSize = 64;
+	MaxDeltaTileFraction = 0.5f;
+	TextureVersion = 0;
+	CurrentTileSize = 0;
+	TileGridSize = FIntPoint::ZeroValue;
+	TileCacheVersion = 0;
+
 	OwnerIDCounter = 0;
 }
 
@@ -373,7 +386,7 @@ void ARenderTargetReplicationProxy::ReceiveTexture_Implementation(const FBPVRRep
 	}
 }
 
-void ARenderTargetReplicationProxy::InitTextureSend_Implementation(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped/*, bool bIsJPG*/)
+void ARenderTargetReplicationProxy::InitTextureSend_Implementation(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped/*, bool bIsJPG*/, int32 TextureVersion, int32 BaseVersion, int32 TileSize)
 {
 	TextureStore.Reset();
 	TextureStore.PixelFormat = PixelFormat;
@@ -381,6 +394,9 @@ void ARenderTargetReplicationProxy::InitTextureSend_Implementation(int32 Width,
 	//TextureStore.bJPG = bIsJPG;
 	TextureStore.Width = Width;
 	TextureStore.Height = Height;
+	TextureStore.TextureVersion = (uint32)TextureVersion;
+	TextureStore.BaseVersion = (uint32)BaseVersion;
+	TextureStore.TileSize = (uint32)TileSize;
 
 	TextureStore.PackedData.Reset(TotalDataCount);
 	TextureStore.PackedData.AddUninitialized(TotalDataCount);
@@ -402,7 +418,7 @@ bool ARenderTargetReplicationProxy::Ack_InitTextureSend_Validate(int32 TotalData
 
 void ARenderTargetReplicationProxy::Ack_InitTextureSend_Implementation(int32 TotalDataCount)
 {
-	if (TotalDataCount == TextureStore.PackedData.Num())
+	if (SendSnapshot.IsValid() && TotalDataCount == SendSnapshot->PackedData.Num())
 	{
 		BlobNum = 0;
 
@@ -416,21 +432,37 @@ void ARenderTargetReplicationProxy::Ack_InitTextureSend_Implementation(int32 Tot
 	}
 }
 
+void ARenderTargetReplicationProxy::SendTextureSnapshot(const FBPVRTextureSnapshotPtr& Snapshot)
+{
+	if (!Snapshot.IsValid())
+		return;
+
+	// Drop any send in progress, the new snapshot supersedes it
+	if (SendTimer_Handle.IsValid())
+		GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
+
+	SendSnapshot = Snapshot;
+	BlobNum = 0;
+	SendInitMessage();
+}
+
 void ARenderTargetReplicationProxy::SendInitMessage()
 {
-	int32 TotalBlobs = TextureStore.PackedData.Num() / TextureBlobSize + (TextureStore.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+	if (!SendSnapshot.IsValid())
+		return;
 
-	InitTextureSend(TextureStore.Width, TextureStore.Height, TextureStore.PackedData.Num(), TotalBlobs, TextureStore.PixelFormat, TextureStore.bIsZipped/*, TextureStore.bJPG*/);
+	const FBPVRReplicatedTextureStore& Snapshot = *SendSnapshot;
+	int32 TotalBlobs = Snapshot.PackedData.Num() / TextureBlobSize + (Snapshot.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+
+	InitTextureSend(Snapshot.Width, Snapshot.Height, Snapshot.PackedData.Num(), TotalBlobs, Snapshot.PixelFormat, Snapshot.bIsZipped/*, Snapshot.bJPG*/, (int32)Snapshot.TextureVersion, (int32)Snapshot.BaseVersion, (int32)Snapshot.TileSize);
 
 }
 
 void ARenderTargetReplicationProxy::SendNextDataBlob()
 {
-	if (this->IsPendingKill() || !this->GetOwner() || this->GetOwner()->IsPendingKill())
+	if (this->IsPendingKill() || !this->GetOwner() || this->GetOwner()->IsPendingKill() || !SendSnapshot.IsValid())
 	{	
-		TextureStore.Reset();
-		TextureStore.PackedData.Empty();
-		TextureStore.UnpackedData.Empty();
+		SendSnapshot.Reset();
 		BlobNum = 0;
 		if (SendTimer_Handle.IsValid())
 			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
@@ -438,29 +470,25 @@ void ARenderTargetReplicationProxy::SendNextDataBlob()
 		return;
 	}
 
+	const TArray<uint8>& PackedData = SendSnapshot->PackedData;
+
 	BlobNum++;
-	int32 TotalBlobs = TextureStore.PackedData.Num() / TextureBlobSize + (TextureStore.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+	int32 TotalBlobs = PackedData.Num() / TextureBlobSize + (PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
 
 	if (BlobNum <= TotalBlobs)
 	{
 		TArray<uint8> BlobStore;
-		int32 BlobLen = (BlobNum == TotalBlobs ? TextureStore.PackedData.Num() % TextureBlobSize : TextureBlobSize);
-
-
-		BlobStore.AddUninitialized(BlobLen);
-		uint8* MemLoc = TextureStore.PackedData.GetData();
 		int32 MemCount = (BlobNum - 1) * TextureBlobSize;
-		MemLoc += MemCount;
+		int32 BlobLen = FMath::Min(TextureBlobSize, PackedData.Num() - MemCount);
 
-		FMemory::Memcpy(BlobStore.GetData(), MemLoc, BlobLen);
+		BlobStore.Append(PackedData.GetData() + MemCount, BlobLen);
 
 		ReceiveTextureBlob(BlobStore, MemCount, BlobNum);
 	}
 	else
 	{
-		TextureStore.Reset();
-		TextureStore.PackedData.Empty();
-		TextureStore.UnpackedData.Empty();
+		// Release our reference, the snapshot is freed once the last proxy finishes with it
+		SendSnapshot.Reset();
 		if (SendTimer_Handle.IsValid())
 			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
 		BlobNum = 0;
@@ -523,6 +551,200 @@ void ARenderTargetReplicationProxy::Ack_ReceiveTextureBlob_Implementation(int32
 
 }
 
+bool ARenderTargetReplicationProxy::Ack_TextureVersion_Validate(int32 TextureVersion)
+{
+	return true;
+}
+
+void ARenderTargetReplicationProxy::Ack_TextureVersion_Implementation(int32 TextureVersion)
+{
+	if (OwningManager.IsValid())
+	{
+		OwningManager->OnClientAckedTextureVersion(this, TextureVersion);
+	}
+}
+
+void UVRRenderTargetManager::OnClientAckedTextureVersion(ARenderTargetReplicationProxy* Proxy, int32 AckedVersion)
+{
+	FClientRepData* RepData = NetRelevancyLog.FindByPredicate([Proxy](const FClientRepData& Other)
+		{
+			return Other.ReplicationProxy.Get() == Proxy;
+		});
+
+	if (!RepData)
+		return;
+
+	if (AckedVersion <= 0 || (uint32)AckedVersion > TextureVersion)
+	{
+		// Client couldn't apply a delta, fall back to sending it the full texture
+		RepData->AckedTextureVersion = 0;
+
+		if (RepData->bIsRelevant)
+		{
+			RepData->bIsDirty = true;
+			QueueImageStore();
+		}
+	}
+	else
+	{
+		RepData->AckedTextureVersion = AckedVersion;
+	}
+}
+
+void UVRRenderTargetManager::UpdateTileVersions(const TArray<uint16>& Pixels, int32 Width, int32 Height)
+{
+	const int32 TileSize = FMath::Max(TextureTileSize, 8);
+	const FIntPoint NewGridSize(FMath::DivideAndRoundUp(Width, TileSize), FMath::DivideAndRoundUp(Height, TileSize));
+	const int32 NumTiles = NewGridSize.X * NewGridSize.Y;
+
+	if (Pixels.Num() != Width * Height)
+		return;
+
+	// Size or tile layout changed, every tile is new
+	bool bReset = NewGridSize != TileGridSize || TileHashes.Num() != NumTiles || CurrentTileSize != TileSize;
+	uint32 NewVersion = TextureVersion + 1;
+	bool bAnyChanged = bReset;
+
+	if (bReset)
+	{
+		TileGridSize = NewGridSize;
+		CurrentTileSize = TileSize;
+		TileHashes.SetNumZeroed(NumTiles);
+		TileVersions.SetNumZeroed(NumTiles);
+	}
+
+	for (int32 TileY = 0; TileY < NewGridSize.Y; TileY++)
+	{
+		const int32 StartY = TileY * TileSize;
+		const int32 TileHeight = FMath::Min(TileSize, Height - StartY);
+
+		for (int32 TileX = 0; TileX < NewGridSize.X; TileX++)
+		{
+			const int32 StartX = TileX * TileSize;
+			const int32 TileWidth = FMath::Min(TileSize, Width - StartX);
+
+			uint32 Hash = 0;
+			for (int32 Row = 0; Row < TileHeight; Row++)
+			{
+				Hash = FCrc::MemCrc32(&Pixels[(StartY + Row) * Width + StartX], TileWidth * sizeof(uint16), Hash);
+			}
+
+			const int32 TileIndex = TileY * NewGridSize.X + TileX;
+			if (bReset || TileHashes[TileIndex] != Hash)
+			{
+				TileHashes[TileIndex] = Hash;
+				TileVersions[TileIndex] = NewVersion;
+				bAnyChanged = true;
+			}
+		}
+	}
+
+	if (bAnyChanged)
+	{
+		TextureVersion = NewVersion;
+	}
+}
+
+bool UVRRenderTargetManager::BuildDeltaTextureStore(uint32 BaseVersion, const TArray<uint16>& Pixels, FBPVRReplicatedTextureStore& OutStore)
+{
+	OutStore.Reset();
+
+	// Tile indices are sent as uint16s
+	if (BaseVersion == 0 || BaseVersion > TextureVersion || TileVersions.Num() == 0 || TileVersions.Num() > MAX_uint16)
+		return false;
+
+	TArray<uint16> DirtyTiles;
+	for (int32 i = 0; i < TileVersions.Num(); i++)
+	{
+		if (TileVersions[i] > BaseVersion)
+		{
+			DirtyTiles.Add((uint16)i);
+		}
+	}
+
+	// Already up to date
+	if (DirtyTiles.Num() == 0)
+		return true;
+
+	if (DirtyTiles.Num() > FMath::FloorToInt(TileVersions.Num() * MaxDeltaTileFraction))
+		return false;
+
+	const int32 Width = RenderTargetStore.Width;
+	const int32 Height = RenderTargetStore.Height;
+
+	OutStore.UnpackedData.Reserve(1 + DirtyTiles.Num() * (1 + CurrentTileSize * CurrentTileSize));
+	OutStore.UnpackedData.Add((uint16)DirtyTiles.Num());
+	OutStore.UnpackedData.Append(DirtyTiles);
+
+	for (uint16 TileIndex : DirtyTiles)
+	{
+		const int32 StartX = (TileIndex % TileGridSize.X) * CurrentTileSize;
+		const int32 StartY = (TileIndex / TileGridSize.X) * CurrentTileSize;
+		const int32 TileWidth = FMath::Min(CurrentTileSize, Width - StartX);
+		const int32 TileHeight = FMath::Min(CurrentTileSize, Height - StartY);
+
+		for (int32 Row = 0; Row < TileHeight; Row++)
+		{
+			OutStore.UnpackedData.Append(&Pixels[(StartY + Row) * Width + StartX], TileWidth);
+		}
+	}
+
+	OutStore.Width = Width;
+	OutStore.Height = Height;
+	OutStore.PixelFormat = RenderTargetStore.PixelFormat;
+	OutStore.TextureVersion = TextureVersion;
+	OutStore.BaseVersion = BaseVersion;
+	OutStore.TileSize = CurrentTileSize;
+	OutStore.PackData();
+
+	return true;
+}
+
+bool UVRRenderTargetManager::ApplyDeltaToTileCache(const FBPVRReplicatedTextureStore& DeltaStore)
+{
+	const TArray<uint16>& Data = DeltaStore.UnpackedData;
+	const int32 Width = DeltaStore.Width;
+	const int32 Height = DeltaStore.Height;
+	const int32 TileSize = DeltaStore.TileSize;
+
+	if (DeltaStore.BaseVersion != TileCacheVersion || TileCachePixels.Num() != Width * Height || TileSize <= 0 || Data.Num() < 1)
+		return false;
+
+	const int32 NumTiles = Data[0];
+	if (Data.Num() < 1 + NumTiles)
+		return false;
+
+	const int32 TilesX = FMath::DivideAndRoundUp(Width, TileSize);
+	const int32 TilesY = FMath::DivideAndRoundUp(Height, TileSize);
+	const uint16* Src = Data.GetData() + 1 + NumTiles;
+	const uint16* SrcEnd = Data.GetData() + Data.Num();
+
+	for (int32 i = 0; i < NumTiles; i++)
+	{
+		const int32 TileIndex = Data[1 + i];
+		const int32 StartX = (TileIndex % TilesX) * TileSize;
+		const int32 StartY = (TileIndex / TilesX) * TileSize;
+
+		if (TileIndex / TilesX >= TilesY)
+			return false;
+
+		const int32 TileWidth = FMath::Min(TileSize, Width - StartX);
+		const int32 TileHeight = FMath::Min(TileSize, Height - StartY);
+
+		if (Src + TileWidth * TileHeight > SrcEnd)
+			return false;
+
+		for (int32 Row = 0; Row < TileHeight; Row++)
+		{
+			FMemory::Memcpy(&TileCachePixels[(StartY + Row) * Width + StartX], Src, TileWidth * sizeof(uint16));
+			Src += TileWidth;
+		}
+	}
+
+	TileCacheVersion = DeltaStore.TextureVersion;
+	return true;
+}
+
 void UVRRenderTargetManager::UpdateRelevancyMap()
 {
 	AActor* myOwner = GetOwner();
@@ -625,6 +847,30 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 
 	RenderTargetStore.UnPackData();
 
+	if (RenderTargetStore.IsDelta())
+	{
+		if (!ApplyDeltaToTileCache(RenderTargetStore))
+		{
+			// Our cache doesn't match the base the server built this against, ask for the full texture again
+			TileCacheVersion = 0;
+			TileCachePixels.Empty();
+			RenderTargetStore.Reset();
+
+			if (LocalProxy.IsValid())
+			{
+				LocalProxy->Ack_TextureVersion(0);
+			}
+
+			return false;
+		}
+
+		RenderTargetStore.UnpackedData.Empty();
+	}
+	else
+	{
+		TileCachePixels = MoveTemp(RenderTargetStore.UnpackedData);
+		TileCacheVersion = RenderTargetStore.TextureVersion;
+	}
 
 	int32 Width = RenderTargetStore.Width;
 	int32 Height = RenderTargetStore.Height;
@@ -632,12 +878,12 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 	uint8 PixelFormat8 = 0;
 
 	TArray<FColor> FinalColorData;
-	FinalColorData.AddUninitialized(RenderTargetStore.UnpackedData.Num());
+	FinalColorData.AddUninitialized(TileCachePixels.Num());
 
 	uint32 Counter = 0;
 	FColor ColorVal;
 	ColorVal.A = 0xFF;
-	for (uint16 CompColor : RenderTargetStore.UnpackedData)
+	for (uint16 CompColor : TileCachePixels)
 	{
 		//CompColor.FillTo(ColorVal);
 		ColorVal.R = CompColor << 3;
@@ -726,6 +972,12 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 	RenderBase->ReleaseResource();
 	RenderBase->MarkPendingKill();
 
+	// Let the server know what we have so that it can send deltas against it
+	if (TileCacheVersion != 0 && LocalProxy.IsValid())
+	{
+		LocalProxy->Ack_TextureVersion((int32)TileCacheVersion);
+	}
+
 	return true;
 }
 
@@ -826,8 +1078,36 @@ void UVRRenderTargetManager::TickComponent(float DeltaTime, enum ELevelTick Tick
 				RenderTargetStore.Width = Size2D.X;
 				RenderTargetStore.Height = Size2D.Y;
 				RenderTargetStore.PixelFormat = nextRenderData->PixelFormat;
+
+				// Build the tile deltas before packing as packing consumes the unpacked data
+				// Keyed by the version the clients acknowledged so that clients on the same version share one
+				TMap<uint32, FBPVRTextureSnapshotPtr> DeltaStores;
+				if (bUseDeltaTextureReplication)
+				{
+					UpdateTileVersions(RenderTargetStore.UnpackedData, Size2D.X, Size2D.Y);
+					RenderTargetStore.TextureVersion = TextureVersion;
+
+					for (const FClientRepData& RepData : NetRelevancyLog)
+					{
+						const uint32 AckedVersion = (uint32)RepData.AckedTextureVersion;
+						if (!RepData.bIsDirty || AckedVersion == 0 || DeltaStores.Contains(AckedVersion))
+							continue;
+
+						TSharedPtr<FBPVRReplicatedTextureStore> DeltaStore = MakeShared<FBPVRReplicatedTextureStore>();
+						if (BuildDeltaTextureStore(AckedVersion, RenderTargetStore.UnpackedData, *DeltaStore))
+						{
+							DeltaStores.Add(AckedVersion, DeltaStore);
+						}
+					}
+				}
+
 				RenderTargetStore.PackData();
 
+				// Proxies only hold a reference to this, it goes away once the last of them finishes sending
+				const int32 FullTextureBytes = RenderTargetStore.PackedData.Num();
+				FBPVRTextureSnapshotPtr FullSnapshot = MakeShared<FBPVRReplicatedTextureStore>(MoveTemp(RenderTargetStore));
+				RenderTargetStore.Reset();
+
 
 //#if WITH_PUSH_MODEL
 				//MARK_PROPERTY_DIRTY_FROM_NAME(UVRRenderTargetManager, RenderTargetStore, this);
@@ -844,8 +1124,25 @@ void UVRRenderTargetManager::TickComponent(float DeltaTime, enum ELevelTick Tick
 					{
 						if (NetRelevancyLog[i].ReplicationProxy.IsValid())
 						{
-							NetRelevancyLog[i].ReplicationProxy->TextureStore = RenderTargetStore;
-							NetRelevancyLog[i].ReplicationProxy->SendInitMessage();
+							if (FBPVRTextureSnapshotPtr* DeltaStore = DeltaStores.Find((uint32)NetRelevancyLog[i].AckedTextureVersion))
+							{
+								// An empty delta means the client is already up to date
+								const int32 DeltaBytes = (*DeltaStore)->PackedData.Num();
+								if (DeltaBytes > 0)
+								{
+									NetRelevancyLog[i].ReplicationProxy->SendTextureSnapshot(*DeltaStore);
+									INC_DWORD_STAT_BY(STAT_RTTextureBytesSent, DeltaBytes);
+									INC_DWORD_STAT_BY(STAT_RTTextureBytesSavedByDelta, FMath::Max(FullTextureBytes - DeltaBytes, 0));
+									INC_DWORD_STAT(STAT_RTDeltaTexturesSent);
+								}
+							}
+							else
+							{
+								NetRelevancyLog[i].ReplicationProxy->SendTextureSnapshot(FullSnapshot);
+								INC_DWORD_STAT_BY(STAT_RTTextureBytesSent, FullTextureBytes);
+								INC_DWORD_STAT(STAT_RTFullTexturesSent);
+							}
+
 							NetRelevancyLog[i].bIsDirty = false;
 						}
 					}
@@ -1173,6 +1470,13 @@ bool FBPVRReplicatedTextureStore::NetSerialize(FArchive& Ar, class UPackageMap*
 	Ar.SerializeIntPacked(Width);
 	Ar.SerializeIntPacked(Height);
 	Ar.SerializeBits(&PixelFormat, 8);
+	Ar.SerializeIntPacked(TextureVersion);
+	Ar.SerializeIntPacked(BaseVersion);
+
+	if (BaseVersion != 0)
+	{
+		Ar.SerializeIntPacked(TileSize);
+	}
 
 	Ar << PackedData;
 
@@ -0,0 +1,304 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/VRStereoWidgetRedrawSubsystem.h"
+#include "Blueprint/UserWidget.h"
+#include "Widgets/SWidget.h"
+#include "Debugging/SlateDebugging.h"
+
+DECLARE_CYCLE_STAT(TEXT("StereoWidgets ~ ArbitrateRedraws"), STAT_StereoWidgetArbitrateRedraws, STATGROUP_VRStereoWidgets);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stereo Widget Redraws Performed"), STAT_StereoWidgetRedrawsPerformed, STATGROUP_VRStereoWidgets);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stereo Widget Redraws Skipped"), STAT_StereoWidgetRedrawsSkipped, STATGROUP_VRStereoWidgets);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stereo Widget Redraws Deferred"), STAT_StereoWidgetRedrawsDeferred, STATGROUP_VRStereoWidgets);
+
+// CVars
+namespace StereoWidgetRedrawCvars
+{
+	static int32 RedrawBudget = 4;
+	FAutoConsoleVariableRef CVarStereoWidgetRedrawBudget(
+		TEXT("vr.StereoWidgetRedrawBudget"),
+		RedrawBudget,
+		TEXT("Max number of scheduled stereo widgets that can render in a single frame, the rest are deferred to following frames.\n")
+		TEXT("0: Unlimited, scheduled widgets still only redraw when invalidated"),
+		ECVF_Default);
+}
+
+void UVRStereoWidgetRedrawSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+}
+
+void UVRStereoWidgetRedrawSubsystem::Deinitialize()
+{
+	PendingRequests.Empty();
+	GrantedComponents.Empty();
+	InvalidationRoots.Empty();
+	ComponentsByRootWidget.Empty();
+	UpdateWidgetInvalidateBinding();
+
+	Super::Deinitialize();
+}
+
+bool UVRStereoWidgetRedrawSubsystem::CanTrackWidgetInvalidations()
+{
+	return WITH_SLATE_DEBUGGING != 0;
+}
+
+void UVRStereoWidgetRedrawSubsystem::UpdateWidgetInvalidateBinding()
+{
+#if WITH_SLATE_DEBUGGING
+	// Only listen while something is tracked, the event fires for every invalidation in the application
+	const bool bShouldBind = ComponentsByRootWidget.Num() > 0;
+	if (bShouldBind && !WidgetInvalidateHandle.IsValid())
+	{
+		WidgetInvalidateHandle = FSlateDebugging::WidgetInvalidateEvent.AddUObject(this, &UVRStereoWidgetRedrawSubsystem::OnWidgetInvalidated);
+	}
+	else if (!bShouldBind && WidgetInvalidateHandle.IsValid())
+	{
+		FSlateDebugging::WidgetInvalidateEvent.Remove(WidgetInvalidateHandle);
+		WidgetInvalidateHandle.Reset();
+	}
+#endif
+}
+
+bool UVRStereoWidgetRedrawSubsystem::RequestRedraw(USceneComponent* InComponent, int32 InPriority, bool bIsVisible)
+{
+	if (!InComponent)
+		return false;
+
+	if (RedrawFrame != GFrameCounter)
+	{
+		RedrawFrame = GFrameCounter;
+		RedrawsThisFrame = 0;
+	}
+
+	// Reserved at the last arbitration, or there is still room in this frames budget after the reserved grants
+	if (StereoWidgetRedrawCvars::RedrawBudget <= 0 || GrantedComponents.Remove(InComponent) > 0 ||
+		RedrawsThisFrame + GrantedComponents.Num() < StereoWidgetRedrawCvars::RedrawBudget)
+	{
+		PendingRequests.RemoveAllSwap([InComponent](const FVRStereoWidgetRedrawRequest& Request) { return Request.Component == InComponent; });
+
+		++RedrawsThisFrame;
+		++TotalRedrawsPerformed;
+		INC_DWORD_STAT(STAT_StereoWidgetRedrawsPerformed);
+		return true;
+	}
+
+	if (FVRStereoWidgetRedrawRequest* Existing = PendingRequests.FindByPredicate([InComponent](const FVRStereoWidgetRedrawRequest& Request) { return Request.Component == InComponent; }))
+	{
+		Existing->LastRequestFrame = GFrameCounter;
+		Existing->Priority = InPriority;
+		Existing->bIsVisible = bIsVisible;
+		return false;
+	}
+
+	FVRStereoWidgetRedrawRequest& NewRequest = PendingRequests.AddDefaulted_GetRef();
+	NewRequest.Component = InComponent;
+	NewRequest.LastRequestFrame = GFrameCounter;
+	NewRequest.Priority = InPriority;
+	NewRequest.bIsVisible = bIsVisible;
+	return false;
+}
+
+void UVRStereoWidgetRedrawSubsystem::NotifyRedrawSkipped()
+{
+	++TotalRedrawsSkipped;
+	INC_DWORD_STAT(STAT_StereoWidgetRedrawsSkipped);
+}
+
+void UVRStereoWidgetRedrawSubsystem::RemoveRedrawRequest(USceneComponent* InComponent)
+{
+	GrantedComponents.Remove(InComponent);
+	PendingRequests.RemoveAllSwap([InComponent](const FVRStereoWidgetRedrawRequest& Request) { return Request.Component == InComponent; });
+
+	FVRStereoWidgetInvalidationRoot InvalidationRoot;
+	if (InvalidationRoots.RemoveAndCopyValue(InComponent, InvalidationRoot))
+	{
+		ComponentsByRootWidget.Remove(InvalidationRoot.RootWidget.Pin().Get());
+		UpdateWidgetInvalidateBinding();
+	}
+}
+
+bool UVRStereoWidgetRedrawSubsystem::ConsumeWidgetInvalidation(USceneComponent* InComponent, const TSharedPtr<SWidget>& InRootWidget)
+{
+	if (!InComponent || !InRootWidget.IsValid())
+		return false;
+
+	// Without the slate debugging invalidate event there is nothing to tell a clean widget from a dirty one,
+	// treat it as always invalidated so the widget keeps drawing at its own rate (still within the budget).
+	if (!CanTrackWidgetInvalidations())
+		return true;
+
+	FVRStereoWidgetInvalidationRoot& InvalidationRoot = InvalidationRoots.FindOrAdd(InComponent);
+
+	TSharedPtr<SWidget> OldRootWidget = InvalidationRoot.RootWidget.Pin();
+	if (OldRootWidget != InRootWidget)
+	{
+		// The window was re-created, nothing was drawn from the new one yet
+		if (OldRootWidget.IsValid())
+		{
+			ComponentsByRootWidget.Remove(OldRootWidget.Get());
+		}
+
+		InvalidationRoot.RootWidget = InRootWidget;
+		InvalidationRoot.bInvalidated = true;
+		ComponentsByRootWidget.Add(InRootWidget.Get(), InComponent);
+		UpdateWidgetInvalidateBinding();
+	}
+
+	const bool bWasInvalidated = InvalidationRoot.bInvalidated;
+	InvalidationRoot.bInvalidated = false;
+	return bWasInvalidated;
+}
+
+void UVRStereoWidgetRedrawSubsystem::OnWidgetInvalidated(const FSlateDebuggingInvalidateArgs& InvalidateArgs)
+{
+#if WITH_SLATE_DEBUGGING
+	if (ComponentsByRootWidget.Num() < 1)
+		return;
+
+	// Walk up to the window, the event fires for every widget in the application so bail out as soon as possible
+	TSharedPtr<SWidget> ParentWidget;
+	for (const SWidget* Widget = InvalidateArgs.WidgetInvalidated; Widget != nullptr; Widget = ParentWidget.Get())
+	{
+		if (const TWeakObjectPtr<USceneComponent>* Component = ComponentsByRootWidget.Find(Widget))
+		{
+			if (FVRStereoWidgetInvalidationRoot* InvalidationRoot = InvalidationRoots.Find(*Component))
+			{
+				InvalidationRoot->bInvalidated = true;
+			}
+			return;
+		}
+
+		ParentWidget = Widget->GetParentWidget();
+	}
+#endif
+}
+
+bool UVRStereoWidgetRedrawSubsystem::HasPendingSlateWork(UUserWidget* InWidget, const TSharedPtr<SWidget>& InSlateWidget)
+{
+	if (InWidget)
+	{
+		if (InWidget->IsAnyAnimationPlaying() || InWidget->IsHovered() || InWidget->HasAnyUserFocus())
+			return true;
+	}
+
+	TSharedPtr<SWidget> RootWidget = InSlateWidget.IsValid() ? InSlateWidget : (InWidget ? InWidget->GetCachedWidget() : nullptr);
+
+	if (RootWidget.IsValid())
+	{
+		// Active timers drive throbbers, text carets and the like, volatile widgets repaint every frame by definition
+		if (RootWidget->IsVolatile() || RootWidget->IsHovered() ||
+			RootWidget->HasAnyUpdateFlags(EWidgetUpdateFlags::NeedsActiveTimerUpdate | EWidgetUpdateFlags::NeedsVolatilePaint))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UVRStereoWidgetRedrawSubsystem::ResetRedrawCounters()
+{
+	TotalRedrawsPerformed = 0;
+	TotalRedrawsSkipped = 0;
+	TotalRedrawsDeferred = 0;
+}
+
+void UVRStereoWidgetRedrawSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_StereoWidgetArbitrateRedraws);
+
+	// Grants that were not consumed this frame have expired, the component will request again if it is still dirty
+	GrantedComponents.Reset();
+
+	// Components or windows that went away without unregistering, the root widget keys are only compared, never dereferenced
+	bool bRemovedRoots = false;
+	for (auto RootIt = InvalidationRoots.CreateIterator(); RootIt; ++RootIt)
+	{
+		if (!RootIt.Key().IsValid() || !RootIt.Value().RootWidget.IsValid())
+		{
+			RootIt.RemoveCurrent();
+			bRemovedRoots = true;
+		}
+	}
+
+	if (bRemovedRoots)
+	{
+		ComponentsByRootWidget.Reset();
+		for (const TPair<TWeakObjectPtr<USceneComponent>, FVRStereoWidgetInvalidationRoot>& RootPair : InvalidationRoots)
+		{
+			ComponentsByRootWidget.Add(RootPair.Value.RootWidget.Pin().Get(), RootPair.Key);
+		}
+
+		UpdateWidgetInvalidateBinding();
+	}
+
+	// Drop anything that wasn't renewed this frame, it either went clean or stopped ticking
+	const uint64 CurrentFrame = GFrameCounter;
+	PendingRequests.RemoveAllSwap([CurrentFrame](const FVRStereoWidgetRedrawRequest& Request) { return !Request.Component.IsValid() || Request.LastRequestFrame != CurrentFrame; });
+
+	if (PendingRequests.Num() < 1)
+		return;
+
+	// Visible widgets first, then by layer priority, then whoever has waited the longest so nothing starves at equal priority
+	PendingRequests.Sort([](const FVRStereoWidgetRedrawRequest& A, const FVRStereoWidgetRedrawRequest& B)
+	{
+		if (A.bIsVisible != B.bIsVisible)
+			return A.bIsVisible;
+
+		if (A.Priority != B.Priority)
+			return A.Priority > B.Priority;
+
+		return A.FramesWaiting > B.FramesWaiting;
+	});
+
+	const int32 NumGranted = StereoWidgetRedrawCvars::RedrawBudget > 0 ? FMath::Min(StereoWidgetRedrawCvars::RedrawBudget, PendingRequests.Num()) : PendingRequests.Num();
+
+	for (int32 i = 0; i < NumGranted; ++i)
+	{
+		GrantedComponents.Add(PendingRequests[i].Component);
+	}
+
+	// Keep the losers queued with their wait time so they move up at the next arbitration
+	PendingRequests.RemoveAt(0, NumGranted, false);
+	for (FVRStereoWidgetRedrawRequest& Request : PendingRequests)
+	{
+		++Request.FramesWaiting;
+	}
+
+	TotalRedrawsDeferred += PendingRequests.Num();
+	INC_DWORD_STAT_BY(STAT_StereoWidgetRedrawsDeferred, PendingRequests.Num());
+}
+
+bool UVRStereoWidgetRedrawSubsystem::IsTickable() const
+{
+	return PendingRequests.Num() > 0 || GrantedComponents.Num() > 0;
+}
+
+UWorld* UVRStereoWidgetRedrawSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+bool UVRStereoWidgetRedrawSubsystem::IsTickableInEditor() const
+{
+	return false;
+}
+
+bool UVRStereoWidgetRedrawSubsystem::IsTickableWhenPaused() const
+{
+	return false;
+}
+
+ETickableTickType UVRStereoWidgetRedrawSubsystem::GetTickableTickType() const
+{
+	if (IsTemplate(RF_ClassDefaultObject))
+		return ETickableTickType::Never;
+
+	return ETickableTickType::Conditional;
+}
+
+TStatId UVRStereoWidgetRedrawSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRStereoWidgetRedrawSubsystem, STATGROUP_Tickables);
+}
@@ -118,6 +118,17 @@ void UReplicatedVRCameraComponent::GetLifetimeReplicatedProps(TArray< class FLif
 
 void UReplicatedVRCameraComponent::Server_SendCameraTransform_Implementation(FBPVRComponentPosRep NewTransform)
 {
+	bool bSendAck = false;
+	uint8 BaselineAck = 0;
+	const bool bResolved = PoseDeltaReceiver.Resolve(NewTransform, bSendAck, BaselineAck);
+
+	if (bSendAck)
+		Client_AckPoseBaseline(BaselineAck);
+
+	// Delta against a baseline we never got, hold the last pose until the client resyncs
+	if (!bResolved)
+		return;
+
 	// Store new transform and trigger OnRep_Function
 	ReplicatedCameraTransform = NewTransform;
 
@@ -134,6 +145,11 @@ bool UReplicatedVRCameraComponent::Server_SendCameraTransform_Validate(FBPVRComp
 	// Optionally check to make sure that player is inside of their bounds and deny it if they aren't?
 }
 
+void UReplicatedVRCameraComponent::Client_AckPoseBaseline_Implementation(uint8 BaselineAck)
+{
+	PoseDeltaSender.OnBaselineAck(BaselineAck);
+}
+
 /*bool UReplicatedVRCameraComponent::IsServer()
 {
 	if (GEngine != nullptr && GWorld != nullptr)
@@ -273,16 +289,20 @@ void UReplicatedVRCameraComponent::TickComponent(float DeltaTime, enum ELevelTic
 
 					if (GetNetMode() == NM_Client)
 					{
+						// Turns the send into a baseline or delta if delta encoding is on
+						FBPVRComponentPosRep SendTransform = ReplicatedCameraTransform;
+						PoseDeltaSender.PrepareForSend(SendTransform);
+
 						AVRBaseCharacter* OwningChar = Cast<AVRBaseCharacter>(GetOwner());
 						if (OverrideSendTransform != nullptr && OwningChar != nullptr)
 						{
-							(OwningChar->* (OverrideSendTransform))(ReplicatedCameraTransform);
+							(OwningChar->* (OverrideSendTransform))(SendTransform);
 						}
 						else
 						{
 							// Don't bother with any of this if not replicating transform
 							//if (bHasAuthority && bReplicateTransform)
-							Server_SendCameraTransform(ReplicatedCameraTransform);
+							Server_SendCameraTransform(SendTransform);
 						}
 					}
 				}
@@ -1,6 +1,8 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "VRBPDatatypes.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
 
 namespace VRDataTypeCVARs
 {
@@ -13,6 +15,17 @@ namespace VRDataTypeCVARs
 		TEXT("When on, will rep Quantized transforms at full precision, WARNING use at own risk, if this isn't the same setting client & server then it will crash.\n")
 		TEXT("0: Disable, 1: Enable"),
 		ECVF_Default);
+
+	static int32 PoseDeltaResyncInterval = 60;
+	FAutoConsoleVariableRef CVarPoseDeltaResyncInterval(
+		TEXT("vrexp.PoseDeltaResyncInterval"),
+		PoseDeltaResyncInterval,
+		TEXT("Number of delta encoded pose sends before an absolute baseline is forced again.\n")
+		TEXT("0: Only resync when the pose leaves the delta range or a baseline is lost"),
+		ECVF_Default);
+
+	// Gives the previous baseline time to be acked before we replace it
+	static const int32 MinSendsBetweenBaselines = 4;
 }
 
 bool FTransform_NetQuantize::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
@@ -198,3 +211,150 @@ FTransform FBPEuroLowPassFilterTrans::RunFilterSmoothing(const FTransform& InRaw
 	// Filter passed value 
 	return NewTrans;
 }
+
+void FVRPoseDeltaSender::Reset()
+{
+	for (FBaseline& Baseline : SentBaselines)
+	{
+		Baseline.bValid = false;
+	}
+
+	AckedBaselineId = INDEX_NONE;
+	NextBaselineId = 0;
+
+	// First send is always a baseline
+	SendsSinceBaseline = VRDataTypeCVARs::MinSendsBetweenBaselines;
+}
+
+void FVRPoseDeltaSender::PrepareForSend(FBPVRComponentPosRep& InOutPose)
+{
+	InOutPose.ClearDeltaState();
+
+	if (!InOutPose.bUseDeltaEncoding)
+		return;
+
+	++SendsSinceBaseline;
+
+	bool bWantsBaseline = AckedBaselineId == INDEX_NONE ||
+		(VRDataTypeCVARs::PoseDeltaResyncInterval > 0 && SendsSinceBaseline >= VRDataTypeCVARs::PoseDeltaResyncInterval);
+
+	bool bInDeltaRange = false;
+
+	if (AckedBaselineId != INDEX_NONE)
+	{
+		const FBaseline& Baseline = SentBaselines[AckedBaselineId];
+
+		const FVector DeltaPos = InOutPose.Position - Baseline.Position;
+		FQuat DeltaRot = Baseline.Rotation.Inverse() * InOutPose.Rotation.Quaternion();
+		DeltaRot.Normalize();
+
+		const float DeltaPosMax = DeltaPos.GetAbsMax();
+		const float DeltaAngle = FMath::RadiansToDegrees(2.f * FMath::Acos(FMath::Min(1.f, FMath::Abs(DeltaRot.W))));
+
+		bInDeltaRange = DeltaPosMax <= TransNetQuant::MaxDeltaPosition && DeltaAngle <= TransNetQuant::MaxDeltaRotationDegrees;
+
+		// Start moving the baseline once we pass half of the range so the ack lands before we run out
+		if (DeltaPosMax > TransNetQuant::MaxDeltaPosition * 0.5f || DeltaAngle > TransNetQuant::MaxDeltaRotationDegrees * 0.5f)
+		{
+			bWantsBaseline = true;
+		}
+	}
+
+	if (bWantsBaseline && SendsSinceBaseline >= VRDataTypeCVARs::MinSendsBetweenBaselines)
+	{
+		// Never overwrite the slot the current deltas are encoded against
+		uint8 NewId = NextBaselineId;
+		if (NewId == AckedBaselineId)
+		{
+			NewId = (NewId + 1) & TransNetQuant::BaselineIdMask;
+		}
+
+		NextBaselineId = (NewId + 1) & TransNetQuant::BaselineIdMask;
+		SendsSinceBaseline = 0;
+
+		FBaseline& Baseline = SentBaselines[NewId];
+		QuantizePose(InOutPose, Baseline.Position, Baseline.Rotation);
+		Baseline.bValid = true;
+
+		InOutPose.SetAsBaseline(NewId);
+	}
+	else if (bInDeltaRange)
+	{
+		const FBaseline& Baseline = SentBaselines[AckedBaselineId];
+		InOutPose.SetDeltaFromBaseline((uint8)AckedBaselineId, Baseline.Position, Baseline.Rotation);
+	}
+	// Otherwise it goes out absolute while waiting on the next baseline
+}
+
+void FVRPoseDeltaSender::OnBaselineAck(uint8 BaselineAck)
+{
+	const int32 AckId = BaselineAck & TransNetQuant::BaselineIdMask;
+
+	if (BaselineAck & TransNetQuant::BaselineLostFlag)
+	{
+		// Receiver never got it, stop using it and resync as soon as allowed
+		SentBaselines[AckId].bValid = false;
+		if (AckedBaselineId == AckId)
+		{
+			AckedBaselineId = INDEX_NONE;
+			SendsSinceBaseline = VRDataTypeCVARs::MinSendsBetweenBaselines;
+		}
+	}
+	else if (SentBaselines[AckId].bValid)
+	{
+		// Ids wrap every NumBaselineIds * MinSendsBetweenBaselines sends, far longer than an ack takes to arrive
+		AckedBaselineId = AckId;
+	}
+}
+
+void FVRPoseDeltaSender::QuantizePose(const FBPVRComponentPosRep& InPose, FVector& OutPosition, FQuat& OutRotation)
+{
+	FBPVRComponentPosRep SendPose = InPose;
+	SendPose.ClearDeltaState();
+
+	bool bSuccess = true;
+	FBitWriter Writer(0, true);
+	SendPose.NetSerialize(Writer, nullptr, bSuccess);
+
+	FBPVRComponentPosRep ReceivedPose;
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	ReceivedPose.NetSerialize(Reader, nullptr, bSuccess);
+
+	OutPosition = ReceivedPose.Position;
+	OutRotation = ReceivedPose.Rotation.Quaternion();
+}
+
+bool FVRPoseDeltaReceiver::Resolve(FBPVRComponentPosRep& InOutPose, bool& bOutSendAck, uint8& OutAck)
+{
+	bOutSendAck = false;
+	OutAck = 0;
+
+	if (!InOutPose.bIsBaseline && !InOutPose.bIsDelta)
+		return true;
+
+	const uint8 Id = InOutPose.BaselineId & TransNetQuant::BaselineIdMask;
+	FVRPoseDeltaSender::FBaseline& Baseline = Baselines[Id];
+
+	if (InOutPose.bIsBaseline)
+	{
+		Baseline.Position = InOutPose.Position;
+		Baseline.Rotation = InOutPose.Rotation.Quaternion();
+		Baseline.bValid = true;
+
+		InOutPose.ClearDeltaState();
+		bOutSendAck = true;
+		OutAck = Id;
+		return true;
+	}
+
+	if (!Baseline.bValid)
+	{
+		InOutPose.ClearDeltaState();
+		bOutSendAck = true;
+		OutAck = Id | TransNetQuant::BaselineLostFlag;
+		return false;
+	}
+
+	InOutPose.ResolveDelta(Baseline.Position, Baseline.Rotation);
+	return true;
+}
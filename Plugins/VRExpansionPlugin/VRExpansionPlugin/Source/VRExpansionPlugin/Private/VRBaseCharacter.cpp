@@ -50,7 +50,7 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
 	{
 		VRReplicatedCamera->bOffsetByHMD = false;
 		VRReplicatedCamera->SetupAttachment(NetSmoother);
-		VRReplicatedCamera->OverrideSendTransform = &AVRBaseCharacter::Server_SendTransformCamera;
+		VRReplicatedCamera->OverrideSendTransform = &AVRBaseCharacter::SendTransformCamera;
 	}
 
 	VRMovementReference = NULL;
@@ -85,7 +85,7 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
 		//LeftMotionController->bUpdateInCharacterMovement = true;
 		// Keep the controllers ticking after movement
 		LeftMotionController->AddTickPrerequisiteComponent(GetCharacterMovement());
-		LeftMotionController->OverrideSendTransform = &AVRBaseCharacter::Server_SendTransformLeftController;
+		LeftMotionController->OverrideSendTransform = &AVRBaseCharacter::SendTransformLeftController;
 	}
 
 	RightMotionController = CreateDefaultSubobject<UGripMotionControllerComponent>(AVRBaseCharacter::RightMotionControllerComponentName);
@@ -99,7 +99,7 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
 		//RightMotionController->bUpdateInCharacterMovement = true;
 		// Keep the controllers ticking after movement
 		RightMotionController->AddTickPrerequisiteComponent(GetCharacterMovement());
-		RightMotionController->OverrideSendTransform = &AVRBaseCharacter::Server_SendTransformRightController;
+		RightMotionController->OverrideSendTransform = &AVRBaseCharacter::SendTransformRightController;
 	}
 
 	OffsetComponentToWorld = FTransform(FQuat(0.0f, 0.0f, 0.0f, 1.0f), FVector::ZeroVector, FVector(1.0f));
@@ -116,6 +116,9 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
 
 	VRReplicateCapsuleHeight = false;
 
+	bBatchTrackedPoseUpdates = false;
+	LastReceivedPoseTimeStamp = -MAX_FLT;
+
 	bUseExperimentalUnseatModeFix = true;
 
 	ReplicatedMovementVR.Owner = this;
@@ -313,6 +316,86 @@ bool AVRBaseCharacter::Server_SendTransformRightController_Validate(FBPVRCompone
 	return true;
 	// Optionally check to make sure that player is inside of their bounds and deny it if they aren't?
 }
+
+void AVRBaseCharacter::SendTransformCamera(FBPVRComponentPosRep NewTransform)
+{
+	if (bBatchTrackedPoseUpdates)
+		QueueTrackedPose(EVRTrackedPoseFlags::Camera, NewTransform);
+	else
+		Server_SendTransformCamera(NewTransform);
+}
+
+void AVRBaseCharacter::SendTransformLeftController(FBPVRComponentPosRep NewTransform)
+{
+	if (bBatchTrackedPoseUpdates)
+		QueueTrackedPose(EVRTrackedPoseFlags::LeftController, NewTransform);
+	else
+		Server_SendTransformLeftController(NewTransform);
+}
+
+void AVRBaseCharacter::SendTransformRightController(FBPVRComponentPosRep NewTransform)
+{
+	if (bBatchTrackedPoseUpdates)
+		QueueTrackedPose(EVRTrackedPoseFlags::RightController, NewTransform);
+	else
+		Server_SendTransformRightController(NewTransform);
+}
+
+void AVRBaseCharacter::QueueTrackedPose(EVRTrackedPoseFlags Pose, const FBPVRComponentPosRep& NewTransform)
+{
+	PendingTrackedPoses.SetPose(Pose, NewTransform);
+
+	// The components tick at different points in the frame, so send once every actor has ticked (before the net driver flushes)
+	if (!FlushTrackedPosesHandle.IsValid())
+	{
+		FlushTrackedPosesHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &AVRBaseCharacter::FlushTrackedPoses);
+	}
+}
+
+void AVRBaseCharacter::FlushTrackedPoses(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || PendingTrackedPoses.ChangedPoses == 0)
+		return;
+
+	PendingTrackedPoses.TimeStamp = World->GetTimeSeconds();
+	Server_SendTrackedPoses(PendingTrackedPoses);
+	PendingTrackedPoses.ChangedPoses = 0;
+}
+
+void AVRBaseCharacter::Server_SendTrackedPoses_Implementation(const FVRTrackedPosesRep& NewPoses)
+{
+	// Unreliable, so an older update can arrive after a newer one
+	if (NewPoses.TimeStamp < LastReceivedPoseTimeStamp)
+		return;
+
+	LastReceivedPoseTimeStamp = NewPoses.TimeStamp;
+
+	if (VRReplicatedCamera && NewPoses.HasPose(EVRTrackedPoseFlags::Camera))
+		VRReplicatedCamera->Server_SendCameraTransform_Implementation(NewPoses.CameraPose);
+
+	if (LeftMotionController && NewPoses.HasPose(EVRTrackedPoseFlags::LeftController))
+		LeftMotionController->Server_SendControllerTransform_Implementation(NewPoses.LeftControllerPose);
+
+	if (RightMotionController && NewPoses.HasPose(EVRTrackedPoseFlags::RightController))
+		RightMotionController->Server_SendControllerTransform_Implementation(NewPoses.RightControllerPose);
+}
+
+bool AVRBaseCharacter::Server_SendTrackedPoses_Validate(const FVRTrackedPosesRep& NewPoses)
+{
+	return true;
+	// Optionally check to make sure that player is inside of their bounds and deny it if they aren't?
+}
+
+void AVRBaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (FlushTrackedPosesHandle.IsValid())
+	{
+		FWorldDelegates::OnWorldPostActorTick.Remove(FlushTrackedPosesHandle);
+		FlushTrackedPosesHandle.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
 FVector AVRBaseCharacter::GetTeleportLocation(FVector OriginalLocation)
 {	
 	return OriginalLocation;
@@ -6,6 +6,11 @@
 #include "IHeadMountedDisplay.h"
 #include "Grippables/HandSocketComponent.h"
 #include "Misc/CollisionIgnoreSubsystem.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Misc/StringBuilder.h"
 
 #if WITH_CHAOS
 #include "Chaos/ParticleHandle.h"
@@ -132,58 +137,219 @@ bool UVRExpansionFunctionLibrary::GetIsActorMovable(AActor* ActorToCheck)
 	return false;
 }
 
-void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName(FName SlotType, AActor* Actor, FVector WorldLocation, float MaxRange, bool& bHadSlotInRange, FTransform& SlotWorldTransform, FName& SlotName, UGripMotionControllerComponent* QueryController)
+// Grip slot index, built once per mesh and slot type so that slot queries don't have to gather and stringify every socket name each call
+namespace VRGripSlotIndex
 {
-	bHadSlotInRange = false;
-	SlotWorldTransform = FTransform::Identity;
-	SlotName = NAME_None;
-	UHandSocketComponent* TargetHandSocket = nullptr;
+	struct FSlotEntry
+	{
+		FName SocketName;
+		FVector ComponentLocation;
+	};
 
-	if (!Actor)
-		return;
+	struct FSlotList
+	{
+		TArray<FSlotEntry> Slots;
 
-	MaxRange = FMath::Square(MaxRange);
+		// Skeletal sockets and bones move with animation, so only their names are indexed
+		bool bStaticLocations = false;
+	};
 
-	if (USceneComponent* rootComp = Actor->GetRootComponent())
+	struct FMeshSlotIndex
 	{
-		FVector RelativeWorldLocation = rootComp->GetComponentTransform().InverseTransformPosition(WorldLocation);
-		float ClosestSlotDistance = -0.1f;
+		int32 SourceSocketCount = 0;
+		TMap<FName, FSlotList> SlotsByType;
+	};
+
+	static TMap<TWeakObjectPtr<const UObject>, FMeshSlotIndex> MeshIndices;
+
+	// Case insensitive "contains" to match the previous FString behavior, without allocating
+	static bool SlotNameMatches(FName Name, const TCHAR* SlotTypeString)
+	{
+		TStringBuilder<NAME_SIZE> NameString;
+		Name.AppendString(NameString);
+		return FCString::Stristr(*NameString, SlotTypeString) != nullptr;
+	}
+
+#if WITH_EDITOR
+	static void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+	{
+		// Sockets can be edited while PIE is running, just drop everything, it rebuilds on demand
+		if (MeshIndices.Num() > 0 && Object && (Object->IsA<UStaticMesh>() || Object->IsA<UStaticMeshSocket>() || Object->IsA<USkeletalMesh>() || Object->IsA<USkeletalMeshSocket>()))
+		{
+			MeshIndices.Empty();
+		}
+	}
+#endif
+
+	// Returns the indexed slots of the given type for a component, or nullptr if the component type isn't indexed
+	static const FSlotList* GetSlots(USceneComponent* Component, FName SlotType)
+	{
+#if WITH_EDITOR
+		static FDelegateHandle PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(&OnObjectPropertyChanged);
+#endif
 
-		TArray<FName> SocketNames = rootComp->GetAllSocketNames();
+		const UObject* Source = nullptr;
+		int32 SourceSocketCount = 0;
+		bool bStaticLocations = false;
 
-		FString GripIdentifier = SlotType.ToString();
+		UStaticMesh* StaticMesh = nullptr;
+		USkeletalMesh* SkeletalMesh = nullptr;
 
-		int foundIndex = 0;
+		if (UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component))
+		{
+			StaticMesh = StaticMeshComp->GetStaticMesh();
+			if (!StaticMesh)
+				return nullptr;
+
+			Source = StaticMesh;
+			SourceSocketCount = StaticMesh->Sockets.Num();
+			bStaticLocations = true;
+		}
+		else if (USkinnedMeshComponent* SkinnedComp = Cast<USkinnedMeshComponent>(Component))
+		{
+			SkeletalMesh = SkinnedComp->SkeletalMesh;
+			if (!SkeletalMesh)
+				return nullptr;
+
+			Source = SkeletalMesh;
+			SourceSocketCount = SkeletalMesh->NumSockets() + SkeletalMesh->GetRefSkeleton().GetNum();
+		}
+		else
+		{
+			return nullptr;
+		}
 
-		for (int i = 0; i < SocketNames.Num(); ++i)
+		FMeshSlotIndex* MeshIndex = MeshIndices.Find(Source);
+		if (!MeshIndex || MeshIndex->SourceSocketCount != SourceSocketCount)
 		{
-			if (SocketNames[i].ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+			if (!MeshIndex)
 			{
+				// Only runs when a new mesh is seen, clear out anything that got garbage collected
+				for (auto Itr = MeshIndices.CreateIterator(); Itr; ++Itr)
+				{
+					if (!Itr.Key().IsValid())
+					{
+						Itr.RemoveCurrent();
+					}
+				}
+			}
+
+			MeshIndex = &MeshIndices.FindOrAdd(Source);
+			MeshIndex->SourceSocketCount = SourceSocketCount;
+			MeshIndex->SlotsByType.Reset();
+		}
+
+		if (FSlotList* ExistingList = MeshIndex->SlotsByType.Find(SlotType))
+		{
+			return ExistingList;
+		}
+
+		FSlotList& NewList = MeshIndex->SlotsByType.Add(SlotType);
+		NewList.bStaticLocations = bStaticLocations;
 
-				float vecLen = FVector::DistSquared(RelativeWorldLocation, rootComp->GetSocketTransform(SocketNames[i], ERelativeTransformSpace::RTS_Component).GetLocation());
+		TStringBuilder<NAME_SIZE> SlotTypeString;
+		SlotType.AppendString(SlotTypeString);
+
+		if (StaticMesh)
+		{
+			for (const UStaticMeshSocket* Socket : StaticMesh->Sockets)
+			{
+				if (Socket && SlotNameMatches(Socket->SocketName, *SlotTypeString))
+				{
+					NewList.Slots.Add({ Socket->SocketName, Socket->RelativeLocation });
+				}
+			}
+		}
+		else if (SkeletalMesh)
+		{
+			// Same set of names that USkinnedMeshComponent::QuerySupportedSockets reports
+			const FReferenceSkeleton& RefSkeleton = SkeletalMesh->GetRefSkeleton();
+			for (int32 BoneIndex = 0; BoneIndex < RefSkeleton.GetNum(); ++BoneIndex)
+			{
+				const FName BoneName = RefSkeleton.GetBoneName(BoneIndex);
+				if (SlotNameMatches(BoneName, *SlotTypeString))
+				{
+					NewList.Slots.Add({ BoneName, FVector::ZeroVector });
+				}
+			}
 
-				if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
+			for (int32 SocketIndex = 0; SocketIndex < SkeletalMesh->NumSockets(); ++SocketIndex)
+			{
+				const USkeletalMeshSocket* Socket = SkeletalMesh->GetSocketByIndex(SocketIndex);
+				if (Socket && SlotNameMatches(Socket->SocketName, *SlotTypeString))
 				{
-					ClosestSlotDistance = vecLen;
-					bHadSlotInRange = true;
-					foundIndex = i;
+					NewList.Slots.Add({ Socket->SocketName, FVector::ZeroVector });
 				}
 			}
 		}
 
-		TArray<USceneComponent*> AttachChildren = rootComp->GetAttachChildren();
+		NewList.Slots.Shrink();
+		return &NewList;
+	}
+
+	static void GetGripSlotInRange(FName SlotType, USceneComponent* Component, FVector WorldLocation, float MaxRange, bool& bHadSlotInRange, FTransform& SlotWorldTransform, FName& SlotName, UGripMotionControllerComponent* QueryController)
+	{
+		bHadSlotInRange = false;
+		SlotWorldTransform = FTransform::Identity;
+		SlotName = NAME_None;
+		UHandSocketComponent* TargetHandSocket = nullptr;
+
+		if (!Component)
+			return;
+
+		FVector RelativeWorldLocation = Component->GetComponentTransform().InverseTransformPosition(WorldLocation);
+		MaxRange = FMath::Square(MaxRange);
+
+		float ClosestSlotDistance = -0.1f;
+
+		FName FoundSocketName = NAME_None;
+
+		TStringBuilder<NAME_SIZE> GripIdentifier;
+		SlotType.AppendString(GripIdentifier);
+
+		auto CheckSocket = [&](FName SocketName, const FVector& SocketLocation)
+		{
+			float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketLocation);
+
+			if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
+			{
+				ClosestSlotDistance = vecLen;
+				bHadSlotInRange = true;
+				FoundSocketName = SocketName;
+			}
+		};
+
+		if (const FSlotList* SlotList = GetSlots(Component, SlotType))
+		{
+			for (const FSlotEntry& Slot : SlotList->Slots)
+			{
+				CheckSocket(Slot.SocketName, SlotList->bStaticLocations ? Slot.ComponentLocation : Component->GetSocketTransform(Slot.SocketName, ERelativeTransformSpace::RTS_Component).GetLocation());
+			}
+		}
+		else
+		{
+			// Component types that aren't indexed still go through the generic socket query
+			TArray<FName> SocketNames = Component->GetAllSocketNames();
+
+			for (const FName& Socket : SocketNames)
+			{
+				if (SlotNameMatches(Socket, *GripIdentifier))
+				{
+					CheckSocket(Socket, Component->GetSocketTransform(Socket, ERelativeTransformSpace::RTS_Component).GetLocation());
+				}
+			}
+		}
 
-		TArray<UHandSocketComponent*> RotationallyMatchingHandSockets;
-		for (USceneComponent* AttachChild : AttachChildren)
+		TArray<UHandSocketComponent*, TInlineAllocator<4>> RotationallyMatchingHandSockets;
+		for (USceneComponent* AttachChild : Component->GetAttachChildren())
 		{
 			if (AttachChild && AttachChild->IsA<UHandSocketComponent>())
 			{
 				if (UHandSocketComponent* SocketComp = Cast<UHandSocketComponent>(AttachChild))
 				{
-					if (!SocketComp->bDisabled && SocketComp->SlotPrefix.ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+					if (!SocketComp->bDisabled && SlotNameMatches(SocketComp->SlotPrefix, *GripIdentifier))
 					{
 						float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketComp->GetRelativeLocation());
-
 						if (SocketComp->bAlwaysInRange)
 						{
 							TargetHandSocket = SocketComp;
@@ -232,7 +398,6 @@ void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName(FName SlotType, A
 			}
 		}
 
-
 		if (bHadSlotInRange)
 		{
 			if (TargetHandSocket)
@@ -243,125 +408,22 @@ void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName(FName SlotType, A
 			}
 			else
 			{
-				SlotWorldTransform = rootComp->GetSocketTransform(SocketNames[foundIndex]);
-				SlotName = SocketNames[foundIndex];
+				SlotWorldTransform = Component->GetSocketTransform(FoundSocketName);
+				SlotName = FoundSocketName;
 				SlotWorldTransform.SetScale3D(FVector(1.0f));
 			}
 		}
 	}
 }
 
-void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName_Component(FName SlotType, UPrimitiveComponent* Component, FVector WorldLocation, float MaxRange, bool& bHadSlotInRange, FTransform& SlotWorldTransform, FName& SlotName, UGripMotionControllerComponent* QueryController)
+void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName(FName SlotType, AActor* Actor, FVector WorldLocation, float MaxRange, bool& bHadSlotInRange, FTransform& SlotWorldTransform, FName& SlotName, UGripMotionControllerComponent* QueryController)
 {
-	bHadSlotInRange = false;
-	SlotWorldTransform = FTransform::Identity;
-	SlotName = NAME_None;
-	UHandSocketComponent* TargetHandSocket = nullptr;
-
-	if (!Component)
-		return;
-
-	FVector RelativeWorldLocation = Component->GetComponentTransform().InverseTransformPosition(WorldLocation);
-	MaxRange = FMath::Square(MaxRange);
-
-	float ClosestSlotDistance = -0.1f;
-
-	TArray<FName> SocketNames = Component->GetAllSocketNames();
-
-	FString GripIdentifier = SlotType.ToString();
-
-	int foundIndex = 0;
-
-	for (int i = 0; i < SocketNames.Num(); ++i)
-	{
-		if (SocketNames[i].ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
-		{
-			float vecLen = FVector::DistSquared(RelativeWorldLocation, Component->GetSocketTransform(SocketNames[i], ERelativeTransformSpace::RTS_Component).GetLocation());
-
-			if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
-			{
-				ClosestSlotDistance = vecLen;
-				bHadSlotInRange = true;
-				foundIndex = i;
-			}
-		}
-	}
-
-	TArray<USceneComponent*> AttachChildren = Component->GetAttachChildren();
-
-	TArray<UHandSocketComponent*> RotationallyMatchingHandSockets;
-	for (USceneComponent* AttachChild : AttachChildren)
-	{
-		if (AttachChild && AttachChild->IsA<UHandSocketComponent>())
-		{
-			if (UHandSocketComponent* SocketComp = Cast<UHandSocketComponent>(AttachChild))
-			{
-				if (!SocketComp->bDisabled && SocketComp->SlotPrefix.ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
-				{
-					float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketComp->GetRelativeLocation());
-					if (SocketComp->bAlwaysInRange)
-					{
-						TargetHandSocket = SocketComp;
-						ClosestSlotDistance = vecLen;
-						bHadSlotInRange = true;
-					}
-					else
-					{
-						float RangeVal = (SocketComp->OverrideDistance > 0.0f ? FMath::Square(SocketComp->OverrideDistance) : MaxRange);
-						if (RangeVal >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
-						{
-							if (SocketComp->bMatchRotation)
-							{
-								RotationallyMatchingHandSockets.Add(SocketComp);
-							}
-							else
-							{
-								TargetHandSocket = SocketComp;
-								ClosestSlotDistance = vecLen;
-								bHadSlotInRange = true;
-							}
-						}
-					}
-				}
-			}
-		}
-	}
-
-	// Try and sort through any hand sockets flagged as rotationally matched
-	if (RotationallyMatchingHandSockets.Num() > 0)
-	{
-		FQuat ControllerRot = QueryController->GetPivotTransform().GetRotation();
-		FQuat ClosestQuat = RotationallyMatchingHandSockets[0]->GetComponentTransform().GetRotation();
-
-		TargetHandSocket = RotationallyMatchingHandSockets[0];
-		bHadSlotInRange = true;
-		ClosestSlotDistance = ControllerRot.AngularDistance(ClosestQuat);
-		for (int i = 1; i < RotationallyMatchingHandSockets.Num(); i++)
-		{
-			float CheckDistance = ControllerRot.AngularDistance(RotationallyMatchingHandSockets[i]->GetComponentTransform().GetRotation());
-			if (CheckDistance < ClosestSlotDistance)
-			{
-				TargetHandSocket = RotationallyMatchingHandSockets[i];
-				ClosestSlotDistance = CheckDistance;
-			}
-		}
-	}
+	VRGripSlotIndex::GetGripSlotInRange(SlotType, Actor ? Actor->GetRootComponent() : nullptr, WorldLocation, MaxRange, bHadSlotInRange, SlotWorldTransform, SlotName, QueryController);
+}
 
-	if (bHadSlotInRange)
-	{
-		if (TargetHandSocket)
-		{
-			SlotWorldTransform = TargetHandSocket->GetHandSocketTransform(QueryController);
-			SlotName = TargetHandSocket->GetFName();
-			SlotWorldTransform.SetScale3D(FVector(1.0f));
-		}
-		else
-		{
-			SlotWorldTransform = Component->GetSocketTransform(SocketNames[foundIndex]);
-			SlotName = SocketNames[foundIndex];
-			SlotWorldTransform.SetScale3D(FVector(1.0f));
-		}
-	}
+void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName_Component(FName SlotType, UPrimitiveComponent* Component, FVector WorldLocation, float MaxRange, bool& bHadSlotInRange, FTransform& SlotWorldTransform, FName& SlotName, UGripMotionControllerComponent* QueryController)
+{
+	VRGripSlotIndex::GetGripSlotInRange(SlotType, Component, WorldLocation, MaxRange, bHadSlotInRange, SlotWorldTransform, SlotName, QueryController);
 }
 
 FRotator UVRExpansionFunctionLibrary::GetHMDPureYaw(FRotator HMDRotation)
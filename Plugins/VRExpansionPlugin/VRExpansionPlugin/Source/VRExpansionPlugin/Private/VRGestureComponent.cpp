@@ -1,7 +1,96 @@
 #include "VRGestureComponent.h"
 #include "TimerManager.h"
+#include "Async/ParallelFor.h"
 
 DECLARE_CYCLE_STAT(TEXT("TickGesture ~ TickingGesture"), STAT_TickGesture, STATGROUP_TickGesture);
+DECLARE_CYCLE_STAT(TEXT("TickGesture ~ RecognizeGesture"), STAT_RecognizeGesture, STATGROUP_TickGesture);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gestures Compared"), STAT_GesturesCompared, STATGROUP_TickGesture);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gestures Pruned By Lower Bound"), STAT_GesturesPruned, STATGROUP_TickGesture);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gestures Abandoned Early"), STAT_GesturesAbandoned, STATGROUP_TickGesture);
+
+namespace VRGestureDTW
+{
+	// Lower bounds are summed in a different order than the table so give them a little slack before pruning on them
+	static const float LowerBoundSlack = 0.999f;
+
+	FORCEINLINE float GestureDistance(const FVector& Seq1, const FVector& Seq2, bool bMirrorGesture)
+	{
+		if (bMirrorGesture)
+		{
+			return FVector::DistSquared(Seq1, FVector(Seq2.X, -Seq2.Y, Seq2.Z));
+		}
+
+		return FVector::DistSquared(Seq1, Seq2);
+	}
+
+	FORCEINLINE float AxisDistanceToRange(float Value, float RangeMin, float RangeMax)
+	{
+		return Value < RangeMin ? RangeMin - Value : (Value > RangeMax ? Value - RangeMax : 0.f);
+	}
+
+	// Squared distance from a point to a box, the box can be mirrored on Y the same as the gesture samples are
+	FORCEINLINE float DistanceToBounds(const FVector& Point, const FVector& BoundsMin, const FVector& BoundsMax, bool bMirrorGesture)
+	{
+		const float DX = AxisDistanceToRange(Point.X, BoundsMin.X, BoundsMax.X);
+		const float DY = bMirrorGesture ? AxisDistanceToRange(Point.Y, -BoundsMax.Y, -BoundsMin.Y) : AxisDistanceToRange(Point.Y, BoundsMin.Y, BoundsMax.Y);
+		const float DZ = AxisDistanceToRange(Point.Z, BoundsMin.Z, BoundsMax.Z);
+		return DX * DX + DY * DY + DZ * DZ;
+	}
+
+	// Every column of the table is on the winning path, so each example sample costs at least its distance to the bounds of the input
+	float LowerBoundFromInputBounds(const FBox& InputBounds, const FVector* Example, int32 NumExample, bool bMirrorGesture)
+	{
+		float Bound = 0.f;
+		for (int32 j = 0; j < NumExample; j++)
+		{
+			// Mirror the sample instead of the box here, the distance is symmetric
+			const FVector Sample = bMirrorGesture ? FVector(Example[j].X, -Example[j].Y, Example[j].Z) : Example[j];
+			Bound += DistanceToBounds(Sample, InputBounds.Min, InputBounds.Max, false);
+		}
+
+		return Bound;
+	}
+
+	// LB_Keogh, with a band every input row up to NumExample - BandWidth has to be on the winning path and within the band of the example
+	float LowerBoundFromEnvelope(const FVRGestureEnvelope& Envelope, const FVector* Input, int32 NumInput, bool bMirrorGesture)
+	{
+		const int32 NumRows = FMath::Min(NumInput, Envelope.NumSamples - Envelope.BandWidth);
+		float Bound = 0.f;
+		for (int32 i = 0; i < NumRows; i++)
+		{
+			Bound += DistanceToBounds(Input[i], Envelope.Min[i], Envelope.Max[i], bMirrorGesture);
+		}
+
+		return Bound;
+	}
+}
+
+void FVRGestureEnvelope::Build(const FVRGesture& Gesture, int32 InBandWidth)
+{
+	SourceData = Gesture.Samples.GetData();
+	NumSamples = Gesture.Samples.Num();
+	BandWidth = InBandWidth;
+	SampleCrc = FCrc::MemCrc32(Gesture.Samples.GetData(), Gesture.Samples.Num() * sizeof(FVector));
+
+	Min.SetNumUninitialized(NumSamples);
+	Max.SetNumUninitialized(NumSamples);
+
+	for (int32 i = 0; i < NumSamples; i++)
+	{
+		FVector WindowMin = Gesture.Samples[i];
+		FVector WindowMax = Gesture.Samples[i];
+
+		const int32 WindowEnd = FMath::Min(NumSamples - 1, i + BandWidth);
+		for (int32 j = FMath::Max(0, i - BandWidth); j <= WindowEnd; j++)
+		{
+			WindowMin = WindowMin.ComponentMin(Gesture.Samples[j]);
+			WindowMax = WindowMax.ComponentMax(Gesture.Samples[j]);
+		}
+
+		Min[i] = WindowMin;
+		Max[i] = WindowMax;
+	}
+}
 
 UVRGestureComponent::UVRGestureComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -12,6 +101,14 @@ UVRGestureComponent::UVRGestureComponent(const FObjectInitializer& ObjectInitial
 	//PrimaryComponentTick.bTickEvenWhenPaused = false;
 
 	maxSlope = 3;// INT_MAX;
+	DTWBandWidth = 0;
+	bParallelRecognition = false;
+	ParallelRecognitionMinGestures = 32;
+	bStreamingRecognition = false;
+	StreamingRescaleTolerance = 0.05f;
+	StreamDatabase = nullptr;
+	StreamScaler = 1.f;
+	StreamSampleCount = 0;
 	//globalThreshold = 10.0f;
 	SameSampleTolerance = 0.1f;
 	bGestureChanged = false;
@@ -145,6 +242,7 @@ void UVRGestureComponent::BeginRecording(bool bRunDetection, bool bFlattenGestur
 
 	// Reset does the reserve already
 	GestureLog.Samples.Reset(RecordingBufferSize);
+	ResetStreamingRecognition();
 
 	CurrentState = bRunDetection ? EVRGestureState::GES_Detecting : EVRGestureState::GES_Recording;
 
@@ -295,7 +393,12 @@ void UVRGestureComponent::TickGesture()
 	case EVRGestureState::GES_Detecting:
 	{
 		CaptureGestureFrame();
-		RecognizeGesture(GestureLog);
+
+		if (bStreamingRecognition)
+			RecognizeGestureStreaming();
+		else
+			RecognizeGesture(GestureLog);
+
 		bGestureChanged = false;
 	}break;
 
@@ -319,155 +422,510 @@ void UVRGestureComponent::TickGesture()
 	}
 }
 
-void UVRGestureComponent::RecognizeGesture(FVRGesture inputGesture)
+void UVRGestureComponent::RecognizeGesture(const FVRGesture& inputGesture)
 {
 	if (!GesturesDB || inputGesture.Samples.Num() < 1 || !bGestureChanged)
 		return;
 
+	float minDist = MAX_FLT;
+	int OutGestureIndex = FindBestGestureMatch(inputGesture, minDist);
+
+	if (/*minDist < FMath::Square(globalThreshold) && */OutGestureIndex != -1)
+	{
+		OnGestureDetected(GesturesDB->Gestures[OutGestureIndex].GestureType, /*minDist,*/ GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB);
+		OnGestureDetected_Bind.Broadcast(GesturesDB->Gestures[OutGestureIndex].GestureType, /*minDist,*/ GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB);
+		ClearRecording(); // Clear the recording out, we don't want to detect this gesture again with the same data
+		RecordingGestureDraw.Reset();
+	}
+}
+
+int32 UVRGestureComponent::FindBestGestureMatch(const FVRGesture& inputGesture, float& OutDistance)
+{
+	OutDistance = MAX_FLT;
+
+	if (!GesturesDB || inputGesture.Samples.Num() < 1)
+		return INDEX_NONE;
+
+	SCOPE_CYCLE_COUNTER(STAT_RecognizeGesture);
+
 	float minDist = MAX_FLT;
 
 	int OutGestureIndex = -1;
-	bool bMirrorGesture = false;
 
 	FVector Size = inputGesture.GestureSize.GetSize();
 	float Scaler = GesturesDB->TargetGestureScale / Size.GetMax();
-	float FinalScaler = Scaler;
 
-	for (int i = 0; i < GesturesDB->Gestures.Num(); i++)
+	const int32 NumInput = inputGesture.Samples.Num();
+	const int32 BandWidth = FMath::Max(DTWBandWidth, 0);
+
+	// Scale the input once up front instead of per table cell, gestures with scaling disabled use the raw samples
+	TArray<FVector> ScaledSamples;
+	ScaledSamples.SetNumUninitialized(NumInput);
+	FBox ScaledBounds(ForceInit);
+	FBox RawBounds(ForceInit);
+	for (int32 i = 0; i < NumInput; i++)
+	{
+		ScaledSamples[i] = inputGesture.Samples[i] * Scaler;
+		ScaledBounds += ScaledSamples[i];
+		RawBounds += inputGesture.Samples[i];
+	}
+
+	TArray<FVRGesture>& Gestures = GesturesDB->Gestures;
+
+	if (BandWidth > 0 && GestureEnvelopes.Num() != Gestures.Num())
+	{
+		GestureEnvelopes.SetNum(Gestures.Num());
+	}
+
+	// Checks a single database gesture, returns true and the normalized distance if it is under Cutoff
+	auto EvaluateGesture = [&](int32 GestureIndex, float Cutoff, float& OutDistance) -> bool
 	{
-		FVRGesture &exampleGesture = GesturesDB->Gestures[i];
+		const FVRGesture& exampleGesture = Gestures[GestureIndex];
+		const int32 NumExample = exampleGesture.Samples.Num();
 
-		if (!exampleGesture.GestureSettings.bEnabled || exampleGesture.Samples.Num() < 1 || inputGesture.Samples.Num() < exampleGesture.GestureSettings.Minimum_Gesture_Length)
-			continue;
+		if (!exampleGesture.GestureSettings.bEnabled || NumExample < 1 || NumInput < exampleGesture.GestureSettings.Minimum_Gesture_Length)
+			return false;
 
-		FinalScaler = exampleGesture.GestureSettings.bEnableScaling ? Scaler : 1.f;
+		const bool bScaled = exampleGesture.GestureSettings.bEnableScaling;
+		const FVector* Input = bScaled ? ScaledSamples.GetData() : inputGesture.Samples.GetData();
+		const FBox& InputBounds = bScaled ? ScaledBounds : RawBounds;
+		const FVector* Example = exampleGesture.Samples.GetData();
 
-		bMirrorGesture = (MirroringHand != EVRGestureMirrorMode::GES_NoMirror && MirroringHand != EVRGestureMirrorMode::GES_MirrorBoth && MirroringHand == exampleGesture.GestureSettings.MirrorMode);
+		bool bMirrorGesture = (MirroringHand != EVRGestureMirrorMode::GES_NoMirror && MirroringHand != EVRGestureMirrorMode::GES_MirrorBoth && MirroringHand == exampleGesture.GestureSettings.MirrorMode);
+		const float FirstThresholdSq = FMath::Square(exampleGesture.GestureSettings.firstThreshold);
 
-		if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+		if (VRGestureDTW::GestureDistance(Input[0], Example[0], bMirrorGesture) >= FirstThresholdSq)
 		{
-			float d = dtw(inputGesture, exampleGesture, bMirrorGesture, FinalScaler) / (exampleGesture.Samples.Num());
-			if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
-			{
-				minDist = d;
-				OutGestureIndex = i;
-			}
+			if (exampleGesture.GestureSettings.MirrorMode != EVRGestureMirrorMode::GES_MirrorBoth)
+				return false;
+
+			bMirrorGesture = true;
+			if (VRGestureDTW::GestureDistance(Input[0], Example[0], bMirrorGesture) >= FirstThresholdSq)
+				return false;
 		}
-		else if (exampleGesture.GestureSettings.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth)
+
+		// Can't reach the end of the example within the band
+		if (BandWidth > 0 && NumInput < NumExample - BandWidth)
+			return false;
+
+		INC_DWORD_STAT(STAT_GesturesCompared);
+
+		float LowerBound = VRGestureDTW::LowerBoundFromInputBounds(InputBounds, Example, NumExample, bMirrorGesture);
+
+		if (BandWidth > 0)
 		{
-			bMirrorGesture = true;
-			if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+			FVRGestureEnvelope& Envelope = GestureEnvelopes[GestureIndex];
+			if (!Envelope.IsValidFor(exampleGesture, BandWidth))
 			{
-				float d = dtw(inputGesture, exampleGesture, bMirrorGesture, FinalScaler) / (exampleGesture.Samples.Num());
-				if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
-				{
-					minDist = d;
-					OutGestureIndex = i;
-				}
+				Envelope.Build(exampleGesture, BandWidth);
 			}
+
+			LowerBound = FMath::Max(LowerBound, VRGestureDTW::LowerBoundFromEnvelope(Envelope, Input, NumInput, bMirrorGesture));
 		}
 
-		/*if (exampleGesture.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth)
+		if ((LowerBound * VRGestureDTW::LowerBoundSlack) / NumExample >= Cutoff)
 		{
-			bMirrorGesture = true;
+			INC_DWORD_STAT(STAT_GesturesPruned);
+			return false;
+		}
+
+		float Cost = MAX_FLT;
+		if (!ComputeDTW(Input, NumInput, Example, NumExample, bMirrorGesture, maxSlope, BandWidth, Cutoff, Cost))
+		{
+			INC_DWORD_STAT(STAT_GesturesAbandoned);
+			return false;
+		}
+
+		OutDistance = Cost / NumExample;
+		return OutDistance < Cutoff;
+	};
+
+	if (bParallelRecognition && Gestures.Num() >= FMath::Max(ParallelRecognitionMinGestures, 1))
+	{
+		// Only the full threshold can be used to cut off while running in parallel, the best match is picked in order afterwards
+		// so that ties resolve the same as they do serially
+		TArray<float> Distances;
+		Distances.Init(MAX_FLT, Gestures.Num());
 
-			if (GetGestureDistance(inputGesture.Samples[0], exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+		ParallelFor(Gestures.Num(), [&](int32 i)
 			{
-				float d = dtw(inputGesture, exampleGesture, bMirrorGesture) / (exampleGesture.Samples.Num());
-				if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
+				float Distance = MAX_FLT;
+				if (EvaluateGesture(i, FMath::Square(Gestures[i].GestureSettings.FullThreshold), Distance))
 				{
-					minDist = d;
-					OutGestureIndex = i;
+					Distances[i] = Distance;
 				}
+			});
+
+		for (int i = 0; i < Distances.Num(); i++)
+		{
+			if (Distances[i] < minDist)
+			{
+				minDist = Distances[i];
+				OutGestureIndex = i;
 			}
-		}*/
+		}
+	}
+	else
+	{
+		for (int i = 0; i < Gestures.Num(); i++)
+		{
+			float Distance = MAX_FLT;
+			if (EvaluateGesture(i, FMath::Min(minDist, FMath::Square(Gestures[i].GestureSettings.FullThreshold)), Distance))
+			{
+				minDist = Distance;
+				OutGestureIndex = i;
+			}
+		}
 	}
 
-	if (/*minDist < FMath::Square(globalThreshold) && */OutGestureIndex != -1)
+	OutDistance = minDist;
+	return OutGestureIndex;
+}
+
+void UVRGestureComponent::ResetStreamingRecognition()
+{
+	StreamStates.Reset();
+	StreamDatabase = nullptr;
+	StreamScaler = 1.f;
+	StreamSampleCount = 0;
+}
+
+void UVRGestureComponent::StepStreamingColumn(FVRGestureStreamColumn& Column, const FVRGesture& Example, const FVector& Sample, int32 SampleNumber, bool bMirrorGesture)
+{
+	const int32 NumExample = Example.Samples.Num();
+
+	// This is the full tables recurrence run the other way around (input oldest to newest, gesture in recorded order) so that
+	// a column can be extended without the newest sample anchoring it. Without maxSlope both pick the cheapest path over the
+	// same set of paths, with it the slope counters are greedy per cell and depend on the direction the table is filled in.
+
+	// Matches that started before the oldest sample still in the buffer are thrown out
+	const int32 OldestValidSample = SampleNumber - FMath::Max(RecordingBufferSize, 1) + 1;
+
+	// The previous samples values for the column below us (diagonal)
+	float DiagCost = 0.f;
+	int32 DiagStart = SampleNumber;
+
+	// Start of a match is free at any sample
+	Column.StartSample[0] = SampleNumber;
+
+	for (int32 k = 1; k <= NumExample; k++)
 	{
-		OnGestureDetected(GesturesDB->Gestures[OutGestureIndex].GestureType, /*minDist,*/ GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB);
-		OnGestureDetected_Bind.Broadcast(GesturesDB->Gestures[OutGestureIndex].GestureType, /*minDist,*/ GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB);
+		// Gesture samples are stored newest first, walk them in recorded order
+		const float Distance = VRGestureDTW::GestureDistance(Sample, Example.Samples[NumExample - k], bMirrorGesture);
+
+		const float LeftCost = Column.Cost[k - 1];
+		const float UpCost = Column.Cost[k];
+		const int32 UpStart = Column.StartSample[k];
+		const int32 UpSlope = Column.SlopeInput[k];
+
+		float BaseCost = 0.f;
+		int32 Start = 0;
+
+		if (LeftCost < DiagCost && LeftCost < UpCost && Column.SlopeGesture[k - 1] < maxSlope)
+		{
+			BaseCost = LeftCost;
+			Start = Column.StartSample[k - 1];
+			Column.SlopeGesture[k] = Column.SlopeGesture[k - 1] + 1;
+			Column.SlopeInput[k] = 0;
+		}
+		else if (UpCost < DiagCost && UpCost < LeftCost && UpSlope < maxSlope)
+		{
+			BaseCost = UpCost;
+			Start = UpStart;
+			Column.SlopeGesture[k] = 0;
+			Column.SlopeInput[k] = UpSlope + 1;
+		}
+		else
+		{
+			BaseCost = DiagCost;
+			Start = DiagStart;
+			Column.SlopeGesture[k] = 0;
+			Column.SlopeInput[k] = 0;
+		}
+
+		DiagCost = UpCost;
+		DiagStart = UpStart;
+
+		if (BaseCost >= MAX_FLT || Start < OldestValidSample)
+		{
+			Column.Cost[k] = MAX_FLT;
+			Column.StartSample[k] = SampleNumber;
+		}
+		else
+		{
+			Column.Cost[k] = BaseCost + Distance;
+			Column.StartSample[k] = Start;
+		}
+	}
+}
+
+bool UVRGestureComponent::UpdateStreamingGesture(int32 GestureIndex, bool bNewSampleOnly)
+{
+	const FVRGesture& exampleGesture = GesturesDB->Gestures[GestureIndex];
+	FVRGestureStreamState& State = StreamStates[GestureIndex];
+
+	if (!exampleGesture.GestureSettings.bEnabled || exampleGesture.Samples.Num() < 1)
+	{
+		// Force a replay if it gets enabled again
+		State.SourceData = nullptr;
+		return false;
+	}
+
+	const bool bMirrorByHand = (MirroringHand != EVRGestureMirrorMode::GES_NoMirror && MirroringHand != EVRGestureMirrorMode::GES_MirrorBoth && MirroringHand == exampleGesture.GestureSettings.MirrorMode);
+	const bool bNeedsNormal = !bMirrorByHand;
+	const bool bNeedsMirrored = bMirrorByHand || exampleGesture.GestureSettings.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth;
+	const float Scaler = exampleGesture.GestureSettings.bEnableScaling ? StreamScaler : 1.f;
+
+	// Gesture was edited or the mirroring changed, replay the whole buffer for it
+	if (State.SourceData != exampleGesture.Samples.GetData() || State.NumSamples != exampleGesture.Samples.Num() ||
+		State.bNeedsNormal != bNeedsNormal || State.bNeedsMirrored != bNeedsMirrored)
+	{
+		State.SourceData = exampleGesture.Samples.GetData();
+		State.NumSamples = exampleGesture.Samples.Num();
+		State.bNeedsNormal = bNeedsNormal;
+		State.bNeedsMirrored = bNeedsMirrored;
+		bNewSampleOnly = false;
+	}
+
+	if (!bNewSampleOnly)
+	{
+		State.NormalColumn.Reset(State.NumSamples);
+		State.MirroredColumn.Reset(State.NumSamples);
+	}
+
+	// Samples are stored newest first, the newest is sample number StreamSampleCount - 1
+	const int32 FirstLogIndex = bNewSampleOnly ? 0 : GestureLog.Samples.Num() - 1;
+	for (int32 LogIndex = FirstLogIndex; LogIndex >= 0; --LogIndex)
+	{
+		const FVector Sample = GestureLog.Samples[LogIndex] * Scaler;
+		const int32 SampleNumber = StreamSampleCount - 1 - LogIndex;
+
+		if (bNeedsNormal)
+			StepStreamingColumn(State.NormalColumn, exampleGesture, Sample, SampleNumber, false);
+
+		if (bNeedsMirrored)
+			StepStreamingColumn(State.MirroredColumn, exampleGesture, Sample, SampleNumber, true);
+	}
+
+	return true;
+}
+
+void UVRGestureComponent::RecognizeGestureStreaming()
+{
+	if (!GesturesDB || GestureLog.Samples.Num() < 1 || !bGestureChanged)
+		return;
+
+	float minDist = MAX_FLT;
+	int OutGestureIndex = FindBestStreamingGestureMatch(minDist);
+
+	if (OutGestureIndex != -1)
+	{
+		OnGestureDetected(GesturesDB->Gestures[OutGestureIndex].GestureType, GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB);
+		OnGestureDetected_Bind.Broadcast(GesturesDB->Gestures[OutGestureIndex].GestureType, GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB);
 		ClearRecording(); // Clear the recording out, we don't want to detect this gesture again with the same data
 		RecordingGestureDraw.Reset();
 	}
 }
 
-float UVRGestureComponent::dtw(FVRGesture seq1, FVRGesture seq2, bool bMirrorGesture, float Scaler)
+int32 UVRGestureComponent::FindBestStreamingGestureMatch(float& OutDistance)
 {
+	OutDistance = MAX_FLT;
+
+	if (!GesturesDB || GestureLog.Samples.Num() < 1)
+		return INDEX_NONE;
+
+	SCOPE_CYCLE_COUNTER(STAT_RecognizeGesture);
+
+	StreamSampleCount++;
+
+	FVector Size = GestureLog.GestureSize.GetSize();
+	float Scaler = GesturesDB->TargetGestureScale / Size.GetMax();
+
+	TArray<FVRGesture>& Gestures = GesturesDB->Gestures;
 
-	// #TODO: Skip copying the array and reversing it in the future, we only ever use the reversed value.
-	// So pre-reverse it and keep it stored like that on init. When we do the initial sample we can check off of the first index instead of last then
+	// The input scale only grows as the recording bounds expand, so it settles quickly.
+	// Rebuild everything from the buffer when it moves too far, otherwise keep matching against the scale we built with.
+	bool bRebuildAll = StreamDatabase != GesturesDB || StreamStates.Num() != Gestures.Num() ||
+		!FMath::IsNearlyEqual(Scaler, StreamScaler, FMath::Abs(StreamScaler) * StreamingRescaleTolerance);
 
-	// Should also be able to get SizeSquared for values and compared to squared thresholds instead of doing the full SQRT calc.
+	if (bRebuildAll)
+	{
+		StreamDatabase = GesturesDB;
+		StreamScaler = Scaler;
+		StreamStates.Reset();
+		StreamStates.SetNum(Gestures.Num());
+	}
 
+	const int32 NumInput = GestureLog.Samples.Num();
+	const FVector& NewestSample = GestureLog.Samples[0];
+
+	float minDist = MAX_FLT;
+	int OutGestureIndex = -1;
+
+	for (int i = 0; i < Gestures.Num(); i++)
+	{
+		if (!UpdateStreamingGesture(i, !bRebuildAll))
+			continue;
+
+		const FVRGesture& exampleGesture = Gestures[i];
+		const FVRGestureStreamState& State = StreamStates[i];
+		const int32 NumExample = exampleGesture.Samples.Num();
+
+		if (NumInput < exampleGesture.GestureSettings.Minimum_Gesture_Length)
+			continue;
+
+		INC_DWORD_STAT(STAT_GesturesCompared);
+
+		const FVector Sample = NewestSample * (exampleGesture.GestureSettings.bEnableScaling ? StreamScaler : 1.f);
+		const float FirstThresholdSq = FMath::Square(exampleGesture.GestureSettings.firstThreshold);
+
+		// Same first sample checks as the full recognition, the gestures end has to be near our newest sample
+		const FVRGestureStreamColumn* Column = nullptr;
+		bool bMirrorGesture = !State.bNeedsNormal;
+		if (VRGestureDTW::GestureDistance(Sample, exampleGesture.Samples[0], bMirrorGesture) < FirstThresholdSq)
+		{
+			Column = bMirrorGesture ? &State.MirroredColumn : &State.NormalColumn;
+		}
+		else if (exampleGesture.GestureSettings.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth)
+		{
+			if (VRGestureDTW::GestureDistance(Sample, exampleGesture.Samples[0], true) < FirstThresholdSq)
+			{
+				Column = &State.MirroredColumn;
+			}
+		}
+
+		if (!Column)
+			continue;
+
+		float d = Column->Cost[NumExample] / NumExample;
+		if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
+		{
+			minDist = d;
+			OutGestureIndex = i;
+		}
+	}
+
+	OutDistance = minDist;
+	return OutGestureIndex;
+}
+
+float UVRGestureComponent::dtw(const FVRGesture& seq1, const FVRGesture& seq2, bool bMirrorGesture, float Scaler)
+{
+	TArray<FVector> ScaledSamples;
+	ScaledSamples.SetNumUninitialized(seq1.Samples.Num());
+	for (int i = 0; i < seq1.Samples.Num(); i++)
+	{
+		ScaledSamples[i] = seq1.Samples[i] * Scaler;
+	}
+
+	float bestMatch = FLT_MAX;
+	ComputeDTW(ScaledSamples.GetData(), ScaledSamples.Num(), seq2.Samples.GetData(), seq2.Samples.Num(), bMirrorGesture, maxSlope, 0, MAX_FLT, bestMatch);
+	return bestMatch;
+}
+
+bool UVRGestureComponent::ComputeDTW(const FVector* Input, int32 NumInput, const FVector* Example, int32 NumExample, bool bMirrorGesture, int32 MaxSlope, int32 BandWidth, float AbandonCost, float& OutCost)
+{
 	// Getting number of average samples recorded over of a gesture (top down) may be able to achieve a basic % completed check
 	// to see how far into detecting a gesture we are, this would require ignoring the last position threshold though....
 
-	int RowCount = seq1.Samples.Num() + 1;
-	int ColumnCount = seq2.Samples.Num() + 1;
-
-	TArray<float> LookupTable;
-	LookupTable.AddZeroed(ColumnCount * RowCount);
+	// Only the previous row of the lookup table is ever read, so keep two rows instead of the full table
+	const int ColumnCount = NumExample + 1;
 
-	TArray<int> SlopeI;
-	SlopeI.AddZeroed(ColumnCount * RowCount);
-	TArray<int> SlopeJ;
-	SlopeJ.AddZeroed(ColumnCount * RowCount);
+	TArray<float, TInlineAllocator<256>> LookupTable;
+	LookupTable.SetNumUninitialized(ColumnCount * 2);
+	TArray<int, TInlineAllocator<256>> SlopeI;
+	SlopeI.SetNumZeroed(ColumnCount * 2);
+	TArray<int, TInlineAllocator<256>> SlopeJ;
+	SlopeJ.SetNumZeroed(ColumnCount * 2);
 
-	for (int i = 1; i < (ColumnCount * RowCount); i++)
+	// Row 0 is 0 in the first cell and MAX_FLT everywhere else, column 0 is always MAX_FLT after the first row
+	for (int j = 0; j < ColumnCount * 2; j++)
 	{
-		LookupTable[i] = MAX_FLT;
+		LookupTable[j] = MAX_FLT;
 	}
-	// Don't need to do this, it is already handled by add zeroed
-	//tab[0, 0] = 0;
+	LookupTable[0] = 0.f;
 
-	int icol = 0, icolneg = 0;
+	float bestMatch = FLT_MAX;
+	int icolneg = 0, icol = ColumnCount;
 
 	// Dynamic computation of the DTW matrix.
-	for (int i = 1; i < RowCount; i++)
+	for (int i = 1; i <= NumInput; i++)
 	{
-		for (int j = 1; j < ColumnCount; j++)
+		const FVector& InputSample = Input[i - 1];
+		float RowMin = MAX_FLT;
+
+		int BandStart = 1;
+		int BandEnd = NumExample;
+		if (BandWidth > 0)
 		{
-			icol = i * ColumnCount;
-			icolneg = icol - ColumnCount;// (i - 1) * ColumnCount;
+			BandStart = FMath::Max(1, i - BandWidth);
+			BandEnd = FMath::Min(NumExample, i + BandWidth);
+
+			for (int j = 1; j < BandStart; j++)
+			{
+				LookupTable[icol + j] = MAX_FLT;
+				SlopeI[icol + j] = 0;
+				SlopeJ[icol + j] = 0;
+			}
+
+			for (int j = BandEnd + 1; j < ColumnCount; j++)
+			{
+				LookupTable[icol + j] = MAX_FLT;
+				SlopeI[icol + j] = 0;
+				SlopeJ[icol + j] = 0;
+			}
+		}
+
+		LookupTable[icol] = MAX_FLT;
+		SlopeI[icol] = 0;
+		SlopeJ[icol] = 0;
 
+		for (int j = BandStart; j <= BandEnd; j++)
+		{
 			if (
 				LookupTable[icol + (j - 1)] < LookupTable[icolneg + (j - 1)] &&
 				LookupTable[icol + (j - 1)] < LookupTable[icolneg + j] &&
-				SlopeI[icol + (j - 1)] < maxSlope)
+				SlopeI[icol + (j - 1)] < MaxSlope)
 			{
-				LookupTable[icol + j] = GetGestureDistance(seq1.Samples[i - 1] * Scaler, seq2.Samples[j - 1], bMirrorGesture) + LookupTable[icol + j - 1];
+				LookupTable[icol + j] = VRGestureDTW::GestureDistance(InputSample, Example[j - 1], bMirrorGesture) + LookupTable[icol + j - 1];
 				SlopeI[icol + j] = SlopeJ[icol + j - 1] + 1;
 				SlopeJ[icol + j] = 0;
 			}
 			else if (
 				LookupTable[icolneg + j] < LookupTable[icolneg + j - 1] &&
 				LookupTable[icolneg + j] < LookupTable[icol + j - 1] &&
-				SlopeJ[icolneg + j] < maxSlope)
+				SlopeJ[icolneg + j] < MaxSlope)
 			{
-				LookupTable[icol + j] = GetGestureDistance(seq1.Samples[i - 1] * Scaler, seq2.Samples[j - 1], bMirrorGesture) + LookupTable[icolneg + j];
+				LookupTable[icol + j] = VRGestureDTW::GestureDistance(InputSample, Example[j - 1], bMirrorGesture) + LookupTable[icolneg + j];
 				SlopeI[icol + j] = 0;
 				SlopeJ[icol + j] = SlopeJ[icolneg + j] + 1;
 			}
 			else
 			{
-				LookupTable[icol + j] = GetGestureDistance(seq1.Samples[i - 1] * Scaler, seq2.Samples[j - 1], bMirrorGesture) + LookupTable[icolneg + j - 1];
+				LookupTable[icol + j] = VRGestureDTW::GestureDistance(InputSample, Example[j - 1], bMirrorGesture) + LookupTable[icolneg + j - 1];
 				SlopeI[icol + j] = 0;
 				SlopeJ[icol + j] = 0;
 			}
+
+			RowMin = FMath::Min(RowMin, LookupTable[icol + j]);
 		}
-	}
 
-	// Find best between seq2 and an ending (postfix) of seq1.
-	float bestMatch = FLT_MAX;
+		// Find best between seq2 and an ending (postfix) of seq1.
+		if (LookupTable[icol + NumExample] < bestMatch)
+			bestMatch = LookupTable[icol + NumExample];
 
-	for (int i = 1; i < seq1.Samples.Num() + 1/* - seq2.Minimum_Gesture_Length*/; i++)
-	{
-		if (LookupTable[(i*ColumnCount) + seq2.Samples.Num()] < bestMatch)
-		bestMatch = LookupTable[(i*ColumnCount) + seq2.Samples.Num()];
+		// Costs only grow from row to row, once nothing left in this row can beat the cutoff no later ending will either
+		if (AbandonCost < MAX_FLT && FMath::Min(RowMin, bestMatch) / NumExample >= AbandonCost)
+		{
+			OutCost = MAX_FLT;
+			return false;
+		}
+
+		Swap(icol, icolneg);
 	}
 
-	return bestMatch;
+	OutCost = bestMatch;
+	return true;
 }
 
 void UVRGestureComponent::DrawDebugGesture(UObject* WorldContextObject, FTransform &StartTransform, FVRGesture GestureToDraw, FColor const& Color, bool bPersistentLines, uint8 DepthPriority, float LifeTime, float Thickness)
@@ -719,6 +1177,7 @@ FVRGesture UVRGestureComponent::EndRecording()
 void UVRGestureComponent::ClearRecording()
 {
 	GestureLog.Samples.Reset(RecordingBufferSize);
+	ResetStreamingRecognition();
 }
 
 void UVRGestureComponent::SaveRecording(FVRGesture &Recording, FString RecordingName, bool bScaleRecordingToDatabase)
@@ -14,6 +14,8 @@ UVRGlobalSettings::UVRGlobalSettings(const FObjectInitializer& ObjectInitializer
 	MaxSpeedForLerp(500.f),
 	LerpInterpolationMode(EVRLerpInterpolationMode::QuatInterp),
 	bUseCurve(false),
+	BucketUpdatePhaseGroups(4),
+	BucketUpdateFrameBudgetMS(0.0f),
 	MaxCCDPasses(1),
 	OneEuroMinCutoff(0.1f),
 	OneEuroCutoffSlope(10.0f),
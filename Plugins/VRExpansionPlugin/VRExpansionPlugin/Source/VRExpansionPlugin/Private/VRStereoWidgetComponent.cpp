@@ -2,6 +2,7 @@
 
 #include "VRStereoWidgetComponent.h"
 #include "VRExpansionFunctionLibrary.h"
+#include "Misc/VRStereoWidgetRedrawSubsystem.h"
 #include "VRBaseCharacter.h"
 #include "TextureResource.h"
 #include "Engine/Texture.h"
@@ -57,6 +58,11 @@ UVRStereoWidgetRenderComponent::UVRStereoWidgetRenderComponent(const FObjectInit
 	DrawRate = 60.0f;
 	DrawCounter = 0.0f;
 	bLiveTexture = true;
+	bUseRedrawScheduler = false;
+	MaxRedrawInterval = 1.0f;
+	bRedrawRequested = false;
+	TimeSinceLastDraw = 0.0f;
+	LastDrawnSize = FVector2D::ZeroVector;
 }
 
 void UVRStereoWidgetRenderComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -69,12 +75,14 @@ void UVRStereoWidgetRenderComponent::TickComponent(float DeltaTime, enum ELevelT
 	else
 	{
 		DrawCounter += DeltaTime;
+		TimeSinceLastDraw += DeltaTime;
 
-		if (DrawRate > 0.0f && DrawCounter >= (1.0f / DrawRate))
+		if (DrawRate > 0.0f && DrawCounter >= (1.0f / DrawRate) && (!bUseRedrawScheduler || ConsumeScheduledRedraw()))
 		{
 			if (!IsRunningDedicatedServer())
 			{
-				RenderWidget(DeltaTime);
+				// Scheduled widgets may have skipped frames, tick them by the full time since their last render
+				RenderWidget(bUseRedrawScheduler ? TimeSinceLastDraw : DeltaTime);
 			}
 
 			if (!bLiveTexture)
@@ -83,6 +91,7 @@ void UVRStereoWidgetRenderComponent::TickComponent(float DeltaTime, enum ELevelT
 			}
 
 			DrawCounter = 0.0f;
+			TimeSinceLastDraw = 0.0f;
 		}
 	}
 
@@ -121,6 +130,14 @@ void UVRStereoWidgetRenderComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 {
 	Super::EndPlay(EndPlayReason);
 
+	if (UWorld* World = GetWorld())
+	{
+		if (UVRStereoWidgetRedrawSubsystem* RedrawSubsystem = World->GetSubsystem<UVRStereoWidgetRedrawSubsystem>())
+		{
+			RedrawSubsystem->RemoveRedrawRequest(this);
+		}
+	}
+
 	ReleaseResources();
 }
 
@@ -170,6 +187,59 @@ void UVRStereoWidgetRenderComponent::SetWidgetAndInit(TSubclassOf<UUserWidget> N
 {
 	WidgetClass = NewWidgetClass;
 	InitWidget();
+	bRedrawRequested = true;
+}
+
+void UVRStereoWidgetRenderComponent::RequestRedraw()
+{
+	bRedrawRequested = true;
+}
+
+bool UVRStereoWidgetRenderComponent::ConsumeScheduledRedraw()
+{
+	UWorld* World = GetWorld();
+	UVRStereoWidgetRedrawSubsystem* RedrawSubsystem = World ? World->GetSubsystem<UVRStereoWidgetRedrawSubsystem>() : nullptr;
+
+	// Always consumed so an invalidation that lands alongside a manual request doesn't cause a second draw
+	const bool bSlateInvalidated = RedrawSubsystem && RedrawSubsystem->ConsumeWidgetInvalidation(this, SlateWindow);
+
+	bool bInvalidated = bRedrawRequested || bSlateInvalidated || RenderTarget == nullptr ||
+		(MaxRedrawInterval > 0.0f && TimeSinceLastDraw >= MaxRedrawInterval) ||
+		UVRStereoWidgetRedrawSubsystem::HasPendingSlateWork(Widget, SlateWidget);
+
+	if (!bInvalidated)
+	{
+		// Size changes always need a new render, desired size requires a prepass to know
+		FVector2D CurrentSize = this->GetQuadSize();
+		if (bDrawAtDesiredSize && SlateWindow.IsValid())
+		{
+			SlateWindow->SlatePrepass(WidgetRenderScale);
+			FVector2D DesiredSize = SlateWindow->GetDesiredSize();
+
+			if (!DesiredSize.IsNearlyZero())
+			{
+				CurrentSize = FVector2D(FMath::RoundToInt(DesiredSize.X), FMath::RoundToInt(DesiredSize.Y));
+			}
+		}
+
+		bInvalidated = CurrentSize != LastDrawnSize;
+	}
+
+	if (!bInvalidated)
+	{
+		// Nothing changed, wait out another draw interval before checking again
+		DrawCounter = 0.0f;
+
+		if (RedrawSubsystem)
+		{
+			RedrawSubsystem->NotifyRedrawSkipped();
+		}
+
+		return false;
+	}
+
+	// No scheduler in this world (editor preview), draw on invalidation alone
+	return !RedrawSubsystem || RedrawSubsystem->RequestRedraw(this, Priority, GetVisibleFlag());
 }
 
 void UVRStereoWidgetRenderComponent::OnLevelRemovedFromWorld(ULevel* InLevel, UWorld* InWorld)
@@ -343,6 +413,8 @@ void UVRStereoWidgetRenderComponent::RenderWidget(float DeltaTime)
 	}
 
 	WidgetRenderer->DrawWidget(RenderTarget, MyWidget, WidgetRenderScale, TextureSize, DeltaTime);//DeltaTime);
+	LastDrawnSize = TextureSize;
+	bRedrawRequested = false;
 
 	if (Texture != RenderTarget)
 	{
@@ -385,6 +457,9 @@ UVRStereoWidgetComponent::UVRStereoWidgetComponent(const FObjectInitializer& Obj
 	bRenderBothStereoAndWorld = false;
 	bDelayForRenderThread = false;
 	bIsSleeping = false;
+	bUseRedrawScheduler = false;
+	MaxRedrawInterval = 1.0f;
+	bScheduledRedrawGranted = false;
 	//Texture = nullptr;
 }
 
@@ -415,6 +490,14 @@ void UVRStereoWidgetComponent::OnUnregister()
 		LayerId = 0;
 	}
 
+	if (UWorld* World = GetWorld())
+	{
+		if (UVRStereoWidgetRedrawSubsystem* RedrawSubsystem = World->GetSubsystem<UVRStereoWidgetRedrawSubsystem>())
+		{
+			RedrawSubsystem->RemoveRedrawRequest(this);
+		}
+	}
+
 	Super::OnUnregister();
 }
 
@@ -423,11 +506,70 @@ void UVRStereoWidgetComponent::DrawWidgetToRenderTarget(float DeltaTime)
 	Super::DrawWidgetToRenderTarget(DeltaTime);
 
 	bDirtyRenderTarget = true;
+	bScheduledRedrawGranted = false;
+}
+
+bool UVRStereoWidgetComponent::ShouldDrawWidget() const
+{
+	if (bUseRedrawScheduler && !bScheduledRedrawGranted)
+		return false;
+
+	return Super::ShouldDrawWidget();
+}
+
+bool UVRStereoWidgetComponent::ConsumeScheduledRedraw()
+{
+	// Not due yet (RedrawTime, visibility, manual redraw)
+	if (!Super::ShouldDrawWidget())
+		return false;
+
+	UWorld* World = GetWorld();
+	UVRStereoWidgetRedrawSubsystem* RedrawSubsystem = World ? World->GetSubsystem<UVRStereoWidgetRedrawSubsystem>() : nullptr;
+
+	// Always consumed so an invalidation that lands alongside a manual request doesn't cause a second draw
+	const bool bSlateInvalidated = RedrawSubsystem && RedrawSubsystem->ConsumeWidgetInvalidation(this, SlateWindow);
+
+	bool bInvalidated = bRedrawRequested || bSlateInvalidated || LastWidgetRenderTime <= 0.0f ||
+		(MaxRedrawInterval > 0.0f && World && World->TimeSince(LastWidgetRenderTime) >= MaxRedrawInterval) ||
+		UVRStereoWidgetRedrawSubsystem::HasPendingSlateWork(Widget, SlateWidget);
+
+	if (!bInvalidated)
+	{
+		// Size changes always need a new render, desired size requires a prepass to know
+		FIntPoint CurrentSize = DrawSize;
+		if (bDrawAtDesiredSize && SlateWindow.IsValid())
+		{
+			SlateWindow->SlatePrepass(1.0f);
+			FVector2D DesiredSize = SlateWindow->GetDesiredSize();
+
+			if (!DesiredSize.IsNearlyZero())
+			{
+				CurrentSize = FIntPoint(FMath::RoundToInt(DesiredSize.X), FMath::RoundToInt(DesiredSize.Y));
+			}
+		}
+
+		bInvalidated = CurrentSize != CurrentDrawSize;
+	}
+
+	if (!bInvalidated)
+	{
+		if (RedrawSubsystem)
+		{
+			RedrawSubsystem->NotifyRedrawSkipped();
+		}
+
+		return false;
+	}
+
+	// No scheduler in this world (editor preview), draw on invalidation alone
+	return !RedrawSubsystem || RedrawSubsystem->RequestRedraw(this, Priority, IsWidgetVisible() && !bIsSleeping);
 }
 
 void UVRStereoWidgetComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
 
+	bScheduledRedrawGranted = bUseRedrawScheduler && ConsumeScheduledRedraw();
+
 	// Precaching what the widget uses for draw time here as it gets modified in the super tick
 	bool bWidgetDrew = ShouldDrawWidget();
 
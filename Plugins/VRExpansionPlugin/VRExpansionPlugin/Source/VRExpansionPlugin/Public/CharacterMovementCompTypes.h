@@ -603,11 +603,32 @@ public:
 	uint16 VRCapsuleRotation;
 	FVRConditionalMoveRep ConditionalMoveReps;
 
+	// The move that the pending and old moves are delta encoded against, only set by the container while it serializes
+	// The new move is always serialized first so it has already been read when the others need it
+	const FVRCharacterNetworkMoveData* DeltaBaseline;
+
+	// The new moves quantized VR values as the server decodes them, the same on both ends so deltas reconstruct exactly
+	FIntVector QuantizedVRCapsuleLocation;
+	FIntVector QuantizedLFDiff;
+
 	FVRCharacterNetworkMoveData();
 
 	virtual ~FVRCharacterNetworkMoveData();
 	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
 	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+
+	// Mirrors the FVector_NetQuantize100 packing, returns the integer values that get sent and what they decode to
+	static FIntVector QuantizeVector100(const FVector& InVector);
+	static FVector DequantizeVector100(const FIntVector& InQuantized);
+
+private:
+
+	// Sends the value as a bounded delta from the baseline when that is smaller, otherwise as the usual absolute value
+	static void SerializeVectorDelta(FArchive& Ar, UPackageMap* PackageMap, FVector_NetQuantize100& Value, const FIntVector& BaselineQuantized, bool& bOutSuccess);
+	static void SerializeYawDelta(FArchive& Ar, uint16& Value, uint16 BaselineValue);
+
+	// True if the conditional values would decode the same as the baselines
+	static bool ConditionalRepsMatch(const FVRConditionalMoveRep& A, const FVRConditionalMoveRep& B);
 };
 
 struct VREXPANSIONPLUGIN_API FVRCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
@@ -635,8 +656,9 @@ public:
 
  /**
   * Serialize movement data. Passes Serialize calls to each FCharacterNetworkMoveData as applicable, based on bHasPendingMove and bHasOldMove.
+  * The pending and old moves VR values are delta encoded against the new move.
   */
-  //virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap);
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap) override;
 
 
 
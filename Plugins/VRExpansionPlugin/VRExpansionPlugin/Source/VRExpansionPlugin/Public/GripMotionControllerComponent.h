@@ -78,11 +78,14 @@ public:
 	/** Returns true if the LateUpdateSetup data is stale. */
 	bool GetSkipLateUpdate_RenderThread() const { return UpdateStates[LateUpdateRenderReadIndex].bSkip; }
 
+	/** Drops the cached hierarchies so that they are re-gathered on the next Setup, called on attach / detach, grip / drop and late update setting changes */
+	void MarkLateUpdateSetDirty() { bLateUpdateSetDirty = true; }
+
 public:
 
-	/** A utility method that calls CacheSceneInfo on ParentComponent and all of its descendants */
+	/** A utility method that calls CacheSceneInfo on the primitives of ParentComponents cached hierarchy, gathering it first if needed */
 	void GatherLateUpdatePrimitives(USceneComponent* ParentComponent);
-	void ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent* MotionController, TArray<FBPActorGripInformation> & GripArray);
+	void ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent* MotionController, const TArray<FBPActorGripInformation> & GripArray);
 
 	/** Generates a LateUpdatePrimitiveInfo for the given component if it has a SceneProxy and appends it to the current LateUpdatePrimitives array */
 	void CacheSceneInfo(USceneComponent* Component);
@@ -108,6 +111,34 @@ public:
 	FLateUpdateState UpdateStates[2];
 	int32 LateUpdateGameWriteIndex;
 	int32 LateUpdateRenderReadIndex;
+
+	/** A component in a cached hierarchy with what it was attached to and how many children it had when gathered */
+	struct FCachedLateUpdateNode
+	{
+		TWeakObjectPtr<USceneComponent> Component;
+		TWeakObjectPtr<USceneComponent> AttachParent;
+		int32 NumAttachChildren;
+		bool bIsPrimitive;
+	};
+
+	/** Flattened component hierarchy under a late update root, kept between frames so we don't walk GetChildrenComponents every frame */
+	struct FCachedLateUpdateHierarchy
+	{
+		/** The root first, then all of its descendants */
+		TArray<FCachedLateUpdateNode> Nodes;
+		/** Setup pass that last used this entry, unused entries are pruned */
+		uint32 LastUsedPass;
+
+		FCachedLateUpdateHierarchy() : LastUsedPass(0) {}
+	};
+
+	TMap<TWeakObjectPtr<USceneComponent>, FCachedLateUpdateHierarchy> CachedHierarchies;
+	uint32 SetupPass;
+	bool bLateUpdateSetDirty;
+
+	/** Caches the scene info of the hierarchies primitives, returns false without finishing if a component in it was destroyed, re-attached elsewhere or had children attached / detached */
+	bool CacheHierarchyPrimitives(const FCachedLateUpdateHierarchy& Hierarchy);
+	static void BuildCachedHierarchy(USceneComponent* ParentComponent, FCachedLateUpdateHierarchy& Hierarchy);
 };
 
 /**
@@ -199,6 +230,11 @@ public:
 		TWeakObjectPtr<AVRBaseCharacter> AttachChar;
 	void UpdateTracking(float DeltaTime);
 	virtual void OnAttachmentChanged() override;
+	virtual void OnChildAttached(USceneComponent* ChildComponent) override;
+	virtual void OnChildDetached(USceneComponent* ChildComponent) override;
+
+	// Lets the late update manager know that the set of late updated primitives needs to be re-gathered
+	void MarkLateUpdatesDirty();
 
 	FVector LastLocationForLateUpdate;
 	FTransform LastRelativePosition;
@@ -409,12 +445,17 @@ public:
 	}
 
 	// When possible I suggest that you use GetAllGrips/GetGrippedObjects instead of directly referencing this
+	// Fast array replicated, changing a replicated grip property on the server needs a MarkGripDirty call to be sent
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GripMotionController", ReplicatedUsing = OnRep_GrippedObjects)
-	TArray<FBPActorGripInformation> GrippedObjects;
+	FBPGripInformationArray GrippedObjects;
 
 	// When possible I suggest that you use GetAllGrips/GetGrippedObjects instead of directly referencing this
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GripMotionController", ReplicatedUsing = OnRep_LocallyGrippedObjects)
-	TArray<FBPActorGripInformation> LocallyGrippedObjects;
+	FBPGripInformationArray LocallyGrippedObjects;
+
+	// Flags a grip as changed so that the fast array replicates it, call after changing replicated grip properties on the server
+	// Does nothing if the grip isn't in one of this controllers grip arrays
+	void MarkGripDirty(FBPActorGripInformation& Grip);
 
 	// Local Grip TransactionalBuffer to store server sided grips that need to be emplaced into the local buffer
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GripMotionController", ReplicatedUsing = OnRep_LocalTransaction)
@@ -457,7 +498,7 @@ public:
 	bool bAlwaysSendTickGrip;
 
 	// Clean up a grip that is "bad", object is being destroyed or was a bad destructible mesh
-	void CleanUpBadGrip(TArray<FBPActorGripInformation> &GrippedObjectsArray, int GripIndex, bool bReplicatedArray);
+	void CleanUpBadGrip(FBPGripInformationArray &GrippedObjectsArray, int GripIndex, bool bReplicatedArray);
 	void CleanUpBadPhysicsHandles();
 
 	// Recreates a grip physics handle bodies
@@ -497,14 +538,6 @@ public:
 	// Handles variable state changes and specific actions on a grip replication
 	inline bool HandleGripReplication(FBPActorGripInformation & Grip, FBPActorGripInformation * OldGripInfo = nullptr)
 	{
-		if (Grip.ValueCache.bWasInitiallyRepped && Grip.GripID != Grip.ValueCache.CachedGripID)
-		{
-			// There appears to be a bug with TArray replication where if you replace an index with another value of that
-			// Index, it doesn't fully re-init the object, this is a workaround to re-zero non replicated variables
-			// when that happens.
-			Grip.ClearNonReppingItems();
-		}
-
 		// Ignore server down no rep grips, this is kind of unavoidable unless I make yet another list which I don't want to do
 		if (Grip.GripMovementReplicationSetting == EGripMovementReplicationSettings::ClientSide_Authoritive_NoRep)
 		{
@@ -716,27 +749,26 @@ public:
 	}
 
 	UFUNCTION()
-	virtual void OnRep_GrippedObjects(TArray<FBPActorGripInformation> OriginalArrayState) // Original array state is useless without full serialize, it just hold last delta
+	virtual void OnRep_GrippedObjects()
 	{
 		// Need to think about how best to handle the simulating flag here, don't handle for now
-		// Check for removed gripped actors
-		// This might actually be better left as an RPC multicast
-
-		for (int i = GrippedObjects.Num() - 1; i >= 0; --i)
-		{
-			HandleGripReplication(GrippedObjects[i], OriginalArrayState.FindByKey(GrippedObjects[i].GripID));
-		}
+		// Drops are still sent through the NotifyDrop multicast
+		ProcessReplicatedGripEvents(GrippedObjects);
 	}
 
 	UFUNCTION()
-	virtual void OnRep_LocallyGrippedObjects(TArray<FBPActorGripInformation> OriginalArrayState)
+	virtual void OnRep_LocallyGrippedObjects()
 	{
-		for (int i = LocallyGrippedObjects.Num() - 1; i >= 0; --i)
-		{
-			HandleGripReplication(LocallyGrippedObjects[i], OriginalArrayState.FindByKey(LocallyGrippedObjects[i].GripID));
-		}
+		ProcessReplicatedGripEvents(LocallyGrippedObjects);
 	}
 
+	// Runs the adds / changes / removes queued by the fast array callbacks
+	// Also polled in tick in case the array was received without its rep notify firing
+	void ProcessReplicatedGripEvents(FBPGripInformationArray& GripArray);
+
+	// Called on clients when the server removed a grip from a replicated array
+	virtual void OnGripRemovedByReplication(const FBPActorGripInformation& RemovedGrip);
+
 	UPROPERTY(BlueprintReadWrite, Category = "GripMotionController")
 	TArray<UPrimitiveComponent *> AdditionalLateUpdateComponents;
 
@@ -795,6 +827,14 @@ public:
 	UFUNCTION(Unreliable, Server, WithValidation)
 	void Server_SendControllerTransform(FBPVRComponentPosRep NewTransform);
 
+	// Server acking a delta baseline (or reporting a lost one) back to the owning client, only used with ReplicatedControllerTransform.bUseDeltaEncoding
+	UFUNCTION(Unreliable, Client)
+	void Client_AckPoseBaseline(uint8 BaselineAck);
+
+	// Delta stream state for the client -> server transform sends
+	FVRPoseDeltaSender PoseDeltaSender;
+	FVRPoseDeltaReceiver PoseDeltaReceiver;
+
 	// Pointer to an override to call from the owning character - this saves 7 bits a rep avoiding component IDs on the RPC
 	typedef void (AVRBaseCharacter::*VRBaseCharTransformRPC_Pointer)(FBPVRComponentPosRep NewTransform);
 	VRBaseCharTransformRPC_Pointer OverrideSendTransform;
@@ -1143,10 +1183,25 @@ public:
 	void TickGrip(float DeltaTime);
 
 	// Splitting logic into separate function
-	void HandleGripArray(TArray<FBPActorGripInformation> &GrippedObjectsArray, const FTransform & ParentTransform, float DeltaTime, bool bReplicatedArray = false);
+	void HandleGripArray(FBPGripInformationArray &GrippedObjectsArray, const FTransform & ParentTransform, float DeltaTime, bool bReplicatedArray = false);
+
+	// Fills the grips resolution cache (interface owner, grip scripts, custom grip flag) so that HandleGripArray doesn't have to
+	void CacheGripResolution(FBPActorGripInformation & Grip, UPrimitiveComponent * root, AActor * actor);
+
+	// Returns false if the grip scripts the interface owner reports no longer match the cached list
+	bool IsGripResolutionCacheCurrent(const FBPActorGripInformation & Grip) const;
+
+	// Call if the grip scripts of a held object are changed during the grip, will rebuild the cached script list for its grips
+	UFUNCTION(BlueprintCallable, Category = "GripMotionController")
+		void NotifyGripScriptsChanged(UObject * ObjectToRefresh);
+
+	// Calls NotifyGripScriptsChanged on every controller in the objects world, the grippables call this when their script array replicates
+	// Call it after changing GripLogicScripts from code on the server, or from a custom GetGripScripts implementation
+	UFUNCTION(BlueprintCallable, Category = "GripMotionController")
+		static void NotifyGripScriptsChangedOnAllControllers(UObject * ObjectToRefresh);
 
 	// Gets the world transform of a grip, modified by secondary grips, returns if it has a valid transform, if not then this tick will be skipped for the object
-	bool GetGripWorldTransform(TArray<UVRGripScriptBase*>& GripScripts, float DeltaTime,FTransform & WorldTransform, const FTransform &ParentTransform, FBPActorGripInformation &Grip, AActor * actor, UPrimitiveComponent * root, bool bRootHasInterface, bool bActorHasInterface, bool bIsForTeleport, bool &bForceADrop);
+	bool GetGripWorldTransform(TArrayView<UVRGripScriptBase*> GripScripts, float DeltaTime,FTransform & WorldTransform, const FTransform &ParentTransform, FBPActorGripInformation &Grip, AActor * actor, UPrimitiveComponent * root, bool bRootHasInterface, bool bActorHasInterface, bool bIsForTeleport, bool &bForceADrop);
 
 	// Calculate component to world without the protected tag, doesn't set it, just returns it
 	inline FTransform CalcControllerComponentToWorld(FRotator Orientation, FVector Position)
@@ -38,9 +38,13 @@ public:
 
 	virtual void GatherCurrentMovement() override;
 
-	UPROPERTY(EditAnywhere, Replicated, BlueprintReadOnly, Instanced, Category = "VRGripInterface")
+	UPROPERTY(EditAnywhere, Replicated, ReplicatedUsing = OnRep_GripLogicScripts, BlueprintReadOnly, Instanced, Category = "VRGripInterface")
 		TArray<class UVRGripScriptBase *> GripLogicScripts;
 
+	// Refreshes the cached grip scripts of any controller holding this
+	UFUNCTION()
+		virtual void OnRep_GripLogicScripts();
+
 	bool ReplicateSubobjects(UActorChannel* Channel, class FOutBunch *Bunch, FReplicationFlags *RepFlags) override;
 
 	// Sets the Deny Gripping variable on the FBPInterfaceSettings struct
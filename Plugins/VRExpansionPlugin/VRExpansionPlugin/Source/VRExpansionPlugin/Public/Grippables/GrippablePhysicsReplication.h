@@ -22,6 +22,7 @@
 #include "PhysicsReplication.h"
 
 #include "Misc/ScopeRWLock.h"
+#include "Templates/Atomic.h"
 
 #include "GrippablePhysicsReplication.generated.h"
 //#include "GrippablePhysicsReplication.generated.h"
@@ -37,6 +38,8 @@
 	TEXT(" 1: use the valve input controller. You will have to define input bindings for the controllers you want to support."),
 	ECVF_ReadOnly);*/
 
+DECLARE_STATS_GROUP(TEXT("VRPhysicsReplication"), STATGROUP_VRPhysicsReplication, STATCAT_Advanced);
+
 //#if PHYSICS_INTERFACE_PHYSX
 struct FAsyncPhysicsRepCallbackDataVR;
 class FPhysicsReplicationAsyncCallbackVR;
@@ -53,6 +56,91 @@ public:
 
 	virtual void OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrimitiveComponent>, FReplicatedPhysicsTarget>& ComponentsToTargets) override;
 	virtual bool ApplyRigidBodyState(float DeltaSeconds, FBodyInstance* BI, FReplicatedPhysicsTarget& PhysicsTarget, const FRigidBodyErrorCorrection& ErrorCorrection, const float PingSecondsOneWay) override;
+
+	// Error correction values, resolved from the cvars / physics settings once per tick instead of per target
+	struct FCorrectionSettingsVR
+	{
+		float NetPingExtrapolation;
+		float NetPingLimit;
+		float ErrorPerLinearDiff;
+		float ErrorPerAngularDiff;
+		float MaxRestoredStateError;
+		float ErrorAccumulationSeconds;
+		float ErrorAccumulationDistanceSq;
+		float ErrorAccumulationSimilarity;
+		float PositionLerp;
+		float LinearVelocityCoefficient;
+		float AngleLerp;
+		float AngularVelocityCoefficient;
+		float MaxLinearHardSnapDistance;
+		bool bAlwaysHardSnap;
+
+		static FCorrectionSettingsVR Resolve(const FRigidBodyErrorCorrection& ErrorCorrection);
+	};
+
+	// Packed per target entry, filled on the game thread, has its correction computed in parallel and is then applied on the game thread
+	struct FPendingTargetVR
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Key;
+		UPrimitiveComponent* PrimComp = nullptr;
+		FBodyInstance* BI = nullptr;
+		FReplicatedPhysicsTarget* PhysicsTarget = nullptr;
+		FRigidBodyState CurrentState;
+		float PingSecondsOneWay = 0.0f;
+
+		// Results
+		FVector TargetPos = FVector::ZeroVector;
+		FQuat TargetQuat = FQuat::Identity;
+		FVector NewPos = FVector::ZeroVector;
+		FQuat NewAng = FQuat::Identity;
+		FVector NewLinVel = FVector::ZeroVector;
+		FVector NewAngVel = FVector::ZeroVector;
+
+		bool bApplyCorrection = false;
+		bool bSyncComponent = false;
+		bool bRestoredState = false;
+		bool bCorrect = false;
+		bool bHardSnap = false;
+		bool bShouldSleep = false;
+	};
+
+	// Validates the target and reads the current body state, returns false if the target state is invalid
+	static bool PrepareTargetVR(FBodyInstance* BI, FReplicatedPhysicsTarget& PhysicsTarget, float PingSecondsOneWay, FPendingTargetVR& OutTarget);
+
+	// Pure error and correction math, only writes to the target and the packed entry so it is safe to run off of the game thread
+	static void ComputeCorrectionVR(float DeltaSeconds, const FCorrectionSettingsVR& Settings, FPendingTargetVR& Target);
+
+	// Runs ComputeCorrectionVR over the packed targets in parallel chunks once there are enough of them
+	static void ComputeCorrectionsVR(float DeltaSeconds, const FCorrectionSettingsVR& Settings, TArrayView<FPendingTargetVR> Targets, bool bForceSingleThread = false);
+
+	void ApplyCorrectionVR(const FCorrectionSettingsVR& Settings, const FPendingTargetVR& Target);
+
+private:
+
+	// Body and net owner lookups for a target, kept between ticks so skeletal meshes don't do a bone name search
+	// and the owner chain isn't walked for every target every tick
+	struct FCachedTargetVR
+	{
+		FName BoneName = NAME_None;
+		int32 BodyIndex = INDEX_NONE;
+		bool bIsSkeletal = false;
+		bool bInitialized = false;
+
+		TWeakObjectPtr<AActor> Owner;
+		TWeakObjectPtr<const AActor> NetOwner;
+	};
+
+	FBodyInstance* GetCachedBodyInstanceVR(FCachedTargetVR& Cached, UPrimitiveComponent* PrimComp, FName BoneName, bool& bOutIsSkeletal);
+
+	// Re-resolves only when the owners owner changed or the actor owning the connection went away (client left)
+	static bool HasCachedNetOwningPlayerVR(FCachedTargetVR& Cached, AActor* OwningActor);
+
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, FCachedTargetVR> CachedTargets;
+
+	// Reused between ticks to avoid re-allocating
+	TArray<FPendingTargetVR> PendingTargets;
+
+public:
 #if WITH_CHAOS
 
 	static void ApplyAsyncDesiredStateVR(float DeltaSeconds, const FAsyncPhysicsRepCallbackDataVR* Input);
@@ -98,34 +186,159 @@ struct FContactModBodyInstancePair
 };
 
 #if PHYSICS_INTERFACE_PHYSX
+
+// Order independent key for an ignored pair, built from the two sync actors
+struct FContactModIgnoreKey
+{
+	const physx::PxActor* ActorA;
+	const physx::PxActor* ActorB;
+
+	FContactModIgnoreKey() :
+		ActorA(nullptr),
+		ActorB(nullptr)
+	{}
+
+	FContactModIgnoreKey(const physx::PxActor* Actor1, const physx::PxActor* Actor2)
+	{
+		// Sort so that (A, B) and (B, A) land in the same bucket
+		if (Actor1 < Actor2)
+		{
+			ActorA = Actor1;
+			ActorB = Actor2;
+		}
+		else
+		{
+			ActorA = Actor2;
+			ActorB = Actor1;
+		}
+	}
+
+	FORCEINLINE bool operator==(const FContactModIgnoreKey& Other) const
+	{
+		return ActorA == Other.ActorA && ActorB == Other.ActorB;
+	}
+
+	friend FORCEINLINE uint32 GetTypeHash(const FContactModIgnoreKey& Key)
+	{
+		return HashCombine(PointerHash(Key.ActorA), PointerHash(Key.ActorB));
+	}
+};
+
+// Ignore pairs for the contact modify callbacks
+// The game thread edits the master map, an immutable copy of its keys is published into one of two snapshot buffers
+// at the start of each physics step (when nothing is simulating). The simulation only ever reads the active snapshot, so it needs no lock.
+class FContactModifyIgnoreSetVR
+{
+public:
+
+	FContactModifyIgnoreSetVR() :
+		ActiveSnapshot(0),
+		bSnapshotDirty(false)
+	{}
+
+	// Game thread only
+	void AddPair(const FContactModBodyInstancePair& Pair);
+	void RemovePair(const FContactModBodyInstancePair& Pair);
+	void RemovePairsForPrimitive(const UPrimitiveComponent* Prim);
+	void RemoveInvalidPairs();
+
+	FORCEINLINE int32 Num() const
+	{
+		return ContactsToIgnore.Num();
+	}
+
+	// Called from the physics scenes pre tick, copies the master set into the back buffer and flips it active
+	void PublishSnapshot();
+
+	// Physics thread, lock free
+	FORCEINLINE bool ShouldIgnore(const physx::PxActor* Actor1, const physx::PxActor* Actor2) const
+	{
+		return Snapshots[ActiveSnapshot.Load(EMemoryOrder::Relaxed)].Contains(FContactModIgnoreKey(Actor1, Actor2));
+	}
+
+private:
+
+	static FORCEINLINE FContactModIgnoreKey MakeKey(const FContactModBodyInstancePair& Pair)
+	{
+		return FContactModIgnoreKey(Pair.Actor1.SyncActor, Pair.Actor2.SyncActor);
+	}
+
+	// Master copy, game thread owned
+	TMap<FContactModIgnoreKey, FContactModBodyInstancePair> ContactsToIgnore;
+
+	TSet<FContactModIgnoreKey> Snapshots[2];
+	TAtomic<int32> ActiveSnapshot;
+	bool bSnapshotDirty;
+};
+
 class FContactModifyCallbackVR : public FContactModifyCallback
 {
 public:
 
-	TArray<FContactModBodyInstancePair> ContactsToIgnore;
-	FRWLock RWAccessLock;
+	FContactModifyIgnoreSetVR ContactsToIgnore;
+
+	FContactModifyCallbackVR(FPhysScene* OwningPhysScene) :
+		PhysScene(OwningPhysScene)
+	{
+		// Publish pending ignore changes before each simulation step
+		if (PhysScene)
+		{
+			PreTickHandle = PhysScene->OnPhysScenePreTick.AddLambda([this](FPhysScene* Scene, float DeltaTime)
+			{
+				ContactsToIgnore.PublishSnapshot();
+			});
+		}
+	}
 
 	void onContactModify(PxContactModifyPair* const pairs, PxU32 count) override;
 
 	virtual ~FContactModifyCallbackVR()
 	{
-
+		if (PhysScene)
+		{
+			PhysScene->OnPhysScenePreTick.Remove(PreTickHandle);
+		}
 	}
+
+private:
+
+	FPhysScene* PhysScene;
+	FDelegateHandle PreTickHandle;
 };
 
 class FCCDContactModifyCallbackVR : public FCCDContactModifyCallback
 {
 public:
 
-	TArray<FContactModBodyInstancePair> ContactsToIgnore;
-	FRWLock RWAccessLock;
+	FContactModifyIgnoreSetVR ContactsToIgnore;
+
+	FCCDContactModifyCallbackVR(FPhysScene* OwningPhysScene) :
+		PhysScene(OwningPhysScene)
+	{
+		// Publish pending ignore changes before each simulation step
+		if (PhysScene)
+		{
+			PreTickHandle = PhysScene->OnPhysScenePreTick.AddLambda([this](FPhysScene* Scene, float DeltaTime)
+			{
+				ContactsToIgnore.PublishSnapshot();
+			});
+		}
+	}
 
 	void onCCDContactModify(PxContactModifyPair* const pairs, PxU32 count) override;
 
 	virtual ~FCCDContactModifyCallbackVR()
 	{
-
+		if (PhysScene)
+		{
+			PhysScene->OnPhysScenePreTick.Remove(PreTickHandle);
+		}
 	}
+
+private:
+
+	FPhysScene* PhysScene;
+	FDelegateHandle PreTickHandle;
 };
 
 class IContactModifyCallbackFactoryVR : public IContactModifyCallbackFactory
@@ -134,7 +347,7 @@ public:
 
 	virtual FContactModifyCallback* Create(FPhysScene* OwningPhysScene) override
 	{
-		return new FContactModifyCallbackVR();
+		return new FContactModifyCallbackVR(OwningPhysScene);
 	}
 
 	virtual void Destroy(FContactModifyCallback* ContactCallback) override
@@ -150,7 +363,7 @@ public:
 
 	virtual FCCDContactModifyCallback* Create(FPhysScene* OwningPhysScene) override
 	{
-		return new FCCDContactModifyCallbackVR();
+		return new FCCDContactModifyCallbackVR(OwningPhysScene);
 	}
 
 	virtual void Destroy(FCCDContactModifyCallback* ContactCallback) override
@@ -123,6 +123,9 @@ public:
 	// Resetting the initial transform here so that it comes in prior to BeginPlay and save loading.
 	virtual void OnRegister() override;
 
+	// Drops out of the interactible update subsystems active set
+	virtual void OnUnregister() override;
+
 	// Now replicating this so that it works correctly over the network
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_InitialRelativeTransform, Category = "VRDialComponent")
 		FTransform_NetQuantize InitialRelativeTransform;
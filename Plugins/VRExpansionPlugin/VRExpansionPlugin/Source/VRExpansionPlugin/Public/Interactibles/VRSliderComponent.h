@@ -32,6 +32,45 @@ enum class EVRInteractibleSliderDropBehavior : uint8
 	RetainMomentum
 };
 
+/**
+* Closest point table for a followed spline, sampled in spline local space at the knots of the splines reparam table.
+* Samples are grouped into chunks with bounding spheres so closest point queries only test the chunks that can win,
+* the engines own per segment refinement is then run on the winning segment and its neighbors. Keys match
+* FindInputKeyClosestToWorldLocation unless the spline passes back within one reparam step of itself.
+* Distance to key lookups stay on ReparamTable.Eval, a second table would only add its own linearization error.
+*/
+struct VREXPANSIONPLUGIN_API FVRSplineArcLengthTable
+{
+	TArray<FVector> Positions;
+	TArray<float> Keys;
+
+	TArray<FVector> ChunkCenters;
+	TArray<float> ChunkRadii;
+
+	float SplineLength;
+
+	// What the table was built from, any change to the spline bumps its curve version
+	TWeakObjectPtr<const USplineComponent> Spline;
+	uint32 SplineVersion;
+	int32 NumSplinePoints;
+	bool bClosedLoop;
+
+	static const int32 SamplesPerChunk = 16;
+
+	FVRSplineArcLengthTable() :
+		SplineLength(0.f),
+		SplineVersion(0),
+		NumSplinePoints(0),
+		bClosedLoop(false)
+	{}
+
+	bool IsValidFor(const USplineComponent* InSpline) const;
+	void Build(const USplineComponent* InSpline);
+	void Reset();
+
+	float FindInputKeyClosestToLocalLocation(const USplineComponent* InSpline, const FVector& LocalLocation) const;
+};
+
 /** Delegate for notification when the slider state changes. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FVRSliderHitPointSignature, float, SliderProgressPoint);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FVRSliderFinishedLerpingSignature, float, FinalProgress);
@@ -198,6 +237,9 @@ public:
 	// Resetting the initial transform here so that it comes in prior to BeginPlay and save loading.
 	virtual void OnRegister() override;
 
+	// Drops out of the interactible update subsystems active set
+	virtual void OnUnregister() override;
+
 	// Now replicating this so that it works correctly over the network
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_InitialRelativeTransform, Category = "VRSliderComponent")
 		FTransform_NetQuantize InitialRelativeTransform;
@@ -245,6 +287,14 @@ public:
 
 	void GetLerpedKey(float &ClosestKey, float DeltaTime);
 	float GetCurrentSliderProgress(FVector CurLocation, bool bUseKeyInstead = false, float CurKey = 0.f);
+
+	// Table backed closest point query, rebuilds the table for SplineComponentToFollow if it changed
+	float FindSplineInputKeyClosestToWorldLocation(const FVector& WorldLocation);
+	// Same key GetTransformAtDistanceAlongSpline uses
+	float GetSplineInputKeyAtDistance(float Distance);
+	const FVRSplineArcLengthTable& GetSplineArcLengthTable();
+
+	FVRSplineArcLengthTable SplineArcLengthTable;
 	FVector ClampSlideVector(FVector ValueToClamp);
 
 	// ------------------------------------------------
@@ -12,6 +12,8 @@
 //DECLARE_DYNAMIC_MULTICAST_DELEGATE(FVRPhysicsReplicationDelegate, void, Return);
 
 
+DECLARE_STATS_GROUP(TEXT("BucketUpdates"), STATGROUP_BucketUpdates, STATCAT_Advanced);
+
 DECLARE_DELEGATE_RetVal(bool, FBucketUpdateTickSignature);
 DECLARE_DYNAMIC_DELEGATE(FDynamicBucketUpdateTickSignature);
 
@@ -25,6 +27,9 @@ public:
 	
 	FName FunctionName;
 
+	// Phase group within the owning bucket that this callback fires in
+	uint8 PhaseIndex;
+
 	bool ExecuteBoundCallback();
 	bool IsBoundToObjectFunction(UObject * Obj, FName & FuncName);
 	bool IsBoundToObjectDelegate(FDynamicBucketUpdateTickSignature & DynEvent);
@@ -47,13 +52,49 @@ public:
 
 	TArray<FUpdateBucketDrop> Callbacks;
 
-	bool Update(float DeltaTime);
+	// The bucket period is split into NumPhases groups, one group fires every nUpdateRate / NumPhases
+	// so each callback still fires once per nUpdateRate
+	uint8 NumPhases;
+	uint8 NextPhaseToAssign;
+	uint8 CurrentPhase;
+
+	// Phases that have come due but haven't finished firing yet (carried over when the frame budget runs out)
+	uint8 NumDuePhases;
+
+	// Where to resume in Callbacks for the current phase, INDEX_NONE starts at the end of the array
+	int32 CallbackCursor;
+
+	// Returns false if the bucket ran out of frame budget before it finished its due phases
+	bool Update(float DeltaTime, uint64 BudgetEndCycles, int32 & CallbacksFired);
+
+	bool HasCallbacks() const
+	{
+		return Callbacks.Num() > 0;
+	}
+
+	void AddCallback(const FUpdateBucketDrop & NewCallback);
+
+	// Removes a callback and keeps the resume cursor pointing at the same entry
+	void RemoveCallbackAt(int32 Index);
 
-	FUpdateBucket() {}
+	FUpdateBucket() :
+		nUpdateRate(0.0f),
+		nUpdateCount(0.0f),
+		NumPhases(1),
+		NextPhaseToAssign(0),
+		CurrentPhase(0),
+		NumDuePhases(0),
+		CallbackCursor(INDEX_NONE)
+	{}
 
-	FUpdateBucket(uint32 UpdateHTZ) :
+	FUpdateBucket(uint32 UpdateHTZ, uint8 PhaseGroups = 1) :
 		nUpdateRate(1.0f / UpdateHTZ),
-		nUpdateCount(0.0f)
+		nUpdateCount(0.0f),
+		NumPhases(FMath::Max<uint8>(PhaseGroups, 1)),
+		NextPhaseToAssign(0),
+		CurrentPhase(0),
+		NumDuePhases(0),
+		CallbackCursor(INDEX_NONE)
 	{
 	}
 };
@@ -68,6 +109,18 @@ public:
 	bool bNeedsUpdate;
 	TMap<uint32, FUpdateBucket> ReplicationBuckets;
 
+	// How many phase groups new buckets get
+	uint8 NumPhaseGroups;
+
+	// Per frame budget in seconds, 0 is unlimited
+	float FrameBudgetSeconds;
+
+	// Bucket that ran out of budget last frame, it is updated first on the next one so it can't be starved
+	uint32 ResumeBucketKey;
+
+	// Worst frame cost seen so far, in milliseconds
+	float WorstFrameCostMS;
+
 	void UpdateBuckets(float DeltaTime);
 
 	bool AddBucketObject(uint32 UpdateHTZ, UObject* InObject, FName FunctionName);
@@ -91,6 +144,10 @@ public:
 	FUpdateBucketContainer()
 	{
 		bNeedsUpdate = false;
+		NumPhaseGroups = 1;
+		FrameBudgetSeconds = 0.0f;
+		ResumeBucketKey = 0;
+		WorstFrameCostMS = 0.0f;
 	};
 
 };
@@ -113,6 +170,8 @@ public:
 		// Not allowing for editor type as this is a replication subsystem
 	}
 
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
 	//UPROPERTY()
 	FUpdateBucketContainer BucketContainer;
 
@@ -148,6 +207,17 @@ public:
 	UFUNCTION(BlueprintPure, Category = "BucketUpdateSubsystem")
 		bool IsActive();
 
+	// Sets the per frame time budget in milliseconds, callbacks past the budget are carried over to the next frame, 0 is unlimited
+	UFUNCTION(BlueprintCallable, Category = "BucketUpdateSubsystem")
+		void SetFrameBudget(float BudgetMS);
+
+	// Returns the worst frame cost of the bucket updates in milliseconds since the last reset
+	UFUNCTION(BlueprintPure, Category = "BucketUpdateSubsystem")
+		float GetWorstFrameCost() const;
+
+	UFUNCTION(BlueprintCallable, Category = "BucketUpdateSubsystem")
+		void ResetWorstFrameCost();
+
 	// FTickableGameObject functions
 	/**
 	 * Function called every frame on this GripScript. Override this function to implement custom logic to be executed every frame.
@@ -117,6 +117,14 @@ public:
 	{
 		Super::Deinitialize();
 
+		for (const TPair<TWeakObjectPtr<UPrimitiveComponent>, TArray<FCollisionPrimPair>>& IndexPair : ComponentPairIndex)
+		{
+			UnbindPrimitiveCallbacks(IndexPair.Key);
+		}
+
+		ComponentPairIndex.Empty();
+		SweepQueue.Empty();
+
 		if (UpdateHandle.IsValid())
 		{
 			GetWorld()->GetTimerManager().ClearTimer(UpdateHandle);
@@ -151,63 +159,18 @@ public:
 			{
 				for (const FCollisionIgnorePair& BonePair : Pair.Value.PairArray)
 				{
-					bool bPrim1Exists = false;
-					bool bPrim2Exists = false;
-
-					for (const TPair<FCollisionPrimPair, FCollisionIgnorePairArray>& KeyPair : CollisionTrackedPairs)
+					// Only walks the pairs that each primitive is still part of
+					// Bodies can already be gone if this came from a physics state being destroyed
+					if (!bSkipPrim1 && !IsBoneStillIgnored(Pair.Key.Prim1, BonePair.BoneName1))
 					{
-						if (!bPrim1Exists && !bSkipPrim1)
-						{
-							if (KeyPair.Key.Prim1 == Pair.Key.Prim1)
-							{
-								bPrim1Exists = KeyPair.Value.PairArray.ContainsByPredicate([BonePair](const FCollisionIgnorePair& Other)
-									{
-										return BonePair.BoneName1 == Other.BoneName1;
-									});
-							}
-							else if (KeyPair.Key.Prim2 == Pair.Key.Prim1)
-							{
-								bPrim1Exists = KeyPair.Value.PairArray.ContainsByPredicate([BonePair](const FCollisionIgnorePair& Other)
-									{
-										return BonePair.BoneName1 == Other.BoneName2;
-									});
-							}
-						}
-
-						if (!bPrim2Exists && !bSkipPrim2)
-						{
-							if (KeyPair.Key.Prim1 == Pair.Key.Prim2)
-							{
-								bPrim2Exists = KeyPair.Value.PairArray.ContainsByPredicate([BonePair](const FCollisionIgnorePair& Other)
-									{
-										return BonePair.BoneName2 == Other.BoneName1;
-									});
-							}
-							else if (KeyPair.Key.Prim2 == Pair.Key.Prim2)
-							{
-								bPrim2Exists = KeyPair.Value.PairArray.ContainsByPredicate([BonePair](const FCollisionIgnorePair& Other)
-									{
-										return BonePair.BoneName2 == Other.BoneName2;
-									});
-							}
-						}
-
-
-						if ((bPrim1Exists || bSkipPrim1) && (bPrim2Exists || bSkipPrim2))
-						{
-							break; // Exit early
-						}
+						if (FBodyInstance* BI = Pair.Key.Prim1->GetBodyInstance(BonePair.BoneName1))
+							BI->SetContactModification(false);
 					}
 
-					if (!bPrim1Exists && !bSkipPrim1)
-					{
-						Pair.Key.Prim1->GetBodyInstance(BonePair.BoneName1)->SetContactModification(false);
-					}
-
-
-					if (!bPrim2Exists && !bSkipPrim2)
+					if (!bSkipPrim2 && !IsBoneStillIgnored(Pair.Key.Prim2, BonePair.BoneName2))
 					{
-						Pair.Key.Prim2->GetBodyInstance(BonePair.BoneName2)->SetContactModification(false);
+						if (FBodyInstance* BI = Pair.Key.Prim2->GetBodyInstance(BonePair.BoneName2))
+							BI->SetContactModification(false);
 					}
 				}
 			}
@@ -220,8 +183,8 @@ public:
 		{
 			if (!UpdateHandle.IsValid())
 			{
-				// Setup the heartbeat on 1htz checks
-				GetWorld()->GetTimerManager().SetTimer(UpdateHandle, this, &UCollisionIgnoreSubsystem::CheckActiveFilters, 1.0f, true, 1.0f);
+				// Primitives remove themselves through their physics state callbacks, this is only a slow safety sweep for anything missed
+				GetWorld()->GetTimerManager().SetTimer(UpdateHandle, this, &UCollisionIgnoreSubsystem::SweepTrackedPrimitives, 5.0f, true, 5.0f);
 			}
 		}
 		else if (UpdateHandle.IsValid())
@@ -233,6 +196,14 @@ public:
 	UFUNCTION(Category = "Collision")
 		void CheckActiveFilters();
 
+	// Checks a slice of the tracked primitives for validity each call, runs a full CheckActiveFilters if any are found dead
+	UFUNCTION(Category = "Collision")
+		void SweepTrackedPrimitives();
+
+	// Drops every pair for a tracked primitive the moment its physics state is destroyed along with it
+	UFUNCTION()
+		void OnPrimitivePhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange);
+
 	// #TODO implement this, though it should be rare
 	void InitiateIgnore();
 
@@ -241,6 +212,22 @@ public:
 	bool IsComponentIgnoringCollision(UPrimitiveComponent* Prim1);
 private:
 
+	// Reverse index of the tracked pairs that each primitive is part of, kept in sync with CollisionTrackedPairs
+	// Not a UPROPERTY as nested containers are not supported, the keys are weak and CollisionTrackedPairs owns the data anyway
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, TArray<FCollisionPrimPair>> ComponentPairIndex;
+
+	void AddTrackedPair(const FCollisionPrimPair& PrimPair);
+	void RemoveTrackedPair(const FCollisionPrimPair& PrimPair);
+
+	// Returns true if any tracked pair still ignores collision on this bone of the primitive
+	bool IsBoneStillIgnored(const TWeakObjectPtr<UPrimitiveComponent>& Prim, FName BoneName) const;
+
+	void BindPrimitiveCallbacks(const TWeakObjectPtr<UPrimitiveComponent>& Prim);
+	void UnbindPrimitiveCallbacks(const TWeakObjectPtr<UPrimitiveComponent>& Prim);
+
+	// Primitives still left to check in the current safety sweep
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> SweepQueue;
+
 	FTimerHandle UpdateHandle;
 
 };
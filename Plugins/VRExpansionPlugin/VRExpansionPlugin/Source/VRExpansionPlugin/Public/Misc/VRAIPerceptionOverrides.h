@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "VRBaseCharacter.h"
+#include "WorldCollision.h"
 #include "AIModule/Classes/GenericTeamAgentInterface.h"
 #include "AIModule/Classes/Perception/AISense.h"
 #include "AIModule/Classes/Perception/AISenseConfig.h"
@@ -131,10 +132,13 @@ struct FAISightQueryVR
 	mutable int32 UserData;
 
 	uint64 bLastResult : 1;
-	uint64 LastProcessedFrameNumber : 63;
+
+	/** Set while an async line of sight trace for this query is in flight */
+	uint64 bAsyncTracePending : 1;
+	uint64 LastProcessedFrameNumber : 62;
 
 	FAISightQueryVR(FPerceptionListenerID ListenerId = FPerceptionListenerID::InvalidID(), FAISightTargetVR::FTargetId Target = FAISightTargetVR::InvalidTargetId)
-		: ObserverId(ListenerId), TargetId(Target), Score(0), Importance(0), LastSeenLocation(FAISystem::InvalidLocation), UserData(0), bLastResult(false), LastProcessedFrameNumber(GFrameCounter)
+		: ObserverId(ListenerId), TargetId(Target), Score(0), Importance(0), LastSeenLocation(FAISystem::InvalidLocation), UserData(0), bLastResult(false), bAsyncTracePending(false), LastProcessedFrameNumber(GFrameCounter)
 	{
 	}
 
@@ -153,6 +157,12 @@ struct FAISightQueryVR
 		LastProcessedFrameNumber = GFrameCounter;
 	}
 
+	/** For results that were traced on an earlier frame, the age counts from when the trace ran */
+	void OnProcessed(uint64 TracedFrameNumber)
+	{
+		LastProcessedFrameNumber = TracedFrameNumber;
+	}
+
 	void ForgetPreviousResult()
 	{
 		LastSeenLocation = FAISystem::InvalidLocation;
@@ -172,6 +182,30 @@ struct FAISightQueryVR
 	};
 };
 
+/** An async line of sight trace submitted by UAISense_Sight_VR, resolved at the start of the following update */
+struct FAISightAsyncTraceVR
+{
+	FTraceHandle TraceHandle;
+	FPerceptionListenerID ObserverId;
+	FAISightTargetVR::FTargetId TargetId;
+
+	/** Where the target was when the trace was submitted, used as the stimulus location */
+	FVector TargetLocation;
+
+	/** Frame the trace was submitted on, the result age counts from here */
+	uint64 SubmitFrameNumber;
+
+	TWeakObjectPtr<AActor> HitActor;
+	bool bHit;
+	bool bHasResult;
+	bool bResolved;
+
+	FAISightAsyncTraceVR()
+		: ObserverId(FPerceptionListenerID::InvalidID()), TargetId(FAISightTargetVR::InvalidTargetId), TargetLocation(FVector::ZeroVector), SubmitFrameNumber(0), bHit(false), bHasResult(false), bResolved(false)
+	{
+	}
+};
+
 UCLASS(ClassGroup = AI, config = Game)
 class VREXPANSIONPLUGIN_API UAISense_Sight_VR : public UAISense
 {
@@ -223,8 +257,24 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config)
 		float SightLimitQueryImportance;
 
+	/** If true line of sight traces are submitted as async traces and their results are consumed on the next update, moving the trace work off of the game thread.
+	*	Targets implementing IAISightTargetInterface are still tested synchronously. */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config)
+		bool bUseAsyncTraces;
+
+	/** Max async traces submitted per update when bUseAsyncTraces is enabled */
+	UPROPERTY(EditDefaultsOnly, Category = "AI Perception", config, meta = (EditCondition = "bUseAsyncTraces", ClampMin = 1))
+		int32 MaxAsyncTracesPerTick;
+
 	ECollisionChannel DefaultSightCollisionChannel;
 
+	/** Async traces that are in flight */
+	TArray<FAISightAsyncTraceVR> PendingAsyncTraces;
+
+	float QueriesPerSecond;
+	int32 QueriesSinceRateSample;
+	double LastRateSampleTime;
+
 public:
 
 	virtual void PostInitProperties() override;
@@ -237,9 +287,20 @@ public:
 	virtual void OnListenerForgetsActor(const FPerceptionListener& Listener, AActor& ActorToForget) override;
 	virtual void OnListenerForgetsAll(const FPerceptionListener& Listener) override;
 
+	/** Sight queries completed per second, sampled once a second */
+	float GetQueriesPerSecond() const { return QueriesPerSecond; }
+
+	/** Average age in frames of the sight results held for a listener, for async traces this counts from when the trace was submitted */
+	float GetAverageResultAge(const FPerceptionListenerID& ListenerId) const;
+
+	int32 GetNumPendingAsyncTraces() const { return PendingAsyncTraces.Num(); }
+
 protected:
 	virtual float Update() override;
 
+	/** Applies the results of the async traces submitted last update, traces that are still in flight are kept. Returns the number of queries completed */
+	int32 ConsumeAsyncTraceResults(UWorld* World, AIPerception::FListenerMap& ListenersMap);
+
 	virtual bool ShouldAutomaticallySeeTarget(const FDigestedSightProperties& PropDigest, FAISightQueryVR* SightQuery, FPerceptionListener& Listener, AActor* TargetActor, float& OutStimulusStrength) const;
 
 	void OnNewListenerImpl(const FPerceptionListener& NewListener);
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "VRInteractibleUpdateSubsystem.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("VRInteractibles"), STATGROUP_VRInteractibles, STATCAT_Advanced);
+
+class UActorComponent;
+
+/**
+* Updates the interactible components (buttons, dials, levers and sliders) of a world in a single pass.
+* Managed components have no tick function registered at all, they wake when they have something to simulate
+* (held, lerping, carrying momentum or being depressed) and go back to sleep when they settle, so idle
+* interactibles cost nothing per frame and add nothing to the tick task graph.
+* Blueprint subclasses implementing Event Tick keep their own tick function, as does everything when
+* vr.InteractibleBatchedUpdates is 0.
+*/
+UCLASS()
+class VREXPANSIONPLUGIN_API UVRInteractibleUpdateSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UVRInteractibleUpdateSubsystem() :
+		Super()
+	{
+		NumClearedSlots = 0;
+		bIsUpdating = false;
+	}
+
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+		// Editor worlds don't tick the interactibles
+	}
+
+	virtual void Deinitialize() override;
+
+	// Called from the interactibles OnRegister, removes the components tick function if the subsystem will be updating it instead
+	static void RegisterInteractible(UActorComponent* InComponent);
+
+	// Called from the interactibles OnUnregister, drops the component from the active set
+	// Components that were awake are woken again when they register again
+	static void UnregisterInteractible(UActorComponent* InComponent);
+
+	// Wakes or puts an interactible to sleep, used in place of SetComponentTickEnabled
+	// Components that kept their own tick function just have it enabled / disabled
+	static void SetInteractibleAwake(UActorComponent* InComponent, bool bAwake);
+
+	// Returns true if the component is updated by this subsystem instead of its own tick function
+	static bool IsManagedInteractible(const UActorComponent* InComponent);
+
+	void WakeInteractible(UActorComponent* InComponent);
+	void SleepInteractible(UActorComponent* InComponent);
+
+	UFUNCTION(BlueprintPure, Category = "VRInteractibleUpdateSubsystem")
+		int32 GetNumActiveInteractibles() const { return ActiveIndices.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "VRInteractibleUpdateSubsystem")
+		bool IsInteractibleAwake(UActorComponent* InComponent) const { return ActiveIndices.Contains(InComponent); }
+
+	// FTickableGameObject functions
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual bool IsTickableInEditor() const;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual ETickableTickType GetTickableTickType() const;
+	virtual TStatId GetStatId() const override;
+	// End tickable object information
+
+private:
+
+	// Removes the slots cleared during an update and rebuilds the index map
+	void CompactActiveComponents();
+
+	// Packed set of awake components, slots are only nulled out while updating and compacted afterwards
+	UPROPERTY(Transient)
+	TArray<UActorComponent*> ActiveComponents;
+
+	// Component -> slot in ActiveComponents
+	TMap<UActorComponent*, int32> ActiveIndices;
+
+	// Components that were awake when they unregistered, woken again by RegisterInteractible
+	TSet<TWeakObjectPtr<UActorComponent>> SuspendedComponents;
+
+	int32 NumClearedSlots;
+	bool bIsUpdating;
+};
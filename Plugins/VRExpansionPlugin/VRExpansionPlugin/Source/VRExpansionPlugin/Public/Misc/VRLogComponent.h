@@ -8,6 +8,8 @@
 #include "Engine/Console.h"
 #include "Containers/UnrealString.h"
 #include "Core/Public/Misc/OutputDeviceHelper.h"
+#include "Containers/Queue.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "VRLogComponent.generated.h"
 
 /**
@@ -23,35 +25,51 @@ enum class EBPVRConsoleDrawType : uint8
 
 
 /**
-* A single log message for the output log, holding a message and
-* a style, for color and bolding of the message.
+* A single log line for the output log, holding the line and its draw layout
+* so that the text and color don't have to be rebuilt every time it is drawn.
 */
 struct FVRLogMessage
 {
-	TSharedRef<FString> Message;
+	FString Message;
 	ELogVerbosity::Type Verbosity;
 	FName Category;
 	FName Style;
 
-	FVRLogMessage(const TSharedRef<FString>& NewMessage, FName NewCategory, FName NewStyle = NAME_None)
-		: Message(NewMessage)
-		, Verbosity(ELogVerbosity::Log)
-		, Category(NewCategory)
-		, Style(NewStyle)
+	// Cached layout
+	FText DisplayText;
+	FLinearColor Color;
+
+	FVRLogMessage()
+		: Verbosity(ELogVerbosity::Log)
+		, Category(NAME_None)
+		, Style(NAME_None)
+		, Color(FLinearColor(0.8f, 0.8f, 0.8f))
 	{
 	}
 
-	FVRLogMessage(const TSharedRef<FString>& NewMessage, ELogVerbosity::Type NewVerbosity, FName NewCategory, FName NewStyle = NAME_None)
-		: Message(NewMessage)
+	FVRLogMessage(FString&& NewMessage, ELogVerbosity::Type NewVerbosity, FName NewCategory, FName NewStyle = NAME_None)
+		: Message(MoveTemp(NewMessage))
 		, Verbosity(NewVerbosity)
 		, Category(NewCategory)
 		, Style(NewStyle)
 	{
+		DisplayText = FText::FromString(Message);
+
+		switch (Verbosity)
+		{
+		case ELogVerbosity::Error:
+		case ELogVerbosity::Fatal: Color = FLinearColor(0.7f, 0.1f, 0.1f); break;
+		case ELogVerbosity::Warning: Color = FLinearColor(0.5f, 0.5f, 0.0f); break;
+
+		case ELogVerbosity::Log:
+		default: Color = FLinearColor(0.8f, 0.8f, 0.8f);
+		}
 	}
 };
 
 // Custom Log output history class to hold the VR logs.
 /** This class is to capture all log output even if the log window is closed */
+/** Lines are kept in a fixed size ring so memory stays bounded, logs from other threads go through a lock free queue that is drained on the game thread */
 class FVROutputLogHistory : public FOutputDevice
 {
 public:
@@ -65,6 +83,8 @@ public:
 		MaxLineLength = 130;
 		bIsDirty = false;
 		MaxStoredMessages = 1000;
+		RingHead = 0;
+		TotalMessages = 0;
 		GLog->AddOutputDevice(this);
 		GLog->SerializeBacklog(this);
 	}
@@ -78,115 +98,58 @@ public:
 		}
 	}
 
-	/** Gets all captured messages */
-	const TArray< TSharedPtr<FVRLogMessage> >& GetMessages() const
+	virtual bool CanBeUsedOnAnyThread() const override
 	{
-		return Messages;
+		return true;
+	}
+
+	/** Moves any lines logged from other threads into the history, game thread only */
+	void FlushPendingMessages();
+
+	/** Number of lines currently stored */
+	int32 Num() const
+	{
+		return Ring.Num();
+	}
+
+	/** Gets a stored line, index 0 is the oldest */
+	const FVRLogMessage& GetMessage(int32 Index) const
+	{
+		return Ring[(RingHead + Index) % Ring.Num()];
+	}
+
+	/** Total number of lines ever stored, used to tell how many lines are new since a previous draw */
+	int64 GetTotalMessageCount() const
+	{
+		return TotalMessages;
 	}
 
 protected:
 
-	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category) override
-	{
-		// Capture all incoming messages and store them in history
-		CreateLogMessages(V, Verbosity, Category, Messages);
-	}
+	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category) override;
 
-	bool CreateLogMessages(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category, TArray< TSharedPtr<FVRLogMessage> >& OutMessages)
-	{
-		if (Verbosity == ELogVerbosity::SetColor)
-		{
-			// Skip Color Events
-			return false;
-		}
-		else
-		{
-			FName Style;
-			if (Category == NAME_Cmd)
-			{
-				Style = FName(TEXT("Log.Command"));
-			}
-			else if (Verbosity == ELogVerbosity::Error)
-			{
-				Style = FName(TEXT("Log.Error"));
-			}
-			else if (Verbosity == ELogVerbosity::Warning)
-			{
-				Style = FName(TEXT("Log.Warning"));
-			}
-			else
-			{
-				Style = FName(TEXT("Log.Normal"));
-			}
-
-			// Forget timestamps, I don't care about them and we have limited texture space to draw too
-			// Determine how to format timestamps
-			static ELogTimes::Type LogTimestampMode = ELogTimes::None;
-			/*if (UObjectInitialized() && !GExitPurge)
-			{
-			// Logging can happen very late during shutdown, even after the UObject system has been torn down, hence the init check above
-			LogTimestampMode = GetDefault<UEditorStyleSettings>()->LogTimestampMode;
-			}*/
-
-			const int32 OldNumMessages = OutMessages.Num();
-
-			// handle multiline strings by breaking them apart by line
-			TArray<FTextRange> LineRanges;
-			FString CurrentLogDump = V;
-			FTextRange::CalculateLineRangesFromString(CurrentLogDump, LineRanges);
-
-			bool bIsFirstLineInMessage = true;
-			for (const FTextRange& LineRange : LineRanges)
-			{
-				if (!LineRange.IsEmpty())
-				{
-					FString Line = CurrentLogDump.Mid(LineRange.BeginIndex, LineRange.Len());
-					Line = Line.ConvertTabsToSpaces(4);
-
-					// Hard-wrap lines to avoid them being too long
-					/*static const */int32 HardWrapLen = MaxLineLength;
-					for (int32 CurrentStartIndex = 0; CurrentStartIndex < Line.Len();)
-					{
-						int32 HardWrapLineLen = 0;
-						if (bIsFirstLineInMessage)
-						{
-							FString MessagePrefix = FOutputDeviceHelper::FormatLogLine(Verbosity, Category, nullptr, LogTimestampMode);
-
-							HardWrapLineLen = FMath::Min(HardWrapLen - MessagePrefix.Len(), Line.Len() - CurrentStartIndex);
-							FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
-
-							OutMessages.Add(MakeShareable(new FVRLogMessage(MakeShareable(new FString(MessagePrefix + HardWrapLine)), Verbosity, Category, Style)));
-						}
-						else
-						{
-							HardWrapLineLen = FMath::Min(HardWrapLen, Line.Len() - CurrentStartIndex);
-							FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
-
-							OutMessages.Add(MakeShareable(new FVRLogMessage(MakeShareable(new FString(MoveTemp(HardWrapLine))), Verbosity, Category, Style)));
-						}
-
-						bIsFirstLineInMessage = false;
-						CurrentStartIndex += HardWrapLineLen;
-					}
-				}
-			}
-
-			int numMessages = OutMessages.Num();
-			if (numMessages > MaxStoredMessages)
-			{
-				OutMessages.RemoveAt(0, numMessages - MaxStoredMessages, true);
-			}
-			if (OldNumMessages != numMessages)
-				bIsDirty = true;
-
-			return OldNumMessages != numMessages;//OutMessages.Num();
-		}
-	}
+	void CreateLogMessages(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category);
+	void AddLine(FVRLogMessage&& Line);
 
 private:
 
-	/** All log messages since this module has been started */
-	TArray< TSharedPtr<FVRLogMessage> > Messages;
+	// Raw log from a non game thread waiting to be split into lines
+	struct FPendingLog
+	{
+		FString Message;
+		ELogVerbosity::Type Verbosity;
+		FName Category;
+	};
+
+	TQueue<FPendingLog, EQueueMode::Mpsc> PendingLogs;
+
+	// Caps the pending queue so that it stays bounded if nothing flushes it
+	FThreadSafeCounter NumPendingLogs;
+
+	/** Ring of the most recent log lines, RingHead is the oldest once it is full */
+	TArray<FVRLogMessage> Ring;
+	int32 RingHead;
+	int64 TotalMessages;
 };
 
 /**
@@ -219,6 +182,11 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRLogComponent|Console")
 		int32 MaxStoredMessages;
 
+	// Max number of new output log lines appended to the render target per draw, 0 is unlimited
+	// Lines over the budget are drawn on the following calls
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRLogComponent|Console")
+		int32 MaxLinesDrawnPerFrame;
+
 	// Sets the console input text, can be used to clear the console or enter full or partial commands
 	UFUNCTION(BlueprintCallable, Category = "VRLogComponent|Console", meta = (bIgnoreSelf = "true"))
 		void SetConsoleText(FString Text);
@@ -239,4 +207,19 @@ public:
 	void DrawConsole(bool bLowerHalfOnly, UCanvas* Canvas);
 	void DrawOutputLog(bool bUpperHalfOnly, UCanvas* Canvas, float ScrollOffset);
 
+	// Scrolls the existing output log up on the GPU and only draws the new lines under it
+	// Returns false if the target can't be appended to and needs a full redraw instead
+	bool AppendOutputLog(UCanvas* Canvas, UTextureRenderTarget2D* Texture, float ScrollOffset);
+
+private:
+
+	// Scratch copy used to scroll the output log render target contents
+	UPROPERTY(Transient)
+		UTextureRenderTarget2D* ScrollScratchTarget;
+
+	TWeakObjectPtr<UTextureRenderTarget2D> LastOutputLogTarget;
+	FIntPoint LastOutputLogSize;
+	float LastScrollOffset;
+	int64 LastDrawnMessageCount;
+
 };
\ No newline at end of file
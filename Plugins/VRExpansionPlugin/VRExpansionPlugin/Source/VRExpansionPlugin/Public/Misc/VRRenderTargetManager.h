@@ -22,7 +22,7 @@
 
 class UVRRenderTargetManager;
 
-// #TODO: Dirty rects so don't have to send entire texture?
+DECLARE_STATS_GROUP(TEXT("VRRenderTargetManager"), STATGROUP_VRRenderTargetManager, STATCAT_Advanced);
 
 
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
@@ -55,11 +55,26 @@ public:
 	//UPROPERTY(Transient)
 	EPixelFormat PixelFormat;
 
+	// Texture version this store brings the receiver up to
+	UPROPERTY(Transient)
+		uint32 TextureVersion;
+
+	// If non zero then this is a tile delta against this version, the unpacked data is laid out as
+	// [NumTiles, TileIndex..., TilePixels...] instead of the full image
+	UPROPERTY(Transient)
+		uint32 BaseVersion;
+
+	UPROPERTY(Transient)
+		uint32 TileSize;
+
 	FBPVRReplicatedTextureStore()
 	{
 		Width = 0;
 		Height = 0;
 		bIsZipped = false;
+		TextureVersion = 0;
+		BaseVersion = 0;
+		TileSize = 0;
 	}
 
 	void Reset()
@@ -70,9 +85,17 @@ public:
 		Height = 0;
 		PixelFormat = (EPixelFormat)0;
 		bIsZipped = false;
+		TextureVersion = 0;
+		BaseVersion = 0;
+		TileSize = 0;
 		//bJPG = false;
 	}
 
+	FORCEINLINE bool IsDelta() const
+	{
+		return BaseVersion != 0;
+	}
+
 	void PackData();
 	void UnPackData();
 
@@ -179,6 +202,9 @@ struct TStructOpsTypeTraits< FRenderManagerOperation > : public TStructOpsTypeTr
 	};
 };
 
+// Immutable packed texture shared between all of the proxies sending it, freed when the last one finishes
+typedef TSharedPtr<const FBPVRReplicatedTextureStore> FBPVRTextureSnapshotPtr;
+
 /**
 * This class is used as a proxy to send owner only RPCs
 */
@@ -199,14 +225,21 @@ public:
 	UFUNCTION()
 		void OnRep_Manager();
 
+	// Client side receive buffer
 	UPROPERTY(Transient)
 	FBPVRReplicatedTextureStore TextureStore;
+
+	// Server side, the snapshot we are currently sending, BlobNum is our cursor into it
+	FBPVRTextureSnapshotPtr SendSnapshot;
 	
 	UPROPERTY(Transient)
 		int32 BlobNum;
 
 	bool bWaitingForManager;
 
+	// Starts sending a snapshot to our owner, the snapshot is shared and never modified
+	void SendTextureSnapshot(const FBPVRTextureSnapshotPtr& Snapshot);
+
 	void SendInitMessage();
 
 	UFUNCTION()
@@ -231,6 +264,8 @@ public:
 		if(SendTimer_Handle.IsValid())
 			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
 
+		SendSnapshot.Reset();
+
 		Super::EndPlay(EndPlayReason);
 	}
 
@@ -239,7 +274,7 @@ public:
 		void SendLocalDrawOperations(const TArray<FRenderManagerOperation>& LocalRenderOperationStoreList);
 
 	UFUNCTION(Reliable, Client)
-		void InitTextureSend(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped/*, bool bIsJPG*/);
+		void InitTextureSend(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped/*, bool bIsJPG*/, int32 TextureVersion, int32 BaseVersion, int32 TileSize);
 
 	UFUNCTION(Reliable, Server, WithValidation)
 		void Ack_InitTextureSend(int32 TotalDataCount);
@@ -253,6 +288,11 @@ public:
 	UFUNCTION(Reliable, Client)
 		void ReceiveTexture(const FBPVRReplicatedTextureStore&TextureData);
 
+	// Sent once the client has applied a texture, deltas are built against the last acknowledged version
+	// A version of 0 requests a full resend (client tile cache didn't match the delta base)
+	UFUNCTION(Reliable, Server, WithValidation)
+		void Ack_TextureVersion(int32 TextureVersion);
+
 };
 
 
@@ -273,10 +313,15 @@ struct FClientRepData {
 	UPROPERTY()
 		bool bIsDirty;
 
+	// Last texture version this client has confirmed it applied, 0 if it needs a full texture
+	UPROPERTY()
+		int32 AckedTextureVersion;
+
 	FClientRepData() 
 	{
 		bIsRelevant = false;
 		bIsDirty = false;
+		AckedTextureVersion = 0;
 	}
 };
 
@@ -374,6 +419,42 @@ public:
 	UPROPERTY(Transient)
 		FBPVRReplicatedTextureStore RenderTargetStore;
 
+	// If true then clients that already have a version of the texture are only sent the tiles that changed since it
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager")
+		bool bUseDeltaTextureReplication;
+
+	// Size in pixels of the square tiles used for delta texture replication
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager", meta = (ClampMin = "8", UIMin = "8"))
+		int32 TextureTileSize;
+
+	// If more than this fraction of the tiles changed then a full texture is sent instead of a delta
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager", meta = (ClampMin = "0.0", UIMin = "0.0", ClampMax = "1.0", UIMax = "1.0"))
+		float MaxDeltaTileFraction;
+
+	// Server side tile tracking, current version of the texture and the version each tile last changed at
+	uint32 TextureVersion;
+	int32 CurrentTileSize;
+	FIntPoint TileGridSize;
+	TArray<uint32> TileHashes;
+	TArray<uint32> TileVersions;
+
+	// Client side tile cache, the last full image we applied and its version
+	TArray<uint16> TileCachePixels;
+	uint32 TileCacheVersion;
+
+	// Hashes the tiles of a freshly stored texture and bumps the version of any that changed
+	void UpdateTileVersions(const TArray<uint16>& Pixels, int32 Width, int32 Height);
+
+	// Builds a packed delta store of all tiles changed since BaseVersion, returns false if a full send should be used instead
+	// OutStore is left empty if the client is already up to date
+	bool BuildDeltaTextureStore(uint32 BaseVersion, const TArray<uint16>& Pixels, FBPVRReplicatedTextureStore& OutStore);
+
+	// Applies an unpacked delta onto the client tile cache, returns false if the cache didn't match its base
+	bool ApplyDeltaToTileCache(const FBPVRReplicatedTextureStore& DeltaStore);
+
+	// Called on the server when a client acknowledges a texture version
+	void OnClientAckedTextureVersion(ARenderTargetReplicationProxy* Proxy, int32 AckedVersion);
+
 	UFUNCTION(BlueprintCallable, Category = "VRRenderTargetManager|UtilityFunctions")
 		bool GenerateTrisFromBoxPlaneIntersection(UPrimitiveComponent* PrimToBoxCheck, FTransform WorldTransformOfPlane, const FPlane& LocalProjectionPlane, FVector2D PlaneSize, FColor UVColor, TArray<FCanvasUVTri>& OutTris);
 	
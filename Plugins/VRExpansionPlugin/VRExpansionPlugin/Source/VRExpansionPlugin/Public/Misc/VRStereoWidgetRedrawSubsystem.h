@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "VRStereoWidgetRedrawSubsystem.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("VRStereoWidgets"), STATGROUP_VRStereoWidgets, STATCAT_Advanced);
+
+class UUserWidget;
+class SWidget;
+struct FSlateDebuggingInvalidateArgs;
+
+// A pending redraw request, arbitrated once per frame against the global widget render budget
+struct FVRStereoWidgetRedrawRequest
+{
+	TWeakObjectPtr<USceneComponent> Component;
+	uint64 LastRequestFrame;
+	int32 Priority;
+	uint32 FramesWaiting;
+	bool bIsVisible;
+
+	FVRStereoWidgetRedrawRequest() :
+		LastRequestFrame(0),
+		Priority(0),
+		FramesWaiting(0),
+		bIsVisible(false)
+	{}
+};
+
+// Slate root of a scheduled widget and whether anything under it was invalidated since its last draw
+struct FVRStereoWidgetInvalidationRoot
+{
+	TWeakPtr<SWidget> RootWidget;
+	bool bInvalidated;
+
+	FVRStereoWidgetInvalidationRoot() :
+		bInvalidated(true)
+	{}
+};
+
+/**
+* Schedules stereo widget redraws for a world.
+* Widgets only request a redraw when something in their slate tree was invalidated (SetText, SetBrush, layout changes ect),
+* it reports pending work (animations, active timers, volatile widgets) or their draw size changes.
+* Requests are granted on the spot while the frame still has room in vr.StereoWidgetRedrawBudget, the rest are arbitrated
+* in visibility / priority order at the end of the frame and the grants are consumed on the following frame.
+* Components keep requesting every tick while dirty, requests that were not renewed are dropped at arbitration.
+* Invalidations are tracked through the slate debugging invalidate event, which is only bound while widgets are scheduled.
+* Builds compiled without WITH_SLATE_DEBUGGING (shipping / test by default) have no invalidation signal, there every due draw
+* counts as invalidated and the scheduler only spreads the draws over the budget.
+*/
+UCLASS()
+class VREXPANSIONPLUGIN_API UVRStereoWidgetRedrawSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UVRStereoWidgetRedrawSubsystem() :
+		Super()
+	{
+		TotalRedrawsPerformed = 0;
+		TotalRedrawsSkipped = 0;
+		TotalRedrawsDeferred = 0;
+		RedrawFrame = 0;
+		RedrawsThisFrame = 0;
+	}
+
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+		// Editor previews draw unscheduled
+	}
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Returns true if the component may redraw its widget this frame, otherwise queues it for the next arbitration
+	bool RequestRedraw(USceneComponent* InComponent, int32 InPriority, bool bIsVisible);
+
+	// Called by components that were due a draw but had nothing invalidated, only used for the counters
+	void NotifyRedrawSkipped();
+
+	// Drops any pending request, grant or tracked invalidation root for the component
+	void RemoveRedrawRequest(USceneComponent* InComponent);
+
+	// Tracks invalidations under the components slate root (its virtual window), returns true if any happened since the last call
+	// A newly tracked or changed root counts as invalidated, always true if CanTrackWidgetInvalidations is false
+	bool ConsumeWidgetInvalidation(USceneComponent* InComponent, const TSharedPtr<SWidget>& InRootWidget);
+
+	// Returns true if this build can see slate invalidations (WITH_SLATE_DEBUGGING)
+	static bool CanTrackWidgetInvalidations();
+
+	// Returns true if the slate tree has pending work that will change what it paints
+	// Covers playing animations, hover / focus, active timers and volatile widgets
+	static bool HasPendingSlateWork(UUserWidget* InWidget, const TSharedPtr<SWidget>& InSlateWidget);
+
+	// Total widget renders granted and performed since the last reset
+	UFUNCTION(BlueprintPure, Category = "VRStereoWidgetRedrawSubsystem")
+		int32 GetRedrawsPerformed() const { return (int32)TotalRedrawsPerformed; }
+
+	// Total widget renders skipped because nothing was invalidated since the last reset
+	UFUNCTION(BlueprintPure, Category = "VRStereoWidgetRedrawSubsystem")
+		int32 GetRedrawsSkipped() const { return (int32)TotalRedrawsSkipped; }
+
+	// Total widget renders pushed to a later frame by the render budget since the last reset
+	UFUNCTION(BlueprintPure, Category = "VRStereoWidgetRedrawSubsystem")
+		int32 GetRedrawsDeferred() const { return (int32)TotalRedrawsDeferred; }
+
+	UFUNCTION(BlueprintCallable, Category = "VRStereoWidgetRedrawSubsystem")
+		void ResetRedrawCounters();
+
+	// FTickableGameObject functions
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual bool IsTickableInEditor() const;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual ETickableTickType GetTickableTickType() const;
+	virtual TStatId GetStatId() const override;
+	// End tickable object information
+
+private:
+
+	void OnWidgetInvalidated(const FSlateDebuggingInvalidateArgs& InvalidateArgs);
+	FDelegateHandle WidgetInvalidateHandle;
+
+	// Binds the invalidate event while there are tracked roots, unbinds it once there are none
+	void UpdateWidgetInvalidateBinding();
+
+	// Roots of the scheduled widgets
+	TMap<TWeakObjectPtr<USceneComponent>, FVRStereoWidgetInvalidationRoot> InvalidationRoots;
+
+	// Root widget -> owning component, for mapping invalidations back
+	TMap<const SWidget*, TWeakObjectPtr<USceneComponent>> ComponentsByRootWidget;
+
+	// Redraws performed in RedrawFrame, counts against the budget along with the grants reserved at the last arbitration
+	uint64 RedrawFrame;
+	int32 RedrawsThisFrame;
+
+	// Requests waiting on the next arbitration
+	TArray<FVRStereoWidgetRedrawRequest> PendingRequests;
+
+	// Components granted a render for the current frame
+	TSet<TWeakObjectPtr<USceneComponent>> GrantedComponents;
+
+	uint64 TotalRedrawsPerformed;
+	uint64 TotalRedrawsSkipped;
+	uint64 TotalRedrawsDeferred;
+};
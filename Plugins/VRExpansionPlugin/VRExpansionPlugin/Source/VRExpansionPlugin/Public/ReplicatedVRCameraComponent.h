@@ -108,6 +108,14 @@ public:
 	UFUNCTION(Unreliable, Server, WithValidation)
 	void Server_SendCameraTransform(FBPVRComponentPosRep NewTransform);
 
+	// Server acking a delta baseline (or reporting a lost one) back to the owning client, only used with ReplicatedCameraTransform.bUseDeltaEncoding
+	UFUNCTION(Unreliable, Client)
+	void Client_AckPoseBaseline(uint8 BaselineAck);
+
+	// Delta stream state for the client -> server transform sends
+	FVRPoseDeltaSender PoseDeltaSender;
+	FVRPoseDeltaReceiver PoseDeltaReceiver;
+
 	// Pointer to an override to call from the owning character - this saves 7 bits a rep avoiding component IDs on the RPC
 	typedef void (AVRBaseCharacter::*VRBaseCharTransformRPC_Pointer)(FBPVRComponentPosRep NewTransform);
 	VRBaseCharTransformRPC_Pointer OverrideSendTransform;
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 //#include "EngineMinimal.h"
 #include "Components/PrimitiveComponent.h"
+#include "Engine/NetSerialization.h"
 
 #include "PhysicsPublic.h"
 #include "PhysicsEngine/ConstraintDrives.h"
@@ -454,6 +455,58 @@ namespace TransNetQuant
 	static const float MinimumQ = -1.0f / 1.414214f;
 	static const float MaximumQ = +1.0f / 1.414214f;
 	static const float MinMaxQDiff = TransNetQuant::MaximumQ - TransNetQuant::MinimumQ;
+
+	// Delta pose encoding (FBPVRComponentPosRep), deltas are only sent inside of these ranges from the acknowledged baseline
+	static const float MaxDeltaPosition = 400.0f; // Fits within both delta packed vector ranges
+	static const float MaxDeltaRotationDegrees = 45.0f;
+	static const float MaxDeltaQ = 0.382683f; // Sin(MaxDeltaRotationDegrees / 2), the largest a delta quats X/Y/Z can be
+
+	static const uint32 BaselineIdBits = 5;
+	static const uint8 NumBaselineIds = 1 << BaselineIdBits;
+	static const uint8 BaselineIdMask = NumBaselineIds - 1;
+	static const uint8 BaselineLostFlag = 0x80; // Set in an ack when the receiver does not have the baseline a delta referenced
+
+	// Smallest Three for a delta rotation within MaxDeltaRotationDegrees
+	// Inside of that range W is always the largest component, so its index isn't sent and the remaining three
+	// are quantized over +/- MaxDeltaQ instead of the full +/- 1/sqrt(2) range
+	template <uint32 bits>
+	static void SerializeDeltaQuat_SmallestThree(FArchive& Ar, FQuat& InDeltaQuat)
+	{
+		check(bits > 1 && bits <= 32);
+
+		uint32 IntegerA = 0, IntegerB = 0, IntegerC = 0;
+		const float scale = float((1 << bits) - 1);
+
+		if (Ar.IsSaving())
+		{
+			InDeltaQuat.Normalize();
+
+			// q and -q are the same rotation, keep W positive so it can be rebuilt
+			const float Sign = InDeltaQuat.W >= 0.f ? 1.f : -1.f;
+			const float a = FMath::Clamp(InDeltaQuat.X * Sign, -MaxDeltaQ, MaxDeltaQ);
+			const float b = FMath::Clamp(InDeltaQuat.Y * Sign, -MaxDeltaQ, MaxDeltaQ);
+			const float c = FMath::Clamp(InDeltaQuat.Z * Sign, -MaxDeltaQ, MaxDeltaQ);
+
+			IntegerA = FMath::FloorToInt(((a + MaxDeltaQ) / (2.f * MaxDeltaQ)) * scale + 0.5f);
+			IntegerB = FMath::FloorToInt(((b + MaxDeltaQ) / (2.f * MaxDeltaQ)) * scale + 0.5f);
+			IntegerC = FMath::FloorToInt(((c + MaxDeltaQ) / (2.f * MaxDeltaQ)) * scale + 0.5f);
+		}
+
+		Ar.SerializeBits(&IntegerA, bits);
+		Ar.SerializeBits(&IntegerB, bits);
+		Ar.SerializeBits(&IntegerC, bits);
+
+		if (Ar.IsLoading())
+		{
+			const float inverse_scale = 1.0f / scale;
+
+			InDeltaQuat.X = IntegerA * inverse_scale * (2.f * MaxDeltaQ) - MaxDeltaQ;
+			InDeltaQuat.Y = IntegerB * inverse_scale * (2.f * MaxDeltaQ) - MaxDeltaQ;
+			InDeltaQuat.Z = IntegerC * inverse_scale * (2.f * MaxDeltaQ) - MaxDeltaQ;
+			InDeltaQuat.W = FMath::Sqrt(FMath::Max(0.f, 1.f - InDeltaQuat.X * InDeltaQuat.X - InDeltaQuat.Y * InDeltaQuat.Y - InDeltaQuat.Z * InDeltaQuat.Z));
+			InDeltaQuat.Normalize();
+		}
+	}
 }
 
 USTRUCT(/*noexport, */BlueprintType, Category = "VRExpansionLibrary|TransformNetQuantize", meta = (HasNativeMake = "VRExpansionPlugin.VRExpansionFunctionLibrary.MakeTransform_NetQuantize", HasNativeBreak = "VRExpansionPlugin.VRExpansionFunctionLibrary.BreakTransform_NetQuantize"))
@@ -737,6 +790,19 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = Replication, AdvancedDisplay)
 		EVRRotationQuantization RotationQuantizationLevel;
 
+	// If true the owning client sends this pose to the server as a delta from a pose the server has acknowledged.
+	// Absolute baselines are resent every vrexp.PoseDeltaResyncInterval sends, when the pose leaves the delta range, or after a lost baseline.
+	// Only the client -> server send uses it, replication from the server to other clients is always absolute.
+	UPROPERTY(EditDefaultsOnly, Category = Replication, AdvancedDisplay)
+		bool bUseDeltaEncoding;
+
+	// Delta stream state, only valid between FVRPoseDeltaSender::PrepareForSend and FVRPoseDeltaReceiver::Resolve
+	FVector DeltaPosition;
+	FQuat DeltaRotation;
+	uint8 BaselineId;
+	uint8 bIsBaseline : 1;
+	uint8 bIsDelta : 1;
+
 	FORCEINLINE uint16 CompressAxisTo10BitShort(float Angle)
 	{
 		// map [0->360) to [0->1024) and mask off any winding
@@ -752,13 +818,51 @@ public:
 
 	FBPVRComponentPosRep():
 		QuantizationLevel(EVRVectorQuantization::RoundTwoDecimals),
-		RotationQuantizationLevel(EVRRotationQuantization::RoundToShort)
+		RotationQuantizationLevel(EVRRotationQuantization::RoundToShort),
+		bUseDeltaEncoding(false),
+		DeltaPosition(FVector::ZeroVector),
+		DeltaRotation(FQuat::Identity),
+		BaselineId(0),
+		bIsBaseline(false),
+		bIsDelta(false)
 	{
 		//QuantizationLevel = EVRVectorQuantization::RoundTwoDecimals;
 		Position = FVector::ZeroVector;
 		Rotation = FRotator::ZeroRotator;
 	}
 
+	FORCEINLINE void ClearDeltaState()
+	{
+		bIsBaseline = false;
+		bIsDelta = false;
+	}
+
+	// Sends this (absolute) pose as a baseline the receiver will store and acknowledge
+	FORCEINLINE void SetAsBaseline(uint8 InBaselineId)
+	{
+		BaselineId = InBaselineId & TransNetQuant::BaselineIdMask;
+		bIsBaseline = true;
+		bIsDelta = false;
+	}
+
+	// Sends this pose as a delta from an acknowledged baseline
+	FORCEINLINE void SetDeltaFromBaseline(uint8 InBaselineId, const FVector& BasePosition, const FQuat& BaseRotation)
+	{
+		BaselineId = InBaselineId & TransNetQuant::BaselineIdMask;
+		DeltaPosition = Position - BasePosition;
+		DeltaRotation = BaseRotation.Inverse() * Rotation.Quaternion();
+		bIsBaseline = false;
+		bIsDelta = true;
+	}
+
+	// Rebuilds the absolute pose from the baseline the received delta was encoded against
+	FORCEINLINE void ResolveDelta(const FVector& BasePosition, const FQuat& BaseRotation)
+	{
+		Position = BasePosition + DeltaPosition;
+		Rotation = (BaseRotation * DeltaRotation).Rotator();
+		ClearDeltaState();
+	}
+
 	/** Network serialization */
 	// Doing a custom NetSerialize here because this is sent via RPCs and should change on every update
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
@@ -770,6 +874,33 @@ public:
 		Ar.SerializeBits(&QuantizationLevel, 1); // Only two values 0:1
 		Ar.SerializeBits(&RotationQuantizationLevel, 1); // Only two values 0:1
 
+		// Delta stream header, a single bit when the pose is sent plain absolute
+		uint8 bUsesDeltaStream = (bIsBaseline || bIsDelta) ? 1 : 0;
+		Ar.SerializeBits(&bUsesDeltaStream, 1);
+
+		if (bUsesDeltaStream)
+		{
+			uint8 bDelta = bIsDelta ? 1 : 0;
+			Ar.SerializeBits(&bDelta, 1);
+			Ar.SerializeBits(&BaselineId, TransNetQuant::BaselineIdBits);
+
+			if (Ar.IsLoading())
+			{
+				bIsDelta = bDelta != 0;
+				bIsBaseline = bDelta == 0;
+			}
+
+			if (bIsDelta)
+			{
+				bOutSuccess &= SerializeDelta(Ar);
+				return bOutSuccess;
+			}
+		}
+		else if (Ar.IsLoading())
+		{
+			ClearDeltaState();
+		}
+
 		// No longer using their built in rotation rep, as controllers will rarely if ever be at 0 rot on an axis and 
 		// so the 1 bit overhead per axis is just that, overhead
 		//Rotation.SerializeCompressedShort(Ar);
@@ -855,6 +986,32 @@ public:
 		return bOutSuccess;
 	}
 
+	// Delta payload, positions get a smaller packed vector range and rotations use Smallest Three with an implied W
+	bool SerializeDelta(FArchive& Ar)
+	{
+		bool bOutSuccess = true;
+
+		/**
+		*	Valid range 100: 2^16 / 100 = +/- 655.36
+		*	Valid range 10: 2^12 / 10 = +/- 409.6
+		*	Both cover TransNetQuant::MaxDeltaPosition
+		*/
+		switch (QuantizationLevel)
+		{
+		case EVRVectorQuantization::RoundTwoDecimals: bOutSuccess &= SerializePackedVector<100, 16>(DeltaPosition, Ar); break;
+		case EVRVectorQuantization::RoundOneDecimal: bOutSuccess &= SerializePackedVector<10, 12>(DeltaPosition, Ar); break;
+		}
+
+		// Bit counts picked to roughly match the angular precision of the absolute modes
+		switch (RotationQuantizationLevel)
+		{
+		case EVRRotationQuantization::RoundTo10Bits: TransNetQuant::SerializeDeltaQuat_SmallestThree<8>(Ar, DeltaRotation); break;
+		case EVRRotationQuantization::RoundToShort: TransNetQuant::SerializeDeltaQuat_SmallestThree<14>(Ar, DeltaRotation); break;
+		}
+
+		return bOutSuccess;
+	}
+
 };
 
 template<>
@@ -867,6 +1024,52 @@ struct TStructOpsTypeTraits< FBPVRComponentPosRep > : public TStructOpsTypeTrait
 	};
 };
 
+// Sender side of the FBPVRComponentPosRep delta stream, one per sent pose
+// Encodes outgoing poses against the newest baseline the receiver acknowledged
+struct VREXPANSIONPLUGIN_API FVRPoseDeltaSender
+{
+	struct FBaseline
+	{
+		FVector Position;
+		FQuat Rotation;
+		bool bValid;
+
+		FBaseline() : Position(FVector::ZeroVector), Rotation(FQuat::Identity), bValid(false) {}
+	};
+
+	// Baselines as the receiver decoded them, indexed by id
+	FBaseline SentBaselines[TransNetQuant::NumBaselineIds];
+	int32 AckedBaselineId;
+	uint8 NextBaselineId;
+	int32 SendsSinceBaseline;
+
+	FVRPoseDeltaSender()
+	{
+		Reset();
+	}
+
+	void Reset();
+
+	// Turns the outgoing pose into a baseline, a delta, or leaves it absolute
+	void PrepareForSend(FBPVRComponentPosRep& InOutPose);
+
+	// Called with the receivers ack, which either confirms a baseline or reports a lost one
+	void OnBaselineAck(uint8 BaselineAck);
+
+	// Round trips an absolute pose through NetSerialize so that baselines match what the receiver decodes exactly
+	static void QuantizePose(const FBPVRComponentPosRep& InPose, FVector& OutPosition, FQuat& OutRotation);
+};
+
+// Receiver side of the FBPVRComponentPosRep delta stream
+struct VREXPANSIONPLUGIN_API FVRPoseDeltaReceiver
+{
+	FVRPoseDeltaSender::FBaseline Baselines[TransNetQuant::NumBaselineIds];
+
+	// Stores baselines and resolves deltas to absolute poses, returns false if the pose referenced a baseline we don't have
+	// bOutSendAck is set when the sender needs to be told OutAck
+	bool Resolve(FBPVRComponentPosRep& InOutPose, bool& bOutSendAck, uint8& OutAck);
+};
+
 UENUM(Blueprintable)
 enum class EGripCollisionType : uint8
 {
@@ -1346,7 +1549,7 @@ struct TStructOpsTypeTraits< FBPSecondaryGripInfo > : public TStructOpsTypeTrait
 #define INVALID_VRGRIP_ID 0
 
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
-struct VREXPANSIONPLUGIN_API FBPActorGripInformation
+struct VREXPANSIONPLUGIN_API FBPActorGripInformation : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 public:
@@ -1450,9 +1653,49 @@ public:
 
 	}ValueCache;
 
+	// Cached interface and grip script resolution, filled in NotifyGrip so that the grip tick doesn't have to
+	// run the interface checks or build a new script array every frame. Cleared on re-grip or when the scripts change.
+	struct FGripResolutionCache
+	{
+		// Object that owns the grip interface for this grip (the root component first, then the actor)
+		TWeakObjectPtr<UObject> InterfaceOwner;
+
+		// Root and actor that this was resolved against, only used for identity comparison
+		const UObject * ResolvedRoot;
+		const UObject * ResolvedActor;
+
+		TArray<TWeakObjectPtr<UVRGripScriptBase>, TInlineAllocator<4>> GripScripts;
+
+		bool bIsResolved;
+		bool bRootHasInterface;
+		bool bActorHasInterface;
+		bool bIsCustomGrip;
+
+		FGripResolutionCache() :
+			ResolvedRoot(nullptr),
+			ResolvedActor(nullptr),
+			bIsResolved(false),
+			bRootHasInterface(false),
+			bActorHasInterface(false),
+			bIsCustomGrip(false)
+		{}
+
+		FORCEINLINE bool IsValidFor(const UObject * Root, const UObject * Actor) const
+		{
+			return bIsResolved && ResolvedRoot == Root && ResolvedActor == Actor;
+		}
+
+		void Invalidate()
+		{
+			bIsResolved = false;
+		}
+
+	}ResolutionCache;
+
 	void ClearNonReppingItems()
 	{
 		ValueCache = FGripValueCache();
+		ResolutionCache = FGripResolutionCache();
 		bColliding = false;
 		bIsLocked = false;
 		LastLockedRotation = FQuat::Identity;
@@ -1551,6 +1794,12 @@ public:
 		return false;
 	}
 
+	// Fast array replication callbacks, these only queue the event on the array
+	// The owning controller handles them once the whole receive is done
+	void PreReplicatedRemove(const struct FBPGripInformationArray& InArraySerializer);
+	void PostReplicatedAdd(const struct FBPGripInformationArray& InArraySerializer);
+	void PostReplicatedChange(const struct FBPGripInformationArray& InArraySerializer);
+
 	FBPActorGripInformation() :
 		GripID(INVALID_VRGRIP_ID),
 		GripTargetType(EGripTargetType::ActorGrip),
@@ -1585,6 +1834,114 @@ public:
 
 };
 
+// Replicated grip list, replaces the plain TArray so that only grips that were marked dirty get compared and sent.
+// Mirrors the TArray functions that the controller uses, Add / RemoveAt / Empty mark the array themselves, anything
+// changing a replicated property of an existing grip on the server has to call MarkItemDirty on it.
+USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
+struct VREXPANSIONPLUGIN_API FBPGripInformationArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly, Category = "Grips")
+	TArray<FBPActorGripInformation> Items;
+
+	// Client side replication events, filled in by the item callbacks and consumed by the owning controller
+	mutable TArray<uint8> PendingRepAdds;
+	mutable TArray<uint8> PendingRepChanges;
+	mutable TArray<FBPActorGripInformation> PendingRepRemoves;
+
+	// Last replicated state of each grip on clients, the fast array only gives us the new state so changes are diffed against this
+	TArray<FBPActorGripInformation> LastReplicatedStates;
+
+	FBPGripInformationArray()
+	{
+		// Only send the changed properties of a dirty grip instead of the full struct
+		SetDeltaSerializationEnabled(true);
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FBPActorGripInformation, FBPGripInformationArray>(Items, DeltaParms, *this);
+	}
+
+	FORCEINLINE bool HasPendingRepEvents() const
+	{
+		return PendingRepAdds.Num() > 0 || PendingRepChanges.Num() > 0 || PendingRepRemoves.Num() > 0;
+	}
+
+	FORCEINLINE bool OwnsGrip(const FBPActorGripInformation& Grip) const
+	{
+		return Items.Num() > 0 && &Grip >= Items.GetData() && &Grip < Items.GetData() + Items.Num();
+	}
+
+	// TArray mirror
+	FORCEINLINE int32 Num() const { return Items.Num(); }
+	FORCEINLINE bool IsValidIndex(int32 Index) const { return Items.IsValidIndex(Index); }
+	FORCEINLINE FBPActorGripInformation& operator[](int32 Index) { return Items[Index]; }
+	FORCEINLINE const FBPActorGripInformation& operator[](int32 Index) const { return Items[Index]; }
+
+	FORCEINLINE TArray<FBPActorGripInformation>::RangedForIteratorType begin() { return Items.begin(); }
+	FORCEINLINE TArray<FBPActorGripInformation>::RangedForConstIteratorType begin() const { return Items.begin(); }
+	FORCEINLINE TArray<FBPActorGripInformation>::RangedForIteratorType end() { return Items.end(); }
+	FORCEINLINE TArray<FBPActorGripInformation>::RangedForConstIteratorType end() const { return Items.end(); }
+
+	template <typename KeyType>
+	FORCEINLINE FBPActorGripInformation* FindByKey(const KeyType& Key) { return Items.FindByKey(Key); }
+
+	template <typename KeyType>
+	FORCEINLINE const FBPActorGripInformation* FindByKey(const KeyType& Key) const { return Items.FindByKey(Key); }
+
+	template <typename KeyType>
+	FORCEINLINE bool Contains(const KeyType& Key) const { return Items.Contains(Key); }
+
+	FORCEINLINE bool Find(const FBPActorGripInformation& Grip, int32& Index) const { return Items.Find(Grip, Index); }
+	FORCEINLINE int32 Find(const FBPActorGripInformation& Grip) const { return Items.Find(Grip); }
+
+	FORCEINLINE int32 Add(const FBPActorGripInformation& Grip)
+	{
+		const int32 Index = Items.Add(Grip);
+		MarkItemDirty(Items[Index]);
+		return Index;
+	}
+
+	FORCEINLINE void RemoveAt(int32 Index)
+	{
+		Items.RemoveAt(Index);
+		MarkArrayDirty();
+	}
+
+	FORCEINLINE void Empty()
+	{
+		Items.Empty();
+		MarkArrayDirty();
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits< FBPGripInformationArray > : public TStructOpsTypeTraitsBase2<FBPGripInformationArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+FORCEINLINE void FBPActorGripInformation::PreReplicatedRemove(const FBPGripInformationArray& InArraySerializer)
+{
+	InArraySerializer.PendingRepRemoves.Add(*this);
+}
+
+FORCEINLINE void FBPActorGripInformation::PostReplicatedAdd(const FBPGripInformationArray& InArraySerializer)
+{
+	InArraySerializer.PendingRepAdds.Add(GripID);
+}
+
+FORCEINLINE void FBPActorGripInformation::PostReplicatedChange(const FBPGripInformationArray& InArraySerializer)
+{
+	InArraySerializer.PendingRepChanges.AddUnique(GripID);
+}
+
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
 struct VREXPANSIONPLUGIN_API FBPGripPair
 {
@@ -238,6 +238,91 @@ struct TStructOpsTypeTraits< FVRReplicatedCapsuleHeight > : public TStructOpsTyp
 	};
 };
 
+// Bit flags for which poses are included in a batched tracked pose update
+enum class EVRTrackedPoseFlags : uint8
+{
+	Camera = 0x01,
+	LeftController = 0x02,
+	RightController = 0x04
+};
+
+// The HMD and both controller poses sent up to the server in one RPC, only the flagged poses are serialized
+USTRUCT()
+struct VREXPANSIONPLUGIN_API FVRTrackedPosesRep
+{
+	GENERATED_USTRUCT_BODY()
+public:
+
+	// EVRTrackedPoseFlags of the poses that changed since the last send
+	UPROPERTY(Transient)
+		uint8 ChangedPoses;
+
+	// Client world time the poses were sent at, shared by all of them
+	UPROPERTY(Transient)
+		float TimeStamp;
+
+	UPROPERTY(Transient)
+		FBPVRComponentPosRep CameraPose;
+
+	UPROPERTY(Transient)
+		FBPVRComponentPosRep LeftControllerPose;
+
+	UPROPERTY(Transient)
+		FBPVRComponentPosRep RightControllerPose;
+
+	FVRTrackedPosesRep() :
+		ChangedPoses(0),
+		TimeStamp(0.0f)
+	{}
+
+	FORCEINLINE bool HasPose(EVRTrackedPoseFlags Pose) const
+	{
+		return (ChangedPoses & (uint8)Pose) != 0;
+	}
+
+	FORCEINLINE void SetPose(EVRTrackedPoseFlags Pose, const FBPVRComponentPosRep& NewPose)
+	{
+		switch (Pose)
+		{
+		case EVRTrackedPoseFlags::Camera: CameraPose = NewPose; break;
+		case EVRTrackedPoseFlags::LeftController: LeftControllerPose = NewPose; break;
+		case EVRTrackedPoseFlags::RightController: RightControllerPose = NewPose; break;
+		}
+
+		ChangedPoses |= (uint8)Pose;
+	}
+
+	/** Network serialization */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+	{
+		bOutSuccess = true;
+
+		Ar.SerializeBits(&ChangedPoses, 3);
+		Ar << TimeStamp;
+
+		// Each pose keeps its own quantization levels
+		bool bPoseSuccess = true;
+		if (HasPose(EVRTrackedPoseFlags::Camera))
+			bOutSuccess &= CameraPose.NetSerialize(Ar, Map, bPoseSuccess);
+
+		if (HasPose(EVRTrackedPoseFlags::LeftController))
+			bOutSuccess &= LeftControllerPose.NetSerialize(Ar, Map, bPoseSuccess);
+
+		if (HasPose(EVRTrackedPoseFlags::RightController))
+			bOutSuccess &= RightControllerPose.NetSerialize(Ar, Map, bPoseSuccess);
+
+		return bOutSuccess;
+	}
+};
+template<>
+struct TStructOpsTypeTraits< FVRTrackedPosesRep > : public TStructOpsTypeTraitsBase2<FVRTrackedPosesRep>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
 UCLASS()
 class VREXPANSIONPLUGIN_API AVRBaseCharacter : public ACharacter
 {
@@ -292,6 +377,31 @@ public:
 	UFUNCTION(Unreliable, Server, WithValidation)
 		void Server_SendTransformRightController(FBPVRComponentPosRep NewTransform);
 
+	// If true the HMD and controller poses are sent to the server together in a single RPC per frame instead of an RPC each.
+	// Only the poses that changed that frame are included.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacter|Networking")
+		bool bBatchTrackedPoseUpdates;
+
+	UFUNCTION(Unreliable, Server, WithValidation)
+		void Server_SendTrackedPoses(const FVRTrackedPosesRep& NewPoses);
+
+	// The tracked components send through these, they either queue the pose for the batched send or call the matching RPC
+	void SendTransformCamera(FBPVRComponentPosRep NewTransform);
+	void SendTransformLeftController(FBPVRComponentPosRep NewTransform);
+	void SendTransformRightController(FBPVRComponentPosRep NewTransform);
+
+	// Poses queued this frame, sent after all actors have ticked
+	FVRTrackedPosesRep PendingTrackedPoses;
+	FDelegateHandle FlushTrackedPosesHandle;
+
+	// Server side, used to throw out batched updates that arrive out of order
+	float LastReceivedPoseTimeStamp;
+
+	void QueueTrackedPose(EVRTrackedPoseFlags Pose, const FBPVRComponentPosRep& NewTransform);
+	void FlushTrackedPoses(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
 
 	// If true will replicate the capsule height on to clients, allows for dynamic capsule height changes in multiplayer
@@ -205,6 +205,79 @@ public:
 	~FVRGestureSplineDraw();
 };
 
+// Per gesture lower bound envelope for banded DTW, the bounds of the gesture samples within +/- the band width of each sample
+struct FVRGestureEnvelope
+{
+	TArray<FVector> Min;
+	TArray<FVector> Max;
+
+	// What this envelope was built from, so that we can tell when the database gesture changed
+	const FVector* SourceData;
+	int32 NumSamples;
+	int32 BandWidth;
+	uint32 SampleCrc;
+
+	FVRGestureEnvelope()
+	{
+		SourceData = nullptr;
+		NumSamples = 0;
+		BandWidth = 0;
+		SampleCrc = 0;
+	}
+
+	bool IsValidFor(const FVRGesture& Gesture, int32 InBandWidth) const
+	{
+		return SourceData == Gesture.Samples.GetData() && NumSamples == Gesture.Samples.Num() && BandWidth == InBandWidth &&
+			SampleCrc == FCrc::MemCrc32(Gesture.Samples.GetData(), Gesture.Samples.Num() * sizeof(FVector));
+	}
+
+	void Build(const FVRGesture& Gesture, int32 InBandWidth);
+};
+
+// A running DTW column against one database gesture, extended by one input sample at a time
+struct FVRGestureStreamColumn
+{
+	// Index 0 is the free start of a match, index k is the cost of ending on the k'th gesture sample (in recorded order)
+	TArray<float> Cost;
+
+	// Sample number the match in each cell started at, so that matches older than the sample buffer can be thrown out
+	TArray<int32> StartSample;
+
+	// Steps in a row along the input / along the gesture, same as maxSlope limits in the full table
+	TArray<int32> SlopeInput;
+	TArray<int32> SlopeGesture;
+
+	void Reset(int32 NumExample)
+	{
+		Cost.Init(MAX_FLT, NumExample + 1);
+		Cost[0] = 0.f;
+		StartSample.Init(0, NumExample + 1);
+		SlopeInput.Init(0, NumExample + 1);
+		SlopeGesture.Init(0, NumExample + 1);
+	}
+};
+
+// Streaming match state for a single database gesture
+struct FVRGestureStreamState
+{
+	// What the columns were built against, if any of these change the gesture is replayed from the sample buffer
+	const FVector* SourceData;
+	int32 NumSamples;
+	bool bNeedsNormal;
+	bool bNeedsMirrored;
+
+	FVRGestureStreamColumn NormalColumn;
+	FVRGestureStreamColumn MirroredColumn;
+
+	FVRGestureStreamState()
+	{
+		SourceData = nullptr;
+		NumSamples = 0;
+		bNeedsNormal = false;
+		bNeedsMirrored = false;
+	}
+};
+
 /** Delegate for notification when the lever state changes. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FVRGestureDetectedSignature, uint8, GestureType, FString, DetectedGestureName, int, DetectedGestureIndex, UGesturesDatabase *, GestureDataBase);
 
@@ -293,6 +366,42 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures")
 	int maxSlope;
 
+	// Sakoe-Chiba band width, limits how far (in samples) the match can drift from the diagonal of the lookup table.
+	// Lowers the cost of matching and enables envelope pruning, 0 disables the band and matches the full table
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures|Recognition", meta = (ClampMin = "0", UIMin = "0"))
+		int DTWBandWidth;
+
+	// If true the gestures in the database will be checked in parallel, only worth it with larger databases
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures|Recognition")
+		bool bParallelRecognition;
+
+	// Minimum number of gestures in the database before parallel recognition is used
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures|Recognition", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bParallelRecognition"))
+		int ParallelRecognitionMinGestures;
+
+	// Envelopes for the current database gestures, indexed the same as the database, only used when DTWBandWidth > 0
+	TArray<FVRGestureEnvelope> GestureEnvelopes;
+
+	// If true detection keeps a running DTW column per database gesture and extends it with each new sample instead
+	// of re-matching the entire sample buffer every frame. The band width is not used in this mode.
+	// The columns run oldest to newest with a free start where the full match runs newest to oldest from the newest sample,
+	// the costs are the same until maxSlope kicks in, the greedy slope counters can then pick different paths in each direction
+	// and detect a different gesture (or none). vr.GestureRecognitionBenchmark reports how often they disagree.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures|Recognition")
+		bool bStreamingRecognition;
+
+	// How much the input scale can change (as a fraction) before the streaming columns are rebuilt from the sample buffer
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures|Recognition", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bStreamingRecognition"))
+		float StreamingRescaleTolerance;
+
+	// Streaming match state, indexed the same as the database
+	TArray<FVRGestureStreamState> StreamStates;
+	UGesturesDatabase* StreamDatabase;
+	float StreamScaler;
+
+	// Total samples captured since the streaming state was reset, the newest sample is StreamSampleCount - 1
+	int32 StreamSampleCount;
+
 	UPROPERTY(BlueprintReadOnly, Category = "VRGestures")
 	EVRGestureState CurrentState;
 
@@ -358,11 +467,35 @@ public:
 	// Recognize gesture in the given sequence.
 	// It will always assume that the gesture ends on the last observation of that sequence.
 	// If the distance between the last observations of each sequence is too great, or if the overall DTW distance between the two sequences is too great, no gesture will be recognized.
-	void RecognizeGesture(FVRGesture inputGesture);
+	void RecognizeGesture(const FVRGesture& inputGesture);
+
+	// Matching half of RecognizeGesture, returns the index of the best database gesture (or INDEX_NONE) without firing the detection events
+	int32 FindBestGestureMatch(const FVRGesture& inputGesture, float& OutDistance);
+
 
+	// Same as RecognizeGesture but only extends the running columns with the newest sample
+	void RecognizeGestureStreaming();
+
+	// Matching half of RecognizeGestureStreaming, extends the columns with the newest sample in GestureLog and returns the index
+	// of the best database gesture (or INDEX_NONE) without firing the detection events. Call it once per captured sample.
+	int32 FindBestStreamingGestureMatch(float& OutDistance);
+
+	// Throws out the streaming columns, they will be rebuilt from the sample buffer on the next sample
+	void ResetStreamingRecognition();
+
+	// Brings one gestures streaming state up to date with the sample buffer, returns false if it isn't checked by this component
+	bool UpdateStreamingGesture(int32 GestureIndex, bool bNewSampleOnly);
+
+	// Extends a streaming column with one input sample
+	void StepStreamingColumn(FVRGestureStreamColumn& Column, const FVRGesture& Example, const FVector& Sample, int32 SampleNumber, bool bMirrorGesture);
 
 	// Compute the min DTW distance between seq2 and all possible endings of seq1.
-	float dtw(FVRGesture seq1, FVRGesture seq2, bool bMirrorGesture = false, float Scaler = 1.f);
+	float dtw(const FVRGesture& seq1, const FVRGesture& seq2, bool bMirrorGesture = false, float Scaler = 1.f);
+
+	// Core DTW over pre-scaled input samples, returns false if abandoned early because the normalized cost
+	// (cost / NumExample) can no longer come in under AbandonCost.
+	// BandWidth of 0 runs the full table.
+	static bool ComputeDTW(const FVector* Input, int32 NumInput, const FVector* Example, int32 NumExample, bool bMirrorGesture, int32 MaxSlope, int32 BandWidth, float AbandonCost, float& OutCost);
 
 };
 
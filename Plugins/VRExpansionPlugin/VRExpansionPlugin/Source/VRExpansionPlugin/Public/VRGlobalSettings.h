@@ -170,6 +170,17 @@ public:
 	UFUNCTION(BlueprintPure, Category = "GlobalLerpToHand")
 		static bool IsGlobalLerpEnabled();
 
+	// How many phase groups each bucket in the BucketUpdateSubsystem is split into, callbacks are assigned to groups round robin
+	// and the groups fire staggered across the buckets update period so that a full bucket doesn't all fire on the same frame.
+	// 1 fires the entire bucket at once.
+	UPROPERTY(config, BlueprintReadWrite, EditAnywhere, Category = "BucketUpdates", meta = (ClampMin = "1", UIMin = "1", ClampMax = "32", UIMax = "32"))
+		int32 BucketUpdatePhaseGroups;
+
+	// Optional per frame time budget (in milliseconds) for the BucketUpdateSubsystem, callbacks that don't fit
+	// are carried over to the next frame. 0 is unlimited.
+	UPROPERTY(config, BlueprintReadWrite, EditAnywhere, Category = "BucketUpdates", meta = (ClampMin = "0", UIMin = "0"))
+		float BucketUpdateFrameBudgetMS;
+
 	// How many passes CCD will take during simulation, larger values significantly increase the cost of CCD calculation but also prevent tunneling artifacts
 	// Physx only
 	UPROPERTY(config, EditAnywhere, Category = "Physics")
@@ -68,6 +68,32 @@ public:
 	// Counts how long until next draw
 	float DrawCounter;
 
+	/**
+	* If true the widget is only redrawn when its slate tree is invalidated or reports pending work, its size changes or RequestRedraw is called.
+	* Redraws are granted by the worlds stereo widget scheduler within vr.StereoWidgetRedrawBudget, DrawRate becomes the max rate.
+	* Widgets relying on property bindings should set MaxRedrawInterval.
+	* Slate invalidations are only visible with WITH_SLATE_DEBUGGING, without it (shipping / test by default) the widget draws at DrawRate within the budget.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WidgetSettings", meta = (ExposeOnSpawn = true))
+		bool bUseRedrawScheduler;
+
+	/** When using the redraw scheduler, the max time in seconds between redraws without an invalidation, 0 never forces one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WidgetSettings", meta = (ExposeOnSpawn = true, ClampMin = "0.0"))
+		float MaxRedrawInterval;
+
+	// Flags the widget as invalidated so the scheduler redraws it on the next allowed draw
+	UFUNCTION(BlueprintCallable, Category = "WidgetSettings")
+		void RequestRedraw();
+
+	// Set by RequestRedraw, cleared on render
+	bool bRedrawRequested;
+
+	// Time since we last rendered the widget
+	float TimeSinceLastDraw;
+
+	// Texture size of the last render, a change in size always invalidates
+	FVector2D LastDrawnSize;
+
 	/** The Slate widget to be displayed by this component.  Only one of either Widget or SlateWidget can be used */
 	TSharedPtr<SWidget> SlateWidget;
 
@@ -92,6 +118,9 @@ public:
 	void InitWidget();
 	void RenderWidget(float DeltaTime);
 	void ReleaseResources();
+
+	// Returns true if the widget is invalidated and has been granted a render by the redraw scheduler
+	bool ConsumeScheduledRedraw();
 };
 
 
@@ -121,6 +150,7 @@ public:
 	void OnUnregister() override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 	virtual void DrawWidgetToRenderTarget(float DeltaTime) override;
+	virtual bool ShouldDrawWidget() const override;
 	virtual TStructOnScope<FActorComponentInstanceData>  GetComponentInstanceData() const override;
 	void ApplyVRComponentInstanceData(class FVRStereoWidgetComponentInstanceData* WidgetInstanceData);
 
@@ -146,6 +176,19 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StereoLayer")
 		bool bIsSleeping;
 
+	/**
+	* If true the widget is only redrawn when its slate tree is invalidated or reports pending work, its draw size changes or RequestRedraw is called.
+	* Redraws are granted by the worlds stereo widget scheduler within vr.StereoWidgetRedrawBudget, RedrawTime becomes the max rate.
+	* Widgets relying on property bindings should set MaxRedrawInterval.
+	* Slate invalidations are only visible with WITH_SLATE_DEBUGGING, without it (shipping / test by default) the widget draws at RedrawTime within the budget.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StereoLayer")
+		bool bUseRedrawScheduler;
+
+	/** When using the redraw scheduler, the max time in seconds between redraws without an invalidation, 0 never forces one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StereoLayer", meta = (ClampMin = "0.0"))
+		float MaxRedrawInterval;
+
 	/**
 	* Change the layer's render priority, higher priorities render on top of lower priorities
 	* @param	InPriority: Priority value
@@ -232,4 +275,9 @@ private:
 	/** Last frames visiblity state **/
 	bool bLastVisible;
 
+	/** If the redraw scheduler granted us a render this frame **/
+	bool bScheduledRedrawGranted;
+
+	bool ConsumeScheduledRedraw();
+
 };
\ No newline at end of file